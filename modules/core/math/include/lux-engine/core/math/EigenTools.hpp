@@ -1,3 +1,4 @@
+#pragma once
 #include <Eigen/Eigen>
 
 namespace lux::engine::core
@@ -59,4 +60,22 @@ namespace lux::engine::core
     Eigen::Matrix4f orthographicProjectionMatrix(const  ProjectionDescription& desc);
     Eigen::Matrix4f frustumMatrix(const ProjectionDescription& desc);
     Eigen::Matrix4f perspectiveMatrix(float fovy,float aspect,float zNear,float zFar);
+
+    // frustum planes stored as (normal, distance), a point p is inside when normal.dot(p) + distance >= 0
+    struct Frustum
+    {
+        Eigen::Vector4f planes[6]; // left, right, bottom, top, near, far
+    };
+
+    // extract planes in the space `projection_view` transforms from
+    Frustum extractFrustum(const Eigen::Matrix4f& projection_view);
+
+    inline bool sphereInFrustum(const Frustum& frustum, const Eigen::Vector3f& center, float radius) noexcept
+    {
+        for(auto& plane : frustum.planes)
+        {
+            if(plane.head<3>().dot(center) + plane[3] < -radius) return false;
+        }
+        return true;
+    }
 }
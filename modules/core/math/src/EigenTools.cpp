@@ -71,4 +71,20 @@ namespace lux::engine::core
 		mat(2,3) = - (2.0f * zFar * zNear) / (zFar - zNear);
 		return mat;
     }
+
+    Frustum extractFrustum(const Eigen::Matrix4f& m)
+    {
+        Frustum frustum;
+        frustum.planes[0] = m.row(3) + m.row(0);
+        frustum.planes[1] = m.row(3) - m.row(0);
+        frustum.planes[2] = m.row(3) + m.row(1);
+        frustum.planes[3] = m.row(3) - m.row(1);
+        frustum.planes[4] = m.row(3) + m.row(2);
+        frustum.planes[5] = m.row(3) - m.row(2);
+        for(auto& plane : frustum.planes)
+        {
+            plane /= plane.head<3>().norm();
+        }
+        return frustum;
+    }
 }
\ No newline at end of file
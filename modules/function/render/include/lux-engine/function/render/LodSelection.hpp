@@ -0,0 +1,96 @@
+#pragma once
+#include "Camera.hpp"
+#include <lux-engine/resource/mesh/Mesh.hpp>
+#include <lux-engine/platform/cxx/visibility_control.h>
+#include <vector>
+
+namespace lux::engine::function
+{
+    struct LodView
+    {
+        Eigen::Vector3f camera_position;
+        float           fov;                // vertical, degrees like Camera::fov()
+        uint32_t        viewport_height;    // pixels
+    };
+
+    LUX_EXPORT LodView makeLodView(Camera& camera, uint32_t viewport_height);
+
+    struct LodSelectionSettings
+    {
+        // largest acceptable screen space error of the selected lod, in pixels
+        float pixel_error{1.0f};
+        // a coarser lod is only taken once its error is this fraction below the threshold,
+        // objects sitting right at a switch distance don't flicker between two levels
+        float hysteresis{0.2f};
+        // bounds of the quality bias, adaptQualityBias never leaves them
+        float min_quality_bias{0.5f};
+        float max_quality_bias{8.0f};
+    };
+
+    /**
+     * @brief per frame lod selection for every registered object.
+     *        an object takes the coarsest lod whose simplification error (MeshLod::error scaled to world
+     *        units) projects to less than `pixel_error * qualityBias()` pixels at the nearest point of
+     *        its bounding sphere. the distance/threshold pass runs over packed arrays four objects at a time
+     */
+    class LodSelector
+    {
+    public:
+        LUX_EXPORT explicit LodSelector(const LodSelectionSettings& settings = {});
+
+        /**
+         * @param lods          MeshLod table, lods[0] is the full detail level
+         * @param local_bounds  object space bounds of the mesh the errors are relative to
+         * @return uint32_t     object id, ids are dense and stay valid until clear()
+         */
+        LUX_EXPORT uint32_t addObject(const resource::MeshLod* lods, size_t lod_count, const Eigen::AlignedBox3f& local_bounds);
+
+        LUX_EXPORT uint32_t addObject(const resource::Mesh& mesh);
+
+        LUX_EXPORT void setTransform(uint32_t object, const Eigen::Affine3f& model);
+
+        LUX_EXPORT void clear();
+
+        size_t objectCount() const { return _lod_counts.size(); }
+
+        /**
+         * @brief select lods for `visible` objects (every object when nullptr), others keep their level
+         */
+        LUX_EXPORT void select(const LodView& view, const uint32_t* visible = nullptr, size_t visible_count = 0);
+
+        uint32_t lod(uint32_t object) const { return _selected[object]; }
+
+        const std::vector<uint8_t>& lods() const { return _selected; }
+
+        // > 1 trades detail for speed, < 1 the other way around
+        void setQualityBias(float bias) { _quality_bias = bias; }
+
+        float qualityBias() const { return _quality_bias; }
+
+        /**
+         * @brief nudge the quality bias towards meeting `target_ms`, call once per frame with the
+         *        measured frame time. changes are limited to a few percent per frame
+         */
+        LUX_EXPORT void adaptQualityBias(float frame_ms, float target_ms);
+
+    private:
+        LodSelectionSettings    _settings;
+        float                   _quality_bias{1.0f};
+
+        // structure of arrays, one entry per object
+        std::vector<float>      _center_x;
+        std::vector<float>      _center_y;
+        std::vector<float>      _center_z;
+        std::vector<float>      _radius;
+        std::vector<float>      _inverse_extent;    // 1 / world space extent the lod errors are relative to
+        std::vector<float>      _local_extent;
+        std::vector<Eigen::Vector3f> _local_center;
+        std::vector<float>      _local_radius;
+        std::vector<uint32_t>   _error_offsets;     // into _errors
+        std::vector<uint8_t>    _lod_counts;
+        std::vector<uint8_t>    _selected;
+
+        std::vector<float>      _errors;            // relative errors of every object's lods
+        std::vector<float>      _allowed;           // scratch, allowed relative error per object
+    };
+} // namespace lux::engine::function
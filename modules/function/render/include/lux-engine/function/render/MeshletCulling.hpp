@@ -0,0 +1,40 @@
+#pragma once
+#include <lux-engine/resource/mesh/Mesh.hpp>
+#include <lux-engine/core/math/EigenTools.hpp>
+#include <lux-engine/platform/cxx/visibility_control.h>
+#include <functional>
+
+namespace lux::engine::function
+{
+    // a range of the mesh index buffer, ready for glDrawElements/glMultiDrawElements
+    struct DrawRange
+    {
+        uint32_t index_offset;
+        uint32_t index_count;
+    };
+
+    struct MeshletCullingContext
+    {
+        core::Frustum   frustum;            // world space
+        Eigen::Vector3f camera_position;    // world space
+        // optional, returns true if the world space sphere is hidden (e.g. behind a depth pyramid)
+        std::function<bool(const Eigen::Vector3f& center, float radius)> occluded;
+    };
+
+    struct MeshletCullingStats
+    {
+        uint32_t visible{0};
+        uint32_t frustum_culled{0};
+        uint32_t backface_culled{0};
+        uint32_t occlusion_culled{0};
+    };
+
+    /**
+     * @brief cull the meshlets of `mesh.lods[lod]` and append the visible ones to `ranges`,
+     *        meshlets next to each other in the index buffer are merged into a single range
+     */
+    LUX_EXPORT MeshletCullingStats cullMeshlets(
+        const resource::Mesh& mesh, size_t lod, const Eigen::Affine3f& model,
+        const MeshletCullingContext& context, std::vector<DrawRange>& ranges
+    );
+} // namespace lux::engine::function
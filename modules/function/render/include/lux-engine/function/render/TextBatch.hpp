@@ -0,0 +1,64 @@
+#pragma once
+#include <Eigen/Eigen>
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include <lux-engine/platform/cxx/visibility_control.h>
+#include <lux-engine/resource/font/FontAtlas.hpp>
+
+namespace lux::engine::function
+{
+    struct TextVertex
+    {
+        std::array<float, 3>    position;
+        std::array<float, 2>    uv;
+        std::array<uint8_t, 4>  color;      // rgba
+    };
+
+    /**
+     * @brief text quads of a frame grouped by atlas page, so however many strings are added
+     *        drawing takes one call per page. glyphs are placed at any size and orientation from the
+     *        same distance fields, hud and world space text only differ in the plane they are laid out on
+     */
+    class TextBatch
+    {
+    public:
+        LUX_EXPORT void clear();
+
+        /**
+         * @brief lay out utf-8 text starting on the baseline at `origin`, along `right` with glyphs
+         *        standing on `up`. '\n' starts a new line below
+         *
+         * @param size  units of `right` / `up` per em, e.g. pixels for hud text
+         * @return float width of the widest line
+         */
+        LUX_EXPORT float addText(
+            resource::FontAtlas& atlas, uint32_t font, std::string_view text,
+            const Eigen::Vector3f& origin, const Eigen::Vector3f& right, const Eigen::Vector3f& up,
+            float size, const std::array<uint8_t, 4>& color = {255, 255, 255, 255}
+        );
+
+        /**
+         * @brief hud text in pixels with y pointing down, `position` is the top left corner of the first line
+         */
+        LUX_EXPORT float addScreenText(
+            resource::FontAtlas& atlas, uint32_t font, std::string_view text,
+            const Eigen::Vector2f& position, float size, const std::array<uint8_t, 4>& color = {255, 255, 255, 255}
+        );
+
+        size_t pageCount() const { return _pages.size(); }
+
+        // two triangles per glyph
+        const std::vector<TextVertex>& vertices(size_t page) const { return _pages[page]; }
+
+        LUX_EXPORT size_t vertexCount() const;
+
+        // glyphs left out because their distance field was not ready yet
+        size_t pendingGlyphs() const { return _pending; }
+
+    private:
+        std::vector<std::vector<TextVertex>>    _pages;
+        size_t                                  _pending{0};
+    };
+} // namespace lux::engine::function
@@ -0,0 +1,191 @@
+#pragma once
+#include "LodSelection.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <vector>
+#include <lux-engine/resource/texture/TextureFile.hpp>
+#include <lux-engine/platform/cxx/IoQueue.hpp>
+#include <lux-engine/platform/cxx/visibility_control.h>
+
+namespace lux::engine::function
+{
+    struct TextureStreamingSettings
+    {
+        // bytes of every resident level of every streamed texture together
+        size_t      budget_bytes{size_t(512) << 20};
+        // levels no larger than this on both sides are loaded with the texture and never dropped
+        uint32_t    tail_size{64};
+        // copied level data waiting for an io thread or an upload, keeps load bursts from spiking memory
+        size_t      max_staging_bytes{size_t(64) << 20};
+        // upload bytes handed out per update(), spreads large levels over frames
+        size_t      max_upload_bytes{size_t(16) << 20};
+        // > 0 streams coarser levels than the screen size asks for
+        float       lod_bias{0.0f};
+        // nullptr reads on platform::IoQueue::global(), must outlive the streamer
+        platform::IoQueue*  io_queue{nullptr};
+    };
+
+    // one level ready to go up, `data` is exactly what the texture file stores for it
+    struct TextureLevelUpload
+    {
+        uint32_t                texture;
+        uint32_t                level;
+        uint32_t                width;
+        uint32_t                height;
+        std::vector<uint8_t>    data;
+    };
+
+    struct TextureStreamingUpdate
+    {
+        std::vector<TextureLevelUpload> uploads;        // coarsest level of a texture first
+        // textures whose finest levels were dropped, residentLevel() is the new base level
+        std::vector<uint32_t>           evicted;
+        // every texture whose resident range changed, the base level has to be updated
+        std::vector<uint32_t>           changed;
+    };
+
+    struct TextureStreamingStats
+    {
+        size_t resident_bytes{0};
+        size_t wanted_bytes{0};         // what the last update wanted resident, after fitting the budget
+        size_t staging_bytes{0};
+        size_t pending_loads{0};
+        size_t uploaded_bytes{0};       // in the last update
+        size_t evicted_levels{0};       // in the last update
+    };
+
+    /**
+     * @brief progressive mip streaming of texture files under a memory budget.
+     *        a texture is usable right after addTexture(): its smallest levels (stored at the front of the
+     *        file, next to the header that was just read) go up with the next update. every frame the
+     *        objects using a texture report their bounds, the projected size picks the finest level worth
+     *        having and background threads read the missing levels one at a time, most undersampled
+     *        texture first. when the wanted levels don't fit the budget, the finest levels of the textures
+     *        contributing least on screen (unused ones first, least recently used among them) are dropped.
+     *
+     *        per frame: beginFrame(), addUsage() for every visible object, then update() and apply the result
+     *        (see applyTextureStreaming() in the opengl3 TextureStreamingUpload.hpp)
+     */
+    class TextureStreamer
+    {
+    public:
+        LUX_EXPORT explicit TextureStreamer(const TextureStreamingSettings& settings = {});
+
+        LUX_EXPORT ~TextureStreamer();
+
+        TextureStreamer(const TextureStreamer&) = delete;
+
+        TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+        /**
+         * @return uint32_t texture id, UINT32_MAX when the file is not a valid texture file.
+         *         ids of removed textures are reused
+         */
+        LUX_EXPORT uint32_t addTexture(const std::string& path);
+
+        // the gpu texture is the caller's to delete, loads still running are thrown away
+        LUX_EXPORT void removeTexture(uint32_t texture);
+
+        LUX_EXPORT void beginFrame(const LodView& view);
+
+        /**
+         * @brief an object using `texture` this frame
+         *
+         * @param world_bounds  world space bounds of the object
+         * @param uv_scale      how often the texture repeats across the object, 1 when it is mapped once
+         */
+        LUX_EXPORT void addUsage(uint32_t texture, const Eigen::AlignedBox3f& world_bounds, float uv_scale = 1.0f);
+
+        /**
+         * @brief fit the wanted levels into the budget, drop what no longer fits, queue the missing levels
+         *        and hand out the ones the io tasks finished. call once per frame after the usages
+         */
+        LUX_EXPORT TextureStreamingUpdate update();
+
+        const resource::TextureFile& file(uint32_t texture) const { return *_textures[texture].file; }
+
+        // finest level currently resident (uploaded by the caller), the base level to sample from
+        uint32_t residentLevel(uint32_t texture) const { return _textures[texture].resident; }
+
+        // finest level the last update wanted
+        uint32_t wantedLevel(uint32_t texture) const { return _textures[texture].wanted; }
+
+        size_t textureCount() const { return _textures.size(); }
+
+        bool isValid(uint32_t texture) const { return texture < _textures.size() && _textures[texture].file != nullptr; }
+
+        LUX_EXPORT TextureStreamingStats stats() const;
+
+        const TextureStreamingSettings& settings() const { return _settings; }
+
+        LUX_EXPORT void setBudget(size_t budget_bytes);
+
+    private:
+        struct Texture
+        {
+            std::shared_ptr<resource::TextureFile>  file;
+            uint32_t    generation{0};      // bumped on remove, stale loads are dropped
+            uint32_t    level_count{0};
+            uint32_t    tail{0};            // first level of the permanent tail
+            uint32_t    resident{0};        // finest uploaded level, level_count before the tail is up
+            uint32_t    wanted{0};
+            uint32_t    loading{UINT32_MAX};   // level an io task is reading or that waits for upload
+            float       pixels{0.0f};       // projected size this frame, in texels of uv space
+            uint64_t    last_used{0};       // frame
+        };
+
+        struct LoadRequest
+        {
+            float       priority;
+            uint32_t    texture;
+            uint32_t    generation;
+            uint32_t    level;
+            std::shared_ptr<resource::TextureFile> file;
+
+            bool operator<(const LoadRequest& other) const { return priority < other.priority; }
+        };
+
+        struct LoadResult
+        {
+            uint32_t                texture;
+            uint32_t                generation;
+            TextureLevelUpload      upload;
+        };
+
+        size_t levelBytes(const Texture& texture, uint32_t level) const;
+
+        // bytes of levels [first, level_count)
+        size_t rangeBytes(const Texture& texture, uint32_t first) const;
+
+        void fitBudget();
+
+        // one io task per queued load, it reads whichever level is most urgent when it starts
+        void loadNext();
+
+        TextureStreamingSettings        _settings;
+        std::vector<Texture>            _textures;
+        std::vector<uint32_t>           _free_ids;
+        std::vector<TextureLevelUpload> _tail_uploads;  // read in addTexture(), handed out by the next update
+
+        LodView                         _view{};
+        float                           _pixel_scale{0.0f}; // viewport height / tan(fov / 2)
+        uint64_t                        _frame{0};
+        size_t                          _resident_bytes{0};
+        size_t                          _wanted_bytes{0};
+        size_t                          _uploaded_bytes{0};
+        size_t                          _evicted_levels{0};
+
+        // shared with the io tasks
+        platform::IoQueue*              _io;
+        platform::IoCounter             _tasks;
+        mutable std::mutex              _mutex;
+        std::priority_queue<LoadRequest> _queue;
+        std::vector<LoadResult>         _completed;
+        size_t                          _staging_bytes{0};
+        size_t                          _pending{0};    // queued + reading
+    };
+} // namespace lux::engine::function
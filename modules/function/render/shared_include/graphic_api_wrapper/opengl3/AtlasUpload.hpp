@@ -0,0 +1,39 @@
+#pragma once
+#include "TextureUpload.hpp"
+#include <lux-engine/resource/texture/TextureAtlas.hpp>
+
+namespace lux::engine::function
+{
+    /**
+     * @brief bring the texture bound at GL_TEXTURE_2D up to date with an atlas page. `allocate` uploads the
+     *        whole page (first use), otherwise only the dirty rectangle goes up. mips are regenerated,
+     *        the atlas gutters keep them clean for the configured number of levels
+     */
+    inline void uploadAtlasPage(resource::TextureAtlas& atlas, size_t index, bool allocate, bool srgb = true)
+    {
+        const resource::AtlasPage& page = atlas.page(index);
+        const GLsizei size = static_cast<GLsizei>(page.size);
+        if(allocate)
+        {
+            const GLTextureFormat format = glTextureFormat(resource::TextureFormat::RGBA8, srgb);
+            glTexImage2D(GL_TEXTURE_2D, 0, static_cast<GLint>(format.internal_format), size, size, 0,
+                GL_RGBA, GL_UNSIGNED_BYTE, page.pixels.data());
+        }
+        else if(page.isDirty())
+        {
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, size);
+            glTexSubImage2D(GL_TEXTURE_2D, 0,
+                static_cast<GLint>(page.dirty_x0), static_cast<GLint>(page.dirty_y0),
+                static_cast<GLsizei>(page.dirty_x1 - page.dirty_x0), static_cast<GLsizei>(page.dirty_y1 - page.dirty_y0),
+                GL_RGBA, GL_UNSIGNED_BYTE, page.pixels.data() + (size_t(page.dirty_y0) * page.size + page.dirty_x0) * 4);
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        }
+        else
+        {
+            return;
+        }
+        glGenerateMipmap(GL_TEXTURE_2D);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(atlas.mipLevels()) - 1);
+        atlas.clearDirty(index);
+    }
+}
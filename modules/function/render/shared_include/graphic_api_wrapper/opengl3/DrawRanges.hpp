@@ -0,0 +1,22 @@
+#pragma once
+#include <glad/glad.h>
+#include <lux-engine/function/render/MeshletCulling.hpp>
+#include <vector>
+
+namespace lux::engine::function
+{
+    // draw culled ranges of the bound GL_ELEMENT_ARRAY_BUFFER (uint32 indices) in a single call
+    inline void drawRanges(GLenum mode, const std::vector<DrawRange>& ranges)
+    {
+        thread_local std::vector<GLsizei>       counts;
+        thread_local std::vector<const void*>   offsets;
+        counts.clear();
+        offsets.clear();
+        for(auto& range : ranges)
+        {
+            counts.push_back(static_cast<GLsizei>(range.index_count));
+            offsets.push_back(reinterpret_cast<const void*>(size_t(range.index_offset) * sizeof(GLuint)));
+        }
+        glMultiDrawElements(mode, counts.data(), GL_UNSIGNED_INT, offsets.data(), static_cast<GLsizei>(counts.size()));
+    }
+}
@@ -0,0 +1,173 @@
+#pragma once
+#include <glad/glad.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+namespace lux::engine::function
+{
+    struct ReadbackFrame
+    {
+        uint32_t                width{0};
+        uint32_t                height{0};
+        std::vector<uint8_t>    pixels;         // rgba8, rows bottom to top like glReadPixels returns them
+        uint64_t                user_data{0};
+    };
+
+    /**
+     * @brief asynchronous glReadPixels through a ring of pixel pack buffers.
+     *        capture() only queues the copy on the GPU and drops a fence behind it, collect() maps the
+     *        buffers whose fence has signaled, typically a frame or two later, so neither side waits on the other.
+     *        the ring size is the number of captures in flight, capturing every frame wants at least 3
+     */
+    class GlReadbackRing
+    {
+    public:
+        explicit GlReadbackRing(size_t ring_size = 3)
+            : _slots(std::max<size_t>(ring_size, 1))
+        {
+            for(auto& slot : _slots) glGenBuffers(1, &slot.buffer);
+        }
+
+        ~GlReadbackRing()
+        {
+            for(auto& slot : _slots)
+            {
+                if(slot.fence) glDeleteSync(slot.fence);
+                glDeleteBuffers(1, &slot.buffer);
+            }
+        }
+
+        GlReadbackRing(const GlReadbackRing&) = delete;
+
+        GlReadbackRing& operator=(const GlReadbackRing&) = delete;
+
+        /**
+         * @brief queue a copy of a rectangle of the read framebuffer (GL_READ_FRAMEBUFFER and glReadBuffer
+         *        as bound by the caller). when every slot is still in flight the oldest one is waited for,
+         *        its frame is kept for the next collect(), or counted in dropped() if the wait fails
+         */
+        void capture(GLint x, GLint y, GLsizei width, GLsizei height, uint64_t user_data = 0)
+        {
+            if(width <= 0 || height <= 0) return;
+            Slot& slot = _slots[_next];
+            if(slot.fence) retrieve(slot, true);
+
+            const size_t size = size_t(width) * height * 4;
+            // the caller's pack state is put back, like the texture uploads do for the unpack state
+            GLint pack_alignment, previous;
+            glGetIntegerv(GL_PACK_ALIGNMENT, &pack_alignment);
+            glGetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &previous);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+            if(size != slot.capacity)
+            {
+                glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STREAM_READ);
+                slot.capacity = size;
+            }
+            glPixelStorei(GL_PACK_ALIGNMENT, 1);
+            // the pointer is an offset into the bound pack buffer, the call returns without waiting for the GPU
+            glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            glPixelStorei(GL_PACK_ALIGNMENT, pack_alignment);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, static_cast<GLuint>(previous));
+
+            slot.fence     = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            slot.width     = static_cast<uint32_t>(width);
+            slot.height    = static_cast<uint32_t>(height);
+            slot.user_data = user_data;
+            _next = (_next + 1) % _slots.size();
+            // make sure the fence reaches the GPU, otherwise polling it may never see it signal
+            glFlush();
+        }
+
+        /**
+         * @brief append finished captures in capture order
+         *
+         * @param wait block for everything in flight, e.g. before shutting down
+         * @return size_t frames appended
+         */
+        size_t collect(std::vector<ReadbackFrame>& frames, bool wait = false)
+        {
+            // oldest first, a later capture is never returned before an earlier one
+            for(size_t i = 0; i < _slots.size(); i++)
+            {
+                Slot& slot = _slots[(_next + i) % _slots.size()];
+                if(!slot.fence) continue;
+                if(!retrieve(slot, wait)) break;
+            }
+            const size_t count = _ready.size();
+            for(; !_ready.empty(); _ready.pop_front())
+            {
+                frames.push_back(std::move(_ready.front()));
+            }
+            return count;
+        }
+
+        size_t inFlight() const
+        {
+            return static_cast<size_t>(std::count_if(_slots.begin(), _slots.end(), [](const Slot& slot){ return slot.fence != nullptr; }));
+        }
+
+        // captures lost to a failed fence wait or buffer map since construction
+        size_t dropped() const { return _dropped; }
+
+    private:
+        struct Slot
+        {
+            GLuint      buffer{0};
+            size_t      capacity{0};
+            GLsync      fence{nullptr};
+            uint32_t    width{0};
+            uint32_t    height{0};
+            uint64_t    user_data{0};
+        };
+
+        // copy a slot out into _ready once its fence has signaled, false while it is still in flight
+        bool retrieve(Slot& slot, bool wait)
+        {
+            GLenum status;
+            do
+            {
+                // polling with a zero timeout never stalls, waiting is done in one second steps
+                status = glClientWaitSync(slot.fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, wait ? 1000000000ull : 0);
+            } while(wait && status == GL_TIMEOUT_EXPIRED);
+            if(status == GL_TIMEOUT_EXPIRED) return false;
+            glDeleteSync(slot.fence);
+            slot.fence = nullptr;
+            // GL_WAIT_FAILED, the slot is free again but its frame is gone
+            if(status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+            {
+                _dropped++;
+                return true;
+            }
+
+            ReadbackFrame frame;
+            frame.width     = slot.width;
+            frame.height    = slot.height;
+            frame.user_data = slot.user_data;
+            frame.pixels.resize(size_t(slot.width) * slot.height * 4);
+            GLint previous;
+            glGetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &previous);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+            const void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(frame.pixels.size()), GL_MAP_READ_BIT);
+            if(mapped == nullptr)
+            {
+                // a zero filled frame would pass for a black screenshot
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, static_cast<GLuint>(previous));
+                _dropped++;
+                return true;
+            }
+            std::memcpy(frame.pixels.data(), mapped, frame.pixels.size());
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, static_cast<GLuint>(previous));
+            _ready.push_back(std::move(frame));
+            return true;
+        }
+
+        std::vector<Slot>           _slots;
+        size_t                      _next{0};       // slot of the next capture, also the oldest one in flight
+        std::deque<ReadbackFrame>   _ready;         // retrieved but not collected yet
+        size_t                      _dropped{0};
+    };
+} // namespace lux::engine::function
@@ -0,0 +1,95 @@
+#pragma once
+#include "TextureUpload.hpp"
+#include <cstdint>
+#include <lux-engine/resource/texture/EnvironmentMap.hpp>
+
+namespace lux::engine::function
+{
+    /**
+     * @brief upload every level of a cube map (e.g. resource::prefilterSpecular()) to the texture bound at
+     *        GL_TEXTURE_CUBE_MAP as RGB16F / RGB9E5 / RGB32F, with trilinear filtering over the given levels.
+     *        sampling across face edges wants glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS) once per context
+     */
+    inline bool uploadCubemap(const resource::Cubemap& cubemap, HdrUploadFormat hdr_format = HdrUploadFormat::HALF)
+    {
+        if(cubemap.empty()) return false;
+
+        GLint unpack_alignment;
+        glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpack_alignment);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        std::vector<uint8_t> converted;
+        for(size_t index = 0; index < cubemap.levels.size(); index++)
+        {
+            const resource::CubemapLevel& level = cubemap.levels[index];
+            const GLsizei size  = static_cast<GLsizei>(level.size);
+            const size_t  count = size_t(level.size) * level.size;
+            for(uint32_t face = 0; face < 6; face++)
+            {
+                const GLenum target = GL_TEXTURE_CUBE_MAP_POSITIVE_X + face;
+                const float* texels = level.face(face);
+                if(hdr_format == HdrUploadFormat::RGB9E5)
+                {
+                    converted.resize(count * sizeof(uint32_t));
+                    platform::encodeRgb9e5(texels, 3, reinterpret_cast<uint32_t*>(converted.data()), count);
+                    glTexImage2D(target, static_cast<GLint>(index), GL_RGB9_E5, size, size, 0, GL_RGB,
+                        GL_UNSIGNED_INT_5_9_9_9_REV, converted.data());
+                }
+                else if(hdr_format == HdrUploadFormat::HALF)
+                {
+                    converted.resize(count * 3 * sizeof(uint16_t));
+                    platform::floatToHalf(texels, reinterpret_cast<uint16_t*>(converted.data()), count * 3);
+                    glTexImage2D(target, static_cast<GLint>(index), GL_RGB16F, size, size, 0, GL_RGB, GL_HALF_FLOAT, converted.data());
+                }
+                else
+                {
+                    glTexImage2D(target, static_cast<GLint>(index), GL_RGB32F, size, size, 0, GL_RGB, GL_FLOAT, texels);
+                }
+            }
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, unpack_alignment);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(cubemap.levels.size()) - 1);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER,
+            cubemap.levels.size() > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+        return true;
+    }
+
+    // the resource::computeBrdfLut() table to the texture bound at GL_TEXTURE_2D as RG16F
+    inline void uploadBrdfLut(const std::vector<float>& lut, uint32_t size)
+    {
+        std::vector<uint16_t> halves(lut.size());
+        platform::floatToHalf(lut.data(), halves.data(), lut.size());
+        GLint unpack_alignment;
+        glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpack_alignment);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, static_cast<GLsizei>(size), static_cast<GLsizei>(size), 0, GL_RG, GL_HALF_FLOAT,
+            halves.data());
+        glPixelStorei(GL_UNPACK_ALIGNMENT, unpack_alignment);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+
+    /**
+     * glsl side of the split sum, paste into a lighting shader: ibl_specular() is the prefiltered radiance
+     * times the environment brdf for a reflection vector, roughness and F0
+     */
+    constexpr const char* kSpecularIblGlsl = R"(
+uniform samplerCube ibl_prefiltered;
+uniform sampler2D ibl_brdf_lut;
+uniform float ibl_level_count;
+
+vec3 ibl_specular(vec3 n, vec3 v, float roughness, vec3 f0)
+{
+    float n_dot_v = clamp(dot(n, v), 0.0, 1.0);
+    vec3 radiance = textureLod(ibl_prefiltered, reflect(-v, n), roughness * (ibl_level_count - 1.0)).rgb;
+    vec2 brdf = texture(ibl_brdf_lut, vec2(n_dot_v, roughness)).rg;
+    return radiance * (f0 * brdf.x + brdf.y);
+}
+)";
+}
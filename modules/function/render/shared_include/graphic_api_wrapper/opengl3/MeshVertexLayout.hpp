@@ -0,0 +1,14 @@
+#pragma once
+#include "VertexLayout.hpp"
+#include <lux-engine/resource/mesh/Mesh.hpp>
+
+namespace lux::engine::function
+{
+    // matches the playground shaders: position 0, normal 1, uv 2
+    using MeshVertexLayout = VertexLayout<
+        resource::MeshVertex,
+        LUX_VERTEX_ATTRIBUTE(0, resource::MeshVertex, position),
+        LUX_VERTEX_ATTRIBUTE(1, resource::MeshVertex, normal),
+        LUX_VERTEX_ATTRIBUTE(2, resource::MeshVertex, uv)
+    >;
+}
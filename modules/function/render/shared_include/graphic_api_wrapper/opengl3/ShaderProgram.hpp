@@ -1,3 +1,4 @@
+#pragma once
 #include "Shader.hpp"
 #include <Eigen/Eigen>
 #include <array>
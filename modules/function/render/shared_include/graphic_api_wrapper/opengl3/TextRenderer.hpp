@@ -0,0 +1,214 @@
+#pragma once
+#include <glad/glad.h>
+#include <Eigen/Eigen>
+#include <string>
+#include <vector>
+#include <lux-engine/function/render/TextBatch.hpp>
+#include <lux-engine/resource/font/FontAtlas.hpp>
+#include "ShaderProgram.hpp"
+#include "VertexLayout.hpp"
+
+namespace lux::engine::function
+{
+    using TextVertexLayout = VertexLayout<
+        TextVertex,
+        LUX_VERTEX_ATTRIBUTE(0, TextVertex, position),
+        LUX_VERTEX_ATTRIBUTE(1, TextVertex, uv),
+        LUX_VERTEX_ATTRIBUTE_NORMALIZED(2, TextVertex, color)
+    >;
+
+    /**
+     * @brief draws a TextBatch from the distance field pages of a FontAtlas, one draw call per page.
+     *        the edge is antialiased over one screen pixel whatever the text size, so the same
+     *        pages serve hud and world space text. needs a current GL 3.3 context for its whole lifetime
+     */
+    class GlTextRenderer
+    {
+    public:
+        GlTextRenderer()
+        {
+            GlVertexShader   vertex_shader(&kVertexShader);
+            GlFragmentShader fragment_shader(&kFragmentShader);
+            if(!vertex_shader.compile(_info) || !fragment_shader.compile(_info)) return;
+            _program.attachShader(vertex_shader).attachShader(fragment_shader);
+            if(!_program.link(_info)) return;
+            _projection_location = _program.uniformFindLocationUnsafe("projection");
+            _atlas_location      = _program.uniformFindLocationUnsafe("atlas");
+
+            glGenVertexArrays(1, &_vao);
+            glGenBuffers(1, &_vbo);
+            glBindVertexArray(_vao);
+            glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+            TextVertexLayout::apply();
+            glBindVertexArray(0);
+            _enable = true;
+        }
+
+        ~GlTextRenderer()
+        {
+            if(!_textures.empty()) glDeleteTextures(static_cast<GLsizei>(_textures.size()), _textures.data());
+            if(_vbo) glDeleteBuffers(1, &_vbo);
+            if(_vao) glDeleteVertexArrays(1, &_vao);
+        }
+
+        GlTextRenderer(const GlTextRenderer&) = delete;
+
+        GlTextRenderer& operator=(const GlTextRenderer&) = delete;
+
+        bool isEnable() const { return _enable; }
+
+        // shader compile / link messages when isEnable() is false
+        const std::string& info() const { return _info; }
+
+        /**
+         * @brief create textures for new pages and upload the dirty rectangles, then clears them on the atlas.
+         *        call after FontAtlas::update()
+         */
+        void syncPages(resource::FontAtlas& atlas)
+        {
+            GLint unpack_alignment, previous;
+            glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpack_alignment);
+            glGetIntegerv(GL_TEXTURE_BINDING_2D, &previous);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            for(size_t index = 0; index < atlas.pageCount(); index++)
+            {
+                const resource::FontPage& page = atlas.page(index);
+                if(index == _textures.size())
+                {
+                    GLuint texture;
+                    glGenTextures(1, &texture);
+                    glBindTexture(GL_TEXTURE_2D, texture);
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, page.size, page.size, 0, GL_RED, GL_UNSIGNED_BYTE, page.pixels.data());
+                    // the field is smooth, bilinear is all the reconstruction it needs
+                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+                    _textures.push_back(texture);
+                    continue;
+                }
+                if(!page.isDirty()) continue;
+
+                glBindTexture(GL_TEXTURE_2D, _textures[index]);
+                glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(page.size));
+                glTexSubImage2D(GL_TEXTURE_2D, 0, page.dirty_x0, page.dirty_y0,
+                    page.dirty_x1 - page.dirty_x0, page.dirty_y1 - page.dirty_y0, GL_RED, GL_UNSIGNED_BYTE,
+                    page.pixels.data() + static_cast<size_t>(page.dirty_y0) * page.size + page.dirty_x0);
+                glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+            }
+            glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(previous));
+            glPixelStorei(GL_UNPACK_ALIGNMENT, unpack_alignment);
+            atlas.clearDirty();
+        }
+
+        /**
+         * @brief draw every quad of the batch with alpha blending, depth state is left to the caller
+         *
+         * @param projection    maps the batch positions to clip space, screenProjection() for hud text
+         */
+        void draw(const TextBatch& batch, const Eigen::Matrix4f& projection)
+        {
+            if(!_enable || batch.vertexCount() == 0) return;
+
+            // a single upload for the whole frame, pages are ranges of it
+            _staging.clear();
+            _staging.reserve(batch.vertexCount());
+            _ranges.clear();
+            for(size_t page = 0; page < batch.pageCount() && page < _textures.size(); page++)
+            {
+                const auto& vertices = batch.vertices(page);
+                _ranges.push_back(static_cast<GLsizei>(_staging.size()));
+                _staging.insert(_staging.end(), vertices.begin(), vertices.end());
+            }
+            _ranges.push_back(static_cast<GLsizei>(_staging.size()));
+
+            glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+            // orphan the previous frame's storage instead of waiting for it
+            glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(_staging.size() * sizeof(TextVertex)), nullptr, GL_STREAM_DRAW);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(_staging.size() * sizeof(TextVertex)), _staging.data());
+
+            const GLboolean blend = glIsEnabled(GL_BLEND);
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+            _program.use();
+            _program.uniformSetMatrix(_projection_location, false, projection);
+            _program.uniformSetVector<int>(_atlas_location, 0);
+            glActiveTexture(GL_TEXTURE0);
+            glBindVertexArray(_vao);
+            for(size_t page = 0; page + 1 < _ranges.size(); page++)
+            {
+                const GLsizei count = _ranges[page + 1] - _ranges[page];
+                if(count == 0) continue;
+                glBindTexture(GL_TEXTURE_2D, _textures[page]);
+                glDrawArrays(GL_TRIANGLES, _ranges[page], count);
+            }
+            glBindVertexArray(0);
+
+            if(!blend) glDisable(GL_BLEND);
+        }
+
+        // pixels with the origin at the top left and y pointing down, what TextBatch::addScreenText lays out in
+        static Eigen::Matrix4f screenProjection(float width, float height)
+        {
+            Eigen::Matrix4f projection = Eigen::Matrix4f::Identity();
+            projection(0, 0) =  2.0f / width;
+            projection(1, 1) = -2.0f / height;
+            projection(0, 3) = -1.0f;
+            projection(1, 3) =  1.0f;
+            return projection;
+        }
+
+    private:
+        static constexpr const char* kVertexShader =
+R"(
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec2 aUv;
+layout (location = 2) in vec4 aColor;
+
+uniform mat4 projection;
+
+out vec2 uv;
+out vec4 color;
+
+void main()
+{
+    gl_Position = projection * vec4(aPos, 1.0);
+    uv          = aUv;
+    color       = aColor;
+}
+)";
+
+        static constexpr const char* kFragmentShader =
+R"(
+#version 330 core
+in vec2 uv;
+in vec4 color;
+
+uniform sampler2D atlas;
+
+out vec4 FragColor;
+
+void main()
+{
+    // 0.5 is the outline, the transition spans one pixel on screen at any scale
+    float d = texture(atlas, uv).r;
+    float w = max(fwidth(d), 1e-4) * 0.5;
+    float alpha = smoothstep(0.5 - w, 0.5 + w, d);
+    FragColor = vec4(color.rgb, color.a * alpha);
+}
+)";
+
+        ShaderProgram           _program;
+        GLint                   _projection_location{-1};
+        GLint                   _atlas_location{-1};
+        GLuint                  _vao{0};
+        GLuint                  _vbo{0};
+        std::vector<GLuint>     _textures;
+        std::vector<TextVertex> _staging;
+        std::vector<GLsizei>    _ranges;
+        std::string             _info;
+        bool                    _enable{false};
+    };
+} // namespace lux::engine::function
@@ -0,0 +1,56 @@
+#pragma once
+#include "TextureUpload.hpp"
+
+namespace lux::engine::function
+{
+    /**
+     * @brief upload the levels of a texture file to the texture bound at GL_TEXTURE_2D, straight from the
+     *        mapped file. with GL 4.2 the storage is allocated once and filled with glCompressedTexSubImage2D
+     *
+     * @param first_level skip this many of the largest levels, e.g. for low memory configurations
+     */
+    inline bool uploadTextureFile(const resource::TextureFile& file, size_t first_level = 0)
+    {
+        if(!file.isEnable() || first_level >= file.levelCount()) return false;
+
+        const GLTextureFormat format = glTextureFormat(file.format(), file.isSrgb());
+        const GLsizei level_count = static_cast<GLsizei>(file.levelCount() - first_level);
+        const resource::TextureLevelView base = file.level(first_level);
+
+        GLint unpack_alignment;
+        glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpack_alignment);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+        bool immutable = false;
+#if defined(GL_VERSION_4_2)
+        if(glTexStorage2D)
+        {
+            glTexStorage2D(GL_TEXTURE_2D, level_count, format.internal_format,
+                static_cast<GLsizei>(base.width), static_cast<GLsizei>(base.height));
+            immutable = true;
+        }
+#endif
+        for(GLsizei level = 0; level < level_count; level++)
+        {
+            const resource::TextureLevelView view = file.level(first_level + level);
+            const GLsizei width  = static_cast<GLsizei>(view.width);
+            const GLsizei height = static_cast<GLsizei>(view.height);
+            const GLsizei size   = static_cast<GLsizei>(view.size);
+            if(format.compressed)
+            {
+                if(immutable) glCompressedTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, width, height, format.internal_format, size, view.data);
+                else          glCompressedTexImage2D(GL_TEXTURE_2D, level, format.internal_format, width, height, 0, size, view.data);
+            }
+            else
+            {
+                if(immutable) glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, width, height, format.format, format.type, view.data);
+                else          glTexImage2D(GL_TEXTURE_2D, level, static_cast<GLint>(format.internal_format), width, height, 0,
+                                           format.format, format.type, view.data);
+            }
+        }
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, level_count - 1);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, unpack_alignment);
+        return true;
+    }
+}
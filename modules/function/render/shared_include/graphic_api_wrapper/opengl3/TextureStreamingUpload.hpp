@@ -0,0 +1,63 @@
+#pragma once
+#include "TextureUpload.hpp"
+#include <lux-engine/function/render/TextureStreaming.hpp>
+
+namespace lux::engine::function
+{
+    /**
+     * @brief apply a streaming update, `textures[id]` is the gpu texture of streamer texture `id` (created by
+     *        the caller right after addTexture()). levels are specified one by one instead of through immutable
+     *        storage, so the dropped finest levels give their memory back (re-specified as 0x0), and sampling
+     *        is limited to the resident levels through the base level
+     */
+    inline void applyTextureStreaming(const TextureStreamer& streamer, const TextureStreamingUpdate& update, const GLuint* textures)
+    {
+        GLint unpack_alignment, previous;
+        glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpack_alignment);
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, &previous);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+        for(auto& upload : update.uploads)
+        {
+            const resource::TextureFile& file = streamer.file(upload.texture);
+            const GLTextureFormat format = glTextureFormat(file.format(), file.isSrgb());
+            const GLint   level  = static_cast<GLint>(upload.level);
+            const GLsizei width  = static_cast<GLsizei>(upload.width);
+            const GLsizei height = static_cast<GLsizei>(upload.height);
+            glBindTexture(GL_TEXTURE_2D, textures[upload.texture]);
+            if(format.compressed)
+            {
+                glCompressedTexImage2D(GL_TEXTURE_2D, level, format.internal_format, width, height, 0,
+                    static_cast<GLsizei>(upload.data.size()), upload.data.data());
+            }
+            else
+            {
+                glTexImage2D(GL_TEXTURE_2D, level, static_cast<GLint>(format.internal_format), width, height, 0,
+                    format.format, format.type, upload.data.data());
+            }
+        }
+
+        for(uint32_t texture : update.evicted)
+        {
+            const resource::TextureFile& file = streamer.file(texture);
+            const GLTextureFormat format = glTextureFormat(file.format(), file.isSrgb());
+            glBindTexture(GL_TEXTURE_2D, textures[texture]);
+            for(GLint level = 0; level < static_cast<GLint>(streamer.residentLevel(texture)); level++)
+            {
+                if(format.compressed) glCompressedTexImage2D(GL_TEXTURE_2D, level, format.internal_format, 0, 0, 0, 0, nullptr);
+                else                  glTexImage2D(GL_TEXTURE_2D, level, static_cast<GLint>(format.internal_format), 0, 0, 0,
+                                                   format.format, format.type, nullptr);
+            }
+        }
+
+        for(uint32_t texture : update.changed)
+        {
+            glBindTexture(GL_TEXTURE_2D, textures[texture]);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(streamer.residentLevel(texture)));
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(streamer.file(texture).levelCount() - 1));
+        }
+
+        glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(previous));
+        glPixelStorei(GL_UNPACK_ALIGNMENT, unpack_alignment);
+    }
+}
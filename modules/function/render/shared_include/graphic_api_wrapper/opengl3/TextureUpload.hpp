@@ -0,0 +1,254 @@
+#pragma once
+#include <glad/glad.h>
+#include <algorithm>
+#include <vector>
+#include <lux-engine/platform/media_loaders/Image.hpp>
+#include <lux-engine/platform/media_loaders/ImageOps.hpp>
+#include <lux-engine/resource/texture/TextureFile.hpp>
+
+// block compression enums from EXT_texture_compression_s3tc / EXT_texture_sRGB, not part of core GL
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+    #define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT        0x83F1
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+    #define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT        0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT
+    #define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT  0x8C4D
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+    #define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT  0x8C4F
+#endif
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+    #define GL_COMPRESSED_RGBA_BPTC_UNORM           0x8E8C
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM
+    #define GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM     0x8E8D
+#endif
+
+namespace lux::engine::function
+{
+    struct GLTextureFormat
+    {
+        GLenum  internal_format;
+        GLenum  format;             // unused for compressed formats
+        GLenum  type;               // unused for compressed formats
+        bool    compressed;
+    };
+
+    inline GLTextureFormat glTextureFormat(resource::TextureFormat format, bool srgb)
+    {
+        using resource::TextureFormat;
+        switch(format)
+        {
+            case TextureFormat::R8:    return {GL_R8, GL_RED, GL_UNSIGNED_BYTE, false};
+            case TextureFormat::RG8:   return {GL_RG8, GL_RG, GL_UNSIGNED_BYTE, false};
+            case TextureFormat::RGB8:  return {static_cast<GLenum>(srgb ? GL_SRGB8 : GL_RGB8), GL_RGB, GL_UNSIGNED_BYTE, false};
+            case TextureFormat::RGBA8: return {static_cast<GLenum>(srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8), GL_RGBA, GL_UNSIGNED_BYTE, false};
+            case TextureFormat::BC1:
+                return {static_cast<GLenum>(srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT1_EXT), 0, 0, true};
+            case TextureFormat::BC3:
+                return {static_cast<GLenum>(srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT), 0, 0, true};
+            case TextureFormat::BC4:   return {GL_COMPRESSED_RED_RGTC1, 0, 0, true};
+            case TextureFormat::BC5:   return {GL_COMPRESSED_RG_RGTC2, 0, 0, true};
+            case TextureFormat::BC7:
+                return {static_cast<GLenum>(srgb ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM), 0, 0, true};
+        }
+        return {GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, false};
+    }
+
+    // how FLOAT32 images go up
+    enum class HdrUploadFormat : uint8_t
+    {
+        HALF,       // R16F - RGBA16F, half the size of the floats
+        RGB9E5,     // 4 bytes per texel with a shared exponent, no alpha, no negative values
+        FLOAT       // R32F - RGBA32F as decoded
+    };
+
+    struct ImageUploadSettings
+    {
+        // color sampled through an sRGB format. core GL has no one or two channel sRGB formats,
+        // so sRGB images always go up as rgba
+        bool        srgb{true};
+        // scan the texels first, gray and opaque images drop the channels that carry nothing
+        bool        analyze{true};
+        // linear data only: the shader reads just the first n channels, e.g. 1 for a roughness map
+        uint32_t    used_channels{4};
+        bool        premultiply_alpha{false};
+        // rgba goes up in bgra order, the native layout of many desktop drivers
+        bool        bgra{false};
+        bool        mipmaps{true};
+        HdrUploadFormat hdr_format{HdrUploadFormat::HALF};
+    };
+
+    struct ImageUploadFormat
+    {
+        GLTextureFormat gl;
+        uint32_t        channels;       // bytes per texel of the uploaded data
+        bool            alpha;          // the last uploaded channel is alpha
+        GLint           swizzle[4];     // GL_TEXTURE_SWIZZLE_RGBA, gray formats replicate red into rgb
+    };
+
+    /**
+     * @brief pick the tightest internal format for an 8 bit image with `channels` channels (1 gray,
+     *        2 gray + alpha, 3 rgb, 4 rgba). gray linear images become R8/RG8 with a swizzle, so shaders
+     *        sampling .rgb keep working; rgb is expanded to rgba because drivers store RGB8 padded anyway
+     *        and convert it texel by texel on upload
+     */
+    inline ImageUploadFormat negotiateImageFormat(
+        uint32_t channels, const platform::ImageChannelUsage& usage, const ImageUploadSettings& settings)
+    {
+        constexpr GLint kIdentity[4]    = {GL_RED, GL_GREEN, GL_BLUE, GL_ALPHA};
+        constexpr GLint kGray[4]        = {GL_RED, GL_RED, GL_RED, GL_ONE};
+        constexpr GLint kGrayAlpha[4]   = {GL_RED, GL_RED, GL_RED, GL_GREEN};
+        auto make = [](GLTextureFormat gl, uint32_t texel_channels, bool alpha, const GLint (&swizzle)[4])
+        {
+            ImageUploadFormat format{gl, texel_channels, alpha, {}};
+            std::copy(swizzle, swizzle + 4, format.swizzle);
+            return format;
+        };
+
+        const bool has_alpha = (channels == 2 || channels == 4) && !usage.opaque;
+        if(!settings.srgb)
+        {
+            const uint32_t used = std::clamp<uint32_t>(settings.used_channels, 1, 4);
+            const GLTextureFormat r8  = glTextureFormat(resource::TextureFormat::R8, false);
+            const GLTextureFormat rg8 = glTextureFormat(resource::TextureFormat::RG8, false);
+            if(channels >= 3 && used == 1)                      return make(r8, 1, false, kIdentity);
+            if(channels >= 3 && used == 2 && !usage.grayscale)  return make(rg8, 2, false, kIdentity);
+            // gray read as .rgb (or .rg of a gray mask) samples the same out of a replicated red channel
+            if(usage.grayscale && (!has_alpha || (channels >= 3 && used < 4)))
+            {
+                return make(r8, 1, false, kGray);
+            }
+            if(channels == 2)                                   return make(rg8, 2, true, kGrayAlpha);
+        }
+        // gray + alpha out of an rgba source stays rgba, it is rare and has no cheap pack
+        const GLTextureFormat rgba8 = glTextureFormat(resource::TextureFormat::RGBA8, settings.srgb);
+        ImageUploadFormat format = make(rgba8, 4, has_alpha, kIdentity);
+        if(settings.bgra)
+        {
+            format.gl.format = GL_BGRA;
+            format.gl.type   = GL_UNSIGNED_INT_8_8_8_8_REV;
+        }
+        return format;
+    }
+
+    /**
+     * @brief upload a UINT16 or FLOAT32 image to the texture bound at GL_TEXTURE_2D. 16 bit images keep
+     *        their channel count as R16 - RGBA16 (there are no 16 bit sRGB formats), float images go up
+     *        as `settings.hdr_format`, converted on the cpu. gray images get the same swizzles as 8 bit ones
+     */
+    inline bool uploadHighPrecisionImage(platform::Image& image, const ImageUploadSettings& settings = {})
+    {
+        if(!image.isEnable() || image.format() == platform::PixelFormat::UINT8) return false;
+
+        constexpr GLint kIdentity[4]    = {GL_RED, GL_GREEN, GL_BLUE, GL_ALPHA};
+        constexpr GLint kGray[4]        = {GL_RED, GL_RED, GL_RED, GL_ONE};
+        constexpr GLint kGrayAlpha[4]   = {GL_RED, GL_RED, GL_RED, GL_GREEN};
+        constexpr GLenum kLayouts[4]    = {GL_RED, GL_RG, GL_RGB, GL_RGBA};
+        constexpr GLenum kUnorm16[4]    = {GL_R16, GL_RG16, GL_RGB16, GL_RGBA16};
+        constexpr GLenum kHalf[4]       = {GL_R16F, GL_RG16F, GL_RGB16F, GL_RGBA16F};
+        constexpr GLenum kFloat[4]      = {GL_R32F, GL_RG32F, GL_RGB32F, GL_RGBA32F};
+
+        const uint32_t channels = static_cast<uint32_t>(image.channel());
+        const GLsizei  width    = static_cast<GLsizei>(image.width());
+        const GLsizei  height   = static_cast<GLsizei>(image.height());
+        const size_t   count    = static_cast<size_t>(width) * height;
+        if(channels == 0 || channels > 4) return false;
+
+        GLTextureFormat format{kLayouts[channels - 1], kLayouts[channels - 1], GL_UNSIGNED_SHORT, false};
+        const GLint* swizzle = channels == 1 ? kGray : channels == 2 ? kGrayAlpha : kIdentity;
+        std::vector<uint8_t> converted;
+        const void* upload = image.data();
+        if(image.format() == platform::PixelFormat::UINT16)
+        {
+            format.internal_format = kUnorm16[channels - 1];
+        }
+        else if(settings.hdr_format == HdrUploadFormat::RGB9E5)
+        {
+            format  = GLTextureFormat{GL_RGB9_E5, GL_RGB, GL_UNSIGNED_INT_5_9_9_9_REV, false};
+            swizzle = kIdentity;
+            converted.resize(count * sizeof(uint32_t));
+            platform::encodeRgb9e5(static_cast<const float*>(image.data()), channels,
+                reinterpret_cast<uint32_t*>(converted.data()), count);
+            upload = converted.data();
+        }
+        else if(settings.hdr_format == HdrUploadFormat::HALF)
+        {
+            format.internal_format = kHalf[channels - 1];
+            format.type            = GL_HALF_FLOAT;
+            converted.resize(count * channels * sizeof(uint16_t));
+            platform::floatToHalf(static_cast<const float*>(image.data()),
+                reinterpret_cast<uint16_t*>(converted.data()), count * channels);
+            upload = converted.data();
+        }
+        else
+        {
+            format.internal_format = kFloat[channels - 1];
+            format.type            = GL_FLOAT;
+        }
+
+        GLint unpack_alignment;
+        glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpack_alignment);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, 0, static_cast<GLint>(format.internal_format), width, height, 0,
+            format.format, format.type, upload);
+        glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, unpack_alignment);
+        if(settings.mipmaps) glGenerateMipmap(GL_TEXTURE_2D);
+        return true;
+    }
+
+    /**
+     * @brief upload a decoded image to the texture bound at GL_TEXTURE_2D in the negotiated format,
+     *        converting channels on the cpu with the simd kernels only when the layout changes.
+     *        UINT16 and FLOAT32 images are handed to uploadHighPrecisionImage()
+     */
+    inline bool uploadImage(platform::Image& image, const ImageUploadSettings& settings = {})
+    {
+        if(!image.isEnable()) return false;
+        if(image.format() != platform::PixelFormat::UINT8) return uploadHighPrecisionImage(image, settings);
+
+        const uint32_t channels = static_cast<uint32_t>(image.channel());
+        const GLsizei  width    = static_cast<GLsizei>(image.width());
+        const GLsizei  height   = static_cast<GLsizei>(image.height());
+        const size_t   count    = static_cast<size_t>(width) * height;
+        const uint8_t* pixels   = static_cast<const uint8_t*>(image.data());
+
+        platform::ImageChannelUsage usage;
+        if(settings.analyze)
+        {
+            usage = platform::analyzeChannels(pixels, count, channels);
+        }
+        else
+        {
+            usage.opaque    = channels == 1 || channels == 3;
+            usage.grayscale = channels <= 2;
+        }
+        const ImageUploadFormat format = negotiateImageFormat(channels, usage, settings);
+        const bool premultiply = settings.premultiply_alpha && format.alpha;
+        const bool bgra        = format.gl.format == GL_BGRA;
+
+        std::vector<uint8_t> converted;
+        const uint8_t* upload = pixels;
+        if(format.channels != channels || premultiply || bgra)
+        {
+            converted.resize(count * format.channels);
+            platform::convertChannels(pixels, channels, converted.data(), format.channels, count, true);
+            if(premultiply) platform::premultiplyAlpha(converted.data(), count, format.channels);
+            if(bgra)        platform::swizzleRgbaToBgra(converted.data(), converted.data(), count);
+            upload = converted.data();
+        }
+
+        GLint unpack_alignment;
+        glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpack_alignment);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, 0, static_cast<GLint>(format.gl.internal_format), width, height, 0,
+            format.gl.format, format.gl.type, upload);
+        glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, format.swizzle);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, unpack_alignment);
+        if(settings.mipmaps) glGenerateMipmap(GL_TEXTURE_2D);
+        return true;
+    }
+}
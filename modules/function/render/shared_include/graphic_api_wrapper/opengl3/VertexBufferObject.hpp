@@ -28,6 +28,13 @@ namespace lux::engine::function
             glBindBuffer(target, _vbo);
         }
 
+        // `data` may point straight into a mapped file (e.g. GltfBufferView::data), GL copies it
+        void bufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+        {
+            glBindBuffer(target, _vbo);
+            glBufferData(target, size, data, usage);
+        }
+
     private:
         GLsizei _number;
         GLuint  _vbo;
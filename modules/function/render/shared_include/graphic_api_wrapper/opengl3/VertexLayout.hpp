@@ -0,0 +1,254 @@
+#pragma once
+#include <glad/glad.h>
+#include <Eigen/Eigen>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+namespace lux::engine::function
+{
+    // scalar type -> GL component enum
+    template<class T> struct GLComponentTypeMap;
+    #define GL_COMPONENT_MAP_HELPER(TYPE, GL_TYPE)\
+    template<> struct GLComponentTypeMap<TYPE>{\
+        constexpr static GLenum type = GL_TYPE;\
+        constexpr static bool   integer = !std::is_floating_point_v<TYPE>;\
+    };
+    GL_COMPONENT_MAP_HELPER(float,    GL_FLOAT)          GL_COMPONENT_MAP_HELPER(double,   GL_DOUBLE)
+    GL_COMPONENT_MAP_HELPER(int8_t,   GL_BYTE)           GL_COMPONENT_MAP_HELPER(uint8_t,  GL_UNSIGNED_BYTE)
+    GL_COMPONENT_MAP_HELPER(int16_t,  GL_SHORT)          GL_COMPONENT_MAP_HELPER(uint16_t, GL_UNSIGNED_SHORT)
+    GL_COMPONENT_MAP_HELPER(int32_t,  GL_INT)            GL_COMPONENT_MAP_HELPER(uint32_t, GL_UNSIGNED_INT)
+
+    // four components packed in one uint32, e.g. the output of resource::packTangentFrames
+    struct PackedSnorm10x3_2 { uint32_t value; };
+    struct PackedUnorm10x3_2 { uint32_t value; };
+
+    // attribute type -> (component type, component count)
+    template<class T, class = void> struct GLAttributeFormatMap
+    {
+        static_assert(std::is_arithmetic_v<T>, "no GL attribute format for this type");
+        using component_type = T;
+        constexpr static GLint  size = 1;
+        constexpr static GLenum type = GLComponentTypeMap<T>::type;
+    };
+    template<class T, int LEN> struct GLAttributeFormatMap<Eigen::Matrix<T, LEN, 1>>
+    {
+        using component_type = T;
+        constexpr static GLint  size = LEN;
+        constexpr static GLenum type = GLComponentTypeMap<T>::type;
+    };
+    template<class T, size_t LEN> struct GLAttributeFormatMap<std::array<T, LEN>>
+    {
+        using component_type = T;
+        constexpr static GLint  size = static_cast<GLint>(LEN);
+        constexpr static GLenum type = GLComponentTypeMap<T>::type;
+    };
+    template<> struct GLAttributeFormatMap<PackedSnorm10x3_2>
+    {
+        using component_type = float;   // only float conversions are valid for packed formats
+        constexpr static GLint  size = 4;
+        constexpr static GLenum type = GL_INT_2_10_10_10_REV;
+    };
+    template<> struct GLAttributeFormatMap<PackedUnorm10x3_2>
+    {
+        using component_type = float;
+        constexpr static GLint  size = 4;
+        constexpr static GLenum type = GL_UNSIGNED_INT_2_10_10_10_REV;
+    };
+
+    enum class VertexAttributeMode
+    {
+        FLOAT,          // integers are converted as is
+        NORMALIZED,     // integers are mapped to [0, 1] / [-1, 1]
+        INTEGER         // stays integer in the shader (ivec/uvec), glVertexAttribIPointer
+    };
+
+    /**
+     * @brief one attribute of an interleaved vertex
+     *
+     * @tparam LOCATION shader `layout (location = ...)`
+     * @tparam T        attribute type (scalar, Eigen vector, std::array, packed type)
+     * @tparam OFFSET   byte offset in the vertex, see LUX_VERTEX_ATTRIBUTE for struct members
+     */
+    template<GLuint LOCATION, class T, size_t OFFSET, VertexAttributeMode MODE = VertexAttributeMode::FLOAT>
+    struct VertexAttribute
+    {
+        using format = GLAttributeFormatMap<T>;
+        constexpr static GLuint              location = LOCATION;
+        constexpr static size_t              offset   = OFFSET;
+        constexpr static size_t              bytes    = sizeof(T);
+        constexpr static VertexAttributeMode mode     = MODE;
+
+        static_assert(MODE != VertexAttributeMode::INTEGER || GLComponentTypeMap<typename format::component_type>::integer,
+            "integer attributes need an integer component type");
+
+        static void apply(GLsizei stride, size_t base_offset)
+        {
+            const void* pointer = reinterpret_cast<const void*>(base_offset + OFFSET);
+            if constexpr(MODE == VertexAttributeMode::INTEGER)
+            {
+                glVertexAttribIPointer(LOCATION, format::size, format::type, stride, pointer);
+            }
+            else
+            {
+                glVertexAttribPointer(LOCATION, format::size, format::type,
+                    MODE == VertexAttributeMode::NORMALIZED ? GL_TRUE : GL_FALSE, stride, pointer);
+            }
+            glEnableVertexAttribArray(LOCATION);
+        }
+    };
+
+    #define LUX_VERTEX_ATTRIBUTE(LOCATION, VERTEX, MEMBER)\
+        ::lux::engine::function::VertexAttribute<LOCATION, decltype(VERTEX::MEMBER), offsetof(VERTEX, MEMBER)>
+    #define LUX_VERTEX_ATTRIBUTE_NORMALIZED(LOCATION, VERTEX, MEMBER)\
+        ::lux::engine::function::VertexAttribute<LOCATION, decltype(VERTEX::MEMBER), offsetof(VERTEX, MEMBER),\
+            ::lux::engine::function::VertexAttributeMode::NORMALIZED>
+
+    /**
+     * @brief compile time description of an interleaved vertex buffer,
+     *        apply() issues the glVertexAttribPointer calls for the bound GL_ARRAY_BUFFER
+     *
+     * @tparam VERTEX       the vertex type, its size is the stride
+     * @tparam ATTRIBUTES   VertexAttribute list
+     */
+    template<class VERTEX, class... ATTRIBUTES>
+    struct VertexLayout
+    {
+        using vertex_type = VERTEX;
+        constexpr static GLsizei stride = sizeof(VERTEX);
+
+        static_assert(((ATTRIBUTES::offset + ATTRIBUTES::bytes <= sizeof(VERTEX)) && ...),
+            "attribute exceeds the vertex");
+
+        static void apply(size_t base_offset = 0)
+        {
+            (ATTRIBUTES::apply(stride, base_offset), ...);
+        }
+
+        // distinct per layout type, used as the VertexArrayCache key
+        static const void* id()
+        {
+            static const char tag = 0;
+            return &tag;
+        }
+    };
+
+    /**
+     * @brief VAOs keyed by (layout, vertex buffer, index buffer, base offset), created on first use
+     *        and reused afterwards. bind() skips glBindVertexArray if the VAO is already bound,
+     *        call unbind() after binding VAOs behind the cache's back
+     */
+    class VertexArrayCache
+    {
+    public:
+        VertexArrayCache() = default;
+
+        VertexArrayCache(const VertexArrayCache&) = delete;
+
+        VertexArrayCache& operator=(const VertexArrayCache&) = delete;
+
+        ~VertexArrayCache()
+        {
+            clear();
+        }
+
+        template<class LAYOUT>
+        GLuint get(GLuint vertex_buffer, GLuint index_buffer = 0, size_t base_offset = 0)
+        {
+            const Key key{LAYOUT::id(), vertex_buffer, index_buffer, base_offset};
+            auto iter = _arrays.find(key);
+            if(iter != _arrays.end()) return iter->second;
+
+            GLuint vao;
+            glGenVertexArrays(1, &vao);
+            glBindVertexArray(vao);
+            glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
+            LAYOUT::apply(base_offset);
+            // the element buffer binding is VAO state, the array buffer binding is not
+            if(index_buffer) glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer);
+            _bound = vao;
+            _arrays.emplace(key, vao);
+            return vao;
+        }
+
+        template<class LAYOUT>
+        void bind(GLuint vertex_buffer, GLuint index_buffer = 0, size_t base_offset = 0)
+        {
+            const GLuint vao = get<LAYOUT>(vertex_buffer, index_buffer, base_offset);
+            if(vao != _bound)
+            {
+                glBindVertexArray(vao);
+                _bound = vao;
+            }
+        }
+
+        void unbind()
+        {
+            glBindVertexArray(0);
+            _bound = 0;
+        }
+
+        // drop every VAO referencing `buffer`, call before deleting the buffer
+        void invalidateBuffer(GLuint buffer)
+        {
+            for(auto iter = _arrays.begin(); iter != _arrays.end();)
+            {
+                if(iter->first.vertex_buffer == buffer || iter->first.index_buffer == buffer)
+                {
+                    release(iter->second);
+                    iter = _arrays.erase(iter);
+                }
+                else
+                {
+                    ++iter;
+                }
+            }
+        }
+
+        void clear()
+        {
+            for(auto& [key, vao] : _arrays) release(vao);
+            _arrays.clear();
+        }
+
+        size_t size() const { return _arrays.size(); }
+
+    private:
+        struct Key
+        {
+            const void* layout;
+            GLuint      vertex_buffer;
+            GLuint      index_buffer;
+            size_t      base_offset;
+
+            bool operator==(const Key& other) const
+            {
+                return layout == other.layout && vertex_buffer == other.vertex_buffer
+                    && index_buffer == other.index_buffer && base_offset == other.base_offset;
+            }
+        };
+
+        struct KeyHash
+        {
+            size_t operator()(const Key& key) const
+            {
+                size_t hash = std::hash<const void*>()(key.layout);
+                hash ^= (static_cast<size_t>(key.vertex_buffer) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2));
+                hash ^= (static_cast<size_t>(key.index_buffer)  + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2));
+                hash ^= (key.base_offset + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2));
+                return hash;
+            }
+        };
+
+        void release(GLuint vao)
+        {
+            if(vao == _bound) _bound = 0;
+            glDeleteVertexArrays(1, &vao);
+        }
+
+        std::unordered_map<Key, GLuint, KeyHash> _arrays;
+        GLuint _bound{0};
+    };
+}
@@ -0,0 +1,158 @@
+#pragma once
+#include "TextureUpload.hpp"
+#include <lux-engine/resource/texture/VirtualTexture.hpp>
+
+namespace lux::engine::function
+{
+    /**
+     * @brief allocate the physical tile cache of a virtual texture on the texture bound at GL_TEXTURE_2D,
+     *        one level of slots * tile stride texels per side
+     */
+    inline void allocateVirtualTileCache(const resource::VirtualTexture& texture)
+    {
+        const resource::VirtualTextureFile& file = texture.file();
+        const GLTextureFormat format = glTextureFormat(file.format(), (file.flags() & resource::TEXTURE_FILE_SRGB) != 0);
+        const uint32_t width  = texture.cache().slotsX() * file.tileStride();
+        const uint32_t height = texture.cache().slotsY() * file.tileStride();
+        if(format.compressed)
+        {
+            glCompressedTexImage2D(GL_TEXTURE_2D, 0, format.internal_format, static_cast<GLsizei>(width), static_cast<GLsizei>(height), 0,
+                static_cast<GLsizei>(resource::textureLevelSize(file.format(), width, height)), nullptr);
+        }
+        else
+        {
+            glTexImage2D(GL_TEXTURE_2D, 0, static_cast<GLint>(format.internal_format), static_cast<GLsizei>(width),
+                static_cast<GLsizei>(height), 0, format.format, format.type, nullptr);
+        }
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    }
+
+    // copy finished tiles into their slots of the physical cache bound at GL_TEXTURE_2D
+    inline void uploadVirtualTiles(const resource::VirtualTexture& texture, const std::vector<resource::VirtualTileUpload>& uploads)
+    {
+        const resource::VirtualTextureFile& file = texture.file();
+        const GLTextureFormat format = glTextureFormat(file.format(), (file.flags() & resource::TEXTURE_FILE_SRGB) != 0);
+        const GLsizei stride = static_cast<GLsizei>(file.tileStride());
+        for(const auto& upload : uploads)
+        {
+            const GLint x = static_cast<GLint>(upload.slot_x) * stride;
+            const GLint y = static_cast<GLint>(upload.slot_y) * stride;
+            if(format.compressed)
+            {
+                glCompressedTexSubImage2D(GL_TEXTURE_2D, 0, x, y, stride, stride, format.internal_format,
+                    static_cast<GLsizei>(upload.data.size()), upload.data.data());
+            }
+            else
+            {
+                glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, stride, stride, format.format, format.type, upload.data.data());
+            }
+        }
+    }
+
+    /**
+     * @brief bring the indirection texture bound at GL_TEXTURE_2D up to date, allocating it with `allocate`.
+     *        GL_RGBA8 with one level per virtual level, sampled with GL_NEAREST_MIPMAP_NEAREST.
+     *        level 0 is padded to powers of two: the tile counts of odd sized levels round up and would not
+     *        form a complete GL mip chain, the padding is never fetched
+     */
+    inline void uploadVirtualPageTable(resource::VirtualPageTable& table, bool allocate)
+    {
+        if(table.levelCount() == 0) return;
+        GLsizei padded_width = 1, padded_height = 1;
+        while(padded_width < static_cast<GLsizei>(table.width(0)))   padded_width  <<= 1;
+        while(padded_height < static_cast<GLsizei>(table.height(0))) padded_height <<= 1;
+
+        GLint unpack_alignment;
+        glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpack_alignment);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        std::vector<uint32_t> zeros;
+        for(uint32_t level = 0; level < table.levelCount(); level++)
+        {
+            const GLsizei width = static_cast<GLsizei>(table.width(level));
+            auto dirty = table.dirty(level);
+            if(allocate)
+            {
+                const GLsizei level_width  = std::max<GLsizei>(padded_width >> level, 1);
+                const GLsizei level_height = std::max<GLsizei>(padded_height >> level, 1);
+                zeros.assign(size_t(level_width) * level_height, 0);
+                glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), GL_RGBA8, level_width, level_height, 0, GL_RGBA,
+                    GL_UNSIGNED_BYTE, zeros.data());
+                dirty = resource::VirtualPageTable::DirtyRect{0, 0, table.width(level), table.height(level)};
+            }
+            if(dirty.x0 >= dirty.x1 || dirty.y0 >= dirty.y1) continue;
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, width);
+            glTexSubImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), static_cast<GLint>(dirty.x0), static_cast<GLint>(dirty.y0),
+                static_cast<GLsizei>(dirty.x1 - dirty.x0), static_cast<GLsizei>(dirty.y1 - dirty.y0), GL_RGBA, GL_UNSIGNED_BYTE,
+                table.entries(level) + size_t(dirty.y0) * width + dirty.x0);
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, unpack_alignment);
+        if(allocate)
+        {
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(table.levelCount()) - 1);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        }
+        table.clearDirty();
+    }
+
+    /**
+     * glsl side of the indirection, paste into a shader next to the two samplers:
+     *  - vt_sample() maps a virtual uv to the physical cache and samples it
+     *  - vt_feedback() is the packed tile for the feedback pass (packVirtualTile layout, as rgba8 unorm)
+     */
+    constexpr const char* kVirtualTextureGlsl = R"(
+uniform sampler2D vt_page_table;
+uniform sampler2D vt_cache;
+uniform vec4 vt_info;   // virtual width, virtual height, tile size, border
+uniform vec2 vt_cache_slots;
+uniform float vt_level_count;
+
+float vt_level(vec2 uv)
+{
+    vec2 texel = uv * vt_info.xy;
+    vec2 dx = dFdx(texel), dy = dFdy(texel);
+    return clamp(0.5 * log2(max(dot(dx, dx), dot(dy, dy))), 0.0, vt_level_count - 1.0);
+}
+
+vec2 vt_level_texels(float level)
+{
+    return max(floor(vt_info.xy / exp2(level)), vec2(1.0));
+}
+
+// tiles of a level, the last one of an odd sized level is partial
+vec2 vt_tile_count(float level)
+{
+    return ceil(vt_level_texels(level) / vt_info.z);
+}
+
+// the tile the file stores uv in, same as VirtualTextureFile::tile() addresses it
+vec2 vt_tile(vec2 uv, float level)
+{
+    return clamp(floor(uv * vt_level_texels(level) / vt_info.z), vec2(0.0), vt_tile_count(level) - 1.0);
+}
+
+vec4 vt_sample(vec2 uv)
+{
+    float level = floor(vt_level(uv));
+    vec2 tile = vt_tile(uv, level);
+    vec4 entry = texelFetch(vt_page_table, ivec2(tile), int(level)) * 255.0;
+    float data_level = entry.b;
+    // a coarser fallback is the ancestor the page table found by halving the tile coordinates
+    vec2 data_tile = min(floor(tile / exp2(data_level - level)), vt_tile_count(data_level) - 1.0);
+    vec2 in_tile = clamp(uv * vt_level_texels(data_level) / vt_info.z - data_tile, 0.0, 1.0);
+    float stride = vt_info.z + 2.0 * vt_info.w;
+    vec2 physical = (entry.rg * stride + vt_info.w + in_tile * vt_info.z) / (vt_cache_slots * stride);
+    return textureLod(vt_cache, physical, 0.0);
+}
+
+vec4 vt_feedback(vec2 uv)
+{
+    float level = floor(vt_level(uv));
+    uvec2 tile = uvec2(vt_tile(uv, level));
+    uint packed_tile = (uint(level) << 24) | ((tile.y & 0xFFFu) << 12) | (tile.x & 0xFFFu);
+    return unpackUnorm4x8(packed_tile);
+}
+)";
+}
@@ -0,0 +1,182 @@
+#include "lux-engine/function/render/LodSelection.hpp"
+#include <lux-engine/platform/cxx/Simd.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace lux::engine::function
+{
+    namespace
+    {
+        // allowed relative error = max(distance - radius, 0) * scale / extent
+        template<bool DENSE>
+        void computeAllowedErrors(
+            const float* cx, const float* cy, const float* cz, const float* radius, const float* inverse_extent,
+            const uint32_t* objects, size_t count, const Eigen::Vector3f& eye, float scale, float* allowed)
+        {
+            auto object = [&](size_t i) -> size_t { return DENSE ? i : objects[i]; };
+            size_t i = 0;
+#if defined(LUX_SIMD_SSE2)
+            const __m128 ex = _mm_set1_ps(eye.x());
+            const __m128 ey = _mm_set1_ps(eye.y());
+            const __m128 ez = _mm_set1_ps(eye.z());
+            const __m128 vscale = _mm_set1_ps(scale);
+            const __m128 zero = _mm_setzero_ps();
+            auto load = [&](const float* array, size_t base)
+            {
+                if constexpr(DENSE)
+                {
+                    return _mm_loadu_ps(array + base);
+                }
+                else
+                {
+                    return _mm_setr_ps(array[objects[base]], array[objects[base + 1]],
+                                       array[objects[base + 2]], array[objects[base + 3]]);
+                }
+            };
+            for(; i + 4 <= count; i += 4)
+            {
+                const __m128 dx = _mm_sub_ps(load(cx, i), ex);
+                const __m128 dy = _mm_sub_ps(load(cy, i), ey);
+                const __m128 dz = _mm_sub_ps(load(cz, i), ez);
+                const __m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+                const __m128 nearest  = _mm_max_ps(_mm_sub_ps(distance, load(radius, i)), zero);
+                _mm_storeu_ps(allowed + i, _mm_mul_ps(_mm_mul_ps(nearest, vscale), load(inverse_extent, i)));
+            }
+#endif
+            for(; i < count; i++)
+            {
+                const size_t o = object(i);
+                const float dx = cx[o] - eye.x();
+                const float dy = cy[o] - eye.y();
+                const float dz = cz[o] - eye.z();
+                const float nearest = std::max(std::sqrt(dx * dx + dy * dy + dz * dz) - radius[o], 0.0f);
+                allowed[i] = nearest * scale * inverse_extent[o];
+            }
+        }
+    }
+
+    LodView makeLodView(Camera& camera, uint32_t viewport_height)
+    {
+        return LodView{camera.cameraPosition(), camera.fov(), viewport_height};
+    }
+
+    LodSelector::LodSelector(const LodSelectionSettings& settings)
+        : _settings(settings){}
+
+    uint32_t LodSelector::addObject(const resource::MeshLod* lods, size_t lod_count, const Eigen::AlignedBox3f& local_bounds)
+    {
+        const uint32_t id = static_cast<uint32_t>(_lod_counts.size());
+        const size_t   count = std::clamp<size_t>(lod_count, 1, 255);
+
+        _error_offsets.push_back(static_cast<uint32_t>(_errors.size()));
+        _lod_counts.push_back(static_cast<uint8_t>(count));
+        _selected.push_back(0);
+        for(size_t l = 0; l < count; l++)
+        {
+            // lod_count == 0 means a single full detail level
+            _errors.push_back(l < lod_count ? lods[l].error : 0.0f);
+        }
+
+        const bool empty = local_bounds.isEmpty();
+        _local_center.push_back(empty ? Eigen::Vector3f(Eigen::Vector3f::Zero()) : Eigen::Vector3f(local_bounds.center()));
+        _local_radius.push_back(empty ? 0.0f : local_bounds.diagonal().norm() * 0.5f);
+        // same extent the simplifier measures its errors against
+        _local_extent.push_back(empty ? 1.0f : std::max(local_bounds.sizes().maxCoeff(), 1e-12f));
+
+        _center_x.push_back(0);
+        _center_y.push_back(0);
+        _center_z.push_back(0);
+        _radius.push_back(0);
+        _inverse_extent.push_back(0);
+        setTransform(id, Eigen::Affine3f::Identity());
+        return id;
+    }
+
+    uint32_t LodSelector::addObject(const resource::Mesh& mesh)
+    {
+        Eigen::AlignedBox3f bounds;
+        for(auto& vertex : mesh.vertices) bounds.extend(vertex.position);
+        return addObject(mesh.lods.data(), mesh.lods.size(), bounds);
+    }
+
+    void LodSelector::setTransform(uint32_t object, const Eigen::Affine3f& model)
+    {
+        const float max_scale = model.linear().colwise().norm().maxCoeff();
+        const Eigen::Vector3f center = model * _local_center[object];
+        _center_x[object]       = center.x();
+        _center_y[object]       = center.y();
+        _center_z[object]       = center.z();
+        _radius[object]         = _local_radius[object] * max_scale;
+        _inverse_extent[object] = 1.0f / std::max(_local_extent[object] * max_scale, 1e-12f);
+    }
+
+    void LodSelector::clear()
+    {
+        for(auto* array : {&_center_x, &_center_y, &_center_z, &_radius, &_inverse_extent, &_local_extent, &_local_radius, &_errors})
+        {
+            array->clear();
+        }
+        _local_center.clear();
+        _error_offsets.clear();
+        _lod_counts.clear();
+        _selected.clear();
+    }
+
+    void LodSelector::select(const LodView& view, const uint32_t* visible, size_t visible_count)
+    {
+        const size_t count = visible ? visible_count : _lod_counts.size();
+        _allowed.resize(count);
+
+        // a world space error e at distance d covers e * height / (2 d tan(fov / 2)) pixels
+        const float tan_half_fov = std::tan(view.fov * static_cast<float>(EIGEN_PI) / 360.0f);
+        const float scale = _settings.pixel_error * _quality_bias * 2.0f * tan_half_fov / std::max<float>(view.viewport_height, 1);
+
+        if(visible)
+        {
+            computeAllowedErrors<false>(_center_x.data(), _center_y.data(), _center_z.data(), _radius.data(),
+                _inverse_extent.data(), visible, count, view.camera_position, scale, _allowed.data());
+        }
+        else
+        {
+            computeAllowedErrors<true>(_center_x.data(), _center_y.data(), _center_z.data(), _radius.data(),
+                _inverse_extent.data(), nullptr, count, view.camera_position, scale, _allowed.data());
+        }
+
+        const float coarsen_factor = 1.0f - _settings.hysteresis;
+        for(size_t i = 0; i < count; i++)
+        {
+            const uint32_t object  = visible ? visible[i] : static_cast<uint32_t>(i);
+            const float*   errors  = _errors.data() + _error_offsets[object];
+            const uint32_t levels  = _lod_counts[object];
+            const uint32_t current = std::min<uint32_t>(_selected[object], levels - 1);
+            const float    allowed = _allowed[i];
+
+            // errors grow with the level, find the coarsest level under a threshold
+            auto coarsest = [&](float threshold)
+            {
+                uint32_t level = 0;
+                while(level + 1 < levels && errors[level + 1] <= threshold) level++;
+                return level;
+            };
+
+            if(errors[current] > allowed)
+            {
+                // too coarse, refine right away
+                _selected[object] = static_cast<uint8_t>(coarsest(allowed));
+            }
+            else
+            {
+                // coarsen only with margin
+                _selected[object] = static_cast<uint8_t>(std::max(current, coarsest(allowed * coarsen_factor)));
+            }
+        }
+    }
+
+    void LodSelector::adaptQualityBias(float frame_ms, float target_ms)
+    {
+        if(frame_ms <= 0 || target_ms <= 0) return;
+        // proportional step, clamped so a single spike can't drop quality abruptly
+        const float step = std::clamp(frame_ms / target_ms, 0.95f, 1.05f);
+        _quality_bias = std::clamp(_quality_bias * step, _settings.min_quality_bias, _settings.max_quality_bias);
+    }
+} // namespace lux::engine::function
@@ -0,0 +1,61 @@
+#include "lux-engine/function/render/MeshletCulling.hpp"
+
+namespace lux::engine::function
+{
+    MeshletCullingStats cullMeshlets(
+        const resource::Mesh& mesh, size_t lod, const Eigen::Affine3f& model,
+        const MeshletCullingContext& context, std::vector<DrawRange>& ranges)
+    {
+        MeshletCullingStats stats;
+        if(lod >= mesh.lods.size()) return stats;
+
+        const resource::MeshLod& range = mesh.lods[lod];
+        const Eigen::Matrix3f linear = model.linear();
+        const float scale = std::max({linear.col(0).norm(), linear.col(1).norm(), linear.col(2).norm()});
+        // back facing is preserved by affine maps, so the cone test runs in object space
+        const Eigen::Vector3f local_camera = model.inverse() * context.camera_position;
+        const bool mirrored = linear.determinant() < 0;
+
+        for(uint32_t i = range.meshlet_offset; i < range.meshlet_offset + range.meshlet_count; i++)
+        {
+            const resource::Meshlet& meshlet = mesh.meshlets[i];
+            const Eigen::Vector3f center = model * meshlet.center;
+            const float radius = meshlet.radius * scale;
+
+            if(!core::sphereInFrustum(context.frustum, center, radius))
+            {
+                stats.frustum_culled++;
+                continue;
+            }
+
+            if(!mirrored && meshlet.cone_cutoff < 1.0f)
+            {
+                const Eigen::Vector3f view = (meshlet.cone_apex - local_camera).normalized();
+                if(view.dot(meshlet.cone_axis) >= meshlet.cone_cutoff)
+                {
+                    stats.backface_culled++;
+                    continue;
+                }
+            }
+
+            if(context.occluded && context.occluded(center, radius))
+            {
+                stats.occlusion_culled++;
+                continue;
+            }
+
+            stats.visible++;
+            const uint32_t count = meshlet.triangle_count * 3;
+            if(!ranges.empty() && ranges.back().index_offset + ranges.back().index_count == meshlet.index_offset)
+            {
+                ranges.back().index_count += count;
+            }
+            else
+            {
+                ranges.push_back({meshlet.index_offset, count});
+            }
+        }
+
+        return stats;
+    }
+} // namespace lux::engine::function
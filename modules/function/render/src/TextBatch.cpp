@@ -0,0 +1,81 @@
+#include "lux-engine/function/render/TextBatch.hpp"
+#include <algorithm>
+
+namespace lux::engine::function
+{
+    void TextBatch::clear()
+    {
+        // keeps the capacity, the same text is usually added again next frame
+        for(auto& page : _pages) page.clear();
+        _pending = 0;
+    }
+
+    float TextBatch::addText(
+        resource::FontAtlas& atlas, uint32_t font, std::string_view text,
+        const Eigen::Vector3f& origin, const Eigen::Vector3f& right, const Eigen::Vector3f& up,
+        float size, const std::array<uint8_t, 4>& color)
+    {
+        if(font == resource::FontAtlas::kInvalidFont) return 0.0f;
+        const float line_height = atlas.metrics(font).line_height;
+
+        float pen = 0.0f, baseline = 0.0f, widest = 0.0f;
+        uint32_t previous = 0;
+        const char* it  = text.data();
+        const char* end = it + text.size();
+        while(it < end)
+        {
+            const uint32_t codepoint = resource::decodeUtf8(it, end);
+            if(codepoint == '\n')
+            {
+                widest    = std::max(widest, pen);
+                pen       = 0.0f;
+                baseline -= line_height;
+                previous  = 0;
+                continue;
+            }
+            if(previous != 0) pen += atlas.kerning(font, previous, codepoint);
+            previous = codepoint;
+
+            const resource::Glyph& glyph = atlas.glyph(font, codepoint);
+            if(glyph.state == resource::GlyphState::READY)
+            {
+                if(_pages.size() <= glyph.page) _pages.resize(glyph.page + 1);
+                auto corner = [&](float x, float y, float u, float v)
+                {
+                    const Eigen::Vector3f position = origin + right * ((pen + x) * size) + up * ((baseline + y) * size);
+                    return TextVertex{{position.x(), position.y(), position.z()}, {u, v}, color};
+                };
+                const TextVertex bottom_left  = corner(glyph.plane[0], glyph.plane[1], glyph.uv[0], glyph.uv[1]);
+                const TextVertex bottom_right = corner(glyph.plane[2], glyph.plane[1], glyph.uv[2], glyph.uv[1]);
+                const TextVertex top_right    = corner(glyph.plane[2], glyph.plane[3], glyph.uv[2], glyph.uv[3]);
+                const TextVertex top_left     = corner(glyph.plane[0], glyph.plane[3], glyph.uv[0], glyph.uv[3]);
+                _pages[glyph.page].insert(_pages[glyph.page].end(),
+                    {bottom_left, bottom_right, top_right, bottom_left, top_right, top_left});
+            }
+            else if(glyph.state != resource::GlyphState::EMPTY)
+            {
+                // the pen still advances, the text doesn't jump around when the glyph shows up
+                _pending++;
+            }
+            pen += glyph.advance;
+        }
+        return std::max(widest, pen) * size;
+    }
+
+    float TextBatch::addScreenText(
+        resource::FontAtlas& atlas, uint32_t font, std::string_view text,
+        const Eigen::Vector2f& position, float size, const std::array<uint8_t, 4>& color)
+    {
+        if(font == resource::FontAtlas::kInvalidFont) return 0.0f;
+        const float ascender = atlas.metrics(font).ascender;
+        const Eigen::Vector3f origin(position.x(), position.y() + ascender * size, 0.0f);
+        return addText(atlas, font, text, origin, Eigen::Vector3f::UnitX(), -Eigen::Vector3f::UnitY(), size, color);
+    }
+
+    size_t TextBatch::vertexCount() const
+    {
+        size_t count = 0;
+        for(auto& page : _pages) count += page.size();
+        return count;
+    }
+} // namespace lux::engine::function
@@ -0,0 +1,312 @@
+#include "lux-engine/function/render/TextureStreaming.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace lux::engine::function
+{
+    TextureStreamer::TextureStreamer(const TextureStreamingSettings& settings)
+        : _settings(settings), _io(settings.io_queue ? settings.io_queue : &platform::IoQueue::global())
+    {
+    }
+
+    TextureStreamer::~TextureStreamer()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _queue = {};
+        }
+        // the tasks of the dropped loads find the queue empty and return
+        _tasks.wait();
+    }
+
+    size_t TextureStreamer::levelBytes(const Texture& texture, uint32_t level) const
+    {
+        return texture.file->level(level).size;
+    }
+
+    size_t TextureStreamer::rangeBytes(const Texture& texture, uint32_t first) const
+    {
+        size_t bytes = 0;
+        for(uint32_t level = first; level < texture.level_count; level++) bytes += levelBytes(texture, level);
+        return bytes;
+    }
+
+    uint32_t TextureStreamer::addTexture(const std::string& path)
+    {
+        auto file = std::make_shared<resource::TextureFile>(path);
+        if(!file->isEnable()) return UINT32_MAX;
+
+        uint32_t id;
+        if(!_free_ids.empty())
+        {
+            id = _free_ids.back();
+            _free_ids.pop_back();
+        }
+        else
+        {
+            id = static_cast<uint32_t>(_textures.size());
+            _textures.emplace_back();
+        }
+
+        Texture& texture    = _textures[id];
+        texture.file        = file;
+        texture.level_count = static_cast<uint32_t>(file->levelCount());
+        texture.tail        = texture.level_count - 1;
+        while(texture.tail > 0)
+        {
+            const resource::TextureLevelView view = file->level(texture.tail - 1);
+            if(view.width > _settings.tail_size || view.height > _settings.tail_size) break;
+            texture.tail--;
+        }
+        texture.resident  = texture.level_count;
+        texture.wanted    = texture.tail;
+        texture.loading   = UINT32_MAX;
+        texture.pixels    = 0.0f;
+        texture.last_used = _frame;
+
+        // the tail sits right behind the header in the file, reading it here costs next to nothing
+        for(uint32_t level = texture.level_count; level-- > texture.tail;)
+        {
+            const resource::TextureLevelView view = file->level(level);
+            _tail_uploads.push_back(TextureLevelUpload{id, level, view.width, view.height,
+                std::vector<uint8_t>(view.data, view.data + view.size)});
+        }
+        return id;
+    }
+
+    void TextureStreamer::removeTexture(uint32_t texture)
+    {
+        if(!isValid(texture)) return;
+        Texture& entry = _textures[texture];
+        if(entry.resident < entry.level_count) _resident_bytes -= rangeBytes(entry, entry.resident);
+        _tail_uploads.erase(std::remove_if(_tail_uploads.begin(), _tail_uploads.end(),
+            [&](const TextureLevelUpload& upload){ return upload.texture == texture; }), _tail_uploads.end());
+
+        const uint32_t generation = entry.generation + 1;
+        entry = Texture{};
+        entry.generation = generation;
+        _free_ids.push_back(texture);
+    }
+
+    void TextureStreamer::beginFrame(const LodView& view)
+    {
+        _frame++;
+        _view = view;
+        // an object of radius r at distance d covers r * height / (d tan(fov / 2)) pixels across
+        const float tan_half_fov = std::tan(view.fov * static_cast<float>(EIGEN_PI) / 360.0f);
+        _pixel_scale = static_cast<float>(view.viewport_height) / std::max(tan_half_fov, 1e-6f);
+        for(auto& texture : _textures) texture.pixels = 0.0f;
+    }
+
+    void TextureStreamer::addUsage(uint32_t texture, const Eigen::AlignedBox3f& world_bounds, float uv_scale)
+    {
+        if(!isValid(texture) || world_bounds.isEmpty()) return;
+        Texture& entry = _textures[texture];
+
+        const float radius   = world_bounds.diagonal().norm() * 0.5f;
+        const float distance = (world_bounds.center() - _view.camera_position).norm() - radius;
+        // inside the bounds everything is as close as it gets
+        const float pixels   = distance > 1e-4f
+            ? radius * _pixel_scale / distance
+            : std::numeric_limits<float>::max();
+        entry.pixels    = std::max(entry.pixels, pixels / std::max(uv_scale, 1e-6f));
+        entry.last_used = _frame;
+    }
+
+    void TextureStreamer::fitBudget()
+    {
+        struct Candidate
+        {
+            float       importance;     // screen pixels per texel of the finest wanted level
+            uint64_t    last_used;
+            uint32_t    texture;
+
+            // std::priority_queue pops the largest, make that the least important
+            bool operator<(const Candidate& other) const
+            {
+                if(importance != other.importance) return importance > other.importance;
+                return last_used > other.last_used;
+            }
+        };
+
+        auto importance = [&](const Texture& texture)
+        {
+            const resource::TextureLevelView view = texture.file->level(texture.wanted);
+            return texture.pixels / static_cast<float>(std::max(view.width, view.height));
+        };
+
+        size_t total = 0;
+        std::priority_queue<Candidate> candidates;
+        for(uint32_t id = 0; id < _textures.size(); id++)
+        {
+            Texture& texture = _textures[id];
+            if(!texture.file) continue;
+
+            if(texture.last_used == _frame)
+            {
+                // finest level that still has at least a texel per pixel
+                const float extent = static_cast<float>(std::max(texture.file->width(), texture.file->height()));
+                const float level  = std::floor(std::log2(extent / std::max(texture.pixels, 1e-6f)) + _settings.lod_bias);
+                texture.wanted = static_cast<uint32_t>(std::clamp(level, 0.0f, static_cast<float>(texture.tail)));
+            }
+            else
+            {
+                // unused this frame, keeps what it has until the budget needs the room
+                texture.wanted = std::min(texture.resident, texture.tail);
+            }
+            total += rangeBytes(texture, texture.wanted);
+            if(texture.wanted < texture.tail) candidates.push(Candidate{importance(texture), texture.last_used, id});
+        }
+
+        while(total > _settings.budget_bytes && !candidates.empty())
+        {
+            const Candidate candidate = candidates.top();
+            candidates.pop();
+            Texture& texture = _textures[candidate.texture];
+            total -= levelBytes(texture, texture.wanted);
+            texture.wanted++;
+            if(texture.wanted < texture.tail) candidates.push(Candidate{importance(texture), texture.last_used, candidate.texture});
+        }
+        _wanted_bytes = total;
+    }
+
+    TextureStreamingUpdate TextureStreamer::update()
+    {
+        TextureStreamingUpdate result;
+        _uploaded_bytes = 0;
+        _evicted_levels = 0;
+        fitBudget();
+
+        // drop levels finer than wanted first, their room goes to the loads below
+        for(uint32_t id = 0; id < _textures.size(); id++)
+        {
+            Texture& texture = _textures[id];
+            if(!texture.file || texture.resident >= texture.wanted) continue;
+            for(uint32_t level = texture.resident; level < texture.wanted; level++)
+            {
+                _resident_bytes -= levelBytes(texture, level);
+                _evicted_levels++;
+            }
+            texture.resident = texture.wanted;
+            result.evicted.push_back(id);
+            result.changed.push_back(id);
+        }
+
+        for(auto& upload : _tail_uploads)
+        {
+            _textures[upload.texture].resident = upload.level;
+            result.changed.push_back(upload.texture);
+            _resident_bytes += upload.data.size();
+            _uploaded_bytes += upload.data.size();
+            result.uploads.push_back(std::move(upload));
+        }
+        _tail_uploads.clear();
+
+        std::vector<LoadResult> finished;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            size_t taken = 0;
+            for(; taken < _completed.size(); taken++)
+            {
+                // at least one level per update, however large
+                if(_uploaded_bytes > 0 && _uploaded_bytes + _completed[taken].upload.data.size() > _settings.max_upload_bytes) break;
+                _uploaded_bytes += _completed[taken].upload.data.size();
+                _staging_bytes  -= _completed[taken].upload.data.size();
+                finished.push_back(std::move(_completed[taken]));
+            }
+            _completed.erase(_completed.begin(), _completed.begin() + static_cast<std::ptrdiff_t>(taken));
+        }
+        for(auto& load : finished)
+        {
+            const size_t size = load.upload.data.size();
+            Texture& texture  = _textures[load.texture];
+            const bool current = texture.file && texture.generation == load.generation;
+            if(current) texture.loading = UINT32_MAX;
+            // still the next finer level and still wanted, anything else lost its purpose while loading
+            if(!current || load.upload.level + 1 != texture.resident || load.upload.level < texture.wanted)
+            {
+                _uploaded_bytes -= size;
+                continue;
+            }
+            texture.resident = load.upload.level;
+            _resident_bytes += size;
+            result.changed.push_back(load.texture);
+            result.uploads.push_back(std::move(load.upload));
+        }
+
+        // one level per texture at a time, most undersampled first
+        std::vector<LoadRequest> requests;
+        for(uint32_t id = 0; id < _textures.size(); id++)
+        {
+            Texture& texture = _textures[id];
+            if(!texture.file || texture.loading != UINT32_MAX || texture.resident > texture.tail
+                || texture.resident <= texture.wanted)
+            {
+                continue;
+            }
+            const uint32_t level = texture.resident - 1;
+            const resource::TextureLevelView view = texture.file->level(level);
+            const float priority = texture.pixels / static_cast<float>(std::max(view.width, view.height));
+            requests.push_back(LoadRequest{priority, id, texture.generation, level, texture.file});
+        }
+        std::sort(requests.begin(), requests.end(), [](const LoadRequest& a, const LoadRequest& b){ return b < a; });
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for(auto& request : requests)
+            {
+                const size_t size = levelBytes(_textures[request.texture], request.level);
+                if(_staging_bytes > 0 && _staging_bytes + size > _settings.max_staging_bytes) break;
+                _staging_bytes += size;
+                _pending++;
+                _textures[request.texture].loading = request.level;
+                _queue.push(std::move(request));
+                _io->submit([this]{ loadNext(); }, &_tasks);
+            }
+        }
+
+        std::sort(result.changed.begin(), result.changed.end());
+        result.changed.erase(std::unique(result.changed.begin(), result.changed.end()), result.changed.end());
+        return result;
+    }
+
+    TextureStreamingStats TextureStreamer::stats() const
+    {
+        TextureStreamingStats stats;
+        stats.resident_bytes = _resident_bytes;
+        stats.wanted_bytes   = _wanted_bytes;
+        stats.uploaded_bytes = _uploaded_bytes;
+        stats.evicted_levels = _evicted_levels;
+        std::lock_guard<std::mutex> lock(_mutex);
+        stats.staging_bytes  = _staging_bytes;
+        stats.pending_loads  = _pending;
+        return stats;
+    }
+
+    void TextureStreamer::setBudget(size_t budget_bytes)
+    {
+        _settings.budget_bytes = budget_bytes;
+    }
+
+    void TextureStreamer::loadNext()
+    {
+        LoadRequest request;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if(_queue.empty()) return;
+            request = _queue.top();
+            _queue.pop();
+        }
+
+        // touching the mapped pages is the actual disk read, keep it off the render thread
+        const resource::TextureLevelView view = request.file->level(request.level);
+        LoadResult result{request.texture, request.generation,
+            TextureLevelUpload{request.texture, request.level, view.width, view.height,
+                std::vector<uint8_t>(view.data, view.data + view.size)}};
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _completed.push_back(std::move(result));
+        _pending--;
+    }
+} // namespace lux::engine::function
@@ -0,0 +1,131 @@
+#pragma once
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+
+namespace lux::engine::platform
+{
+    /**
+     * @brief parse a decimal number from [first, last) without locale or null terminator.
+     *        up to 19 significant digits with |exponent| <= 22 are converted exactly with a single
+     *        multiplication (Clinger's fast path), anything else goes through std::from_chars (strtod where the
+     *        standard library lacks it) on a rewritten copy without a decimal point, so no locale can change the result
+     *
+     * @return const char* one past the parsed number, `first` if there is no number
+     */
+    inline const char* parseDouble(const char* first, const char* last, double& value) noexcept
+    {
+        static constexpr double kPowersOfTen[]{
+            1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        const char* p = first;
+        bool negative = false;
+        if(p != last && (*p == '-' || *p == '+'))
+        {
+            negative = *p == '-';
+            p++;
+        }
+
+        uint64_t mantissa   = 0;
+        int      digits     = 0;
+        int64_t  exponent   = 0;
+        bool     truncated  = false;
+        bool     has_digits = false;
+
+        for(; p != last && static_cast<unsigned char>(*p - '0') < 10; p++)
+        {
+            has_digits = true;
+            if(digits < 19)
+            {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                digits  += mantissa != 0;
+            }
+            else
+            {
+                truncated = truncated || *p != '0';
+                exponent++;
+            }
+        }
+
+        if(p != last && *p == '.')
+        {
+            p++;
+            for(; p != last && static_cast<unsigned char>(*p - '0') < 10; p++)
+            {
+                has_digits = true;
+                if(digits < 19)
+                {
+                    mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                    digits  += mantissa != 0;
+                    exponent--;
+                }
+                else
+                {
+                    truncated = truncated || *p != '0';
+                }
+            }
+        }
+
+        if(!has_digits) return first;
+
+        if(p != last && (*p == 'e' || *p == 'E'))
+        {
+            const char* e = p + 1;
+            bool exponent_negative = false;
+            if(e != last && (*e == '-' || *e == '+'))
+            {
+                exponent_negative = *e == '-';
+                e++;
+            }
+            if(e != last && static_cast<unsigned char>(*e - '0') < 10)
+            {
+                int64_t explicit_exponent = 0;
+                for(; e != last && static_cast<unsigned char>(*e - '0') < 10; e++)
+                {
+                    if(explicit_exponent < 100000) explicit_exponent = explicit_exponent * 10 + (*e - '0');
+                }
+                exponent += exponent_negative ? -explicit_exponent : explicit_exponent;
+                p = e;
+            }
+        }
+
+        if(!truncated && exponent >= -22 && exponent <= 22 && mantissa <= (uint64_t(1) << 53))
+        {
+            double result = static_cast<double>(mantissa);
+            result = exponent < 0 ? result / kPowersOfTen[-exponent] : result * kPowersOfTen[exponent];
+            value = negative ? -result : result;
+            return p;
+        }
+
+        // slow path: the significant digits as an integer, plus a sticky 1 standing in for the truncated ones
+        // so rounding still sees them, times a power of ten. short enough for the stack, no radix character
+        char buffer[64];
+        const int length = std::snprintf(buffer, sizeof(buffer), "%s%llu%se%lld", negative ? "-" : "",
+            static_cast<unsigned long long>(mantissa), truncated ? "1" : "", static_cast<long long>(exponent - truncated));
+#if defined(__cpp_lib_to_chars)
+        const std::from_chars_result result = std::from_chars(buffer, buffer + length, value);
+        if(result.ec == std::errc::result_out_of_range)
+        {
+            // from_chars leaves the value alone, strtod would give infinity or zero
+            const double magnitude = exponent > 0 ? std::numeric_limits<double>::infinity() : 0.0;
+            value = negative ? -magnitude : magnitude;
+        }
+#else
+        (void)length;
+        value = std::strtod(buffer, nullptr);
+#endif
+        return p;
+    }
+
+    inline const char* parseFloat(const char* first, const char* last, float& value) noexcept
+    {
+        double result;
+        const char* end = parseDouble(first, last, result);
+        if(end != first) value = static_cast<float>(result);
+        return end;
+    }
+} // namespace lux::engine::platform
@@ -0,0 +1,81 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace lux::engine::platform
+{
+    namespace detail
+    {
+        inline uint64_t hashRead64(const uint8_t* p) noexcept
+        {
+            uint64_t value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        // 64x64 -> 128 multiply folded back to 64 bits
+        inline uint64_t hashMix(uint64_t a, uint64_t b) noexcept
+        {
+#if defined(__SIZEOF_INT128__)
+            const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+            return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#else
+            const uint64_t a_lo = a & 0xffffffffull, a_hi = a >> 32;
+            const uint64_t b_lo = b & 0xffffffffull, b_hi = b >> 32;
+            const uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo;
+            const uint64_t lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+            const uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffffffffull) + lo_hi;
+            const uint64_t upper = hi_hi + (hi_lo >> 32) + (cross >> 32);
+            return ((cross << 32) | (lo_lo & 0xffffffffull)) ^ upper;
+#endif
+        }
+    }
+
+    /**
+     * @brief fast non cryptographic 64 bit hash of a byte range, for content keyed caches.
+     *        four independent lanes over 32 byte stripes, several GB/s on large buffers.
+     *        the value is stable across platforms and builds, it may be stored on disk
+     */
+    inline uint64_t hash64(const void* data, size_t size, uint64_t seed = 0) noexcept
+    {
+        constexpr uint64_t k0 = 0xa0761d6478bd642full;
+        constexpr uint64_t k1 = 0xe7037ed1a0b428dbull;
+        constexpr uint64_t k2 = 0x8ebc6af09c88c6e3ull;
+        constexpr uint64_t k3 = 0x589965cc75374cc3ull;
+
+        const uint8_t* p   = static_cast<const uint8_t*>(data);
+        uint64_t       h0  = seed ^ k0;
+        uint64_t       h1  = seed ^ k1;
+        uint64_t       h2  = seed ^ k2;
+        uint64_t       h3  = seed ^ k3;
+        size_t         remaining = size;
+
+        for(; remaining >= 32; remaining -= 32, p += 32)
+        {
+            h0 = detail::hashMix(detail::hashRead64(p)      ^ k1, h0 ^ k0);
+            h1 = detail::hashMix(detail::hashRead64(p + 8)  ^ k2, h1 ^ k1);
+            h2 = detail::hashMix(detail::hashRead64(p + 16) ^ k3, h2 ^ k2);
+            h3 = detail::hashMix(detail::hashRead64(p + 24) ^ k0, h3 ^ k3);
+        }
+        uint64_t h = detail::hashMix(h0 ^ h2, k1 ^ h1) ^ detail::hashMix(h3 ^ k2, h1 ^ k3);
+
+        for(; remaining >= 8; remaining -= 8, p += 8)
+        {
+            h = detail::hashMix(detail::hashRead64(p) ^ k1, h ^ k0);
+        }
+        if(remaining > 0)
+        {
+            uint8_t tail[8]{};
+            std::memcpy(tail, p, remaining);
+            h = detail::hashMix(detail::hashRead64(tail) ^ k2, h ^ k3);
+        }
+        return detail::hashMix(h ^ static_cast<uint64_t>(size), k1 ^ k3);
+    }
+
+    // order dependent combination of two hashes
+    inline uint64_t hashCombine(uint64_t seed, uint64_t value) noexcept
+    {
+        return detail::hashMix(seed ^ 0x589965cc75374cc3ull, value ^ 0xe7037ed1a0b428dbull);
+    }
+} // namespace lux::engine::platform
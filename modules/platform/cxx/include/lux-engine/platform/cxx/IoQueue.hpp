@@ -0,0 +1,89 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <lux-engine/platform/cxx/visibility_control.h>
+
+namespace lux::engine::platform
+{
+    class IoQueue;
+
+    /**
+     * @brief counts submitted tasks until they have returned. lives with the submitter, which waits on it
+     *        before it destroys whatever its tasks touch
+     */
+    class IoCounter
+    {
+    public:
+        IoCounter() = default;
+
+        IoCounter(const IoCounter&) = delete;
+
+        IoCounter& operator=(const IoCounter&) = delete;
+
+        LUX_EXPORT size_t pending() const;
+
+        // once it returns the counter is no longer touched by the queue and may be destroyed
+        LUX_EXPORT void wait() const;
+
+    private:
+        friend class IoQueue;
+
+        mutable std::mutex              _mutex;
+        mutable std::condition_variable _done;
+        size_t                          _pending{0};
+    };
+
+    /**
+     * @brief a few threads for work that blocks: file reads, decodes and encodes of images, glyph rasterization.
+     *        kept apart from the JobSystem, whose workers must never sleep in a page fault.
+     *        tasks start in submission order. loaders keep their own request queue and submit one task per
+     *        request, the task takes whatever request is most urgent by the time it starts
+     */
+    class IoQueue
+    {
+    public:
+        using Task = std::function<void()>;
+
+        // @param worker_count 0 picks half the hardware threads, between 2 and 4
+        LUX_EXPORT explicit IoQueue(size_t worker_count = 0);
+
+        // runs what is still queued, then joins the workers
+        LUX_EXPORT ~IoQueue();
+
+        IoQueue(const IoQueue&) = delete;
+
+        IoQueue& operator=(const IoQueue&) = delete;
+
+        // the process wide queue the loaders use unless they are handed another one, created on first use
+        LUX_EXPORT static IoQueue& global();
+
+        /**
+         * @brief run `task` on one of the workers
+         *
+         * @param counter incremented now, decremented once the task has returned. optional
+         */
+        LUX_EXPORT void submit(Task task, IoCounter* counter = nullptr);
+
+        size_t workerCount() const { return _workers.size(); }
+
+    private:
+        struct Entry
+        {
+            Task        task;
+            IoCounter*  counter;
+        };
+
+        void workerLoop();
+
+        std::vector<std::thread>    _workers;
+        std::mutex                  _mutex;
+        std::condition_variable     _wake;
+        std::deque<Entry>           _queue;
+        bool                        _stop{false};
+    };
+} // namespace lux::engine::platform
@@ -0,0 +1,244 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <lux-engine/platform/cxx/visibility_control.h>
+
+namespace lux::engine::platform
+{
+    class JobSystem;
+
+    /**
+     * @brief counts scheduled jobs until they have finished, the handle to wait on and to depend on.
+     *        lives with whoever schedules (usually on the stack) and must outlive its jobs.
+     *        can be reused once it has reached zero and nothing waits on it anymore
+     */
+    class JobCounter
+    {
+    public:
+        JobCounter() = default;
+
+        JobCounter(const JobCounter&) = delete;
+
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        bool done() const { return _pending.load(std::memory_order_acquire) == 0; }
+
+        uint32_t pending() const { return _pending.load(std::memory_order_acquire); }
+
+    private:
+        friend class JobSystem;
+
+        std::atomic<uint32_t>       _pending{0};
+        // guards the step to zero and the dependents, jobs scheduled to run once the counter reaches zero
+        mutable std::mutex          _mutex;
+        std::vector<void*>          _dependents;
+    };
+
+    /**
+     * @brief single owner work stealing deque (Chase & Lev, with the C11 orderings of Lê et al. 2013).
+     *        the owner pushes and pops at the bottom, any thread steals from the top. the ring grows on demand,
+     *        replaced rings are kept until destruction since a thief may still read them
+     */
+    template<class T>
+    class WorkStealingDeque
+    {
+    public:
+        explicit WorkStealingDeque(size_t capacity = 256)
+        {
+            size_t size = 1;
+            while(size < capacity) size <<= 1;
+            _rings.push_back(std::make_unique<Ring>(size));
+            _ring.store(_rings.back().get(), std::memory_order_relaxed);
+        }
+
+        WorkStealingDeque(const WorkStealingDeque&) = delete;
+
+        WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+        // owner only
+        void push(T* item)
+        {
+            const int64_t bottom = _bottom.load(std::memory_order_relaxed);
+            const int64_t top    = _top.load(std::memory_order_acquire);
+            Ring* ring = _ring.load(std::memory_order_relaxed);
+            if(bottom - top > static_cast<int64_t>(ring->mask))
+            {
+                ring = grow(ring, top, bottom);
+            }
+            ring->put(bottom, item);
+            std::atomic_thread_fence(std::memory_order_release);
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        // owner only, newest first
+        T* pop()
+        {
+            const int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+            Ring* ring = _ring.load(std::memory_order_relaxed);
+            _bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = _top.load(std::memory_order_relaxed);
+            if(top > bottom)
+            {
+                _bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            T* item = ring->get(bottom);
+            if(top == bottom)
+            {
+                // the last item, race the thieves for it
+                if(!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    item = nullptr;
+                }
+                _bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+            return item;
+        }
+
+        // any thread, oldest first. nullptr when empty or when another thread won the race
+        T* steal()
+        {
+            int64_t top = _top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const int64_t bottom = _bottom.load(std::memory_order_acquire);
+            if(top >= bottom) return nullptr;
+            T* item = _ring.load(std::memory_order_acquire)->get(top);
+            if(!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return nullptr;
+            }
+            return item;
+        }
+
+        // a snapshot, only exact when nobody else touches the deque
+        bool empty() const
+        {
+            return _bottom.load(std::memory_order_relaxed) <= _top.load(std::memory_order_relaxed);
+        }
+
+    private:
+        struct Ring
+        {
+            explicit Ring(size_t size)
+                : mask(size - 1), items(new std::atomic<T*>[size]){}
+
+            void put(int64_t index, T* item) { items[static_cast<size_t>(index) & mask].store(item, std::memory_order_relaxed); }
+
+            T* get(int64_t index) const { return items[static_cast<size_t>(index) & mask].load(std::memory_order_relaxed); }
+
+            size_t                              mask;
+            std::unique_ptr<std::atomic<T*>[]>  items;
+        };
+
+        Ring* grow(Ring* ring, int64_t top, int64_t bottom)
+        {
+            _rings.push_back(std::make_unique<Ring>((ring->mask + 1) * 2));
+            Ring* grown = _rings.back().get();
+            for(int64_t i = top; i < bottom; i++) grown->put(i, ring->get(i));
+            _ring.store(grown, std::memory_order_release);
+            return grown;
+        }
+
+        alignas(64) std::atomic<int64_t>    _top{0};
+        alignas(64) std::atomic<int64_t>    _bottom{0};
+        std::atomic<Ring*>                  _ring{nullptr};
+        std::vector<std::unique_ptr<Ring>>  _rings;     // owner only
+    };
+
+    /**
+     * @brief pool of workers, one per hardware thread besides the caller, each with its own work stealing deque.
+     *        jobs scheduled from a worker go to its deque (newest first, cache friendly), jobs from other threads
+     *        go through a shared queue. idle workers steal the oldest jobs of the others before going to sleep.
+     *        wait() runs jobs while the counter is not done, so waiting inside a job never deadlocks the pool
+     */
+    class JobSystem
+    {
+    public:
+        using Job = std::function<void()>;
+
+        /**
+         * @param worker_count 0 picks one less than the hardware threads (at least one),
+         *                     the thread calling wait() makes up for the missing one
+         */
+        LUX_EXPORT explicit JobSystem(size_t worker_count = 0);
+
+        // runs what is still queued, then joins the workers
+        LUX_EXPORT ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        // the process wide pool parallelFor() runs on, created on first use
+        LUX_EXPORT static JobSystem& global();
+
+        /**
+         * @brief run `job` on any thread
+         *
+         * @param counter incremented now, decremented once the job has finished. optional
+         */
+        LUX_EXPORT void schedule(Job job, JobCounter* counter = nullptr);
+
+        /**
+         * @brief run `job` once `dependency` has reached zero, `counter` counts it from now on.
+         *        chains of counters make a dependency graph without any thread blocking on it
+         */
+        LUX_EXPORT void scheduleAfter(JobCounter& dependency, Job job, JobCounter* counter = nullptr);
+
+        /**
+         * @brief execute other jobs until `counter` is done, yields only when there is nothing to run.
+         *        once it returns the counter is no longer touched by the pool and may be destroyed
+         */
+        LUX_EXPORT void wait(const JobCounter& counter);
+
+        // execute one queued job on the calling thread, false when there was none. for loops that wait on more than a counter
+        LUX_EXPORT bool runPending();
+
+        size_t workerCount() const { return _workers.size(); }
+
+        // index of the calling worker of this pool, or SIZE_MAX on any other thread
+        LUX_EXPORT size_t currentWorker() const;
+
+    private:
+        struct Task;
+
+        // finished tasks of the calling thread, reused instead of going through the allocator
+        static std::vector<std::unique_ptr<Task>>& taskCache();
+
+        Task* allocate(Job job, JobCounter* counter);
+
+        void push(Task* task);
+
+        Task* find(size_t self);
+
+        void execute(Task* task);
+
+        void release(JobCounter& counter);
+
+        void workerLoop(size_t index);
+
+        std::vector<std::unique_ptr<WorkStealingDeque<Task>>>   _deques;
+        std::vector<std::thread>                                _workers;
+
+        // jobs scheduled from threads without a deque
+        std::mutex                                              _shared_mutex;
+        std::deque<Task*>                                       _shared;
+        std::atomic<size_t>                                     _shared_size{0};
+
+        // sleeping workers, woken by any new job
+        std::mutex                                              _sleep_mutex;
+        std::condition_variable                                 _wake;
+        std::atomic<uint64_t>                                   _epoch{0};
+        std::atomic<uint32_t>                                   _sleeping{0};
+        std::atomic<bool>                                       _stop{false};
+    };
+} // namespace lux::engine::platform
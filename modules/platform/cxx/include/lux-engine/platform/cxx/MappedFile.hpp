@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <lux-engine/platform/cxx/visibility_control.h>
+
+namespace lux::engine::platform
+{
+    /// @brief read only view of a whole file mapped into memory
+    class MappedFile
+    {
+    public:
+        LUX_EXPORT MappedFile();
+
+        LUX_EXPORT explicit MappedFile(const std::string& path);
+
+        LUX_EXPORT MappedFile(MappedFile&&) noexcept;
+
+        LUX_EXPORT MappedFile& operator=(MappedFile&&) noexcept;
+
+        LUX_EXPORT ~MappedFile();
+
+        LUX_EXPORT bool open(const std::string& path);
+
+        LUX_EXPORT void close();
+
+        LUX_EXPORT bool isEnable() const;
+
+        LUX_EXPORT const uint8_t* data() const;
+
+        LUX_EXPORT size_t size() const;
+
+    private:
+        class Impl;
+        std::unique_ptr<Impl> _impl;
+    };
+} // namespace lux::engine::platform
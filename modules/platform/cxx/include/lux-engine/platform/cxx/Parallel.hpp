@@ -0,0 +1,55 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <lux-engine/platform/cxx/JobSystem.hpp>
+
+namespace lux::engine::platform
+{
+    inline size_t hardwareThreadCount() noexcept
+    {
+        const unsigned int count = std::thread::hardware_concurrency();
+        return count == 0 ? 1 : count;
+    }
+
+    /**
+     * @brief split [begin, end) into chunks of `grain` elements and run `func(chunk_begin, chunk_end)`
+     *        on the workers of JobSystem::global(), the calling thread takes part as well.
+     *        returns after all chunks are done, nesting inside jobs is fine since waiting runs other jobs
+     */
+    template<class Func> void
+    parallelFor(size_t begin, size_t end, size_t grain, Func&& func)
+    {
+        if(begin >= end) return;
+        grain = std::max<size_t>(grain, 1);
+
+        const size_t chunk_count = (end - begin + grain - 1) / grain;
+        if(chunk_count <= 1 || hardwareThreadCount() <= 1)
+        {
+            func(begin, end);
+            return;
+        }
+
+        std::atomic<size_t> next_chunk{0};
+        auto worker = [&]()
+        {
+            for(size_t chunk = next_chunk++; chunk < chunk_count; chunk = next_chunk++)
+            {
+                const size_t chunk_begin = begin + chunk * grain;
+                func(chunk_begin, std::min(chunk_begin + grain, end));
+            }
+        };
+
+        // helpers only pull chunks, so one per idle worker is enough however many chunks there are
+        JobSystem& jobs = JobSystem::global();
+        const size_t helper_count = std::min(jobs.workerCount(), chunk_count - 1);
+        JobCounter counter;
+        for(size_t i = 0; i < helper_count; i++)
+        {
+            jobs.schedule([&worker]{ worker(); }, &counter);
+        }
+        worker();
+        jobs.wait(counter);
+    }
+} // namespace lux::engine::platform
@@ -0,0 +1,23 @@
+#pragma once
+
+// instruction sets available at compile time, every kernel keeps a scalar fallback.
+// AVX2 is opt in through the LUX_ENGINE_ENABLE_AVX2 cmake option
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define LUX_SIMD_SSE2 1
+#endif
+
+#if defined(__SSE4_1__) || defined(__AVX__)
+    #define LUX_SIMD_SSE41 1
+#endif
+
+#if defined(__AVX2__)
+    #define LUX_SIMD_AVX2 1
+#endif
+
+#if defined(__F16C__) || defined(__AVX2__)
+    #define LUX_SIMD_F16C 1
+#endif
+
+#if defined(LUX_SIMD_SSE2)
+    #include <immintrin.h>
+#endif
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace lux::engine::platform
+{
+    /**
+     * @brief non owning view of `count` elements of T placed `stride` bytes apart,
+     *        elements are read by value so interleaved or unaligned sources are fine.
+     *        T must be bitwise copyable (scalars, fixed size Eigen vectors/matrices)
+     */
+    template<class T>
+    class StridedSpan
+    {
+    public:
+        StridedSpan() = default;
+
+        StridedSpan(const uint8_t* data, size_t count, size_t stride)
+            : _data(data), _count(count), _stride(stride ? stride : sizeof(T)){}
+
+        T operator[](size_t index) const
+        {
+            T value;
+            std::memcpy(static_cast<void*>(&value), _data + index * _stride, sizeof(T));
+            return value;
+        }
+
+        const uint8_t* data() const { return _data; }
+
+        size_t size() const { return _count; }
+
+        size_t stride() const { return _stride; }
+
+        bool empty() const { return _count == 0; }
+
+        // tightly packed and aligned, the span can be reinterpreted as a plain T array
+        bool contiguous() const
+        {
+            return _stride == sizeof(T) && reinterpret_cast<uintptr_t>(_data) % alignof(T) == 0;
+        }
+
+    private:
+        const uint8_t* _data{nullptr};
+        size_t         _count{0};
+        size_t         _stride{sizeof(T)};
+    };
+} // namespace lux::engine::platform
@@ -0,0 +1,103 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <lux-engine/platform/cxx/JobSystem.hpp>
+#include <lux-engine/platform/cxx/visibility_control.h>
+
+namespace lux::engine::platform
+{
+    enum class SystemAffinity : uint8_t
+    {
+        ANY_THREAD,
+        CALLING_THREAD      // GL, windowing and UI code, runs on the thread calling TaskGraph::run()
+    };
+
+    // timings of the last TaskGraph::run(), milliseconds from the start of the frame
+    struct TaskGraphFrame
+    {
+        double              wall_time{0};
+        double              serial_time{0};         // sum of every system, the frame as a plain loop
+        double              critical_time{0};       // longest chain of dependent systems
+        std::vector<size_t> critical_path;          // system indices, first to last
+        std::vector<double> start_times;
+        std::vector<double> durations;
+    };
+
+    /**
+     * @brief per frame systems with declared read and write sets over named resources.
+     *        registration order is the order a serial loop would run them in: a system depends on the last
+     *        earlier writer of everything it touches and, when it writes, on the readers since that writer.
+     *        everything else runs concurrently on a JobSystem. systems are added once and run every frame
+     */
+    class TaskGraph
+    {
+    public:
+        using System = std::function<void()>;
+
+        /**
+         * @brief a resource listed in both sets counts as written. names are only compared, they need not exist anywhere
+         *
+         * @return size_t index of the system, also its position in TaskGraphFrame
+         */
+        LUX_EXPORT size_t addSystem(
+            std::string name, const std::vector<std::string>& reads, const std::vector<std::string>& writes,
+            System system, SystemAffinity affinity = SystemAffinity::ANY_THREAD);
+
+        /**
+         * @brief run every system once and return when all are done. the calling thread runs the
+         *        CALLING_THREAD systems as they become ready and helps with the others meanwhile
+         */
+        LUX_EXPORT void run(JobSystem& jobs = JobSystem::global());
+
+        size_t systemCount() const { return _systems.size(); }
+
+        const std::string& systemName(size_t index) const { return _systems[index].name; }
+
+        // systems `index` waits for, all of them registered earlier
+        const std::vector<size_t>& dependencies(size_t index) const { return _systems[index].dependencies; }
+
+        const TaskGraphFrame& lastFrame() const { return _frame; }
+
+        // "name 0.12 ms -> name 1.40 ms" along the critical path of the last frame, plus the totals
+        LUX_EXPORT std::string describeCriticalPath() const;
+
+    private:
+        struct Node
+        {
+            std::string         name;
+            System              system;
+            SystemAffinity      affinity;
+            std::vector<size_t> dependencies;
+            std::vector<size_t> dependents;
+        };
+
+        struct ResourceState
+        {
+            size_t              last_writer{SIZE_MAX};
+            std::vector<size_t> readers;    // since the last writer
+        };
+
+        void launch(size_t index, JobSystem& jobs, JobCounter& counter);
+
+        void execute(size_t index, JobSystem& jobs, JobCounter& counter);
+
+        void computeCriticalPath();
+
+        std::vector<Node>                               _systems;
+        std::unordered_map<std::string, ResourceState>  _resources;
+
+        // per frame state
+        std::vector<std::atomic<uint32_t>>              _waiting;   // unfinished dependencies of each system
+        std::atomic<size_t>                             _remaining{0};
+        std::mutex                                      _calling_mutex;
+        std::vector<size_t>                             _calling_ready;
+        int64_t                                         _frame_start{0};
+        TaskGraphFrame                                  _frame;
+    };
+} // namespace lux::engine::platform
@@ -0,0 +1,88 @@
+#include "lux-engine/platform/cxx/IoQueue.hpp"
+#include "lux-engine/platform/cxx/Parallel.hpp"
+#include <algorithm>
+
+namespace lux::engine::platform
+{
+    size_t IoCounter::pending() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _pending;
+    }
+
+    void IoCounter::wait() const
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done.wait(lock, [this]{ return _pending == 0; });
+    }
+
+    IoQueue::IoQueue(size_t worker_count)
+    {
+        if(worker_count == 0)
+        {
+            // the threads mostly wait on the disk, a few keep it busy without crowding out the JobSystem
+            worker_count = std::clamp<size_t>(hardwareThreadCount() / 2, 2, 4);
+        }
+        _workers.reserve(worker_count);
+        for(size_t i = 0; i < worker_count; i++)
+        {
+            _workers.emplace_back([this]{ workerLoop(); });
+        }
+    }
+
+    IoQueue::~IoQueue()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _wake.notify_all();
+        for(auto& worker : _workers) worker.join();
+    }
+
+    IoQueue& IoQueue::global()
+    {
+        static IoQueue queue;
+        return queue;
+    }
+
+    void IoQueue::submit(Task task, IoCounter* counter)
+    {
+        if(counter)
+        {
+            std::lock_guard<std::mutex> lock(counter->_mutex);
+            counter->_pending++;
+        }
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _queue.push_back(Entry{std::move(task), counter});
+        }
+        _wake.notify_one();
+    }
+
+    void IoQueue::workerLoop()
+    {
+        while(true)
+        {
+            Entry entry;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _wake.wait(lock, [this]{ return _stop || !_queue.empty(); });
+                // queued tasks still run on shutdown, their submitters may be waiting on them
+                if(_queue.empty()) return;
+                entry = std::move(_queue.front());
+                _queue.pop_front();
+            }
+
+            entry.task();
+            // drop the captures before the submitter hears about it
+            entry.task = nullptr;
+            if(entry.counter)
+            {
+                // notified under the lock, the waiter can't destroy the counter before we let go of it
+                std::lock_guard<std::mutex> lock(entry.counter->_mutex);
+                if(--entry.counter->_pending == 0) entry.counter->_done.notify_all();
+            }
+        }
+    }
+} // namespace lux::engine::platform
@@ -0,0 +1,275 @@
+#include "lux-engine/platform/cxx/JobSystem.hpp"
+#include "lux-engine/platform/cxx/Parallel.hpp"
+#include <algorithm>
+
+namespace lux::engine::platform
+{
+    struct JobSystem::Task
+    {
+        Job         job;
+        JobCounter* counter{nullptr};
+    };
+
+    namespace
+    {
+        struct WorkerIdentity
+        {
+            const JobSystem*    system{nullptr};
+            size_t              index{SIZE_MAX};
+        };
+
+        thread_local WorkerIdentity t_worker;
+
+        // beyond this many cached tasks a thread gives them back to the allocator
+        constexpr size_t kTaskCacheSize = 1024;
+
+        // polls for new work before a worker goes to sleep, jobs tend to come in bursts
+        constexpr uint32_t kIdleSpins = 64;
+    }
+
+    JobSystem::JobSystem(size_t worker_count)
+    {
+        if(worker_count == 0)
+        {
+            worker_count = std::max<size_t>(hardwareThreadCount(), 2) - 1;
+        }
+        _deques.reserve(worker_count);
+        for(size_t i = 0; i < worker_count; i++)
+        {
+            _deques.push_back(std::make_unique<WorkStealingDeque<Task>>());
+        }
+        _workers.reserve(worker_count);
+        for(size_t i = 0; i < worker_count; i++)
+        {
+            _workers.emplace_back([this, i]{ workerLoop(i); });
+        }
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_sleep_mutex);
+            _stop = true;
+        }
+        _wake.notify_all();
+        // the workers empty every queue, the shared one included, before they return
+        for(auto& worker : _workers) worker.join();
+    }
+
+    JobSystem& JobSystem::global()
+    {
+        static JobSystem system;
+        return system;
+    }
+
+    void JobSystem::schedule(Job job, JobCounter* counter)
+    {
+        push(allocate(std::move(job), counter));
+    }
+
+    void JobSystem::scheduleAfter(JobCounter& dependency, Job job, JobCounter* counter)
+    {
+        Task* task = allocate(std::move(job), counter);
+        {
+            // the step to zero happens under this lock, so the task is either released by it or pushed here
+            std::lock_guard<std::mutex> lock(dependency._mutex);
+            if(dependency._pending.load(std::memory_order_acquire) != 0)
+            {
+                dependency._dependents.push_back(task);
+                return;
+            }
+        }
+        push(task);
+    }
+
+    void JobSystem::wait(const JobCounter& counter)
+    {
+        const size_t self = currentWorker();
+        while(!counter.done())
+        {
+            if(Task* task = find(self))
+            {
+                execute(task);
+                continue;
+            }
+            std::this_thread::yield();
+        }
+        // the last job may still be releasing dependents, it holds the lock until it is done with the counter
+        std::lock_guard<std::mutex> lock(counter._mutex);
+    }
+
+    bool JobSystem::runPending()
+    {
+        Task* task = find(currentWorker());
+        if(task == nullptr) return false;
+        execute(task);
+        return true;
+    }
+
+    size_t JobSystem::currentWorker() const
+    {
+        return t_worker.system == this ? t_worker.index : SIZE_MAX;
+    }
+
+    std::vector<std::unique_ptr<JobSystem::Task>>& JobSystem::taskCache()
+    {
+        thread_local std::vector<std::unique_ptr<Task>> cache;
+        return cache;
+    }
+
+    JobSystem::Task* JobSystem::allocate(Job job, JobCounter* counter)
+    {
+        auto& cache = taskCache();
+        std::unique_ptr<Task> task;
+        if(cache.empty())
+        {
+            task = std::make_unique<Task>();
+        }
+        else
+        {
+            task = std::move(cache.back());
+            cache.pop_back();
+        }
+        task->job     = std::move(job);
+        task->counter = counter;
+        if(counter) counter->_pending.fetch_add(1, std::memory_order_relaxed);
+        return task.release();
+    }
+
+    void JobSystem::push(Task* task)
+    {
+        if(t_worker.system == this)
+        {
+            _deques[t_worker.index]->push(task);
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(_shared_mutex);
+            _shared.push_back(task);
+            _shared_size.fetch_add(1, std::memory_order_relaxed);
+        }
+        // a worker about to sleep either sees the new epoch or is already waiting and gets notified
+        _epoch.fetch_add(1, std::memory_order_seq_cst);
+        if(_sleeping.load(std::memory_order_seq_cst) > 0)
+        {
+            std::lock_guard<std::mutex> lock(_sleep_mutex);
+            _wake.notify_one();
+        }
+    }
+
+    JobSystem::Task* JobSystem::find(size_t self)
+    {
+        if(self < _deques.size())
+        {
+            if(Task* task = _deques[self]->pop()) return task;
+        }
+        if(_shared_size.load(std::memory_order_relaxed) > 0)
+        {
+            std::lock_guard<std::mutex> lock(_shared_mutex);
+            if(!_shared.empty())
+            {
+                Task* task = _shared.front();
+                _shared.pop_front();
+                _shared_size.fetch_sub(1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+        // start at a different victim every time so thieves do not all pile onto the first deque
+        thread_local uint32_t t_victim = 0;
+        const size_t count = _deques.size();
+        const size_t first = t_victim++;
+        for(size_t i = 0; i < count; i++)
+        {
+            const size_t victim = (first + i) % count;
+            if(victim == self) continue;
+            if(Task* task = _deques[victim]->steal()) return task;
+        }
+        return nullptr;
+    }
+
+    void JobSystem::execute(Task* task)
+    {
+        task->job();
+        JobCounter* counter = task->counter;
+
+        // drop the captures right away, they may hold resources the waiting thread wants back
+        task->job = nullptr;
+        auto& cache = taskCache();
+        if(cache.size() < kTaskCacheSize)
+        {
+            cache.emplace_back(task);
+        }
+        else
+        {
+            delete task;
+        }
+
+        if(counter == nullptr) return;
+        uint32_t pending = counter->_pending.load(std::memory_order_relaxed);
+        while(pending > 1)
+        {
+            if(counter->_pending.compare_exchange_weak(pending, pending - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+            {
+                return;
+            }
+        }
+        // possibly the last one, step to zero under the lock so wait() and scheduleAfter() see it atomically
+        release(*counter);
+    }
+
+    void JobSystem::release(JobCounter& counter)
+    {
+        std::vector<void*> dependents;
+        {
+            std::lock_guard<std::mutex> lock(counter._mutex);
+            if(counter._pending.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+            dependents.swap(counter._dependents);
+        }
+        for(void* dependent : dependents)
+        {
+            push(static_cast<Task*>(dependent));
+        }
+    }
+
+    void JobSystem::workerLoop(size_t index)
+    {
+        t_worker = WorkerIdentity{this, index};
+        uint32_t idle = 0;
+        while(true)
+        {
+            if(Task* task = find(index))
+            {
+                execute(task);
+                idle = 0;
+                continue;
+            }
+            if(++idle < kIdleSpins)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            idle = 0;
+
+            const uint64_t epoch = _epoch.load(std::memory_order_seq_cst);
+            _sleeping.fetch_add(1, std::memory_order_seq_cst);
+            // anything pushed before the epoch was read is visible now, anything after changes the epoch
+            if(Task* task = find(index))
+            {
+                _sleeping.fetch_sub(1, std::memory_order_seq_cst);
+                execute(task);
+                continue;
+            }
+            {
+                std::unique_lock<std::mutex> lock(_sleep_mutex);
+                _wake.wait(lock, [&]{ return _stop.load() || _epoch.load(std::memory_order_seq_cst) != epoch; });
+            }
+            _sleeping.fetch_sub(1, std::memory_order_seq_cst);
+            // keep running until every queue is empty, the destructor promises queued jobs still run
+            if(_stop.load())
+            {
+                while(Task* task = find(index)) execute(task);
+                return;
+            }
+        }
+    }
+} // namespace lux::engine::platform
@@ -0,0 +1,140 @@
+#include "lux-engine/platform/cxx/MappedFile.hpp"
+
+#if defined _WIN32
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+namespace lux::engine::platform
+{
+    class MappedFile::Impl
+    {
+    public:
+        ~Impl()
+        {
+            close();
+        }
+
+        bool open(const std::string& path)
+        {
+            close();
+#if defined _WIN32
+            _file = CreateFileA(
+                path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr
+            );
+            if(_file == INVALID_HANDLE_VALUE) return false;
+
+            LARGE_INTEGER file_size;
+            if(!GetFileSizeEx(_file, &file_size) || file_size.QuadPart == 0)
+            {
+                close();
+                return false;
+            }
+            _size = static_cast<size_t>(file_size.QuadPart);
+
+            _mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if(_mapping == nullptr)
+            {
+                close();
+                return false;
+            }
+            _data = static_cast<const uint8_t*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+            _file = ::open(path.c_str(), O_RDONLY);
+            if(_file < 0) return false;
+
+            struct stat file_stat;
+            if(fstat(_file, &file_stat) != 0 || file_stat.st_size == 0)
+            {
+                close();
+                return false;
+            }
+            _size = static_cast<size_t>(file_stat.st_size);
+
+            void* address = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _file, 0);
+            _data = address == MAP_FAILED ? nullptr : static_cast<const uint8_t*>(address);
+#endif
+            if(_data == nullptr)
+            {
+                close();
+                return false;
+            }
+            return true;
+        }
+
+        void close()
+        {
+#if defined _WIN32
+            if(_data) UnmapViewOfFile(_data);
+            if(_mapping) CloseHandle(_mapping);
+            if(_file != INVALID_HANDLE_VALUE) CloseHandle(_file);
+            _mapping = nullptr;
+            _file    = INVALID_HANDLE_VALUE;
+#else
+            if(_data) munmap(const_cast<uint8_t*>(_data), _size);
+            if(_file >= 0) ::close(_file);
+            _file = -1;
+#endif
+            _data = nullptr;
+            _size = 0;
+        }
+
+        const uint8_t*  _data{nullptr};
+        size_t          _size{0};
+#if defined _WIN32
+        HANDLE          _file{INVALID_HANDLE_VALUE};
+        HANDLE          _mapping{nullptr};
+#else
+        int             _file{-1};
+#endif
+    };
+
+    MappedFile::MappedFile()
+        : _impl(std::make_unique<Impl>()){}
+
+    MappedFile::MappedFile(const std::string& path)
+        : _impl(std::make_unique<Impl>())
+    {
+        _impl->open(path);
+    }
+
+    MappedFile::MappedFile(MappedFile&&) noexcept = default;
+
+    MappedFile& MappedFile::operator=(MappedFile&&) noexcept = default;
+
+    MappedFile::~MappedFile() = default;
+
+    bool MappedFile::open(const std::string& path)
+    {
+        if(!_impl) _impl = std::make_unique<Impl>();
+        return _impl->open(path);
+    }
+
+    void MappedFile::close()
+    {
+        if(_impl) _impl->close();
+    }
+
+    bool MappedFile::isEnable() const
+    {
+        return _impl && _impl->_data != nullptr;
+    }
+
+    const uint8_t* MappedFile::data() const
+    {
+        return _impl ? _impl->_data : nullptr;
+    }
+
+    size_t MappedFile::size() const
+    {
+        return _impl ? _impl->_size : 0;
+    }
+} // namespace lux::engine::platform
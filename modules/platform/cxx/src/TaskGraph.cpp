@@ -0,0 +1,201 @@
+#include "lux-engine/platform/cxx/TaskGraph.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace lux::engine::platform
+{
+    namespace
+    {
+        int64_t nowNanoseconds()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        double toMilliseconds(int64_t nanoseconds)
+        {
+            return static_cast<double>(nanoseconds) * 1e-6;
+        }
+    }
+
+    size_t TaskGraph::addSystem(
+        std::string name, const std::vector<std::string>& reads, const std::vector<std::string>& writes,
+        System system, SystemAffinity affinity)
+    {
+        const size_t index = _systems.size();
+        Node node;
+        node.name     = std::move(name);
+        node.system   = std::move(system);
+        node.affinity = affinity;
+
+        for(const auto& resource : writes)
+        {
+            // write after write and write after read
+            ResourceState& state = _resources[resource];
+            if(state.last_writer != SIZE_MAX) node.dependencies.push_back(state.last_writer);
+            node.dependencies.insert(node.dependencies.end(), state.readers.begin(), state.readers.end());
+        }
+        for(const auto& resource : reads)
+        {
+            if(std::find(writes.begin(), writes.end(), resource) != writes.end()) continue;
+            // read after write
+            ResourceState& state = _resources[resource];
+            if(state.last_writer != SIZE_MAX) node.dependencies.push_back(state.last_writer);
+        }
+        std::sort(node.dependencies.begin(), node.dependencies.end());
+        node.dependencies.erase(std::unique(node.dependencies.begin(), node.dependencies.end()), node.dependencies.end());
+        // a system listing a resource twice must not wait on itself
+        node.dependencies.erase(std::remove(node.dependencies.begin(), node.dependencies.end(), index), node.dependencies.end());
+
+        for(const auto& resource : writes)
+        {
+            ResourceState& state = _resources[resource];
+            state.last_writer = index;
+            state.readers.clear();
+        }
+        for(const auto& resource : reads)
+        {
+            if(std::find(writes.begin(), writes.end(), resource) != writes.end()) continue;
+            auto& readers = _resources[resource].readers;
+            if(readers.empty() || readers.back() != index) readers.push_back(index);
+        }
+
+        for(size_t dependency : node.dependencies)
+        {
+            _systems[dependency].dependents.push_back(index);
+        }
+        _systems.push_back(std::move(node));
+        return index;
+    }
+
+    void TaskGraph::run(JobSystem& jobs)
+    {
+        const size_t count = _systems.size();
+        if(count == 0) return;
+
+        if(_waiting.size() != count)
+        {
+            _waiting = std::vector<std::atomic<uint32_t>>(count);
+        }
+        for(size_t i = 0; i < count; i++)
+        {
+            _waiting[i].store(static_cast<uint32_t>(_systems[i].dependencies.size()), std::memory_order_relaxed);
+        }
+        _frame.start_times.assign(count, 0.0);
+        _frame.durations.assign(count, 0.0);
+        _remaining.store(count, std::memory_order_release);
+        _calling_ready.clear();
+
+        JobCounter counter;
+        _frame_start = nowNanoseconds();
+        for(size_t i = 0; i < count; i++)
+        {
+            if(_systems[i].dependencies.empty()) launch(i, jobs, counter);
+        }
+
+        while(_remaining.load(std::memory_order_acquire) > 0)
+        {
+            size_t ready = SIZE_MAX;
+            {
+                std::lock_guard<std::mutex> lock(_calling_mutex);
+                if(!_calling_ready.empty())
+                {
+                    // lowest index first, the order the serial loop had
+                    auto lowest = std::min_element(_calling_ready.begin(), _calling_ready.end());
+                    ready = *lowest;
+                    _calling_ready.erase(lowest);
+                }
+            }
+            if(ready != SIZE_MAX)
+            {
+                execute(ready, jobs, counter);
+            }
+            else if(!jobs.runPending())
+            {
+                std::this_thread::yield();
+            }
+        }
+        // every system has finished, this only waits for the jobs to let go of the counter
+        jobs.wait(counter);
+
+        _frame.wall_time = toMilliseconds(nowNanoseconds() - _frame_start);
+        computeCriticalPath();
+    }
+
+    std::string TaskGraph::describeCriticalPath() const
+    {
+        std::string description;
+        char buffer[64];
+        for(size_t index : _frame.critical_path)
+        {
+            if(!description.empty()) description += " -> ";
+            std::snprintf(buffer, sizeof(buffer), " %.2f ms", _frame.durations[index]);
+            description += _systems[index].name;
+            description += buffer;
+        }
+        std::snprintf(buffer, sizeof(buffer), "\ncritical %.2f ms, serial %.2f ms, wall %.2f ms",
+            _frame.critical_time, _frame.serial_time, _frame.wall_time);
+        description += buffer;
+        return description;
+    }
+
+    void TaskGraph::launch(size_t index, JobSystem& jobs, JobCounter& counter)
+    {
+        if(_systems[index].affinity == SystemAffinity::CALLING_THREAD)
+        {
+            std::lock_guard<std::mutex> lock(_calling_mutex);
+            _calling_ready.push_back(index);
+            return;
+        }
+        jobs.schedule([this, index, &jobs, &counter]{ execute(index, jobs, counter); }, &counter);
+    }
+
+    void TaskGraph::execute(size_t index, JobSystem& jobs, JobCounter& counter)
+    {
+        const int64_t start = nowNanoseconds();
+        _systems[index].system();
+        const int64_t end = nowNanoseconds();
+        _frame.start_times[index] = toMilliseconds(start - _frame_start);
+        _frame.durations[index]   = toMilliseconds(end - start);
+
+        for(size_t dependent : _systems[index].dependents)
+        {
+            if(_waiting[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1) launch(dependent, jobs, counter);
+        }
+        _remaining.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    void TaskGraph::computeCriticalPath()
+    {
+        const size_t count = _systems.size();
+        // dependencies always have lower indices, so index order is a topological order
+        std::vector<double> finish(count, 0.0);
+        std::vector<size_t> previous(count, SIZE_MAX);
+        size_t last = 0;
+        _frame.serial_time = 0;
+        for(size_t i = 0; i < count; i++)
+        {
+            double ready = 0;
+            for(size_t dependency : _systems[i].dependencies)
+            {
+                if(finish[dependency] > ready)
+                {
+                    ready       = finish[dependency];
+                    previous[i] = dependency;
+                }
+            }
+            finish[i] = ready + _frame.durations[i];
+            if(finish[i] > finish[last]) last = i;
+            _frame.serial_time += _frame.durations[i];
+        }
+
+        _frame.critical_time = finish[last];
+        _frame.critical_path.clear();
+        for(size_t index = last; index != SIZE_MAX; index = previous[index])
+        {
+            _frame.critical_path.push_back(index);
+        }
+        std::reverse(_frame.critical_path.begin(), _frame.critical_path.end());
+    }
+} // namespace lux::engine::platform
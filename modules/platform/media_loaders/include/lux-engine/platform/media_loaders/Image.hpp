@@ -1,13 +1,50 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <lux-engine/platform/cxx/visibility_control.h>
 
 namespace lux::engine::platform
 {
+    // type of one channel of a decoded image
+    enum class PixelFormat : uint8_t
+    {
+        UINT8,
+        UINT16,     // 16 bit png, full range unorm
+        FLOAT32     // radiance .hdr, linear
+    };
+
+    constexpr size_t pixelFormatSize(PixelFormat format)
+    {
+        return format == PixelFormat::UINT8 ? 1 : format == PixelFormat::UINT16 ? 2 : 4;
+    }
+
     class Image
     {
     public:
-        LUX_EXPORT Image(std::string path, bool flip_vertically = true);
+        LUX_EXPORT Image();
+
+        /**
+         * @brief decode a png/jpg/... file. reentrant: the file is memory mapped and decoded from memory,
+         *        flipping is a separate pass over the rows instead of stb's process wide flag
+         *
+         * @param high_precision keep what the file stores: .hdr decodes to FLOAT32 and 16 bit png to UINT16.
+         *        otherwise everything is UINT8, hdr images tone mapped by the decoder
+         */
+        LUX_EXPORT Image(std::string path, bool flip_vertically = true, bool high_precision = false);
+
+        // decode an encoded image already in memory (e.g. embedded in a glb)
+        LUX_EXPORT static Image fromMemory(
+            const void* encoded, size_t size, bool flip_vertically = true, bool high_precision = false
+        );
+
+        LUX_EXPORT Image(Image&& other) noexcept;
+
+        LUX_EXPORT Image& operator=(Image&& other) noexcept;
+
+        Image(const Image&) = delete;
+
+        Image& operator=(const Image&) = delete;
 
         LUX_EXPORT ~Image();
 
@@ -21,20 +58,18 @@ namespace lux::engine::platform
 
         LUX_EXPORT void* data();
 
-    private:
-        void load(const char*);
+        PixelFormat format() const { return _format; }
 
-        void* _data{nullptr};
-        int _width;
-        int _height;
-        int _channel;
-    };
+        // bytes of one texel, channels * channel size
+        size_t texelSize() const { return static_cast<size_t>(_channel) * pixelFormatSize(_format); }
 
-    class ImageLoader
-    {
-    public:
-        ImageLoader();
+    private:
+        void load(const uint8_t* encoded, size_t size, bool flip_vertically, bool high_precision);
 
-        ~ImageLoader();
+        void* _data{nullptr};
+        int _width{0};
+        int _height{0};
+        int _channel{0};
+        PixelFormat _format{PixelFormat::UINT8};
     };
 } // namespace lux::engine::platform
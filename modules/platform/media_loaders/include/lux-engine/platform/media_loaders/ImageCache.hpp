@@ -0,0 +1,110 @@
+#pragma once
+#include "Image.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <lux-engine/platform/cxx/visibility_control.h>
+
+namespace lux::engine::platform
+{
+    struct ImageCacheStats
+    {
+        uint64_t    hits{0};        // served without decoding, including waits on a decode already running
+        uint64_t    misses{0};      // decodes started
+        uint64_t    evictions{0};
+        size_t      bytes{0};       // decoded pixels held, referenced entries included
+        size_t      entries{0};
+        size_t      budget{0};
+    };
+
+    /**
+     * @brief decoded images shared between everyone loading the same content.
+     *        entries are keyed by a hash of the encoded bytes, so two paths to one file decode once and
+     *        a file changed on disk decodes again. a path remembers the hash together with the file size and
+     *        write time, an unchanged file is a hit without being read at all.
+     *        over the byte budget the least recently used entries nobody references any more are dropped,
+     *        referenced entries are never evicted (the cache may stay over budget until they are released).
+     *        every call is thread safe, concurrent loads of the same content wait for a single decode
+     */
+    class ImageCache
+    {
+    public:
+        LUX_EXPORT explicit ImageCache(size_t budget_bytes = size_t(256) << 20);
+
+        ImageCache(const ImageCache&) = delete;
+
+        ImageCache& operator=(const ImageCache&) = delete;
+
+        /**
+         * @brief nullptr when the file is missing or fails to decode (running out of memory included), failures are not cached
+         *
+         * @param high_precision see Image, 8 bit and high precision decodes of a file are separate entries
+         */
+        LUX_EXPORT std::shared_ptr<Image> load(const std::string& path, bool flip_vertically = true, bool high_precision = false);
+
+        LUX_EXPORT std::shared_ptr<Image> loadFromMemory(
+            const void* encoded, size_t size, bool flip_vertically = true, bool high_precision = false
+        );
+
+        // evicts right away when the new budget is smaller than the bytes held
+        LUX_EXPORT void setBudget(size_t budget_bytes);
+
+        LUX_EXPORT size_t budget() const;
+
+        /**
+         * @brief drop every unreferenced entry regardless of the budget
+         *
+         * @return size_t bytes released
+         */
+        LUX_EXPORT size_t purge();
+
+        LUX_EXPORT ImageCacheStats stats() const;
+
+        LUX_EXPORT void resetStats();
+
+    private:
+        using ImageFuture = std::shared_future<std::shared_ptr<Image>>;
+
+        struct Entry
+        {
+            std::shared_ptr<Image>          image;      // null while decoding
+            ImageFuture                     pending;    // what concurrent loads wait on while decoding
+            size_t                          bytes{0};
+            std::list<uint64_t>::iterator   lru;
+            uint64_t                        content{0};     // hash of the encoded bytes, set with `paths`
+            std::vector<std::string>        paths;          // _paths stamps leading here, dropped with the entry
+        };
+
+        struct PathStamp
+        {
+            uintmax_t                       size{0};
+            std::filesystem::file_time_type time;
+            uint64_t                        content{0};     // hash of the encoded bytes
+        };
+
+        std::shared_ptr<Image> acquire(uint64_t key, const void* encoded, size_t size, bool flip_vertically, bool high_precision);
+
+        // with _mutex held, counts the hit and marks the entry most recently used.
+        // null while the entry is still decoding, `pending` is what to wait on then
+        std::shared_ptr<Image> hit(Entry& entry, ImageFuture& pending);
+
+        // with _mutex held
+        size_t evict(size_t target_bytes);
+
+        mutable std::mutex                              _mutex;
+        std::unordered_map<uint64_t, Entry>             _entries;
+        std::unordered_map<std::string, PathStamp>      _paths;
+        std::list<uint64_t>                             _lru;       // least recently used first
+        size_t                                          _budget;
+        size_t                                          _bytes{0};
+        uint64_t                                        _hits{0};
+        uint64_t                                        _misses{0};
+        uint64_t                                        _evictions{0};
+    };
+} // namespace lux::engine::platform
@@ -0,0 +1,184 @@
+#pragma once
+#include "Image.hpp"
+#include "ImageCache.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <vector>
+#include <lux-engine/platform/cxx/IoQueue.hpp>
+#include <lux-engine/platform/cxx/visibility_control.h>
+
+namespace lux::engine::platform
+{
+    enum class ImagePriority : uint8_t
+    {
+        LOW,
+        NORMAL,
+        HIGH,
+        CRITICAL
+    };
+
+    enum class ImageLoadStatus : uint8_t
+    {
+        PENDING,
+        LOADING,
+        READY,
+        FAILED,
+        CANCELLED
+    };
+
+    /**
+     * @brief shared handle to one asynchronous decode, cheap to copy.
+     *        the image belongs to the handle once the status is READY.
+     *        a default constructed handle reads as CANCELLED with an empty image
+     */
+    class ImageHandle
+    {
+    public:
+        ImageHandle() = default;
+
+        bool valid() const { return _state != nullptr; }
+
+        ImageLoadStatus status() const { return _state ? _state->status.load(std::memory_order_acquire) : ImageLoadStatus::CANCELLED; }
+
+        // READY, FAILED or CANCELLED
+        bool isDone() const { return status() >= ImageLoadStatus::READY; }
+
+        void wait() const
+        {
+            if(_state) _state->done.wait();
+        }
+
+        /**
+         * @brief drop the request. a pending request never reaches a worker,
+         *        a decode already running finishes but its result is thrown away
+         */
+        LUX_EXPORT void cancel();
+
+        // valid when READY, an empty image otherwise. shared with other handles when the loader decodes through an ImageCache
+        Image& image() const
+        {
+            static Image empty;
+            return _state && _state->image ? *_state->image : empty;
+        }
+
+        // nullptr unless READY
+        std::shared_ptr<Image> sharedImage() const { return _state ? _state->image : nullptr; }
+
+        const std::string& path() const
+        {
+            static const std::string empty;
+            return _state ? _state->path : empty;
+        }
+
+        uint64_t userData() const { return _state ? _state->user_data : 0; }
+
+    private:
+        friend class ImageLoader;
+
+        struct State
+        {
+            std::string                     path;
+            bool                            flip_vertically{true};
+            bool                            high_precision{false};
+            uint64_t                        user_data{0};
+            std::atomic<ImageLoadStatus>    status{ImageLoadStatus::PENDING};
+            std::atomic<bool>               cancel_requested{false};
+            std::promise<void>              promise;
+            std::shared_future<void>        done;
+            std::shared_ptr<Image>          image;
+        };
+
+        explicit ImageHandle(std::shared_ptr<State> state)
+            : _state(std::move(state)){}
+
+        std::shared_ptr<State> _state;
+    };
+
+    struct ImageRequest
+    {
+        std::string     path;
+        bool            flip_vertically{true};
+        ImagePriority   priority{ImagePriority::NORMAL};
+        uint64_t        user_data{0};   // handed back through ImageHandle::userData()
+        bool            high_precision{false};  // UINT16 / FLOAT32 pixels, see Image
+    };
+
+    /**
+     * @brief decodes images on the threads of an IoQueue.
+     *        requests run highest priority first, in submission order within a priority.
+     *        finished requests are queued for the owning thread, which picks them up in bulk
+     *        with collect() (typically once per frame, next to the texture uploads)
+     */
+    class ImageLoader
+    {
+    public:
+        /**
+         * @param cache optional, decodes go through it and repeated content is shared. must outlive the loader
+         * @param queue nullptr decodes on IoQueue::global(). must outlive the loader
+         */
+        LUX_EXPORT explicit ImageLoader(ImageCache* cache = nullptr, IoQueue* queue = nullptr);
+
+        // cancels everything still pending and waits for the decodes already running
+        LUX_EXPORT ~ImageLoader();
+
+        ImageLoader(const ImageLoader&) = delete;
+
+        ImageLoader& operator=(const ImageLoader&) = delete;
+
+        LUX_EXPORT ImageHandle load(const ImageRequest& request);
+
+        LUX_EXPORT ImageHandle load(const std::string& path, bool flip_vertically = true,
+            ImagePriority priority = ImagePriority::NORMAL);
+
+        // submit several requests under a single lock
+        LUX_EXPORT std::vector<ImageHandle> loadBatch(const std::vector<ImageRequest>& requests);
+
+        /**
+         * @brief move every request finished since the last call into `completed`
+         *        (READY and FAILED, cancelled requests are dropped)
+         *
+         * @return size_t number of handles appended
+         */
+        LUX_EXPORT size_t collect(std::vector<ImageHandle>& completed);
+
+        // block until nothing is pending or loading
+        LUX_EXPORT void waitIdle();
+
+        LUX_EXPORT size_t pendingCount() const;
+
+    private:
+        struct QueueEntry
+        {
+            ImagePriority                           priority;
+            uint64_t                                sequence;
+            std::shared_ptr<ImageHandle::State>     state;
+
+            bool operator<(const QueueEntry& other) const
+            {
+                // std::priority_queue pops the largest
+                if(priority != other.priority) return priority < other.priority;
+                return sequence > other.sequence;
+            }
+        };
+
+        // one io task per request, it decodes whichever request is first in line when it starts
+        void decodeNext();
+
+        std::shared_ptr<ImageHandle::State> enqueue(const ImageRequest& request);
+
+        ImageCache*                         _cache;
+        IoQueue*                            _io;
+        IoCounter                           _tasks;
+        mutable std::mutex                  _mutex;
+        std::condition_variable             _idle;
+        std::priority_queue<QueueEntry>     _queue;
+        std::vector<ImageHandle>            _completed;
+        uint64_t                            _sequence{0};
+        size_t                              _in_flight{0};  // queued + decoding
+    };
+} // namespace lux::engine::platform
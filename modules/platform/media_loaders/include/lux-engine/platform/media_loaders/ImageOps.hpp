@@ -0,0 +1,81 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <lux-engine/platform/cxx/visibility_control.h>
+
+namespace lux::engine::platform
+{
+    /**
+     * @brief mirror an image top to bottom in place by swapping rows,
+     *        `row_bytes` apart (width * channels * bytes per channel, no padding)
+     */
+    LUX_EXPORT void flipVertically(void* pixels, size_t row_bytes, size_t rows);
+
+    // tightly packed 8 bit texel kernels, `count` is in texels. large inputs are split across threads
+
+    // rgb -> rgba with a constant alpha
+    LUX_EXPORT void expandRgbToRgba(const uint8_t* rgb, uint8_t* rgba, size_t count, uint8_t alpha = 255);
+
+    // rgba -> rg, drops blue and alpha
+    LUX_EXPORT void packRgbaToRg(const uint8_t* rgba, uint8_t* rg, size_t count);
+
+    // copy one channel of `channels` interleaved ones into a single channel image
+    LUX_EXPORT void extractChannel(const uint8_t* source, uint32_t channels, uint32_t channel, uint8_t* target, size_t count);
+
+    // rgba <-> bgra, `source` and `target` may be the same buffer
+    LUX_EXPORT void swizzleRgbaToBgra(const uint8_t* source, uint8_t* target, size_t count);
+
+    /**
+     * @brief multiply the color channels by alpha (the last channel, 2 or 4 channels) in place,
+     *        rounded like c * a / 255. works on the stored values, for sRGB color that is the usual
+     *        approximation of premultiplying in linear space
+     */
+    LUX_EXPORT void premultiplyAlpha(uint8_t* pixels, size_t count, uint32_t channels);
+
+    /**
+     * @brief any channel count (1 - 4) to any other: extra channels are dropped, a single gray channel is
+     *        replicated into rgb, other new color channels are 0 and a new alpha is opaque.
+     *        uses the kernels above for the common pairs
+     *
+     * @param gray_alpha a 2 channel source is gray + alpha (what the decoder produces) instead of red + green
+     */
+    LUX_EXPORT void convertChannels(
+        const uint8_t* source, uint32_t from, uint8_t* target, uint32_t to, size_t count, bool gray_alpha = false
+    );
+
+    struct ImageChannelUsage
+    {
+        bool opaque{true};      // no alpha channel, or every alpha is 255
+        bool grayscale{true};   // a single color channel, or r == g == b everywhere
+    };
+
+    // scan an image for channels that carry no information, stops early once both are ruled out
+    LUX_EXPORT ImageChannelUsage analyzeChannels(const uint8_t* pixels, size_t count, uint32_t channels);
+
+    // float kernels for hdr images, half the size of RGBA32F as half floats and a quarter as RGB9E5
+
+    /**
+     * @brief float -> IEEE half, round to nearest even. out of range values become infinity,
+     *        NaN stays NaN. `count` is in values, not texels
+     */
+    LUX_EXPORT void floatToHalf(const float* source, uint16_t* target, size_t count);
+
+    LUX_EXPORT void halfToFloat(const uint16_t* source, float* target, size_t count);
+
+    /**
+     * @brief pack texels into GL_RGB9_E5 (three 9 bit mantissas sharing a 5 bit exponent), following
+     *        EXT_texture_shared_exponent. negative and NaN values become 0, values above 65408 clamp.
+     *        `channels` 1 - 4: gray is replicated into rgb, alpha is dropped
+     */
+    LUX_EXPORT void encodeRgb9e5(const float* source, uint32_t channels, uint32_t* target, size_t count);
+
+    // GL_RGB9_E5 -> rgb floats
+    LUX_EXPORT void decodeRgb9e5(const uint32_t* source, float* rgb, size_t count);
+
+    /**
+     * @brief rgba -> planar BT.601 limited range YCbCr 4:2:0, chroma is the average of each 2x2 block
+     *        (centered siting, what y4m calls 420jpeg). odd sizes repeat the last row / column,
+     *        `u` and `v` take (width + 1) / 2 * (height + 1) / 2 bytes
+     */
+    LUX_EXPORT void rgbaToYuv420(const uint8_t* rgba, uint32_t width, uint32_t height, uint8_t* y, uint8_t* u, uint8_t* v);
+} // namespace lux::engine::platform
@@ -0,0 +1,54 @@
+#pragma once
+#include "Image.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <lux-engine/platform/cxx/visibility_control.h>
+
+namespace lux::engine::platform
+{
+    enum class ResizeFilter
+    {
+        BOX,        // area average when shrinking, blocky when enlarging
+        BILINEAR,   // tent filter, widened to the scale factor when shrinking
+        MITCHELL,   // cubic B = C = 1/3, little ringing, good default for enlarging
+        LANCZOS3    // sharpest, some ringing near hard edges, good default for shrinking
+    };
+
+    struct ResizeSettings
+    {
+        ResizeFilter    filter{ResizeFilter::LANCZOS3};
+        // color channels are sRGB encoded and filtered in linear space, alpha is always linear
+        bool            srgb{true};
+        // sample across the opposite edge, for tiling textures
+        bool            wrap{false};
+        // weight color by alpha while filtering, so fully transparent texels don't bleed their color in
+        bool            alpha_weighted{true};
+    };
+
+    /**
+     * @brief separable resize of an 8 bit image (1 - 4 channels, 2 is gray + alpha) into `target`.
+     *        source rows are converted to float on the fly for the horizontal pass, the vertical pass
+     *        writes 8 bit rows directly, both are split into row ranges across threads
+     */
+    LUX_EXPORT bool resizeImage(
+        const uint8_t* pixels, int width, int height, int channels,
+        int target_width, int target_height, const ResizeSettings& settings, std::vector<uint8_t>& target
+    );
+
+    // 8 bit images only, false for UINT16 / FLOAT32 ones
+    LUX_EXPORT bool resizeImage(
+        Image& image, int target_width, int target_height, const ResizeSettings& settings, std::vector<uint8_t>& target
+    );
+
+    /**
+     * @brief the largest extent with the same aspect ratio that fits into `max_width` x `max_height`,
+     *        never larger than the source. for thumbnails and capping texture sizes on low memory configurations
+     */
+    inline void fitExtent(int width, int height, int max_width, int max_height, int& fitted_width, int& fitted_height)
+    {
+        const double scale = std::min({1.0, double(max_width) / std::max(width, 1), double(max_height) / std::max(height, 1)});
+        fitted_width  = std::max(1, static_cast<int>(width * scale + 0.5));
+        fitted_height = std::max(1, static_cast<int>(height * scale + 0.5));
+    }
+} // namespace lux::engine::platform
@@ -0,0 +1,152 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <lux-engine/platform/cxx/IoQueue.hpp>
+#include <lux-engine/platform/cxx/visibility_control.h>
+
+namespace lux::engine::platform
+{
+    enum class ImageFileFormat : uint8_t
+    {
+        PNG,    // deflate, small files but the slow one to write
+        QOI     // run length / delta coded, several times faster than png at a similar size for rendered frames
+    };
+
+    /**
+     * @brief encode tightly packed 8 bit rows (top to bottom) into `encoded`, which is replaced.
+     *        png takes 1 - 4 channels, qoi 3 or 4
+     */
+    LUX_EXPORT bool encodeImage(
+        ImageFileFormat format, const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels,
+        std::vector<uint8_t>& encoded
+    );
+
+    LUX_EXPORT bool writeImage(
+        const std::string& path, ImageFileFormat format, const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels
+    );
+
+    struct ImageWriteRequest
+    {
+        std::string             path;
+        ImageFileFormat         format{ImageFileFormat::PNG};
+        std::vector<uint8_t>    pixels;                 // handed over to the writer
+        uint32_t                width{0};
+        uint32_t                height{0};
+        uint32_t                channels{4};
+        bool                    flip_vertically{false}; // rows are bottom to top, e.g. straight from glReadPixels
+    };
+
+    /**
+     * @brief encodes and writes images on the threads of an IoQueue, submit() only moves the pixels into a queue.
+     *        the queue is bounded, a full queue blocks submit() instead of piling up frames in memory
+     */
+    class ImageWriter
+    {
+    public:
+        /**
+         * @param max_queued    requests waiting for an io thread before submit() blocks
+         * @param queue         nullptr writes on IoQueue::global(). must outlive the writer
+         */
+        LUX_EXPORT explicit ImageWriter(size_t max_queued = 16, IoQueue* queue = nullptr);
+
+        // writes everything already submitted
+        LUX_EXPORT ~ImageWriter();
+
+        ImageWriter(const ImageWriter&) = delete;
+
+        ImageWriter& operator=(const ImageWriter&) = delete;
+
+        LUX_EXPORT void submit(ImageWriteRequest request);
+
+        // block until every submitted image is on disk
+        LUX_EXPORT void waitIdle();
+
+        LUX_EXPORT size_t pendingCount() const;
+
+        // requests that could not be encoded or written since construction
+        LUX_EXPORT size_t failedCount() const;
+
+    private:
+        // one io task per request, requests are taken in submission order
+        void writeNext();
+
+        size_t                          _max_queued;
+        IoQueue*                        _io;
+        IoCounter                       _tasks;
+        mutable std::mutex              _mutex;
+        std::condition_variable         _space;
+        std::condition_variable         _idle;
+        std::deque<ImageWriteRequest>   _queue;
+        size_t                          _in_flight{0};  // queued + encoding
+        size_t                          _failed{0};
+    };
+
+    struct Y4mSettings
+    {
+        uint32_t    fps_numerator{60};
+        uint32_t    fps_denominator{1};
+        // frames waiting for the writer thread before pushFrame() blocks
+        size_t      max_queued{8};
+    };
+
+    /**
+     * @brief raw YUV4MPEG2 stream (4:2:0, BT.601 limited range) for frame dumps, readable by ffmpeg and most players.
+     *        conversion and writing run on a background thread, frames keep their submission order
+     */
+    class Y4mWriter
+    {
+    public:
+        LUX_EXPORT Y4mWriter(const std::string& path, uint32_t width, uint32_t height, const Y4mSettings& settings = {});
+
+        // writes every queued frame and closes the file
+        LUX_EXPORT ~Y4mWriter();
+
+        Y4mWriter(const Y4mWriter&) = delete;
+
+        Y4mWriter& operator=(const Y4mWriter&) = delete;
+
+        bool isEnable() const { return _enable; }
+
+        /**
+         * @brief queue one rgba frame of the stream size, blocks while `max_queued` frames are waiting
+         *
+         * @return false when the size doesn't match or the stream is not open
+         */
+        LUX_EXPORT bool pushFrame(std::vector<uint8_t> rgba, bool flip_vertically = false);
+
+        LUX_EXPORT void waitIdle();
+
+        // frames written so far
+        LUX_EXPORT uint64_t frameCount() const;
+
+    private:
+        struct Frame
+        {
+            std::vector<uint8_t>    rgba;
+            bool                    flip_vertically;
+        };
+
+        void writerLoop();
+
+        std::ofstream               _file;
+        uint32_t                    _width{0};
+        uint32_t                    _height{0};
+        size_t                      _max_queued{0};
+        bool                        _enable{false};
+        std::thread                 _writer;
+        mutable std::mutex          _mutex;
+        std::condition_variable     _wake;
+        std::condition_variable     _space;
+        std::condition_variable     _idle;
+        std::deque<Frame>           _queue;
+        bool                        _busy{false};
+        uint64_t                    _written{0};
+        bool                        _stop{false};
+    };
+} // namespace lux::engine::platform
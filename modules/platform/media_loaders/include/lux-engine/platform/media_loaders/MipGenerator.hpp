@@ -0,0 +1,53 @@
+#pragma once
+#include "Image.hpp"
+#include <cstdint>
+#include <vector>
+#include <lux-engine/platform/cxx/visibility_control.h>
+
+namespace lux::engine::platform
+{
+    enum class MipFilter
+    {
+        BOX,        // 2x2 average on even sizes, cheapest and softest
+        KAISER      // kaiser windowed sinc, sharper, what offline texture tools default to
+    };
+
+    struct MipSettings
+    {
+        MipFilter   filter{MipFilter::KAISER};
+        // color channels are sRGB encoded and filtered in linear space, alpha is always linear.
+        // turn off for data textures (normals, masks, roughness)
+        bool        srgb{true};
+        // sample across the opposite edge, for tiling textures
+        bool        wrap{true};
+        // > 0 keeps the fraction of texels with alpha >= cutoff constant across levels,
+        // so alpha tested foliage/fences don't thin out in the distance
+        float       alpha_cutoff{0.0f};
+        // 0 generates the full chain down to 1x1
+        uint32_t    max_levels{0};
+    };
+
+    struct MipLevel
+    {
+        int                     width;
+        int                     height;
+        std::vector<uint8_t>    pixels;     // tightly packed, MipChain::channels per texel
+    };
+
+    struct MipChain
+    {
+        int                     channels{0};
+        std::vector<MipLevel>   levels;     // levels[0] is the source image
+    };
+
+    /**
+     * @brief build the mip chain of an 8 bit image (1 - 4 channels, 2 is gray + alpha).
+     *        every level is filtered from the previous one in float, rows are spread across threads
+     */
+    LUX_EXPORT void generateMips(
+        const uint8_t* pixels, int width, int height, int channels, const MipSettings& settings, MipChain& chain
+    );
+
+    // 8 bit images only, `chain` is left empty for UINT16 / FLOAT32 ones
+    LUX_EXPORT void generateMips(Image& image, const MipSettings& settings, MipChain& chain);
+} // namespace lux::engine::platform
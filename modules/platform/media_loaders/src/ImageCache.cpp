@@ -0,0 +1,213 @@
+#include "lux-engine/platform/media_loaders/ImageCache.hpp"
+#include <lux-engine/platform/cxx/Hash.hpp>
+#include <lux-engine/platform/cxx/MappedFile.hpp>
+#include <algorithm>
+
+namespace lux::engine::platform
+{
+	namespace
+	{
+		inline uint64_t contentHash(const void* encoded, size_t size)
+		{
+			// the size as seed keeps a truncated copy of a file apart from the original
+			return hash64(encoded, size, size);
+		}
+
+		// the same bytes decoded flipped and unflipped, or to 8 bit and high precision, are different images
+		inline uint64_t entryKey(uint64_t content, bool flip_vertically, bool high_precision)
+		{
+			return hashCombine(content, (flip_vertically ? 1 : 0) | (high_precision ? 2 : 0));
+		}
+
+		inline size_t imageBytes(Image& image)
+		{
+			return static_cast<size_t>(image.width()) * image.height() * image.texelSize();
+		}
+	}
+
+	ImageCache::ImageCache(size_t budget_bytes)
+		: _budget(budget_bytes)
+	{
+	}
+
+	std::shared_ptr<Image> ImageCache::load(const std::string& path, bool flip_vertically, bool high_precision)
+	{
+		std::error_code error;
+		PathStamp stamp;
+		stamp.size = std::filesystem::file_size(path, error);
+		if(!error) stamp.time = std::filesystem::last_write_time(path, error);
+		const bool stamped = !error;
+
+		if(stamped)
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			auto known = _paths.find(path);
+			if(known != _paths.end() && known->second.size == stamp.size && known->second.time == stamp.time)
+			{
+				auto entry = _entries.find(entryKey(known->second.content, flip_vertically, high_precision));
+				if(entry != _entries.end())
+				{
+					ImageFuture pending;
+					auto image = hit(entry->second, pending);
+					lock.unlock();
+					return image ? image : pending.get();
+				}
+			}
+		}
+
+		MappedFile file(path);
+		if(!file.isEnable()) return nullptr;
+		stamp.content = contentHash(file.data(), file.size());
+		const uint64_t key = entryKey(stamp.content, flip_vertically, high_precision);
+		auto image = acquire(key, file.data(), file.size(), flip_vertically, high_precision);
+		if(image && stamped)
+		{
+			// the entry can't be evicted while `image` references it
+			std::lock_guard<std::mutex> lock(_mutex);
+			Entry& entry = _entries.find(key)->second;
+			_paths[path]  = stamp;
+			entry.content = stamp.content;
+			if(std::find(entry.paths.begin(), entry.paths.end(), path) == entry.paths.end()) entry.paths.push_back(path);
+		}
+		return image;
+	}
+
+	std::shared_ptr<Image> ImageCache::loadFromMemory(const void* encoded, size_t size, bool flip_vertically, bool high_precision)
+	{
+		if(!encoded || size == 0) return nullptr;
+		return acquire(entryKey(contentHash(encoded, size), flip_vertically, high_precision), encoded, size, flip_vertically, high_precision);
+	}
+
+	std::shared_ptr<Image> ImageCache::acquire(
+		uint64_t key, const void* encoded, size_t size, bool flip_vertically, bool high_precision)
+	{
+		std::promise<std::shared_ptr<Image>> promise;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			auto found = _entries.find(key);
+			if(found != _entries.end())
+			{
+				ImageFuture pending;
+				auto image = hit(found->second, pending);
+				lock.unlock();
+				return image ? image : pending.get();
+			}
+
+			Entry& entry  = _entries[key];
+			entry.pending = promise.get_future().share();
+			entry.lru     = _lru.insert(_lru.end(), key);
+			_misses++;
+		}
+
+		// decode outside the lock, other keys keep loading meanwhile
+		std::shared_ptr<Image> image;
+		try
+		{
+			image = std::make_shared<Image>(Image::fromMemory(encoded, size, flip_vertically, high_precision));
+			if(!image->isEnable()) image.reset();
+		}
+		catch(...)
+		{
+			// out of memory is a failed decode too, the entry must not stay pending forever
+			image.reset();
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			auto found = _entries.find(key);
+			if(image)
+			{
+				Entry& entry  = found->second;
+				entry.image   = image;
+				entry.bytes   = imageBytes(*image);
+				entry.pending = {};
+				_bytes += entry.bytes;
+				evict(_budget);
+			}
+			else
+			{
+				// waiters get nullptr as well, the next load tries again
+				_lru.erase(found->second.lru);
+				_entries.erase(found);
+			}
+		}
+		promise.set_value(image);
+		return image;
+	}
+
+	std::shared_ptr<Image> ImageCache::hit(Entry& entry, ImageFuture& pending)
+	{
+		_hits++;
+		_lru.splice(_lru.end(), _lru, entry.lru);
+		if(!entry.image) pending = entry.pending;
+		return entry.image;
+	}
+
+	size_t ImageCache::evict(size_t target_bytes)
+	{
+		size_t released = 0;
+		for(auto it = _lru.begin(); it != _lru.end() && _bytes > target_bytes;)
+		{
+			auto found = _entries.find(*it);
+			Entry& entry = found->second;
+			// copies are only handed out under the lock, a count of one can't grow behind our back
+			if(!entry.image || entry.image.use_count() > 1)
+			{
+				++it;
+				continue;
+			}
+			_bytes   -= entry.bytes;
+			released += entry.bytes;
+			_evictions++;
+			// the next load of those paths reads the file again anyway, the stamps would only pile up
+			for(const auto& path : entry.paths)
+			{
+				auto stamp = _paths.find(path);
+				if(stamp != _paths.end() && stamp->second.content == entry.content) _paths.erase(stamp);
+			}
+			it = _lru.erase(it);
+			_entries.erase(found);
+		}
+		return released;
+	}
+
+	void ImageCache::setBudget(size_t budget_bytes)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_budget = budget_bytes;
+		evict(_budget);
+	}
+
+	size_t ImageCache::budget() const
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _budget;
+	}
+
+	size_t ImageCache::purge()
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		return evict(0);
+	}
+
+	ImageCacheStats ImageCache::stats() const
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		ImageCacheStats stats;
+		stats.hits      = _hits;
+		stats.misses    = _misses;
+		stats.evictions = _evictions;
+		stats.bytes     = _bytes;
+		stats.entries   = _entries.size();
+		stats.budget    = _budget;
+		return stats;
+	}
+
+	void ImageCache::resetStats()
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_hits      = 0;
+		_misses    = 0;
+		_evictions = 0;
+	}
+} // namespace lux::engine::platform
@@ -0,0 +1,143 @@
+#include "lux-engine/platform/media_loaders/ImageLoader.hpp"
+
+namespace lux::engine::platform
+{
+	void ImageHandle::cancel()
+	{
+		if(!_state) return;
+		_state->cancel_requested.store(true, std::memory_order_release);
+
+		// a pending request is finished right here, the worker skips it when it is popped
+		ImageLoadStatus expected = ImageLoadStatus::PENDING;
+		if(_state->status.compare_exchange_strong(expected, ImageLoadStatus::CANCELLED, std::memory_order_acq_rel))
+		{
+			_state->promise.set_value();
+		}
+	}
+
+	ImageLoader::ImageLoader(ImageCache* cache, IoQueue* queue)
+		: _cache(cache), _io(queue ? queue : &IoQueue::global())
+	{
+	}
+
+	ImageLoader::~ImageLoader()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			while(!_queue.empty())
+			{
+				ImageHandle(_queue.top().state).cancel();
+				_queue.pop();
+				// no task will see it, pendingCount() must not wait for it
+				_in_flight--;
+			}
+			if(_in_flight == 0) _idle.notify_all();
+		}
+		// the tasks of the dropped requests find the queue empty and return
+		_tasks.wait();
+	}
+
+	std::shared_ptr<ImageHandle::State> ImageLoader::enqueue(const ImageRequest& request)
+	{
+		auto state = std::make_shared<ImageHandle::State>();
+		state->path            = request.path;
+		state->flip_vertically = request.flip_vertically;
+		state->high_precision  = request.high_precision;
+		state->user_data       = request.user_data;
+		state->done            = state->promise.get_future().share();
+		_queue.push(QueueEntry{request.priority, _sequence++, state});
+		_in_flight++;
+		_io->submit([this]{ decodeNext(); }, &_tasks);
+		return state;
+	}
+
+	ImageHandle ImageLoader::load(const ImageRequest& request)
+	{
+		std::shared_ptr<ImageHandle::State> state;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			state = enqueue(request);
+		}
+		return ImageHandle(std::move(state));
+	}
+
+	ImageHandle ImageLoader::load(const std::string& path, bool flip_vertically, ImagePriority priority)
+	{
+		return load(ImageRequest{path, flip_vertically, priority});
+	}
+
+	std::vector<ImageHandle> ImageLoader::loadBatch(const std::vector<ImageRequest>& requests)
+	{
+		std::vector<ImageHandle> handles;
+		handles.reserve(requests.size());
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			for(auto& request : requests)
+			{
+				handles.push_back(ImageHandle(enqueue(request)));
+			}
+		}
+		return handles;
+	}
+
+	size_t ImageLoader::collect(std::vector<ImageHandle>& completed)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		const size_t count = _completed.size();
+		completed.insert(completed.end(),
+			std::make_move_iterator(_completed.begin()), std::make_move_iterator(_completed.end()));
+		_completed.clear();
+		return count;
+	}
+
+	void ImageLoader::waitIdle()
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_idle.wait(lock, [this]{ return _in_flight == 0; });
+	}
+
+	size_t ImageLoader::pendingCount() const
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _in_flight;
+	}
+
+	void ImageLoader::decodeNext()
+	{
+		std::shared_ptr<ImageHandle::State> state;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			if(_queue.empty()) return;
+			state = _queue.top().state;
+			_queue.pop();
+		}
+
+		ImageLoadStatus expected = ImageLoadStatus::PENDING;
+		const bool claimed = state->status.compare_exchange_strong(
+			expected, ImageLoadStatus::LOADING, std::memory_order_acq_rel);
+		if(claimed)
+		{
+			std::shared_ptr<Image> image = _cache
+				? _cache->load(state->path, state->flip_vertically, state->high_precision)
+				: std::make_shared<Image>(state->path, state->flip_vertically, state->high_precision);
+			if(state->cancel_requested.load(std::memory_order_acquire))
+			{
+				state->status.store(ImageLoadStatus::CANCELLED, std::memory_order_release);
+			}
+			else
+			{
+				const bool ok = image && image->isEnable();
+				state->image  = std::move(image);
+				state->status.store(ok ? ImageLoadStatus::READY : ImageLoadStatus::FAILED, std::memory_order_release);
+			}
+			state->promise.set_value();
+		}
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		if(claimed && state->status.load(std::memory_order_relaxed) != ImageLoadStatus::CANCELLED)
+		{
+			_completed.push_back(ImageHandle(state));
+		}
+		if(--_in_flight == 0) _idle.notify_all();
+	}
+} // namespace lux::engine::platform
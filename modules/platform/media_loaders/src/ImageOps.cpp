@@ -0,0 +1,607 @@
+#include "lux-engine/platform/media_loaders/ImageOps.hpp"
+#include <lux-engine/platform/cxx/Parallel.hpp>
+#include <lux-engine/platform/cxx/Simd.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace lux::engine::platform
+{
+	namespace
+	{
+		void swapRows(uint8_t* a, uint8_t* b, size_t bytes)
+		{
+			size_t i = 0;
+#if defined(LUX_SIMD_AVX2)
+			for(; i + 32 <= bytes; i += 32)
+			{
+				const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+				const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(a + i), vb);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(b + i), va);
+			}
+#endif
+#if defined(LUX_SIMD_SSE2)
+			for(; i + 16 <= bytes; i += 16)
+			{
+				const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+				const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(a + i), vb);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(b + i), va);
+			}
+#endif
+			for(; i < bytes; i++) std::swap(a[i], b[i]);
+		}
+
+		// texel kernels are memory bound as well, split in chunks of 256k texels
+		constexpr size_t kTexelGrain = size_t(1) << 18;
+
+		template<typename Func>
+		void forTexels(size_t count, Func&& func)
+		{
+			parallelFor(0, count, kTexelGrain, func);
+		}
+
+		inline uint8_t mulDiv255(uint32_t value, uint32_t alpha)
+		{
+			const uint32_t t = value * alpha + 128;
+			return static_cast<uint8_t>((t + (t >> 8)) >> 8);
+		}
+
+		void expandRgbToRgbaRange(const uint8_t* rgb, uint8_t* rgba, size_t count, uint8_t alpha)
+		{
+			size_t i = 0;
+#if defined(LUX_SIMD_SSE41)
+			// 16 texels: three 16 byte loads, four pshufb into rgb_ lanes, alpha or'ed in
+			const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+			const __m128i alpha_bits = _mm_set1_epi32(static_cast<int>(static_cast<uint32_t>(alpha) << 24));
+			for(; i + 16 <= count; i += 16)
+			{
+				const uint8_t* in = rgb + i * 3;
+				__m128i* out = reinterpret_cast<__m128i*>(rgba + i * 4);
+				const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+				const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 16));
+				const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 32));
+				_mm_storeu_si128(out + 0, _mm_or_si128(_mm_shuffle_epi8(a, shuffle), alpha_bits));
+				_mm_storeu_si128(out + 1, _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(b, a, 12), shuffle), alpha_bits));
+				_mm_storeu_si128(out + 2, _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(c, b, 8), shuffle), alpha_bits));
+				_mm_storeu_si128(out + 3, _mm_or_si128(_mm_shuffle_epi8(_mm_srli_si128(c, 4), shuffle), alpha_bits));
+			}
+#endif
+			for(; i < count; i++)
+			{
+				rgba[i * 4 + 0] = rgb[i * 3 + 0];
+				rgba[i * 4 + 1] = rgb[i * 3 + 1];
+				rgba[i * 4 + 2] = rgb[i * 3 + 2];
+				rgba[i * 4 + 3] = alpha;
+			}
+		}
+
+		void packRgbaToRgRange(const uint8_t* rgba, uint8_t* rg, size_t count)
+		{
+			size_t i = 0;
+#if defined(LUX_SIMD_SSE2)
+			// the low 16 bits of every texel are rg, sign extend them so the signed saturating pack keeps them intact
+			for(; i + 8 <= count; i += 8)
+			{
+				const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba + i * 4));
+				const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba + i * 4 + 16));
+				const __m128i low_a = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+				const __m128i low_b = _mm_srai_epi32(_mm_slli_epi32(b, 16), 16);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(rg + i * 2), _mm_packs_epi32(low_a, low_b));
+			}
+#endif
+			for(; i < count; i++)
+			{
+				rg[i * 2 + 0] = rgba[i * 4 + 0];
+				rg[i * 2 + 1] = rgba[i * 4 + 1];
+			}
+		}
+
+		void extractChannelRange(const uint8_t* source, uint32_t channels, uint32_t channel, uint8_t* target, size_t count)
+		{
+			size_t i = 0;
+#if defined(LUX_SIMD_SSE2)
+			if(channels == 4)
+			{
+				const __m128i mask = _mm_set1_epi32(0xFF);
+				const int shift = static_cast<int>(channel * 8);
+				for(; i + 16 <= count; i += 16)
+				{
+					const __m128i* in = reinterpret_cast<const __m128i*>(source + i * 4);
+					__m128i v[4];
+					for(int k = 0; k < 4; k++)
+					{
+						v[k] = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128(in + k), _mm_cvtsi32_si128(shift)), mask);
+					}
+					const __m128i low  = _mm_packs_epi32(v[0], v[1]);
+					const __m128i high = _mm_packs_epi32(v[2], v[3]);
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(target + i), _mm_packus_epi16(low, high));
+				}
+			}
+#endif
+			for(; i < count; i++) target[i] = source[i * channels + channel];
+		}
+
+		void swizzleRgbaToBgraRange(const uint8_t* source, uint8_t* target, size_t count)
+		{
+			size_t i = 0;
+#if defined(LUX_SIMD_SSE2)
+			// green and alpha stay, red and blue trade places with one rotate of each 32 bit texel
+			const __m128i ga_mask = _mm_set1_epi32(static_cast<int>(0xFF00FF00u));
+			const __m128i rb_mask = _mm_set1_epi32(0x00FF00FF);
+			for(; i + 4 <= count; i += 4)
+			{
+				const __m128i v  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4));
+				const __m128i rb = _mm_and_si128(v, rb_mask);
+				const __m128i br = _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(target + i * 4), _mm_or_si128(_mm_and_si128(v, ga_mask), br));
+			}
+#endif
+			for(; i < count; i++)
+			{
+				const uint8_t r = source[i * 4 + 0];
+				const uint8_t b = source[i * 4 + 2];
+				target[i * 4 + 0] = b;
+				target[i * 4 + 1] = source[i * 4 + 1];
+				target[i * 4 + 2] = r;
+				target[i * 4 + 3] = source[i * 4 + 3];
+			}
+		}
+
+		void premultiplyAlphaRange(uint8_t* pixels, size_t count, uint32_t channels)
+		{
+			size_t i = 0;
+#if defined(LUX_SIMD_SSE2)
+			if(channels == 4)
+			{
+				// widen to 16 bits, multiply by the broadcast alpha (255 in the alpha lane) and divide by 255 exactly
+				const __m128i zero       = _mm_setzero_si128();
+				const __m128i color_mask = _mm_setr_epi16(-1, -1, -1, 0, -1, -1, -1, 0);
+				const __m128i alpha_one  = _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255);
+				const __m128i rounding   = _mm_set1_epi16(128);
+				auto premultiply = [&](__m128i texels)
+				{
+					__m128i alpha = _mm_shufflelo_epi16(texels, _MM_SHUFFLE(3, 3, 3, 3));
+					alpha = _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+					alpha = _mm_or_si128(_mm_and_si128(alpha, color_mask), alpha_one);
+					const __m128i t = _mm_add_epi16(_mm_mullo_epi16(texels, alpha), rounding);
+					return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+				};
+				for(; i + 4 <= count; i += 4)
+				{
+					__m128i* texels = reinterpret_cast<__m128i*>(pixels + i * 4);
+					const __m128i v = _mm_loadu_si128(texels);
+					const __m128i low  = premultiply(_mm_unpacklo_epi8(v, zero));
+					const __m128i high = premultiply(_mm_unpackhi_epi8(v, zero));
+					_mm_storeu_si128(texels, _mm_packus_epi16(low, high));
+				}
+			}
+#endif
+			for(; i < count; i++)
+			{
+				uint8_t* texel = pixels + i * channels;
+				const uint32_t alpha = texel[channels - 1];
+				for(uint32_t c = 0; c + 1 < channels; c++) texel[c] = mulDiv255(texel[c], alpha);
+			}
+		}
+
+		void convertChannelsRange(const uint8_t* source, uint32_t from, uint8_t* target, uint32_t to, size_t count, bool gray_alpha)
+		{
+			const bool gray = from == 1 || (from == 2 && gray_alpha);
+			for(size_t i = 0; i < count; i++)
+			{
+				const uint8_t* in  = source + i * from;
+				uint8_t*       out = target + i * to;
+				for(uint32_t c = 0; c < to; c++)
+				{
+					if(gray && c < 3)                   out[c] = in[0];
+					else if(gray && c == 3)             out[c] = from == 2 ? in[1] : 255;
+					else if(c < from)                   out[c] = in[c];
+					else                                out[c] = c == 3 ? 255 : 0;
+				}
+			}
+		}
+	}
+
+	void flipVertically(void* pixels, size_t row_bytes, size_t rows)
+	{
+		uint8_t* base = static_cast<uint8_t*>(pixels);
+		const size_t pairs = rows / 2;
+		// memory bound, only split large images
+		const size_t grain = std::max<size_t>(1, (size_t(1) << 20) / std::max<size_t>(row_bytes, 1));
+		parallelFor(0, pairs, grain,
+			[&](size_t begin, size_t end)
+			{
+				for(size_t y = begin; y < end; y++)
+				{
+					swapRows(base + y * row_bytes, base + (rows - 1 - y) * row_bytes, row_bytes);
+				}
+			}
+		);
+	}
+	void expandRgbToRgba(const uint8_t* rgb, uint8_t* rgba, size_t count, uint8_t alpha)
+	{
+		forTexels(count, [&](size_t begin, size_t end) { expandRgbToRgbaRange(rgb + begin * 3, rgba + begin * 4, end - begin, alpha); });
+	}
+
+	void packRgbaToRg(const uint8_t* rgba, uint8_t* rg, size_t count)
+	{
+		forTexels(count, [&](size_t begin, size_t end) { packRgbaToRgRange(rgba + begin * 4, rg + begin * 2, end - begin); });
+	}
+
+	void extractChannel(const uint8_t* source, uint32_t channels, uint32_t channel, uint8_t* target, size_t count)
+	{
+		forTexels(count,
+			[&](size_t begin, size_t end)
+			{
+				extractChannelRange(source + begin * channels, channels, channel, target + begin, end - begin);
+			}
+		);
+	}
+
+	void swizzleRgbaToBgra(const uint8_t* source, uint8_t* target, size_t count)
+	{
+		forTexels(count, [&](size_t begin, size_t end) { swizzleRgbaToBgraRange(source + begin * 4, target + begin * 4, end - begin); });
+	}
+
+	void premultiplyAlpha(uint8_t* pixels, size_t count, uint32_t channels)
+	{
+		if(channels != 2 && channels != 4) return;
+		forTexels(count, [&](size_t begin, size_t end) { premultiplyAlphaRange(pixels + begin * channels, end - begin, channels); });
+	}
+
+	void convertChannels(const uint8_t* source, uint32_t from, uint8_t* target, uint32_t to, size_t count, bool gray_alpha)
+	{
+		if(from == to)                  std::memcpy(target, source, count * to);
+		else if(from == 3 && to == 4)   expandRgbToRgba(source, target, count);
+		else if(from == 4 && to == 2)   packRgbaToRg(source, target, count);
+		else if(from >= 3 && to == 1)   extractChannel(source, from, 0, target, count);
+		else
+		{
+			forTexels(count,
+				[&](size_t begin, size_t end)
+				{
+					convertChannelsRange(source + begin * from, from, target + begin * to, to, end - begin, gray_alpha);
+				}
+			);
+		}
+	}
+
+	ImageChannelUsage analyzeChannels(const uint8_t* pixels, size_t count, uint32_t channels)
+	{
+		const bool has_alpha = channels == 2 || channels == 4;
+		const bool has_color = channels >= 3;
+		bool opaque = true;
+		bool gray   = true;
+		const uint32_t alpha = channels - 1;
+		// checked per chunk, a colored or translucent image usually shows it in the first rows
+		constexpr size_t kChunk = 4096;
+		for(size_t begin = 0; begin < count && ((has_alpha && opaque) || (has_color && gray)); begin += kChunk)
+		{
+			const size_t end = std::min(count, begin + kChunk);
+			size_t i = begin;
+#if defined(LUX_SIMD_SSE2)
+			if(channels == 4)
+			{
+				const __m128i alpha_mask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+				const __m128i rg_gb_mask = _mm_set1_epi32(0xFFFF);
+				const __m128i zero       = _mm_setzero_si128();
+				__m128i alpha_ok = _mm_set1_epi32(-1);
+				__m128i gray_ok  = _mm_set1_epi32(-1);
+				for(; i + 4 <= end; i += 4)
+				{
+					const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i * 4));
+					alpha_ok = _mm_and_si128(alpha_ok, _mm_cmpeq_epi32(_mm_and_si128(v, alpha_mask), alpha_mask));
+					// bytes 0 and 1 of v ^ (v >> 8) are r ^ g and g ^ b
+					const __m128i diff = _mm_and_si128(_mm_xor_si128(v, _mm_srli_epi32(v, 8)), rg_gb_mask);
+					gray_ok = _mm_and_si128(gray_ok, _mm_cmpeq_epi32(diff, zero));
+				}
+				opaque = opaque && _mm_movemask_epi8(alpha_ok) == 0xFFFF;
+				gray   = gray && _mm_movemask_epi8(gray_ok) == 0xFFFF;
+			}
+#endif
+			for(; i < end; i++)
+			{
+				const uint8_t* texel = pixels + i * channels;
+				if(has_alpha) opaque = opaque && texel[alpha] == 255;
+				if(has_color) gray = gray && texel[0] == texel[1] && texel[1] == texel[2];
+			}
+		}
+		ImageChannelUsage usage;
+		usage.opaque    = opaque;
+		usage.grayscale = gray;
+		return usage;
+	}
+
+	namespace
+	{
+		inline uint32_t floatBits(float value)
+		{
+			uint32_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			return bits;
+		}
+
+		inline float bitsFloat(uint32_t bits)
+		{
+			float value;
+			std::memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+
+		// constants of the branch free float -> half conversion, shared by the scalar and the sse2 path
+		constexpr uint32_t kHalfOverflow     = (127 + 16) << 23;                   // 65536.0f, first value rounding to infinity
+		constexpr uint32_t kHalfMinNormal    = (127 - 14) << 23;                   // smallest normal half
+		constexpr uint32_t kHalfSubnormMagic = ((127 - 15) + (23 - 10) + 1) << 23; // 0.5f, aligns subnormals for the fpu to round
+		constexpr uint32_t kHalfNormalBias   = 0xfff - ((127 - 15) << 23);         // rebias the exponent, round half up
+
+		inline uint16_t floatToHalfScalar(float value)
+		{
+			uint32_t bits = floatBits(value);
+			const uint32_t sign = bits & 0x80000000u;
+			bits ^= sign;
+			uint32_t half;
+			if(bits >= kHalfOverflow)
+			{
+				half = bits > 0x7f800000u ? 0x7e00 : 0x7c00;
+			}
+			else if(bits < kHalfMinNormal)
+			{
+				half = floatBits(bitsFloat(bits) + bitsFloat(kHalfSubnormMagic)) - kHalfSubnormMagic;
+			}
+			else
+			{
+				// ties go to the even mantissa
+				half = (bits + kHalfNormalBias + ((bits >> 13) & 1)) >> 13;
+			}
+			return static_cast<uint16_t>(half | (sign >> 16));
+		}
+
+		inline float halfToFloatScalar(uint16_t half)
+		{
+			const uint32_t sign     = static_cast<uint32_t>(half & 0x8000) << 16;
+			const uint32_t exponent = (half >> 10) & 0x1f;
+			const uint32_t mantissa = half & 0x3ff;
+			if(exponent == 0x1f) return bitsFloat(sign | 0x7f800000u | (mantissa << 13));
+			if(exponent == 0)
+			{
+				// subnormal, mantissa * 2^-24
+				const float value = static_cast<float>(mantissa) * bitsFloat((127 - 24) << 23);
+				return bitsFloat(sign | floatBits(value));
+			}
+			return bitsFloat(sign | ((exponent + 127 - 15) << 23) | (mantissa << 13));
+		}
+
+		void floatToHalfRange(const float* source, uint16_t* target, size_t count)
+		{
+			size_t i = 0;
+#if defined(LUX_SIMD_F16C)
+			for(; i + 4 <= count; i += 4)
+			{
+				const __m128i half = _mm_cvtps_ph(_mm_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT);
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(target + i), half);
+			}
+#elif defined(LUX_SIMD_SSE2)
+			const __m128i sign_mask      = _mm_set1_epi32(static_cast<int>(0x80000000u));
+			const __m128i overflow       = _mm_set1_epi32(static_cast<int>(kHalfOverflow));
+			const __m128i infinity       = _mm_set1_epi32(0x7f800000);
+			const __m128i half_infinity  = _mm_set1_epi32(0x7c00);
+			const __m128i half_nan_bit   = _mm_set1_epi32(0x200);
+			const __m128i min_normal     = _mm_set1_epi32(static_cast<int>(kHalfMinNormal));
+			const __m128i subnorm_magic  = _mm_set1_epi32(static_cast<int>(kHalfSubnormMagic));
+			const __m128i normal_bias    = _mm_set1_epi32(static_cast<int>(kHalfNormalBias));
+			for(; i + 4 <= count; i += 4)
+			{
+				const __m128i value = _mm_castps_si128(_mm_loadu_ps(source + i));
+				const __m128i sign  = _mm_and_si128(value, sign_mask);
+				const __m128i bits  = _mm_xor_si128(value, sign);
+
+				const __m128i is_regular   = _mm_cmpgt_epi32(overflow, bits);
+				const __m128i is_subnormal = _mm_cmpgt_epi32(min_normal, bits);
+				const __m128i is_nan       = _mm_cmpgt_epi32(bits, infinity);
+				const __m128i special      = _mm_or_si128(half_infinity, _mm_and_si128(is_nan, half_nan_bit));
+
+				const __m128  subnormal_sum = _mm_add_ps(_mm_castsi128_ps(bits), _mm_castsi128_ps(subnorm_magic));
+				const __m128i subnormal     = _mm_sub_epi32(_mm_castps_si128(subnormal_sum), subnorm_magic);
+				const __m128i odd           = _mm_and_si128(_mm_srli_epi32(bits, 13), _mm_set1_epi32(1));
+				const __m128i normal        = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(bits, normal_bias), odd), 13);
+
+				__m128i half = _mm_or_si128(_mm_and_si128(is_subnormal, subnormal), _mm_andnot_si128(is_subnormal, normal));
+				half = _mm_or_si128(_mm_and_si128(is_regular, half), _mm_andnot_si128(is_regular, special));
+				half = _mm_or_si128(half, _mm_srli_epi32(sign, 16));
+				// sign extend the low 16 bits so the signed saturating pack keeps them intact
+				half = _mm_srai_epi32(_mm_slli_epi32(half, 16), 16);
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(target + i), _mm_packs_epi32(half, half));
+			}
+#endif
+			for(; i < count; i++) target[i] = floatToHalfScalar(source[i]);
+		}
+
+		void halfToFloatRange(const uint16_t* source, float* target, size_t count)
+		{
+			size_t i = 0;
+#if defined(LUX_SIMD_F16C)
+			for(; i + 4 <= count; i += 4)
+			{
+				const __m128i half = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(source + i));
+				_mm_storeu_ps(target + i, _mm_cvtph_ps(half));
+			}
+#endif
+			for(; i < count; i++) target[i] = halfToFloatScalar(source[i]);
+		}
+
+		// EXT_texture_shared_exponent: 9 bit mantissas, 5 bit exponent biased by 15
+		constexpr float kRgb9e5Max = 65408.0f; // (2^9 - 1) / 2^9 * 2^16
+
+		inline float clampRgb9e5(float value)
+		{
+			// written so NaN fails the comparison and becomes 0, like maxps
+			return std::min(value > 0.0f ? value : 0.0f, kRgb9e5Max);
+		}
+
+		inline uint32_t encodeRgb9e5Scalar(float r, float g, float b)
+		{
+			r = clampRgb9e5(r);
+			g = clampRgb9e5(g);
+			b = clampRgb9e5(b);
+			const float max_value = std::max(r, std::max(g, b));
+			// floor(log2(max)) straight from the exponent bits, at least -16
+			const int32_t  exponent = std::max<int32_t>(static_cast<int32_t>((floatBits(max_value) >> 23) & 0xff) - 127, -16) + 16;
+			// scale = 2^(24 - exponent), maps the largest channel into [256, 512]
+			float scale = bitsFloat(static_cast<uint32_t>(24 - exponent + 127) << 23);
+			uint32_t shared = static_cast<uint32_t>(exponent);
+			if(static_cast<int32_t>(max_value * scale + 0.5f) == 512)
+			{
+				scale *= 0.5f;
+				shared++;
+			}
+			const uint32_t rm = static_cast<uint32_t>(static_cast<int32_t>(r * scale + 0.5f));
+			const uint32_t gm = static_cast<uint32_t>(static_cast<int32_t>(g * scale + 0.5f));
+			const uint32_t bm = static_cast<uint32_t>(static_cast<int32_t>(b * scale + 0.5f));
+			return rm | (gm << 9) | (bm << 18) | (shared << 27);
+		}
+
+		void encodeRgb9e5Range(const float* source, uint32_t channels, uint32_t* target, size_t count)
+		{
+			size_t i = 0;
+#if defined(LUX_SIMD_SSE2)
+			if(channels >= 3)
+			{
+				const __m128 zero       = _mm_setzero_ps();
+				const __m128 max_value  = _mm_set1_ps(kRgb9e5Max);
+				const __m128 half       = _mm_set1_ps(0.5f);
+				const __m128i min_exp   = _mm_set1_epi32(127 - 16);
+				const __m128i exp_bias  = _mm_set1_epi32(127 + 24 + 127 - 16);
+				const __m128i overflow  = _mm_set1_epi32(512);
+				const __m128i one       = _mm_set1_epi32(1);
+				for(; i + 4 <= count; i += 4)
+				{
+					const float* in = source + i * channels;
+					__m128 r, g, b;
+					if(channels == 4)
+					{
+						__m128 t0 = _mm_loadu_ps(in), t1 = _mm_loadu_ps(in + 4), t2 = _mm_loadu_ps(in + 8), t3 = _mm_loadu_ps(in + 12);
+						_MM_TRANSPOSE4_PS(t0, t1, t2, t3);
+						r = t0;
+						g = t1;
+						b = t2;
+					}
+					else
+					{
+						r = _mm_setr_ps(in[0], in[3], in[6], in[9]);
+						g = _mm_setr_ps(in[1], in[4], in[7], in[10]);
+						b = _mm_setr_ps(in[2], in[5], in[8], in[11]);
+					}
+					r = _mm_min_ps(_mm_max_ps(r, zero), max_value);
+					g = _mm_min_ps(_mm_max_ps(g, zero), max_value);
+					b = _mm_min_ps(_mm_max_ps(b, zero), max_value);
+					const __m128 max_channel = _mm_max_ps(r, _mm_max_ps(g, b));
+
+					// biased float exponent clamped to 2^-16, no sse2 max for 32 bit integers
+					__m128i exponent = _mm_srli_epi32(_mm_castps_si128(max_channel), 23);
+					const __m128i small = _mm_cmpgt_epi32(min_exp, exponent);
+					exponent = _mm_or_si128(_mm_and_si128(small, min_exp), _mm_andnot_si128(small, exponent));
+					// shared = exponent - 127 + 16, scale = 2^(24 - shared) whose biased exponent is exp_bias - exponent
+					__m128i shared = _mm_sub_epi32(exponent, _mm_set1_epi32(127 - 16));
+					__m128  scale  = _mm_castsi128_ps(_mm_slli_epi32(_mm_sub_epi32(exp_bias, exponent), 23));
+					__m128  scale_half = _mm_castsi128_ps(_mm_slli_epi32(_mm_sub_epi32(_mm_sub_epi32(exp_bias, exponent), one), 23));
+
+					const __m128i max_mantissa = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(max_channel, scale), half));
+					const __m128i bump = _mm_cmpeq_epi32(max_mantissa, overflow);
+					shared = _mm_sub_epi32(shared, bump);
+					scale  = _mm_or_ps(_mm_and_ps(_mm_castsi128_ps(bump), scale_half), _mm_andnot_ps(_mm_castsi128_ps(bump), scale));
+
+					const __m128i rm = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(r, scale), half));
+					const __m128i gm = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(g, scale), half));
+					const __m128i bm = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(b, scale), half));
+					__m128i packed = _mm_or_si128(rm, _mm_slli_epi32(gm, 9));
+					packed = _mm_or_si128(packed, _mm_slli_epi32(bm, 18));
+					packed = _mm_or_si128(packed, _mm_slli_epi32(shared, 27));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(target + i), packed);
+				}
+			}
+#endif
+			for(; i < count; i++)
+			{
+				const float* texel = source + i * channels;
+				target[i] = channels >= 3
+					? encodeRgb9e5Scalar(texel[0], texel[1], texel[2])
+					: encodeRgb9e5Scalar(texel[0], texel[0], texel[0]);
+			}
+		}
+	}
+
+	void floatToHalf(const float* source, uint16_t* target, size_t count)
+	{
+		forTexels(count, [&](size_t begin, size_t end) { floatToHalfRange(source + begin, target + begin, end - begin); });
+	}
+
+	void halfToFloat(const uint16_t* source, float* target, size_t count)
+	{
+		forTexels(count, [&](size_t begin, size_t end) { halfToFloatRange(source + begin, target + begin, end - begin); });
+	}
+
+	void encodeRgb9e5(const float* source, uint32_t channels, uint32_t* target, size_t count)
+	{
+		if(channels == 0 || channels > 4) return;
+		forTexels(count,
+			[&](size_t begin, size_t end) { encodeRgb9e5Range(source + begin * channels, channels, target + begin, end - begin); });
+	}
+
+	void decodeRgb9e5(const uint32_t* source, float* rgb, size_t count)
+	{
+		forTexels(count, [&](size_t begin, size_t end)
+		{
+			for(size_t i = begin; i < end; i++)
+			{
+				const uint32_t packed = source[i];
+				// 2^(exponent - 15 - 9)
+				const float scale = bitsFloat(((packed >> 27) + 127 - 24) << 23);
+				rgb[i * 3 + 0] = static_cast<float>(packed & 0x1ff) * scale;
+				rgb[i * 3 + 1] = static_cast<float>((packed >> 9) & 0x1ff) * scale;
+				rgb[i * 3 + 2] = static_cast<float>((packed >> 18) & 0x1ff) * scale;
+			}
+		});
+	}
+
+	void rgbaToYuv420(const uint8_t* rgba, uint32_t width, uint32_t height, uint8_t* y, uint8_t* u, uint8_t* v)
+	{
+		const uint32_t chroma_width  = (width + 1) / 2;
+		const uint32_t chroma_height = (height + 1) / 2;
+		// chroma rows, each one covers two luma rows
+		const size_t grain = std::max<size_t>(1, kTexelGrain / std::max<size_t>(size_t(width) * 2, 1));
+		parallelFor(0, chroma_height, grain,
+			[&](size_t begin, size_t end)
+			{
+				for(size_t cy = begin; cy < end; cy++)
+				{
+					const size_t row0 = cy * 2;
+					const size_t row1 = std::min<size_t>(row0 + 1, height - 1);
+					const uint8_t* in0 = rgba + row0 * width * 4;
+					const uint8_t* in1 = rgba + row1 * width * 4;
+					uint8_t* y0 = y + row0 * width;
+					uint8_t* y1 = y + row1 * width;
+					// 8 bit fixed point BT.601: 219 / 255 luma and 224 / 255 chroma excursion
+					for(uint32_t x = 0; x < width; x++)
+					{
+						const uint8_t* a = in0 + x * 4;
+						const uint8_t* b = in1 + x * 4;
+						y0[x] = static_cast<uint8_t>(((66 * a[0] + 129 * a[1] + 25 * a[2] + 128) >> 8) + 16);
+						y1[x] = static_cast<uint8_t>(((66 * b[0] + 129 * b[1] + 25 * b[2] + 128) >> 8) + 16);
+					}
+					for(uint32_t cx = 0; cx < chroma_width; cx++)
+					{
+						const size_t x0 = size_t(cx) * 8;
+						const size_t x1 = std::min<size_t>(cx * 2 + 1, width - 1) * 4;
+						// sums of four texels, the shift by 10 folds in the average
+						const int r = in0[x0 + 0] + in0[x1 + 0] + in1[x0 + 0] + in1[x1 + 0];
+						const int g = in0[x0 + 1] + in0[x1 + 1] + in1[x0 + 1] + in1[x1 + 1];
+						const int b = in0[x0 + 2] + in0[x1 + 2] + in1[x0 + 2] + in1[x1 + 2];
+						u[cy * chroma_width + cx] = static_cast<uint8_t>(((-38 * r - 74 * g + 112 * b + 512) >> 10) + 128);
+						v[cy * chroma_width + cx] = static_cast<uint8_t>(((112 * r - 94 * g - 18 * b + 512) >> 10) + 128);
+					}
+				}
+			}
+		);
+	}
+} // namespace lux::engine::platform
@@ -0,0 +1,110 @@
+#include "lux-engine/platform/media_loaders/ImageResize.hpp"
+#include "Resample.hpp"
+#include <lux-engine/platform/cxx/Parallel.hpp>
+#include <cstring>
+
+namespace lux::engine::platform
+{
+	namespace
+	{
+		const ResampleKernel& resizeKernel(ResizeFilter filter)
+		{
+			switch(filter)
+			{
+				case ResizeFilter::BOX:         return kBoxKernel;
+				case ResizeFilter::BILINEAR:    return kTriangleKernel;
+				case ResizeFilter::MITCHELL:    return kMitchellKernel;
+				case ResizeFilter::LANCZOS3:    return kLanczos3Kernel;
+			}
+			return kLanczos3Kernel;
+		}
+
+		void premultiplyRow(float* rgba, int width, int alpha)
+		{
+			for(int x = 0; x < width; x++, rgba += 4)
+			{
+				for(int c = 0; c < alpha; c++) rgba[c] *= rgba[alpha];
+			}
+		}
+
+		// negative lobes can push alpha out of range, divide by the clamped value like the encoder will store it
+		void unpremultiplyRow(float* rgba, int width, int alpha)
+		{
+			for(int x = 0; x < width; x++, rgba += 4)
+			{
+				const float a = std::clamp(rgba[alpha], 0.0f, 1.0f);
+				const float inverse = a > 0.0f ? 1.0f / a : 0.0f;
+				for(int c = 0; c < alpha; c++) rgba[c] *= inverse;
+			}
+		}
+	}
+
+	bool resizeImage(
+		const uint8_t* pixels, int width, int height, int channels,
+		int target_width, int target_height, const ResizeSettings& settings, std::vector<uint8_t>& target)
+	{
+		if(pixels == nullptr || width <= 0 || height <= 0 || channels < 1 || channels > 4
+			|| target_width <= 0 || target_height <= 0)
+		{
+			return false;
+		}
+
+		target.resize(size_t(target_width) * target_height * channels);
+		if(width == target_width && height == target_height)
+		{
+			std::memcpy(target.data(), pixels, target.size());
+			return true;
+		}
+
+		const ResampleKernel&   kernel     = resizeKernel(settings.filter);
+		const ResampleWeights   horizontal = computeResampleWeights(width, target_width, kernel, settings.wrap);
+		const ResampleWeights   vertical   = computeResampleWeights(height, target_height, kernel, settings.wrap);
+		const int               alpha      = settings.alpha_weighted ? resampleAlphaChannel(channels) : -1;
+		const size_t            source_row = size_t(width) * channels;
+		const size_t            float_row  = size_t(target_width) * 4;
+
+		// horizontal first: every source row is decoded exactly once and only a target_width wide float
+		// copy of the image is kept, never the full size one
+		std::vector<float> intermediate(float_row * height);
+		parallelFor(0, height, resampleRowGrain(width),
+			[&](size_t begin, size_t end)
+			{
+				std::vector<float> row(size_t(width) * 4);
+				for(size_t y = begin; y < end; y++)
+				{
+					decodeRowRgbaF32(pixels + y * source_row, width, channels, settings.srgb, row.data());
+					if(alpha >= 0) premultiplyRow(row.data(), width, alpha);
+					resampleHorizontalRow(row.data(), &intermediate[y * float_row], target_width, horizontal);
+				}
+			}
+		);
+
+		parallelFor(0, target_height, resampleRowGrain(target_width),
+			[&](size_t begin, size_t end)
+			{
+				std::vector<const float*> rows(vertical.taps);
+				std::vector<float> row(float_row);
+				for(size_t y = begin; y < end; y++)
+				{
+					const int32_t* indices = &vertical.indices[y * vertical.taps];
+					for(int k = 0; k < vertical.taps; k++)
+					{
+						rows[k] = &intermediate[size_t(indices[k]) * float_row];
+					}
+					resampleVerticalRow(rows.data(), &vertical.weights[y * vertical.taps], vertical.taps, row.data(), float_row);
+					if(alpha >= 0) unpremultiplyRow(row.data(), target_width, alpha);
+					encodeRowRgbaF32(row.data(), target_width, channels, settings.srgb, 1.0f,
+						&target[y * size_t(target_width) * channels]);
+				}
+			}
+		);
+		return true;
+	}
+
+	bool resizeImage(Image& image, int target_width, int target_height, const ResizeSettings& settings, std::vector<uint8_t>& target)
+	{
+		if(!image.isEnable() || image.format() != PixelFormat::UINT8) return false;
+		return resizeImage(static_cast<const uint8_t*>(image.data()), image.width(), image.height(), image.channel(),
+			target_width, target_height, settings, target);
+	}
+} // namespace lux::engine::platform
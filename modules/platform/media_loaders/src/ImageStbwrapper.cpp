@@ -1,13 +1,51 @@
 #include "lux-engine/platform/media_loaders/Image.hpp"
+#include "lux-engine/platform/media_loaders/ImageOps.hpp"
+#include <lux-engine/platform/cxx/MappedFile.hpp>
+#include <climits>
+// decoding only goes through stbi_load_from_memory, the stdio path is never used
+#define STBI_NO_STDIO
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 
 namespace lux::engine::platform
 {
-	Image::Image(std::string path, bool flip_vertically)
+	Image::Image() = default;
+
+	Image::Image(std::string path, bool flip_vertically, bool high_precision)
+	{
+		MappedFile file(path);
+		if(file.isEnable())
+		{
+			load(file.data(), file.size(), flip_vertically, high_precision);
+		}
+	}
+
+	Image Image::fromMemory(const void* encoded, size_t size, bool flip_vertically, bool high_precision)
+	{
+		Image image;
+		image.load(static_cast<const uint8_t*>(encoded), size, flip_vertically, high_precision);
+		return image;
+	}
+
+	Image::Image(Image&& other) noexcept
+		: _data(other._data), _width(other._width), _height(other._height), _channel(other._channel), _format(other._format)
+	{
+		other._data = nullptr;
+	}
+
+	Image& Image::operator=(Image&& other) noexcept
 	{
-		stbi_set_flip_vertically_on_load(flip_vertically);
-		load(path.c_str());
+		if(this != &other)
+		{
+			stbi_image_free(_data);
+			_data		= other._data;
+			_width		= other._width;
+			_height		= other._height;
+			_channel	= other._channel;
+			_format		= other._format;
+			other._data = nullptr;
+		}
+		return *this;
 	}
 
 	Image::~Image()
@@ -15,9 +53,29 @@ namespace lux::engine::platform
 		stbi_image_free(_data);
 	}
 
-	void Image::load(const char *path)
+	void Image::load(const uint8_t* encoded, size_t size, bool flip_vertically, bool high_precision)
 	{
-		_data = stbi_load(path, &_width, &_height, &_channel, 0);
+		if(encoded == nullptr || size == 0 || size > INT_MAX) return;
+		const int length = static_cast<int>(size);
+		if(high_precision && stbi_is_hdr_from_memory(encoded, length))
+		{
+			_format = PixelFormat::FLOAT32;
+			_data   = stbi_loadf_from_memory(encoded, length, &_width, &_height, &_channel, 0);
+		}
+		else if(high_precision && stbi_is_16_bit_from_memory(encoded, length))
+		{
+			_format = PixelFormat::UINT16;
+			_data   = stbi_load_16_from_memory(encoded, length, &_width, &_height, &_channel, 0);
+		}
+		else
+		{
+			_format = PixelFormat::UINT8;
+			_data   = stbi_load_from_memory(encoded, length, &_width, &_height, &_channel, 0);
+		}
+		if(_data && flip_vertically)
+		{
+			flipVertically(_data, size_t(_width) * texelSize(), _height);
+		}
 	}
 
 	bool Image::isEnable()
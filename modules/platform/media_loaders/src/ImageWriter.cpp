@@ -0,0 +1,285 @@
+#include "lux-engine/platform/media_loaders/ImageWriter.hpp"
+#include "lux-engine/platform/media_loaders/ImageOps.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+// encoding only goes through stbi_write_png_to_func, files are written by the caller
+#define STBI_WRITE_NO_STDIO
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+namespace lux::engine::platform
+{
+	namespace
+	{
+		void appendBigEndian(std::vector<uint8_t>& out, uint32_t value)
+		{
+			out.push_back(static_cast<uint8_t>(value >> 24));
+			out.push_back(static_cast<uint8_t>(value >> 16));
+			out.push_back(static_cast<uint8_t>(value >> 8));
+			out.push_back(static_cast<uint8_t>(value));
+		}
+
+		bool encodePng(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels, std::vector<uint8_t>& encoded)
+		{
+			if(channels == 0 || channels > 4 || size_t(width) * channels > INT_MAX || height > INT_MAX) return false;
+			auto append = [](void* context, void* data, int size)
+			{
+				auto* out = static_cast<std::vector<uint8_t>*>(context);
+				out->insert(out->end(), static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+			};
+			return stbi_write_png_to_func(append, &encoded, static_cast<int>(width), static_cast<int>(height),
+				static_cast<int>(channels), pixels, static_cast<int>(width * channels)) != 0;
+		}
+
+		// https://qoiformat.org/qoi-specification.pdf
+		bool encodeQoi(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels, std::vector<uint8_t>& encoded)
+		{
+			constexpr uint8_t kOpIndex = 0x00, kOpDiff = 0x40, kOpLuma = 0x80, kOpRun = 0xc0, kOpRgb = 0xfe, kOpRgba = 0xff;
+			if((channels != 3 && channels != 4) || width == 0 || height == 0) return false;
+
+			const size_t count = size_t(width) * height;
+			// worst case is one rgba op per texel
+			encoded.reserve(14 + count * (channels + 1) + 8);
+			encoded.insert(encoded.end(), {'q', 'o', 'i', 'f'});
+			appendBigEndian(encoded, width);
+			appendBigEndian(encoded, height);
+			encoded.push_back(static_cast<uint8_t>(channels));
+			encoded.push_back(0);   // sRGB with linear alpha
+
+			uint8_t  index[64][4]{};
+			uint8_t  previous[4]{0, 0, 0, 255};
+			uint32_t run = 0;
+			for(size_t i = 0; i < count; i++)
+			{
+				const uint8_t* in = pixels + i * channels;
+				const uint8_t  texel[4]{in[0], in[1], in[2], channels == 4 ? in[3] : previous[3]};
+				if(std::memcmp(texel, previous, 4) == 0)
+				{
+					run++;
+					if(run == 62 || i + 1 == count)
+					{
+						encoded.push_back(static_cast<uint8_t>(kOpRun | (run - 1)));
+						run = 0;
+					}
+					continue;
+				}
+				if(run > 0)
+				{
+					encoded.push_back(static_cast<uint8_t>(kOpRun | (run - 1)));
+					run = 0;
+				}
+
+				const uint32_t slot = (texel[0] * 3u + texel[1] * 5u + texel[2] * 7u + texel[3] * 11u) % 64;
+				if(std::memcmp(index[slot], texel, 4) == 0)
+				{
+					encoded.push_back(static_cast<uint8_t>(kOpIndex | slot));
+				}
+				else
+				{
+					std::memcpy(index[slot], texel, 4);
+					if(texel[3] == previous[3])
+					{
+						// wrapping differences
+						const int dr = static_cast<int8_t>(texel[0] - previous[0]);
+						const int dg = static_cast<int8_t>(texel[1] - previous[1]);
+						const int db = static_cast<int8_t>(texel[2] - previous[2]);
+						const int dr_dg = dr - dg, db_dg = db - dg;
+						if(dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1)
+						{
+							encoded.push_back(static_cast<uint8_t>(kOpDiff | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+						}
+						else if(dg >= -32 && dg <= 31 && dr_dg >= -8 && dr_dg <= 7 && db_dg >= -8 && db_dg <= 7)
+						{
+							encoded.push_back(static_cast<uint8_t>(kOpLuma | (dg + 32)));
+							encoded.push_back(static_cast<uint8_t>((dr_dg + 8) << 4 | (db_dg + 8)));
+						}
+						else
+						{
+							encoded.insert(encoded.end(), {kOpRgb, texel[0], texel[1], texel[2]});
+						}
+					}
+					else
+					{
+						encoded.insert(encoded.end(), {kOpRgba, texel[0], texel[1], texel[2], texel[3]});
+					}
+				}
+				std::memcpy(previous, texel, 4);
+			}
+			encoded.insert(encoded.end(), {0, 0, 0, 0, 0, 0, 0, 1});
+			return true;
+		}
+	}
+
+	bool encodeImage(
+		ImageFileFormat format, const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels,
+		std::vector<uint8_t>& encoded)
+	{
+		encoded.clear();
+		if(pixels == nullptr) return false;
+		switch(format)
+		{
+			case ImageFileFormat::PNG: return encodePng(pixels, width, height, channels, encoded);
+			case ImageFileFormat::QOI: return encodeQoi(pixels, width, height, channels, encoded);
+		}
+		return false;
+	}
+
+	bool writeImage(
+		const std::string& path, ImageFileFormat format, const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels)
+	{
+		std::vector<uint8_t> encoded;
+		if(!encodeImage(format, pixels, width, height, channels, encoded)) return false;
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+		return static_cast<bool>(file);
+	}
+
+	ImageWriter::ImageWriter(size_t max_queued, IoQueue* queue)
+		: _max_queued(std::max<size_t>(max_queued, 1)), _io(queue ? queue : &IoQueue::global())
+	{
+	}
+
+	ImageWriter::~ImageWriter()
+	{
+		// screenshots are not thrown away, the queue is drained before the writer goes
+		waitIdle();
+		_tasks.wait();
+	}
+
+	void ImageWriter::submit(ImageWriteRequest request)
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_space.wait(lock, [this]{ return _queue.size() < _max_queued; });
+		_queue.push_back(std::move(request));
+		_in_flight++;
+		_io->submit([this]{ writeNext(); }, &_tasks);
+	}
+
+	void ImageWriter::waitIdle()
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_idle.wait(lock, [this]{ return _in_flight == 0; });
+	}
+
+	size_t ImageWriter::pendingCount() const
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _in_flight;
+	}
+
+	size_t ImageWriter::failedCount() const
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _failed;
+	}
+
+	void ImageWriter::writeNext()
+	{
+		ImageWriteRequest request;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			request = std::move(_queue.front());
+			_queue.pop_front();
+		}
+		_space.notify_one();
+
+		bool written = request.pixels.size() >= size_t(request.width) * request.height * request.channels;
+		if(written && request.flip_vertically)
+		{
+			flipVertically(request.pixels.data(), size_t(request.width) * request.channels, request.height);
+		}
+		std::vector<uint8_t> encoded;
+		written = written && encodeImage(request.format, request.pixels.data(), request.width, request.height, request.channels, encoded);
+		if(written)
+		{
+			std::ofstream file(request.path, std::ios::binary | std::ios::trunc);
+			file.write(reinterpret_cast<const char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+			written = static_cast<bool>(file);
+		}
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		if(!written) _failed++;
+		if(--_in_flight == 0) _idle.notify_all();
+	}
+
+	Y4mWriter::Y4mWriter(const std::string& path, uint32_t width, uint32_t height, const Y4mSettings& settings)
+		: _file(path, std::ios::binary | std::ios::trunc), _width(width), _height(height),
+		  _max_queued(std::max<size_t>(settings.max_queued, 1))
+	{
+		if(!_file || width == 0 || height == 0) return;
+		_file << "YUV4MPEG2 W" << width << " H" << height
+			<< " F" << settings.fps_numerator << ':' << std::max<uint32_t>(settings.fps_denominator, 1)
+			<< " Ip A1:1 C420jpeg XYSCSS=420JPEG\n";
+		if(!_file) return;
+		_enable = true;
+		_writer = std::thread([this]{ writerLoop(); });
+	}
+
+	Y4mWriter::~Y4mWriter()
+	{
+		if(!_writer.joinable()) return;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stop = true;
+		}
+		_wake.notify_all();
+		_writer.join();
+	}
+
+	bool Y4mWriter::pushFrame(std::vector<uint8_t> rgba, bool flip_vertically)
+	{
+		if(!_enable || rgba.size() < size_t(_width) * _height * 4) return false;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_space.wait(lock, [this]{ return _queue.size() < _max_queued; });
+			_queue.push_back(Frame{std::move(rgba), flip_vertically});
+		}
+		_wake.notify_one();
+		return true;
+	}
+
+	void Y4mWriter::waitIdle()
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_idle.wait(lock, [this]{ return _queue.empty() && !_busy; });
+	}
+
+	uint64_t Y4mWriter::frameCount() const
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _written;
+	}
+
+	void Y4mWriter::writerLoop()
+	{
+		const size_t luma_size   = size_t(_width) * _height;
+		const size_t chroma_size = size_t((_width + 1) / 2) * ((_height + 1) / 2);
+		std::vector<uint8_t> planes(luma_size + chroma_size * 2);
+		while(true)
+		{
+			Frame frame;
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_wake.wait(lock, [this]{ return _stop || !_queue.empty(); });
+				// queued frames are still written on shutdown
+				if(_queue.empty()) return;
+				frame = std::move(_queue.front());
+				_queue.pop_front();
+				_busy = true;
+			}
+			_space.notify_one();
+
+			if(frame.flip_vertically) flipVertically(frame.rgba.data(), size_t(_width) * 4, _height);
+			rgbaToYuv420(frame.rgba.data(), _width, _height,
+				planes.data(), planes.data() + luma_size, planes.data() + luma_size + chroma_size);
+			_file << "FRAME\n";
+			_file.write(reinterpret_cast<const char*>(planes.data()), static_cast<std::streamsize>(planes.size()));
+
+			std::lock_guard<std::mutex> lock(_mutex);
+			_written++;
+			_busy = false;
+			if(_queue.empty()) _idle.notify_all();
+		}
+	}
+} // namespace lux::engine::platform
@@ -0,0 +1,124 @@
+#include "lux-engine/platform/media_loaders/MipGenerator.hpp"
+#include "Resample.hpp"
+#include <lux-engine/platform/cxx/Parallel.hpp>
+#include <algorithm>
+#include <atomic>
+
+namespace lux::engine::platform
+{
+	namespace
+	{
+		constexpr size_t kRowsPerTask = 64;
+
+		void decodeLevel(const uint8_t* pixels, int width, int height, int channels, bool srgb, std::vector<float>& rgba)
+		{
+			rgba.resize(size_t(width) * height * 4);
+			parallelFor(0, height, kRowsPerTask,
+				[&](size_t begin, size_t end)
+				{
+					for(size_t y = begin; y < end; y++)
+					{
+						decodeRowRgbaF32(pixels + y * width * channels, width, channels, srgb, &rgba[y * width * 4]);
+					}
+				}
+			);
+		}
+
+		void encodeLevel(const std::vector<float>& rgba, int width, int height, int channels, bool srgb,
+			float alpha_scale, std::vector<uint8_t>& pixels)
+		{
+			pixels.resize(size_t(width) * height * channels);
+			parallelFor(0, height, kRowsPerTask,
+				[&](size_t begin, size_t end)
+				{
+					for(size_t y = begin; y < end; y++)
+					{
+						encodeRowRgbaF32(&rgba[y * width * 4], width, channels, srgb, alpha_scale, &pixels[y * width * channels]);
+					}
+				}
+			);
+		}
+
+		float alphaCoverage(const std::vector<float>& rgba, int alpha, float cutoff, float scale)
+		{
+			const size_t texels = rgba.size() / 4;
+			std::atomic<size_t> covered{0};
+			parallelFor(0, texels, 64 * 1024,
+				[&](size_t begin, size_t end)
+				{
+					size_t count = 0;
+					for(size_t i = begin; i < end; i++) count += rgba[i * 4 + alpha] * scale >= cutoff;
+					covered += count;
+				}
+			);
+			return float(covered.load()) / float(std::max<size_t>(texels, 1));
+		}
+
+		// scale alpha so the level covers the same fraction as level 0, coverage grows with the scale
+		float fitAlphaScale(const std::vector<float>& rgba, int alpha, float cutoff, float target_coverage)
+		{
+			float low = 0.0f, high = 4.0f, best = 1.0f, best_error = 1.0f;
+			for(int step = 0; step < 12; step++)
+			{
+				const float mid   = 0.5f * (low + high);
+				const float error = alphaCoverage(rgba, alpha, cutoff, mid) - target_coverage;
+				if(std::fabs(error) < best_error)
+				{
+					best_error = std::fabs(error);
+					best       = mid;
+				}
+				if(error < 0) low = mid;
+				else          high = mid;
+			}
+			return best;
+		}
+	}
+
+	void generateMips(const uint8_t* pixels, int width, int height, int channels, const MipSettings& settings, MipChain& chain)
+	{
+		chain.channels = channels;
+		chain.levels.clear();
+		if(pixels == nullptr || width <= 0 || height <= 0 || channels < 1 || channels > 4) return;
+
+		chain.levels.push_back(MipLevel{width, height,
+			std::vector<uint8_t>(pixels, pixels + size_t(width) * height * channels)});
+
+		const int  alpha    = resampleAlphaChannel(channels);
+		const bool coverage = settings.alpha_cutoff > 0.0f && alpha >= 0;
+		const ResampleKernel& kernel = settings.filter == MipFilter::BOX ? kBoxKernel : kKaiserKernel;
+
+		std::vector<float> current, next;
+		decodeLevel(pixels, width, height, channels, settings.srgb, current);
+		const float target_coverage = coverage ? alphaCoverage(current, alpha, settings.alpha_cutoff, 1.0f) : 0.0f;
+
+		while((width > 1 || height > 1) && (settings.max_levels == 0 || chain.levels.size() < settings.max_levels))
+		{
+			const int next_width  = std::max(width / 2, 1);
+			const int next_height = std::max(height / 2, 1);
+			next.resize(size_t(next_width) * next_height * 4);
+			resampleRgbaF32(current.data(), width, height, next.data(), next_width, next_height,
+				computeResampleWeights(width, next_width, kernel, settings.wrap),
+				computeResampleWeights(height, next_height, kernel, settings.wrap));
+
+			// levels are filtered from the unscaled alpha, the coverage fix is only baked into the output
+			const float alpha_scale = coverage ? fitAlphaScale(next, alpha, settings.alpha_cutoff, target_coverage) : 1.0f;
+			MipLevel level{next_width, next_height, {}};
+			encodeLevel(next, next_width, next_height, channels, settings.srgb, alpha_scale, level.pixels);
+			chain.levels.push_back(std::move(level));
+
+			std::swap(current, next);
+			width  = next_width;
+			height = next_height;
+		}
+	}
+
+	void generateMips(Image& image, const MipSettings& settings, MipChain& chain)
+	{
+		if(!image.isEnable() || image.format() != PixelFormat::UINT8)
+		{
+			chain.levels.clear();
+			return;
+		}
+		generateMips(static_cast<const uint8_t*>(image.data()), image.width(), image.height(), image.channel(), settings, chain);
+	}
+} // namespace lux::engine::platform
@@ -0,0 +1,231 @@
+#include "Resample.hpp"
+#include "SrgbTables.hpp"
+#include <lux-engine/platform/cxx/Parallel.hpp>
+#include <lux-engine/platform/cxx/Simd.hpp>
+#include <algorithm>
+
+namespace lux::engine::platform
+{
+	size_t resampleRowGrain(int width)
+	{
+		return std::max<size_t>(1, (size_t(1) << 16) / std::max(width, 1));
+	}
+
+	void resampleHorizontalRow(const float* source, float* target, int target_width, const ResampleWeights& weights)
+	{
+		const int taps = weights.taps;
+		for(int x = 0; x < target_width; x++)
+		{
+			const int32_t* indices = &weights.indices[size_t(x) * taps];
+			const float*   w       = &weights.weights[size_t(x) * taps];
+#if defined(LUX_SIMD_SSE2)
+			__m128 sum = _mm_setzero_ps();
+			for(int k = 0; k < taps; k++)
+			{
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(source + size_t(indices[k]) * 4), _mm_set1_ps(w[k])));
+			}
+			_mm_storeu_ps(target + size_t(x) * 4, sum);
+#else
+			float sum[4]{0, 0, 0, 0};
+			for(int k = 0; k < taps; k++)
+			{
+				const float* pixel = source + size_t(indices[k]) * 4;
+				for(int c = 0; c < 4; c++) sum[c] += pixel[c] * w[k];
+			}
+			for(int c = 0; c < 4; c++) target[size_t(x) * 4 + c] = sum[c];
+#endif
+		}
+	}
+
+	// rows are contiguous so this is a plain multiply-add stream
+	void resampleVerticalRow(const float* const* rows, const float* w, int taps, float* target, size_t count)
+	{
+		size_t i = 0;
+#if defined(LUX_SIMD_AVX2)
+		for(; i + 8 <= count; i += 8)
+		{
+			__m256 sum = _mm256_setzero_ps();
+			for(int k = 0; k < taps; k++)
+			{
+				sum = _mm256_fmadd_ps(_mm256_loadu_ps(rows[k] + i), _mm256_set1_ps(w[k]), sum);
+			}
+			_mm256_storeu_ps(target + i, sum);
+		}
+#endif
+#if defined(LUX_SIMD_SSE2)
+		for(; i + 4 <= count; i += 4)
+		{
+			__m128 sum = _mm_setzero_ps();
+			for(int k = 0; k < taps; k++)
+			{
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(rows[k] + i), _mm_set1_ps(w[k])));
+			}
+			_mm_storeu_ps(target + i, sum);
+		}
+#endif
+		for(; i < count; i++)
+		{
+			float sum = 0.0f;
+			for(int k = 0; k < taps; k++) sum += rows[k][i] * w[k];
+			target[i] = sum;
+		}
+	}
+
+	void decodeRowRgbaF32(const uint8_t* source, int width, int channels, bool srgb, float* target)
+	{
+		int x = 0;
+#if defined(LUX_SIMD_SSE2)
+		if(channels == 4 && !srgb)
+		{
+			const __m128i zero  = _mm_setzero_si128();
+			const __m128  scale = _mm_set1_ps(1.0f / 255.0f);
+			for(; x + 4 <= width; x += 4)
+			{
+				const __m128i v    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + size_t(x) * 4));
+				const __m128i low  = _mm_unpacklo_epi8(v, zero);
+				const __m128i high = _mm_unpackhi_epi8(v, zero);
+				float* out = target + size_t(x) * 4;
+				_mm_storeu_ps(out + 0,  _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero)), scale));
+				_mm_storeu_ps(out + 4,  _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero)), scale));
+				_mm_storeu_ps(out + 8,  _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero)), scale));
+				_mm_storeu_ps(out + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero)), scale));
+			}
+		}
+#endif
+		const float* to_linear = srgbToLinearTable();
+		const int    alpha     = resampleAlphaChannel(channels);
+		for(; x < width; x++)
+		{
+			const uint8_t* in  = source + size_t(x) * channels;
+			float*         out = target + size_t(x) * 4;
+			out[0] = out[1] = out[2] = 0.0f;
+			out[3] = 1.0f;
+			for(int c = 0; c < channels; c++)
+			{
+				const bool linear = !srgb || c == alpha;
+				out[c] = linear ? in[c] / 255.0f : to_linear[in[c]];
+			}
+		}
+	}
+
+	void encodeRowRgbaF32(const float* source, int width, int channels, bool srgb, float alpha_scale, uint8_t* target)
+	{
+		int x = 0;
+#if defined(LUX_SIMD_SSE2)
+		if(channels == 4 && !srgb)
+		{
+			// clamp, * 255 + 0.5 and truncate, rounds like linearToUnorm8
+			const __m128 scale = _mm_setr_ps(1.0f, 1.0f, 1.0f, alpha_scale);
+			const __m128 zero  = _mm_setzero_ps();
+			const __m128 one   = _mm_set1_ps(1.0f);
+			auto quantize = [&](const float* in)
+			{
+				const __m128 clamped = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(in), scale), zero), one);
+				return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(clamped, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f)));
+			};
+			for(; x + 4 <= width; x += 4)
+			{
+				const float* in = source + size_t(x) * 4;
+				const __m128i low  = _mm_packs_epi32(quantize(in), quantize(in + 4));
+				const __m128i high = _mm_packs_epi32(quantize(in + 8), quantize(in + 12));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(target + size_t(x) * 4), _mm_packus_epi16(low, high));
+			}
+		}
+#endif
+		const int alpha = resampleAlphaChannel(channels);
+		for(; x < width; x++)
+		{
+			const float* in  = source + size_t(x) * 4;
+			uint8_t*     out = target + size_t(x) * channels;
+			for(int c = 0; c < channels; c++)
+			{
+				if(c == alpha)       out[c] = linearToUnorm8(in[c] * alpha_scale);
+				else if(srgb)        out[c] = linearToSrgb8(in[c]);
+				else                 out[c] = linearToUnorm8(in[c]);
+			}
+		}
+	}
+
+	ResampleWeights computeResampleWeights(int source_size, int target_size, const ResampleKernel& kernel, bool wrap)
+	{
+		ResampleWeights result;
+		const float scale        = float(target_size) / float(source_size);
+		const float filter_scale = std::max(1.0f / scale, 1.0f);    // widen the kernel when minifying
+		const float support      = kernel.support * filter_scale;
+		result.taps = std::max(1, static_cast<int>(std::ceil(support * 2.0f)) + 1);
+		result.indices.assign(size_t(target_size) * result.taps, 0);
+		result.weights.assign(size_t(target_size) * result.taps, 0.0f);
+
+		for(int x = 0; x < target_size; x++)
+		{
+			const float center = (x + 0.5f) / scale - 0.5f;
+			const int   first  = static_cast<int>(std::ceil(center - support));
+			int32_t* indices = &result.indices[size_t(x) * result.taps];
+			float*   weights = &result.weights[size_t(x) * result.taps];
+
+			float total = 0.0f;
+			for(int k = 0; k < result.taps; k++)
+			{
+				const int i = first + k;
+				int index = i;
+				if(wrap)
+				{
+					index = ((i % source_size) + source_size) % source_size;
+				}
+				else
+				{
+					index = std::clamp(i, 0, source_size - 1);
+				}
+				indices[k] = index;
+				weights[k] = kernel.function((i - center) / filter_scale);
+				total     += weights[k];
+			}
+
+			if(std::fabs(total) < 1e-8f)
+			{
+				// kernel missed every sample (tiny support), fall back to the nearest pixel
+				std::fill(weights, weights + result.taps, 0.0f);
+				weights[0]  = 1.0f;
+				indices[0]  = std::clamp(static_cast<int>(std::lround(center)), 0, source_size - 1);
+				continue;
+			}
+			for(int k = 0; k < result.taps; k++) weights[k] /= total;
+		}
+		return result;
+	}
+
+	void resampleRgbaF32(
+		const float* source, int source_width, int source_height,
+		float* target, int target_width, int target_height,
+		const ResampleWeights& horizontal, const ResampleWeights& vertical)
+	{
+		const size_t target_row = size_t(target_width) * 4;
+		std::vector<float> intermediate(target_row * source_height);
+
+		parallelFor(0, source_height, resampleRowGrain(target_width),
+			[&](size_t begin, size_t end)
+			{
+				for(size_t y = begin; y < end; y++)
+				{
+					resampleHorizontalRow(source + y * size_t(source_width) * 4, &intermediate[y * target_row], target_width, horizontal);
+				}
+			}
+		);
+
+		parallelFor(0, target_height, resampleRowGrain(target_width),
+			[&](size_t begin, size_t end)
+			{
+				std::vector<const float*> rows(vertical.taps);
+				for(size_t y = begin; y < end; y++)
+				{
+					const int32_t* indices = &vertical.indices[y * vertical.taps];
+					for(int k = 0; k < vertical.taps; k++)
+					{
+						rows[k] = &intermediate[size_t(indices[k]) * target_row];
+					}
+					resampleVerticalRow(rows.data(), &vertical.weights[y * vertical.taps], vertical.taps, target + y * target_row, target_row);
+				}
+			}
+		);
+	}
+} // namespace lux::engine::platform
@@ -0,0 +1,130 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace lux::engine::platform
+{
+    // filter kernels in source pixel units, all normalized after sampling
+    struct ResampleKernel
+    {
+        float (*function)(float);
+        float support;
+    };
+
+    inline float boxKernel(float x)
+    {
+        return x >= -0.5f && x < 0.5f ? 1.0f : 0.0f;
+    }
+
+    inline float triangleKernel(float x)
+    {
+        x = std::fabs(x);
+        return x < 1.0f ? 1.0f - x : 0.0f;
+    }
+
+    inline float sinc(float x)
+    {
+        if(std::fabs(x) < 1e-6f) return 1.0f;
+        const float px = 3.14159265358979f * x;
+        return std::sin(px) / px;
+    }
+
+    // zeroth order modified bessel function of the first kind
+    inline float besselI0(float x)
+    {
+        float sum = 1.0f, term = 1.0f;
+        const float half_squared = x * x * 0.25f;
+        for(int k = 1; k < 32 && term > sum * 1e-8f; k++)
+        {
+            term *= half_squared / float(k * k);
+            sum  += term;
+        }
+        return sum;
+    }
+
+    // kaiser windowed sinc, width 3 and alpha 4 like nvtt's mipmap filter
+    inline float kaiserKernel(float x)
+    {
+        constexpr float kWidth = 3.0f, kAlpha = 4.0f;
+        const float t = x / kWidth;
+        if(std::fabs(t) >= 1.0f) return 0.0f;
+        return sinc(x) * besselI0(kAlpha * std::sqrt(1.0f - t * t)) / besselI0(kAlpha);
+    }
+
+    inline float lanczos3Kernel(float x)
+    {
+        return std::fabs(x) < 3.0f ? sinc(x) * sinc(x / 3.0f) : 0.0f;
+    }
+
+    // mitchell-netravali, B = C = 1/3
+    inline float mitchellKernel(float x)
+    {
+        constexpr float B = 1.0f / 3.0f, C = 1.0f / 3.0f;
+        x = std::fabs(x);
+        if(x < 1.0f)
+        {
+            return ((12 - 9 * B - 6 * C) * x * x * x + (-18 + 12 * B + 6 * C) * x * x + (6 - 2 * B)) / 6.0f;
+        }
+        if(x < 2.0f)
+        {
+            return ((-B - 6 * C) * x * x * x + (6 * B + 30 * C) * x * x + (-12 * B - 48 * C) * x + (8 * B + 24 * C)) / 6.0f;
+        }
+        return 0.0f;
+    }
+
+    constexpr ResampleKernel kBoxKernel{boxKernel, 0.5f};
+    constexpr ResampleKernel kTriangleKernel{triangleKernel, 1.0f};
+    constexpr ResampleKernel kKaiserKernel{kaiserKernel, 3.0f};
+    constexpr ResampleKernel kLanczos3Kernel{lanczos3Kernel, 3.0f};
+    constexpr ResampleKernel kMitchellKernel{mitchellKernel, 2.0f};
+
+    // precomputed taps of one axis, `taps` source indices and weights per destination pixel
+    struct ResampleWeights
+    {
+        int                     taps{0};
+        std::vector<int32_t>    indices;
+        std::vector<float>      weights;
+    };
+
+    /**
+     * @brief sample `kernel` for every destination pixel, widened by the scale factor when minifying.
+     *        out of range taps are clamped to the edge or wrapped around
+     */
+    ResampleWeights computeResampleWeights(int source_size, int target_size, const ResampleKernel& kernel, bool wrap);
+
+    // alpha slot of an 8 bit pixel with `channels` channels, -1 without alpha
+    inline int resampleAlphaChannel(int channels)
+    {
+        return channels == 2 ? 1 : channels == 4 ? 3 : -1;
+    }
+
+    // rows per task, keeps tasks around a few hundred kilobytes of floats
+    size_t resampleRowGrain(int width);
+
+    // one row of 4 float channel pixels through the horizontal taps
+    void resampleHorizontalRow(const float* source, float* target, int target_width, const ResampleWeights& weights);
+
+    // target = sum(w[k] * rows[k]) over `count` floats
+    void resampleVerticalRow(const float* const* rows, const float* w, int taps, float* target, size_t count);
+
+    /**
+     * @brief 8 bit row (1 - 4 channels, 2 is gray + alpha) to 4 float channels, missing color is 0 and
+     *        missing alpha 1. with `srgb` the color channels are decoded to linear, alpha never is
+     */
+    void decodeRowRgbaF32(const uint8_t* source, int width, int channels, bool srgb, float* target);
+
+    // the inverse of decodeRowRgbaF32, clamped and rounded, alpha multiplied by `alpha_scale`
+    void encodeRowRgbaF32(const float* source, int width, int channels, bool srgb, float alpha_scale, uint8_t* target);
+
+    /**
+     * @brief separable resampling of 4 float channel pixels, horizontal pass then vertical pass,
+     *        each split into row ranges across threads
+     */
+    void resampleRgbaF32(
+        const float* source, int source_width, int source_height,
+        float* target, int target_width, int target_height,
+        const ResampleWeights& horizontal, const ResampleWeights& vertical
+    );
+} // namespace lux::engine::platform
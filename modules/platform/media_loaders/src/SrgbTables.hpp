@@ -0,0 +1,51 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace lux::engine::platform
+{
+    // 8 bit sRGB -> linear float
+    inline const float* srgbToLinearTable()
+    {
+        static const auto table = []
+        {
+            static float values[256];
+            for(int i = 0; i < 256; i++)
+            {
+                const float c = i / 255.0f;
+                values[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+            }
+            return values;
+        }();
+        return table;
+    }
+
+    // linear float quantized to 16 bits -> 8 bit sRGB, fine enough that dark values round like the exact curve
+    inline const uint8_t* linearToSrgbTable()
+    {
+        static const auto table = []
+        {
+            static uint8_t values[65536];
+            for(int i = 0; i < 65536; i++)
+            {
+                const float l = i / 65535.0f;
+                const float c = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+                values[i] = static_cast<uint8_t>(std::clamp(c * 255.0f + 0.5f, 0.0f, 255.0f));
+            }
+            return values;
+        }();
+        return table;
+    }
+
+    inline uint8_t linearToSrgb8(float value)
+    {
+        const float clamped = std::clamp(value, 0.0f, 1.0f);
+        return linearToSrgbTable()[static_cast<uint32_t>(clamped * 65535.0f + 0.5f)];
+    }
+
+    inline uint8_t linearToUnorm8(float value)
+    {
+        return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+} // namespace lux::engine::platform
@@ -0,0 +1,214 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <lux-engine/platform/cxx/IoQueue.hpp>
+#include <lux-engine/platform/cxx/MappedFile.hpp>
+#include <lux-engine/platform/cxx/visibility_control.h>
+#include <lux-engine/resource/texture/VirtualTexture.hpp>
+
+namespace lux::engine::resource
+{
+    /**
+     * @brief decode one utf-8 code point and advance `it`, malformed bytes come back as U+FFFD one byte at a time
+     */
+    inline uint32_t decodeUtf8(const char*& it, const char* end)
+    {
+        const uint8_t lead = static_cast<uint8_t>(*it++);
+        if(lead < 0x80) return lead;
+        // continuation bytes and 0xF8 - 0xFF never start a sequence
+        const int      length = lead >= 0xF8 ? -1 : lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : lead >= 0xC0 ? 1 : -1;
+        if(length < 0 || end - it < length) return 0xFFFD;
+        uint32_t codepoint = lead & (0x3F >> length);
+        for(int i = 0; i < length; i++)
+        {
+            const uint8_t next = static_cast<uint8_t>(it[i]);
+            if((next & 0xC0) != 0x80) return 0xFFFD;
+            codepoint = (codepoint << 6) | (next & 0x3F);
+        }
+        // overlong forms, utf-16 surrogates and values past the last plane
+        constexpr uint32_t kMinimum[] = {0, 0x80, 0x800, 0x10000};
+        if(codepoint < kMinimum[length] || (codepoint >= 0xD800 && codepoint <= 0xDFFF) || codepoint > 0x10FFFF) return 0xFFFD;
+        it += length;
+        return codepoint;
+    }
+
+    struct FontAtlasSettings
+    {
+        // pixels per em the distance fields are rasterized at, text of any size is drawn from them
+        uint32_t    glyph_size{48};
+        // distance range on each side of the outline, in pixels of the distance field
+        uint32_t    spread{6};
+        uint32_t    page_size{1024};
+        // glyphs beyond pages * cells per page evict the least recently used ones
+        uint32_t    max_pages{4};
+        // nullptr rasterizes on platform::IoQueue::global(), must outlive the atlas
+        platform::IoQueue*  io_queue{nullptr};
+    };
+
+    // font wide metrics in em, the y axis points up from the baseline
+    struct FontMetrics
+    {
+        float ascender{0.0f};
+        float descender{0.0f};      // negative
+        float line_height{0.0f};
+    };
+
+    enum class GlyphState : uint8_t
+    {
+        PENDING,    // metrics are valid, the distance field is being rasterized
+        READY,
+        EMPTY,      // nothing to draw (space, missing outline), only advances the pen
+        EVICTED     // lost its cell, asked for again on the next use
+    };
+
+    struct Glyph
+    {
+        GlyphState  state{GlyphState::PENDING};
+        uint32_t    page{0};
+        float       advance{0.0f};      // em
+        // quad around the pen position in em: left, bottom, right, top, the spread included
+        float       plane[4]{};
+        // texture coordinates of the quad on its page: left, bottom, right, top, v grows downwards
+        float       uv[4]{};
+    };
+
+    // one r8 page of distance fields
+    struct FontPage
+    {
+        uint32_t                size{0};
+        std::vector<uint8_t>    pixels;     // rows top to bottom
+
+        // changed texels since clearDirty(), x0 >= x1 when clean
+        uint32_t                dirty_x0{0}, dirty_y0{0}, dirty_x1{0}, dirty_y1{0};
+
+        bool isDirty() const { return dirty_x0 < dirty_x1 && dirty_y0 < dirty_y1; }
+    };
+
+    /**
+     * @brief signed distance field glyph atlas shared by every font.
+     *        glyph() answers with metrics right away, the distance field is rasterized by FreeType on the io
+     *        threads and lands on a page with the next update(). every glyph takes one fixed size cell, cells
+     *        are recycled least recently used first but never while the glyph was used in the current frame.
+     *        the distance fields are independent of the drawn size, text scales without rasterizing again
+     */
+    class FontAtlas
+    {
+    public:
+        static constexpr uint32_t kInvalidFont = 0xFFFFFFFF;
+
+        LUX_EXPORT explicit FontAtlas(const FontAtlasSettings& settings = {});
+
+        LUX_EXPORT ~FontAtlas();
+
+        FontAtlas(const FontAtlas&) = delete;
+
+        FontAtlas& operator=(const FontAtlas&) = delete;
+
+        // a ttf/otf file, kInvalidFont when FreeType can't open it or it has no outlines
+        LUX_EXPORT uint32_t addFont(const std::string& path);
+
+        const FontMetrics& metrics(uint32_t font) const { return _fonts[font].metrics; }
+
+        /**
+         * @brief look up a glyph and mark it used this frame, asks for its distance field on first use.
+         *        the reference stays valid for the lifetime of the atlas
+         */
+        LUX_EXPORT const Glyph& glyph(uint32_t font, uint32_t codepoint);
+
+        // horizontal kerning between two code points in em
+        LUX_EXPORT float kerning(uint32_t font, uint32_t left, uint32_t right) const;
+
+        // starts a frame for the eviction order, glyphs used in the frame keep their cells
+        LUX_EXPORT void beginFrame();
+
+        /**
+         * @brief place the distance fields the io tasks finished on the pages
+         *
+         * @return size_t glyphs that became ready
+         */
+        LUX_EXPORT size_t update();
+
+        size_t pageCount() const { return _pages.size(); }
+
+        const FontPage& page(size_t index) const { return _pages[index]; }
+
+        LUX_EXPORT void clearDirty();
+
+        LUX_EXPORT size_t pendingCount() const;
+
+        const FontAtlasSettings& settings() const { return _settings; }
+
+        uint32_t cellSize() const { return _cell_size; }
+
+    private:
+        struct Font
+        {
+            std::shared_ptr<platform::MappedFile>   file;
+            void*                                   face{nullptr};      // FT_Face of the owning thread
+            FontMetrics                             metrics;
+        };
+
+        struct Job
+        {
+            uint32_t                                key;
+            uint32_t                                glyph_index;
+            std::shared_ptr<platform::MappedFile>   file;
+        };
+
+        struct Raster
+        {
+            uint32_t                key;
+            uint32_t                pixel_size{0};      // what the field was rasterized at
+            int32_t                 left{0};            // bitmap origin relative to the pen, pixels
+            int32_t                 top{0};
+            uint32_t                width{0};
+            uint32_t                height{0};
+            std::vector<uint8_t>    pixels;
+        };
+
+        struct GlyphRecord
+        {
+            Glyph       glyph;
+            uint32_t    glyph_index{0};
+        };
+
+        static uint32_t glyphKey(uint32_t font, uint32_t codepoint) { return (font << 21) | (codepoint & 0x1FFFFF); }
+
+        void request(uint32_t key, GlyphRecord& record);
+
+        bool place(Raster& raster);
+
+        // FreeType library and faces of one io task
+        struct Rasterizer;
+
+        // one io task per requested glyph, requests are taken in order
+        void rasterizeNext();
+
+        FontAtlasSettings                           _settings;
+        uint32_t                                    _cell_size{0};
+        uint32_t                                    _cells_per_row{0};
+        void*                                       _library{nullptr};  // FT_Library of the owning thread
+        std::vector<Font>                           _fonts;
+        std::deque<GlyphRecord>                     _glyphs;            // stable addresses
+        std::unordered_map<uint32_t, uint32_t>      _lookup;            // glyph key -> _glyphs index
+        VirtualTileCache                            _cells;             // cell slots keyed by glyph key
+        std::vector<FontPage>                       _pages;
+        std::vector<Raster>                         _deferred;          // finished while every cell was in use
+
+        // shared with the io tasks
+        platform::IoQueue*                          _io;
+        platform::IoCounter                         _tasks;
+        mutable std::mutex                          _mutex;
+        std::deque<Job>                             _queue;
+        std::vector<Raster>                         _completed;
+        std::vector<std::unique_ptr<Rasterizer>>    _rasterizers;       // idle ones, a running task holds its own
+        size_t                                      _pending{0};
+    };
+} // namespace lux::engine::resource
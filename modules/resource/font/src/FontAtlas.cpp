@@ -0,0 +1,327 @@
+#include "lux-engine/resource/font/FontAtlas.hpp"
+#include <algorithm>
+#include <cstring>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_MODULE_H
+#include FT_OUTLINE_H
+
+namespace lux::engine::resource
+{
+    namespace
+    {
+        inline FT_Face asFace(void* face) { return static_cast<FT_Face>(face); }
+
+        inline FT_Library asLibrary(void* library) { return static_cast<FT_Library>(library); }
+
+        inline uint32_t alignUp4(uint32_t value) { return (value + 3) & ~3u; }
+    }
+
+    // FreeType objects are not shared between threads, a running task works with a library and faces of its own
+    struct FontAtlas::Rasterizer
+    {
+        explicit Rasterizer(uint32_t spread)
+        {
+            if(FT_Init_FreeType(&library) != 0) return;
+            FT_Int value = static_cast<FT_Int>(spread);
+            FT_Property_Set(library, "sdf", "spread", &value);
+        }
+
+        ~Rasterizer()
+        {
+            for(auto& [file, face] : faces)
+            {
+                if(face) FT_Done_Face(face);
+            }
+            if(library) FT_Done_FreeType(library);
+        }
+
+        FT_Library                                                  library{nullptr};
+        std::unordered_map<const platform::MappedFile*, FT_Face>   faces;
+    };
+
+    FontAtlas::FontAtlas(const FontAtlasSettings& settings)
+        : _settings(settings), _io(settings.io_queue ? settings.io_queue : &platform::IoQueue::global())
+    {
+        // FreeType takes spreads of 2 - 32 pixels
+        _settings.spread     = std::clamp<uint32_t>(_settings.spread, 2, 32);
+        _settings.glyph_size = std::max<uint32_t>(_settings.glyph_size, 8);
+        _settings.max_pages  = std::max<uint32_t>(_settings.max_pages, 1);
+        // the sdf bitmap is the outline box plus the spread on both sides and one texel of rounding
+        _cell_size     = alignUp4(_settings.glyph_size + 2 * _settings.spread + 2);
+        _settings.page_size = std::max(_settings.page_size, _cell_size);
+        _cells_per_row = _settings.page_size / _cell_size;
+        // slots are handed out in index order while free, so pages fill one after another
+        _cells = VirtualTileCache(_cells_per_row, _cells_per_row * _settings.max_pages);
+
+        FT_Library library = nullptr;
+        if(FT_Init_FreeType(&library) == 0) _library = library;
+    }
+
+    FontAtlas::~FontAtlas()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _queue.clear();
+        }
+        // the tasks of the dropped glyphs find the queue empty and return
+        _tasks.wait();
+        // their faces read from the mapped fonts, they go first
+        _rasterizers.clear();
+
+        for(auto& font : _fonts) FT_Done_Face(asFace(font.face));
+        if(_library) FT_Done_FreeType(asLibrary(_library));
+    }
+
+    uint32_t FontAtlas::addFont(const std::string& path)
+    {
+        // the code point takes the low 21 bits of a glyph key, kNoVirtualTile must stay out of reach
+        if(!_library || _fonts.size() >= 2047) return kInvalidFont;
+        auto file = std::make_shared<platform::MappedFile>(path);
+        if(!file->isEnable()) return kInvalidFont;
+
+        FT_Face face = nullptr;
+        if(FT_New_Memory_Face(asLibrary(_library), file->data(), static_cast<FT_Long>(file->size()), 0, &face) != 0) return kInvalidFont;
+        if(!FT_IS_SCALABLE(face))
+        {
+            FT_Done_Face(face);
+            return kInvalidFont;
+        }
+
+        Font font;
+        font.file = std::move(file);
+        font.face = face;
+        const float units = static_cast<float>(face->units_per_EM);
+        font.metrics.ascender    = static_cast<float>(face->ascender) / units;
+        font.metrics.descender   = static_cast<float>(face->descender) / units;
+        font.metrics.line_height = static_cast<float>(face->height) / units;
+        _fonts.push_back(std::move(font));
+        return static_cast<uint32_t>(_fonts.size() - 1);
+    }
+
+    const Glyph& FontAtlas::glyph(uint32_t font, uint32_t codepoint)
+    {
+        static const Glyph kEmpty{GlyphState::EMPTY};
+        if(font >= _fonts.size()) return kEmpty;
+
+        const uint32_t key = glyphKey(font, codepoint);
+        const auto found = _lookup.find(key);
+        if(found != _lookup.end())
+        {
+            GlyphRecord& record = _glyphs[found->second];
+            if(record.glyph.state == GlyphState::READY)        _cells.touch(key);
+            else if(record.glyph.state == GlyphState::EVICTED) request(key, record);
+            return record.glyph;
+        }
+
+        _lookup[key] = static_cast<uint32_t>(_glyphs.size());
+        GlyphRecord& record = _glyphs.emplace_back();
+        // unscaled outline metrics are cheap, the layout never waits for the distance field
+        FT_Face face = asFace(_fonts[font].face);
+        record.glyph_index = FT_Get_Char_Index(face, codepoint);
+        if(FT_Load_Glyph(face, record.glyph_index, FT_LOAD_NO_SCALE) != 0)
+        {
+            record.glyph.state = GlyphState::EMPTY;
+            return record.glyph;
+        }
+        record.glyph.advance = static_cast<float>(face->glyph->advance.x) / static_cast<float>(face->units_per_EM);
+        if(face->glyph->format != FT_GLYPH_FORMAT_OUTLINE || face->glyph->outline.n_points == 0)
+        {
+            record.glyph.state = GlyphState::EMPTY;
+            return record.glyph;
+        }
+        request(key, record);
+        return record.glyph;
+    }
+
+    float FontAtlas::kerning(uint32_t font, uint32_t left, uint32_t right) const
+    {
+        if(font >= _fonts.size()) return 0.0f;
+        FT_Face face = asFace(_fonts[font].face);
+        if(!FT_HAS_KERNING(face)) return 0.0f;
+        FT_Vector delta{0, 0};
+        FT_Get_Kerning(face, FT_Get_Char_Index(face, left), FT_Get_Char_Index(face, right), FT_KERNING_UNSCALED, &delta);
+        return static_cast<float>(delta.x) / static_cast<float>(face->units_per_EM);
+    }
+
+    void FontAtlas::request(uint32_t key, GlyphRecord& record)
+    {
+        record.glyph.state = GlyphState::PENDING;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _queue.push_back(Job{key, record.glyph_index, _fonts[key >> 21].file});
+            _pending++;
+        }
+        _io->submit([this]{ rasterizeNext(); }, &_tasks);
+    }
+
+    void FontAtlas::beginFrame()
+    {
+        _cells.beginFrame();
+    }
+
+    size_t FontAtlas::update()
+    {
+        std::vector<Raster> finished;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            finished.swap(_completed);
+        }
+        // older leftovers first
+        finished.insert(finished.begin(), std::make_move_iterator(_deferred.begin()), std::make_move_iterator(_deferred.end()));
+        _deferred.clear();
+
+        size_t ready = 0;
+        for(auto& raster : finished)
+        {
+            if(!place(raster))
+            {
+                _deferred.push_back(std::move(raster));
+                continue;
+            }
+            ready++;
+        }
+        return ready;
+    }
+
+    bool FontAtlas::place(Raster& raster)
+    {
+        GlyphRecord& record = _glyphs[_lookup[raster.key]];
+        if(raster.width == 0 || raster.height == 0)
+        {
+            record.glyph.state = GlyphState::EMPTY;
+            return true;
+        }
+
+        uint32_t evicted;
+        const uint32_t slot = _cells.allocate(raster.key, evicted);
+        if(slot == VirtualTileCache::kNoSlot) return false;
+        if(evicted != kNoVirtualTile) _glyphs[_lookup[evicted]].glyph.state = GlyphState::EVICTED;
+
+        const uint32_t row  = slot / _cells_per_row;
+        const uint32_t page = row / _cells_per_row;
+        const uint32_t x    = (slot % _cells_per_row) * _cell_size;
+        const uint32_t y    = (row % _cells_per_row) * _cell_size;
+        while(_pages.size() <= page)
+        {
+            FontPage& added = _pages.emplace_back();
+            added.size = _settings.page_size;
+            added.pixels.assign(size_t(added.size) * added.size, 0);
+        }
+
+        // the whole cell is rewritten, nothing of the previous glyph bleeds into the filtering
+        FontPage& target = _pages[page];
+        for(uint32_t j = 0; j < _cell_size; j++)
+        {
+            uint8_t* line = target.pixels.data() + size_t(y + j) * target.size + x;
+            std::memset(line, 0, _cell_size);
+            if(j < raster.height) std::memcpy(line, raster.pixels.data() + size_t(j) * raster.width, raster.width);
+        }
+        if(target.isDirty())
+        {
+            target.dirty_x0 = std::min(target.dirty_x0, x);
+            target.dirty_y0 = std::min(target.dirty_y0, y);
+            target.dirty_x1 = std::max(target.dirty_x1, x + _cell_size);
+            target.dirty_y1 = std::max(target.dirty_y1, y + _cell_size);
+        }
+        else
+        {
+            target.dirty_x0 = x;
+            target.dirty_y0 = y;
+            target.dirty_x1 = x + _cell_size;
+            target.dirty_y1 = y + _cell_size;
+        }
+
+        const float pixel = 1.0f / static_cast<float>(raster.pixel_size);
+        const float texel = 1.0f / static_cast<float>(target.size);
+        Glyph& glyph   = record.glyph;
+        glyph.page     = page;
+        glyph.plane[0] = static_cast<float>(raster.left) * pixel;
+        glyph.plane[1] = static_cast<float>(raster.top - static_cast<int32_t>(raster.height)) * pixel;
+        glyph.plane[2] = static_cast<float>(raster.left + static_cast<int32_t>(raster.width)) * pixel;
+        glyph.plane[3] = static_cast<float>(raster.top) * pixel;
+        glyph.uv[0]    = static_cast<float>(x) * texel;
+        glyph.uv[1]    = static_cast<float>(y + raster.height) * texel;
+        glyph.uv[2]    = static_cast<float>(x + raster.width) * texel;
+        glyph.uv[3]    = static_cast<float>(y) * texel;
+        glyph.state    = GlyphState::READY;
+        return true;
+    }
+
+    void FontAtlas::clearDirty()
+    {
+        for(auto& page : _pages) page.dirty_x0 = page.dirty_y0 = page.dirty_x1 = page.dirty_y1 = 0;
+    }
+
+    size_t FontAtlas::pendingCount() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _pending + _completed.size() + _deferred.size();
+    }
+
+    void FontAtlas::rasterizeNext()
+    {
+        Job job;
+        std::unique_ptr<Rasterizer> context;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if(_queue.empty()) return;
+            job = std::move(_queue.front());
+            _queue.pop_front();
+            if(!_rasterizers.empty())
+            {
+                context = std::move(_rasterizers.back());
+                _rasterizers.pop_back();
+            }
+        }
+        // never more contexts than tasks running at once, so at most one per io thread
+        if(!context) context = std::make_unique<Rasterizer>(_settings.spread);
+
+        const uint32_t fit = _cell_size - 2 * _settings.spread - 2;
+        Raster raster;
+        raster.key        = job.key;
+        raster.pixel_size = _settings.glyph_size;
+        FT_Face& face = context->faces[job.file.get()];
+        if(context->library && !face)
+        {
+            FT_New_Memory_Face(context->library, job.file->data(), static_cast<FT_Long>(job.file->size()), 0, &face);
+        }
+        auto load = [&](uint32_t pixel_size)
+        {
+            return FT_Set_Pixel_Sizes(face, 0, pixel_size) == 0
+                && FT_Load_Glyph(face, job.glyph_index, FT_LOAD_NO_HINTING | FT_LOAD_NO_BITMAP) == 0;
+        };
+        if(face && load(raster.pixel_size))
+        {
+            // glyphs reaching far outside the em box are rasterized smaller to fit their cell
+            FT_BBox box;
+            FT_Outline_Get_CBox(&face->glyph->outline, &box);
+            const uint32_t extent = static_cast<uint32_t>((std::max(box.xMax - box.xMin, box.yMax - box.yMin) + 63) >> 6);
+            bool loaded = true;
+            if(extent > fit)
+            {
+                raster.pixel_size = std::max<uint32_t>(raster.pixel_size * fit / extent, 1);
+                loaded = load(raster.pixel_size);
+            }
+            if(loaded && FT_Render_Glyph(face->glyph, FT_RENDER_MODE_SDF) == 0)
+            {
+                const FT_Bitmap& bitmap = face->glyph->bitmap;
+                raster.left   = face->glyph->bitmap_left;
+                raster.top    = face->glyph->bitmap_top;
+                raster.width  = std::min<uint32_t>(bitmap.width, _cell_size);
+                raster.height = std::min<uint32_t>(bitmap.rows, _cell_size);
+                raster.pixels.resize(size_t(raster.width) * raster.height);
+                for(uint32_t j = 0; j < raster.height; j++)
+                {
+                    std::memcpy(raster.pixels.data() + size_t(j) * raster.width,
+                        bitmap.buffer + static_cast<ptrdiff_t>(j) * bitmap.pitch, raster.width);
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _completed.push_back(std::move(raster));
+        _rasterizers.push_back(std::move(context));
+        _pending--;
+    }
+} // namespace lux::engine::resource
@@ -0,0 +1,173 @@
+#pragma once
+#include "Mesh.hpp"
+#include <string>
+#include <utility>
+#include <lux-engine/platform/cxx/MappedFile.hpp>
+#include <lux-engine/platform/cxx/StridedSpan.hpp>
+#include <lux-engine/platform/cxx/visibility_control.h>
+
+namespace lux::engine::resource
+{
+    // component types keep their glTF codes, which are the matching GL enums (GL_FLOAT == 5126 ...)
+    enum class GltfComponentType : uint32_t
+    {
+        BYTE            = 5120,
+        UNSIGNED_BYTE   = 5121,
+        SHORT           = 5122,
+        UNSIGNED_SHORT  = 5123,
+        UNSIGNED_INT    = 5125,
+        FLOAT           = 5126
+    };
+
+    struct GltfBufferView
+    {
+        // points into the mapped file, can be handed to glBufferData as is
+        const uint8_t*  data{nullptr};
+        size_t          byte_length{0};
+        size_t          byte_stride{0};     // 0 when tightly packed
+        uint32_t        target{0};          // GL_ARRAY_BUFFER / GL_ELEMENT_ARRAY_BUFFER or 0
+    };
+
+    struct GltfAccessor
+    {
+        const uint8_t*      data{nullptr};  // first element, nullptr for accessors without storage
+        size_t              count{0};
+        size_t              stride{0};      // distance between elements, never 0
+        GltfComponentType   component_type{GltfComponentType::FLOAT};
+        uint32_t            component_count{1};     // SCALAR 1, VEC2 2, ..., MAT4 16
+        bool                normalized{false};
+        int32_t             buffer_view{-1};
+        size_t              byte_offset{0}; // relative to the buffer view, the attribute pointer offset
+        std::vector<float>  min;
+        std::vector<float>  max;
+
+        LUX_EXPORT size_t componentSize() const;
+
+        size_t elementSize() const { return componentSize() * component_count; }
+
+        /**
+         * @brief view the elements as T, e.g. span<Eigen::Vector3f>() for a FLOAT VEC3.
+         *        returns an empty span if sizeof(T) doesn't match the element size
+         */
+        template<class T>
+        platform::StridedSpan<T> span() const
+        {
+            if(data == nullptr || sizeof(T) != elementSize()) return {};
+            return platform::StridedSpan<T>(data, count, stride);
+        }
+    };
+
+    struct GltfPrimitive
+    {
+        std::vector<std::pair<std::string, int32_t>> attributes;   // semantic -> accessor
+        int32_t     indices{-1};
+        int32_t     material{-1};
+        uint32_t    mode{4};                // GL_TRIANGLES
+
+        LUX_EXPORT int32_t attribute(const std::string& semantic) const;
+    };
+
+    struct GltfMesh
+    {
+        std::string                 name;
+        std::vector<GltfPrimitive>  primitives;
+    };
+
+    struct GltfNode
+    {
+        std::string             name;
+        int32_t                 mesh{-1};
+        std::vector<int32_t>    children;
+        // a `matrix` node is decomposed on load, scale stays separate since createTransform is rigid
+        Eigen::Vector3f         translation{Eigen::Vector3f::Zero()};
+        Eigen::Matrix3f         rotation{Eigen::Matrix3f::Identity()};
+        Eigen::Vector3f         scale{Eigen::Vector3f::Ones()};
+
+        LUX_EXPORT Eigen::Affine3f localTransform() const;
+    };
+
+    struct GltfScene
+    {
+        std::string             name;
+        std::vector<int32_t>    nodes;
+    };
+
+    struct GltfMaterial
+    {
+        std::string     name;
+        Eigen::Vector4f base_color_factor{Eigen::Vector4f::Ones()};
+        float           metallic_factor{1.0f};
+        float           roughness_factor{1.0f};
+        Eigen::Vector3f emissive_factor{Eigen::Vector3f::Zero()};
+        // texture indices, -1 if absent
+        int32_t         base_color_texture{-1};
+        int32_t         metallic_roughness_texture{-1};
+        int32_t         normal_texture{-1};
+        int32_t         occlusion_texture{-1};
+        int32_t         emissive_texture{-1};
+        bool            double_sided{false};
+    };
+
+    struct GltfImage
+    {
+        std::string     uri;                // resolved against the model directory
+        int32_t         buffer_view{-1};    // embedded images (glb)
+        std::string     mime_type;
+    };
+
+    struct GltfTexture
+    {
+        int32_t         source{-1};
+        int32_t         sampler{-1};
+    };
+
+    /**
+     * @brief glTF 2.0 (.gltf + .bin, or .glb) scene description.
+     *        buffers are memory mapped and never copied, buffer views and accessors point straight
+     *        into the mappings which live as long as the model. only base64 data uris are decoded
+     */
+    class GltfModel
+    {
+    public:
+        GltfModel() = default;
+
+        GltfModel(const GltfModel&) = delete;
+
+        GltfModel& operator=(const GltfModel&) = delete;
+
+        GltfModel(GltfModel&&) = default;
+
+        GltfModel& operator=(GltfModel&&) = default;
+
+        LUX_EXPORT explicit GltfModel(const std::string& path);
+
+        /**
+         * @return false if the file can't be opened, isn't valid glTF 2.0 or references missing buffers
+         */
+        LUX_EXPORT bool load(const std::string& path);
+
+        bool isEnable() const { return _enable; }
+
+        std::vector<GltfBufferView> buffer_views;
+        std::vector<GltfAccessor>   accessors;
+        std::vector<GltfMesh>       meshes;
+        std::vector<GltfNode>       nodes;
+        std::vector<GltfScene>      scenes;
+        int32_t                     scene{-1};  // default scene
+        std::vector<GltfMaterial>   materials;
+        std::vector<GltfTexture>    textures;
+        std::vector<GltfImage>      images;
+
+    private:
+        bool                                _enable{false};
+        std::vector<platform::MappedFile>   _files;
+        std::vector<std::vector<uint8_t>>   _decoded;   // data uri buffers
+    };
+
+    /**
+     * @brief convert a triangle primitive (POSITION, NORMAL, TEXCOORD_0) to a Mesh.
+     *        v is flipped so uvs match images loaded bottom up, missing normals stay zero
+     *        so generateTangents rebuilds them
+     */
+    LUX_EXPORT bool convertGltfPrimitive(const GltfModel& model, const GltfPrimitive& primitive, Mesh& mesh);
+} // namespace lux::engine::resource
@@ -0,0 +1,61 @@
+#pragma once
+#include <Eigen/Eigen>
+#include <lux-engine/platform/cxx/visibility_control.h>
+#include <cstdint>
+#include <vector>
+
+namespace lux::engine::resource
+{
+    // same memory layout as the interleaved Eigen::Vector8f used by the playground
+    struct MeshVertex
+    {
+        Eigen::Vector3f position;
+        Eigen::Vector3f normal;
+        Eigen::Vector2f uv;
+    };
+    static_assert(sizeof(MeshVertex) == 8 * sizeof(float), "MeshVertex must be tightly packed");
+
+    // a range of Mesh::indices, all lods share Mesh::vertices
+    struct MeshLod
+    {
+        uint32_t index_offset;
+        uint32_t index_count;
+        float    error;         // relative to mesh extent
+        uint32_t meshlet_offset;
+        uint32_t meshlet_count;
+    };
+
+    // a small cluster of triangles with the bounds needed to cull it as a whole
+    struct Meshlet
+    {
+        Eigen::Vector3f center;
+        float           radius;
+        // back facing when dot(normalize(cone_apex - eye), cone_axis) >= cone_cutoff
+        Eigen::Vector3f cone_apex;
+        Eigen::Vector3f cone_axis;
+        float           cone_cutoff;
+
+        uint32_t vertex_offset;     // into Mesh::meshlet_vertices
+        uint32_t vertex_count;
+        uint32_t triangle_offset;   // into Mesh::meshlet_triangles, three bytes per triangle
+        uint32_t triangle_count;
+        uint32_t index_offset;      // the same triangles in Mesh::indices, triangle_count * 3 indices
+    };
+
+    struct Mesh
+    {
+        std::vector<MeshVertex> vertices;
+        std::vector<uint32_t>   indices;
+        // optional, parallel to vertices: xyz tangent, w bitangent sign
+        std::vector<Eigen::Vector4f> tangents;
+        // lods[0] is the full detail mesh, empty means `indices` is the only level
+        std::vector<MeshLod>    lods;
+
+        std::vector<Meshlet>    meshlets;
+        std::vector<uint32_t>   meshlet_vertices;   // meshlet local vertex -> Mesh::vertices
+        std::vector<uint8_t>    meshlet_triangles;  // meshlet local indices
+    };
+
+    // for every vertex, the first vertex with a bitwise equal position
+    LUX_EXPORT std::vector<uint32_t> buildPositionRemap(const std::vector<MeshVertex>& vertices);
+} // namespace lux::engine::resource
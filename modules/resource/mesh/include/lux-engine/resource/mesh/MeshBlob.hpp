@@ -0,0 +1,118 @@
+#pragma once
+#include "Mesh.hpp"
+#include <string>
+#include <lux-engine/platform/cxx/MappedFile.hpp>
+#include <lux-engine/platform/cxx/visibility_control.h>
+
+namespace lux::engine::resource
+{
+    /**
+     * cooked mesh file, little endian, every offset is from the start of the file:
+     *
+     *   MeshBlobHeader
+     *   MeshBlobEntry[mesh_count]
+     *   per mesh, each section aligned to kMeshBlobAlignment:
+     *     MeshVertex[vertex_count], Eigen::Vector4f[vertex_count] (optional tangents),
+     *     uint32_t[index_count], MeshLod[lod_count], Meshlet[meshlet_count],
+     *     uint32_t[meshlet_vertex_count], uint8_t[meshlet_triangle_byte_count], name
+     *
+     * the structs are stored with their in-memory layout, the header records the sizes it was
+     * cooked with so a blob from an incompatible build is rejected instead of misread
+     */
+    constexpr uint32_t kMeshBlobMagic     = 0x424D584C; // "LXMB"
+    constexpr uint32_t kMeshBlobVersion   = 1;
+    constexpr uint64_t kMeshBlobAlignment = 64;
+
+    struct MeshBlobHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t file_size;
+        uint32_t mesh_count;
+        uint32_t vertex_size;
+        uint32_t lod_size;
+        uint32_t meshlet_size;
+    };
+
+    struct MeshBlobEntry
+    {
+        float    bounds_min[3];
+        float    bounds_max[3];
+        uint32_t vertex_count;
+        uint32_t index_count;
+        uint32_t lod_count;
+        uint32_t meshlet_count;
+        uint32_t meshlet_vertex_count;
+        uint32_t meshlet_triangle_byte_count;
+        uint32_t name_length;
+        uint32_t has_tangents;
+        uint64_t vertices_offset;
+        uint64_t tangents_offset;
+        uint64_t indices_offset;
+        uint64_t lods_offset;
+        uint64_t meshlets_offset;
+        uint64_t meshlet_vertices_offset;
+        uint64_t meshlet_triangles_offset;
+        uint64_t name_offset;
+    };
+
+    // read only view of one cooked mesh, the pointers go straight into the mapped file
+    struct MeshView
+    {
+        const char*             name{nullptr};
+        size_t                  name_length{0};
+        Eigen::AlignedBox3f     bounds;
+
+        const MeshVertex*       vertices{nullptr};
+        const Eigen::Vector4f*  tangents{nullptr};  // nullptr if the mesh was cooked without
+        const uint32_t*         indices{nullptr};
+        const MeshLod*          lods{nullptr};
+        const Meshlet*          meshlets{nullptr};
+        const uint32_t*         meshlet_vertices{nullptr};
+        const uint8_t*          meshlet_triangles{nullptr};
+
+        size_t vertex_count{0};
+        size_t index_count{0};
+        size_t lod_count{0};
+        size_t meshlet_count{0};
+        size_t meshlet_vertex_count{0};
+        size_t meshlet_triangle_byte_count{0};
+    };
+
+    /**
+     * @brief a memory mapped cooked mesh file. loading validates the header, the section ranges and
+     *        every index, lod and meshlet range inside them once, after that mesh() only turns offsets into pointers
+     */
+    class MeshBlob
+    {
+    public:
+        MeshBlob() = default;
+
+        LUX_EXPORT explicit MeshBlob(const std::string& path);
+
+        LUX_EXPORT bool load(const std::string& path);
+
+        bool isEnable() const { return _header != nullptr; }
+
+        size_t meshCount() const { return _header ? _header->mesh_count : 0; }
+
+        LUX_EXPORT MeshView mesh(size_t index) const;
+
+    private:
+        platform::MappedFile    _file;
+        const MeshBlobHeader*   _header{nullptr};
+        const MeshBlobEntry*    _entries{nullptr};
+    };
+
+    /**
+     * @brief cook `meshes` (lods, meshlets and tangents already generated) into a blob file
+     *
+     * @param names optional, parallel to meshes
+     */
+    LUX_EXPORT bool writeMeshBlob(
+        const std::string& path, const std::vector<Mesh>& meshes, const std::vector<std::string>& names = {}
+    );
+
+    // copy a cooked mesh back into an editable Mesh
+    LUX_EXPORT void copyMesh(const MeshView& view, Mesh& mesh);
+} // namespace lux::engine::resource
@@ -0,0 +1,82 @@
+#pragma once
+#include "Mesh.hpp"
+#include <lux-engine/platform/cxx/visibility_control.h>
+
+namespace lux::engine::resource
+{
+    struct LodChainSettings
+    {
+        size_t  max_lod_count{8};
+        float   reduction_ratio{0.5f};      // index count of each level relative to the previous one
+        float   max_error{0.05f};           // relative to mesh extent
+        float   attribute_weight{0.05f};    // weight of normal/uv difference against geometric error
+        size_t  min_index_count{96};
+    };
+
+    /**
+     * @brief quadric error metric edge collapse simplifier.
+     *        collapses never move vertices, so every level can index the original vertex buffer.
+     *        vertices with equal positions but different normals/uvs (attribute seams) are
+     *        collapsed together along the seam or not at all
+     */
+    class MeshSimplifier
+    {
+    public:
+        LUX_EXPORT MeshSimplifier(const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices);
+
+        /**
+         * @brief simplify `indices` (a subset of the mesh given to the constructor)
+         *
+         * @param target_index_count stop when the result has no more indices than this
+         * @param target_error stop before any collapse whose error exceeds this, relative to mesh extent
+         * @param result output index buffer
+         * @return float the largest error introduced, relative to mesh extent
+         */
+        LUX_EXPORT float simplify(
+            const std::vector<uint32_t>& indices, size_t target_index_count,
+            float target_error, std::vector<uint32_t>& result
+        );
+
+        LUX_EXPORT void setAttributeWeight(float weight);
+
+    private:
+        struct Quadric
+        {
+            double a00, a11, a22, a01, a02, a12;
+            double b0, b1, b2;
+            double c;
+            double w;       // accumulated area, errors are normalized by it
+        };
+
+        enum class VertexKind : uint8_t
+        {
+            MANIFOLD,
+            BORDER,
+            SEAM,
+            LOCKED
+        };
+
+        static void  quadricAddPlane(Quadric&, const Eigen::Vector3d& normal, double distance, double weight);
+        static void  quadricAdd(Quadric&, const Quadric&);
+        static double quadricError(const Quadric&, const Eigen::Vector3f& position);
+
+        void  buildWedges();
+        void  classifyVertices(const std::vector<uint32_t>& indices);
+        void  buildQuadrics(const std::vector<uint32_t>& indices, std::vector<Quadric>& quadrics) const;
+        float attributeDistance(uint32_t from, uint32_t to) const;
+
+        const std::vector<MeshVertex>& _vertices;
+        std::vector<uint32_t>   _remap;         // first vertex with the same position
+        std::vector<uint32_t>   _wedge;         // next vertex with the same position, circular
+        std::vector<VertexKind> _kind;
+        std::vector<uint64_t>   _open_edges;    // sorted position edges without a twin
+        float                   _extent{1.0f};
+        float                   _attribute_weight{0.05f};
+    };
+
+    // fills mesh.lods and appends every generated level to mesh.indices
+    LUX_EXPORT void generateLodChain(Mesh& mesh, const LodChainSettings& settings = {});
+
+    // cooking entry, meshes are processed in parallel
+    LUX_EXPORT void generateLodChains(std::vector<Mesh>& meshes, const LodChainSettings& settings = {});
+} // namespace lux::engine::resource
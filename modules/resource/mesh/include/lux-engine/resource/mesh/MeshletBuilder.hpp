@@ -0,0 +1,24 @@
+#pragma once
+#include "Mesh.hpp"
+#include <lux-engine/platform/cxx/visibility_control.h>
+
+namespace lux::engine::resource
+{
+    struct MeshletSettings
+    {
+        size_t max_vertices{64};
+        size_t max_triangles{124};
+        // how much a candidate triangle is penalized for facing away from the meshlet cone,
+        // higher values give tighter cones at the cost of meshlet fill
+        float  cone_weight{0.25f};
+    };
+
+    /**
+     * @brief split every lod of `mesh` into meshlets.
+     *        the triangles of each lod range in Mesh::indices are reordered meshlet by meshlet,
+     *        so a meshlet can also be drawn from the regular index buffer via Meshlet::index_offset
+     */
+    LUX_EXPORT void buildMeshlets(Mesh& mesh, const MeshletSettings& settings = {});
+
+    LUX_EXPORT void buildMeshlets(std::vector<Mesh>& meshes, const MeshletSettings& settings = {});
+} // namespace lux::engine::resource
@@ -0,0 +1,42 @@
+#pragma once
+#include "Mesh.hpp"
+#include <string>
+#include <lux-engine/platform/cxx/visibility_control.h>
+
+namespace lux::engine::resource
+{
+    struct ObjMaterial
+    {
+        std::string     name;
+        Eigen::Vector3f ambient{Eigen::Vector3f::Zero()};
+        Eigen::Vector3f diffuse{Eigen::Vector3f::Ones()};
+        Eigen::Vector3f specular{Eigen::Vector3f::Zero()};
+        float           shininess{0.0f};
+        float           opacity{1.0f};
+        // paths are resolved relative to the .mtl file
+        std::string     diffuse_map;
+        std::string     specular_map;
+        std::string     normal_map;
+        std::string     alpha_map;
+    };
+
+    struct ObjModel
+    {
+        // one mesh per (object, material) pair, in order of first appearance
+        std::vector<Mesh>           meshes;
+        std::vector<std::string>    mesh_names;
+        std::vector<int32_t>        mesh_materials;     // index into materials, -1 if none
+        std::vector<ObjMaterial>    materials;
+    };
+
+    /**
+     * @brief load a Wavefront .obj and the .mtl libraries it references.
+     *        the file is memory mapped and parsed in line aligned chunks on every hardware thread,
+     *        corners are merged into indexed vertices per mesh
+     *
+     * @return false if the file can't be opened
+     */
+    LUX_EXPORT bool loadObj(const std::string& path, ObjModel& model);
+
+    LUX_EXPORT bool loadMtl(const std::string& path, std::vector<ObjMaterial>& materials);
+} // namespace lux::engine::resource
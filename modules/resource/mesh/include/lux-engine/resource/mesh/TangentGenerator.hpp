@@ -0,0 +1,35 @@
+#pragma once
+#include "Mesh.hpp"
+#include <lux-engine/platform/cxx/visibility_control.h>
+
+namespace lux::engine::resource
+{
+    struct TangentSettings
+    {
+        // rebuild smooth normals even if the mesh has them, missing (zero) normals are always rebuilt on their own
+        bool    recompute_normals{false};
+        // split a vertex whose corners disagree on uv orientation (mirrored uvs),
+        // without it such vertices keep the tangent of the dominant orientation
+        bool    split_mirrored_vertices{true};
+        size_t  triangles_per_task{16 * 1024};
+    };
+
+    /**
+     * @brief generate per vertex tangents into Mesh::tangents: the uv aligned direction of every triangle,
+     *        angle weighted per corner and averaged per vertex. close to mikktspace on smooth meshes, but without
+     *        its angular grouping, so baked normal maps may differ slightly across hard edges.
+     *        run it before buildMeshlets, splitting mirrored vertices appends to Mesh::vertices and
+     *        rewrites Mesh::indices of every lod
+     */
+    LUX_EXPORT void generateTangents(Mesh& mesh, const TangentSettings& settings = {});
+
+    /**
+     * @brief quantize normals and tangents to GL_INT_2_10_10_10_REV (xyz snorm10, w snorm2),
+     *        normals get w = 0, tangents carry the bitangent sign in w
+     */
+    LUX_EXPORT void packTangentFrames(
+        const Mesh& mesh, std::vector<uint32_t>& packed_normals, std::vector<uint32_t>& packed_tangents
+    );
+
+    LUX_EXPORT uint32_t packSnorm10x3_2(const Eigen::Vector4f& value);
+} // namespace lux::engine::resource
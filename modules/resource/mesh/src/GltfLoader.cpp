@@ -0,0 +1,569 @@
+#include "lux-engine/resource/mesh/GltfLoader.hpp"
+#include "Json.hpp"
+#include <lux-engine/core/math/EigenTools.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+
+namespace lux::engine::resource
+{
+    namespace
+    {
+        constexpr uint32_t kGlbMagic     = 0x46546C67; // "glTF"
+        constexpr uint32_t kGlbChunkJson = 0x4E4F534A; // "JSON"
+        constexpr uint32_t kGlbChunkBin  = 0x004E4942; // "BIN\0"
+
+        struct BufferRange
+        {
+            const uint8_t*  data{nullptr};
+            size_t          size{0};
+        };
+
+        inline uint32_t readU32(const uint8_t* p)
+        {
+            uint32_t value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        inline int32_t indexOr(const JsonValue& value, int32_t fallback = -1)
+        {
+            const int64_t index = value.asInt(fallback);
+            return index >= INT32_MIN && index <= INT32_MAX ? static_cast<int32_t>(index) : -1;
+        }
+
+        // byte counts and offsets, negative values are rejected before they could wrap around as size_t
+        inline bool readSize(const JsonValue& value, size_t& out)
+        {
+            const int64_t number = value.asInt();
+            if(number < 0) return false;
+            out = static_cast<size_t>(number);
+            return true;
+        }
+
+        bool decodeBase64(const char* first, const char* last, std::vector<uint8_t>& out)
+        {
+            auto sextet = [](char c) -> int
+            {
+                if(c >= 'A' && c <= 'Z') return c - 'A';
+                if(c >= 'a' && c <= 'z') return c - 'a' + 26;
+                if(c >= '0' && c <= '9') return c - '0' + 52;
+                if(c == '+' || c == '-') return 62;
+                if(c == '/' || c == '_') return 63;
+                return -1;
+            };
+
+            out.clear();
+            out.reserve((last - first) / 4 * 3);
+            uint32_t bits  = 0;
+            int      count = 0;
+            for(const char* p = first; p < last && *p != '='; p++)
+            {
+                const int v = sextet(*p);
+                if(v < 0) return false;
+                bits = (bits << 6) | static_cast<uint32_t>(v);
+                if(++count == 4)
+                {
+                    out.push_back(static_cast<uint8_t>(bits >> 16));
+                    out.push_back(static_cast<uint8_t>(bits >> 8));
+                    out.push_back(static_cast<uint8_t>(bits));
+                    bits  = 0;
+                    count = 0;
+                }
+            }
+            if(count == 3)
+            {
+                out.push_back(static_cast<uint8_t>(bits >> 10));
+                out.push_back(static_cast<uint8_t>(bits >> 2));
+            }
+            else if(count == 2)
+            {
+                out.push_back(static_cast<uint8_t>(bits >> 4));
+            }
+            return count != 1;
+        }
+
+        // -1 when `c` is not a hex digit
+        int hexDigit(char c)
+        {
+            if(c >= '0' && c <= '9') return c - '0';
+            if(c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if(c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        }
+
+        // uris may be percent encoded, a malformed escape is kept as it is
+        std::string decodeUri(const std::string& uri)
+        {
+            std::string result;
+            result.reserve(uri.size());
+            for(size_t i = 0; i < uri.size(); i++)
+            {
+                const int high = uri[i] == '%' && i + 2 < uri.size() ? hexDigit(uri[i + 1]) : -1;
+                const int low  = high >= 0 ? hexDigit(uri[i + 2]) : -1;
+                if(low >= 0)
+                {
+                    result += static_cast<char>(high << 4 | low);
+                    i += 2;
+                }
+                else
+                {
+                    result += uri[i];
+                }
+            }
+            return result;
+        }
+
+        uint32_t componentCount(const std::string& type)
+        {
+            if(type == "SCALAR") return 1;
+            if(type == "VEC2")   return 2;
+            if(type == "VEC3")   return 3;
+            if(type == "VEC4")   return 4;
+            if(type == "MAT2")   return 4;
+            if(type == "MAT3")   return 9;
+            if(type == "MAT4")   return 16;
+            return 0;
+        }
+
+        void readFloats(const JsonValue& array, float* out, size_t count)
+        {
+            for(size_t i = 0; i < count && i < array.size(); i++)
+            {
+                out[i] = static_cast<float>(array[i].asNumber(out[i]));
+            }
+        }
+
+        int32_t textureIndex(const JsonValue& info)
+        {
+            return indexOr(info["index"]);
+        }
+
+        // read one component as float, applying the normalized integer mapping of the spec
+        float componentAsFloat(const GltfAccessor& accessor, const uint8_t* p)
+        {
+            switch(accessor.component_type)
+            {
+            case GltfComponentType::FLOAT:
+            {
+                float v;
+                std::memcpy(&v, p, sizeof(v));
+                return v;
+            }
+            case GltfComponentType::UNSIGNED_BYTE:
+                return accessor.normalized ? *p / 255.0f : *p;
+            case GltfComponentType::BYTE:
+            {
+                const int8_t v = static_cast<int8_t>(*p);
+                return accessor.normalized ? std::max(v / 127.0f, -1.0f) : v;
+            }
+            case GltfComponentType::UNSIGNED_SHORT:
+            {
+                uint16_t v;
+                std::memcpy(&v, p, sizeof(v));
+                return accessor.normalized ? v / 65535.0f : v;
+            }
+            case GltfComponentType::SHORT:
+            {
+                int16_t v;
+                std::memcpy(&v, p, sizeof(v));
+                return accessor.normalized ? std::max(v / 32767.0f, -1.0f) : v;
+            }
+            case GltfComponentType::UNSIGNED_INT:
+            {
+                uint32_t v;
+                std::memcpy(&v, p, sizeof(v));
+                return static_cast<float>(v);
+            }
+            }
+            return 0.0f;
+        }
+
+        template<int N>
+        bool readAttribute(const GltfModel& model, int32_t index, std::vector<MeshVertex>& vertices, size_t offset)
+        {
+            if(index < 0 || static_cast<size_t>(index) >= model.accessors.size()) return false;
+            const GltfAccessor& accessor = model.accessors[index];
+            if(accessor.data == nullptr || accessor.component_count != N || accessor.count != vertices.size()) return false;
+
+            const size_t component_size = accessor.componentSize();
+            for(size_t v = 0; v < accessor.count; v++)
+            {
+                const uint8_t* element = accessor.data + v * accessor.stride;
+                float* out = reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(&vertices[v]) + offset);
+                for(int c = 0; c < N; c++)
+                {
+                    out[c] = componentAsFloat(accessor, element + c * component_size);
+                }
+            }
+            return true;
+        }
+    }
+
+    size_t GltfAccessor::componentSize() const
+    {
+        switch(component_type)
+        {
+        case GltfComponentType::BYTE:
+        case GltfComponentType::UNSIGNED_BYTE:  return 1;
+        case GltfComponentType::SHORT:
+        case GltfComponentType::UNSIGNED_SHORT: return 2;
+        case GltfComponentType::UNSIGNED_INT:
+        case GltfComponentType::FLOAT:          return 4;
+        }
+        return 0;
+    }
+
+    int32_t GltfPrimitive::attribute(const std::string& semantic) const
+    {
+        for(auto& [name, accessor] : attributes)
+        {
+            if(name == semantic) return accessor;
+        }
+        return -1;
+    }
+
+    Eigen::Affine3f GltfNode::localTransform() const
+    {
+        Eigen::Affine3f transform = core::createTransform(rotation, translation);
+        transform.scale(scale);
+        return transform;
+    }
+
+    GltfModel::GltfModel(const std::string& path)
+    {
+        load(path);
+    }
+
+    bool GltfModel::load(const std::string& path)
+    {
+        *this = GltfModel{};
+
+        platform::MappedFile file(path);
+        if(!file.isEnable()) return false;
+
+        const uint8_t*  bytes = file.data();
+        const size_t    size  = file.size();
+        const char*     json_begin = reinterpret_cast<const char*>(bytes);
+        const char*     json_end   = json_begin + size;
+        BufferRange     glb_bin;
+
+        if(size >= 12 && readU32(bytes) == kGlbMagic)
+        {
+            if(readU32(bytes + 4) != 2) return false;
+            const size_t length = std::min<size_t>(readU32(bytes + 8), size);
+            json_begin = nullptr;
+            for(size_t offset = 12; offset + 8 <= length;)
+            {
+                const size_t chunk_length = readU32(bytes + offset);
+                const uint32_t chunk_type = readU32(bytes + offset + 4);
+                const uint8_t* chunk      = bytes + offset + 8;
+                if(offset + 8 + chunk_length > length) return false;
+                if(chunk_type == kGlbChunkJson && json_begin == nullptr)
+                {
+                    json_begin = reinterpret_cast<const char*>(chunk);
+                    json_end   = json_begin + chunk_length;
+                }
+                else if(chunk_type == kGlbChunkBin && glb_bin.data == nullptr)
+                {
+                    glb_bin = {chunk, chunk_length};
+                }
+                // chunks are 4 byte aligned
+                offset += 8 + ((chunk_length + 3) & ~size_t(3));
+            }
+            if(json_begin == nullptr) return false;
+        }
+
+        JsonValue document;
+        if(!JsonValue::parse(json_begin, json_end, document)) return false;
+        if(document["asset"]["version"].asString().rfind("2.", 0) != 0) return false;
+
+        const std::filesystem::path directory = std::filesystem::path(path).parent_path();
+        _files.push_back(std::move(file));
+
+        // buffers
+        std::vector<BufferRange> buffers;
+        const JsonValue& buffers_json = document["buffers"];
+        for(size_t i = 0; i < buffers_json.size(); i++)
+        {
+            const JsonValue& buffer = buffers_json[i];
+            size_t byte_length;
+            if(!readSize(buffer["byteLength"], byte_length)) return false;
+            const std::string& uri = buffer["uri"].asString();
+            BufferRange range;
+
+            if(uri.empty())
+            {
+                // glb-stored buffer, only valid as the first buffer
+                if(i != 0 || glb_bin.data == nullptr) return false;
+                range = glb_bin;
+            }
+            else if(uri.rfind("data:", 0) == 0)
+            {
+                const size_t comma = uri.find(',');
+                if(comma == std::string::npos || uri.find(";base64") > comma) return false;
+                _decoded.emplace_back();
+                if(!decodeBase64(uri.data() + comma + 1, uri.data() + uri.size(), _decoded.back())) return false;
+                range = {_decoded.back().data(), _decoded.back().size()};
+            }
+            else
+            {
+                platform::MappedFile external((directory / decodeUri(uri)).string());
+                if(!external.isEnable()) return false;
+                range = {external.data(), external.size()};
+                _files.push_back(std::move(external));
+            }
+
+            if(range.size < byte_length) return false;
+            range.size = byte_length;
+            buffers.push_back(range);
+        }
+
+        // buffer views
+        const JsonValue& views_json = document["bufferViews"];
+        buffer_views.resize(views_json.size());
+        for(size_t i = 0; i < views_json.size(); i++)
+        {
+            const JsonValue& view = views_json[i];
+            const int32_t buffer = indexOr(view["buffer"]);
+            size_t offset, length, stride;
+            if(!readSize(view["byteOffset"], offset) || !readSize(view["byteLength"], length)) return false;
+            if(!readSize(view["byteStride"], stride)) return false;
+            if(buffer < 0 || static_cast<size_t>(buffer) >= buffers.size()) return false;
+            if(offset > buffers[buffer].size || length > buffers[buffer].size - offset) return false;
+
+            GltfBufferView& out = buffer_views[i];
+            out.data        = buffers[buffer].data + offset;
+            out.byte_length = length;
+            out.byte_stride = stride;
+            out.target      = static_cast<uint32_t>(view["target"].asInt());
+        }
+
+        // accessors
+        const JsonValue& accessors_json = document["accessors"];
+        accessors.resize(accessors_json.size());
+        for(size_t i = 0; i < accessors_json.size(); i++)
+        {
+            const JsonValue& accessor = accessors_json[i];
+            GltfAccessor& out = accessors[i];
+            out.component_type  = static_cast<GltfComponentType>(accessor["componentType"].asInt());
+            out.component_count = componentCount(accessor["type"].asString());
+            out.normalized      = accessor["normalized"].asBool();
+            out.buffer_view     = indexOr(accessor["bufferView"]);
+            if(!readSize(accessor["count"], out.count) || !readSize(accessor["byteOffset"], out.byte_offset)) return false;
+            if(out.componentSize() == 0 || out.component_count == 0) return false;
+
+            for(const char* key : {"min", "max"})
+            {
+                const JsonValue& bound = accessor[key];
+                std::vector<float>& values = key[1] == 'i' ? out.min : out.max;
+                values.resize(bound.size());
+                readFloats(bound, values.data(), values.size());
+            }
+
+            // accessors without a buffer view are all zeros, sparse substitution is not applied
+            if(out.buffer_view < 0) continue;
+            if(static_cast<size_t>(out.buffer_view) >= buffer_views.size()) return false;
+
+            const GltfBufferView& view = buffer_views[out.buffer_view];
+            out.stride = view.byte_stride ? view.byte_stride : out.elementSize();
+            if(out.count > 0)
+            {
+                // offset + (count - 1) * stride + element <= length, written so that nothing can overflow
+                if(out.byte_offset > view.byte_length || view.byte_length - out.byte_offset < out.elementSize()) return false;
+                if(out.count - 1 > (view.byte_length - out.byte_offset - out.elementSize()) / out.stride) return false;
+            }
+            out.data = view.data + out.byte_offset;
+        }
+
+        // meshes
+        const JsonValue& meshes_json = document["meshes"];
+        meshes.resize(meshes_json.size());
+        for(size_t i = 0; i < meshes_json.size(); i++)
+        {
+            const JsonValue& mesh = meshes_json[i];
+            meshes[i].name = mesh["name"].asString();
+            const JsonValue& primitives_json = mesh["primitives"];
+            meshes[i].primitives.resize(primitives_json.size());
+            for(size_t p = 0; p < primitives_json.size(); p++)
+            {
+                const JsonValue& primitive = primitives_json[p];
+                GltfPrimitive& out = meshes[i].primitives[p];
+                const JsonValue& attributes = primitive["attributes"];
+                for(size_t a = 0; a < attributes.size(); a++)
+                {
+                    out.attributes.emplace_back(attributes.keyAt(a), indexOr(attributes[attributes.keyAt(a)]));
+                }
+                out.indices  = indexOr(primitive["indices"]);
+                out.material = indexOr(primitive["material"]);
+                out.mode     = static_cast<uint32_t>(primitive["mode"].asInt(4));
+            }
+        }
+
+        // nodes
+        const JsonValue& nodes_json = document["nodes"];
+        nodes.resize(nodes_json.size());
+        for(size_t i = 0; i < nodes_json.size(); i++)
+        {
+            const JsonValue& node = nodes_json[i];
+            GltfNode& out = nodes[i];
+            out.name = node["name"].asString();
+            out.mesh = indexOr(node["mesh"]);
+            const JsonValue& children = node["children"];
+            for(size_t c = 0; c < children.size(); c++) out.children.push_back(indexOr(children[c]));
+
+            const JsonValue& matrix = node["matrix"];
+            if(matrix.size() == 16)
+            {
+                Eigen::Matrix4f m;
+                readFloats(matrix, m.data(), 16); // column major, like Eigen
+                Eigen::Matrix3f rotation, scaling;
+                Eigen::Affine3f(m).computeRotationScaling(&rotation, &scaling);
+                out.rotation    = rotation;
+                out.scale       = scaling.diagonal();
+                out.translation = m.block<3, 1>(0, 3);
+            }
+            else
+            {
+                readFloats(node["translation"], out.translation.data(), 3);
+                readFloats(node["scale"], out.scale.data(), 3);
+                float q[4]{0, 0, 0, 1}; // x, y, z, w
+                readFloats(node["rotation"], q, 4);
+                out.rotation = Eigen::Quaternionf(q[3], q[0], q[1], q[2]).normalized().toRotationMatrix();
+            }
+        }
+
+        // scenes
+        const JsonValue& scenes_json = document["scenes"];
+        scenes.resize(scenes_json.size());
+        for(size_t i = 0; i < scenes_json.size(); i++)
+        {
+            scenes[i].name = scenes_json[i]["name"].asString();
+            const JsonValue& roots = scenes_json[i]["nodes"];
+            for(size_t r = 0; r < roots.size(); r++) scenes[i].nodes.push_back(indexOr(roots[r]));
+        }
+        scene = indexOr(document["scene"], scenes.empty() ? -1 : 0);
+
+        // materials
+        const JsonValue& materials_json = document["materials"];
+        materials.resize(materials_json.size());
+        for(size_t i = 0; i < materials_json.size(); i++)
+        {
+            const JsonValue& material = materials_json[i];
+            const JsonValue& pbr = material["pbrMetallicRoughness"];
+            GltfMaterial& out = materials[i];
+            out.name = material["name"].asString();
+            readFloats(pbr["baseColorFactor"], out.base_color_factor.data(), 4);
+            out.metallic_factor             = static_cast<float>(pbr["metallicFactor"].asNumber(1.0));
+            out.roughness_factor            = static_cast<float>(pbr["roughnessFactor"].asNumber(1.0));
+            readFloats(material["emissiveFactor"], out.emissive_factor.data(), 3);
+            out.base_color_texture          = textureIndex(pbr["baseColorTexture"]);
+            out.metallic_roughness_texture  = textureIndex(pbr["metallicRoughnessTexture"]);
+            out.normal_texture              = textureIndex(material["normalTexture"]);
+            out.occlusion_texture           = textureIndex(material["occlusionTexture"]);
+            out.emissive_texture            = textureIndex(material["emissiveTexture"]);
+            out.double_sided                = material["doubleSided"].asBool();
+        }
+
+        const JsonValue& textures_json = document["textures"];
+        textures.resize(textures_json.size());
+        for(size_t i = 0; i < textures_json.size(); i++)
+        {
+            textures[i].source  = indexOr(textures_json[i]["source"]);
+            textures[i].sampler = indexOr(textures_json[i]["sampler"]);
+        }
+
+        const JsonValue& images_json = document["images"];
+        images.resize(images_json.size());
+        for(size_t i = 0; i < images_json.size(); i++)
+        {
+            const std::string& uri = images_json[i]["uri"].asString();
+            if(!uri.empty())
+            {
+                images[i].uri = uri.rfind("data:", 0) == 0 ? uri : (directory / decodeUri(uri)).string();
+            }
+            images[i].buffer_view = indexOr(images_json[i]["bufferView"]);
+            images[i].mime_type   = images_json[i]["mimeType"].asString();
+        }
+
+        _enable = true;
+        return true;
+    }
+
+    bool convertGltfPrimitive(const GltfModel& model, const GltfPrimitive& primitive, Mesh& mesh)
+    {
+        mesh = Mesh{};
+        if(primitive.mode != 4) return false;
+
+        const int32_t position = primitive.attribute("POSITION");
+        if(position < 0 || static_cast<size_t>(position) >= model.accessors.size()) return false;
+        // only accessors backed by a buffer view had their count checked against real bytes
+        if(model.accessors[position].data == nullptr) return false;
+
+        mesh.vertices.resize(model.accessors[position].count, MeshVertex{
+            Eigen::Vector3f::Zero(), Eigen::Vector3f::Zero(), Eigen::Vector2f::Zero()
+        });
+        if(!readAttribute<3>(model, position, mesh.vertices, offsetof(MeshVertex, position))) return false;
+
+        const int32_t normal = primitive.attribute("NORMAL");
+        if(normal >= 0 && !readAttribute<3>(model, normal, mesh.vertices, offsetof(MeshVertex, normal))) return false;
+
+        const int32_t texcoord = primitive.attribute("TEXCOORD_0");
+        if(texcoord >= 0)
+        {
+            if(!readAttribute<2>(model, texcoord, mesh.vertices, offsetof(MeshVertex, uv))) return false;
+            for(auto& vertex : mesh.vertices) vertex.uv.y() = 1.0f - vertex.uv.y();
+        }
+
+        if(primitive.indices < 0)
+        {
+            mesh.indices.resize(mesh.vertices.size() - mesh.vertices.size() % 3);
+            for(size_t i = 0; i < mesh.indices.size(); i++) mesh.indices[i] = static_cast<uint32_t>(i);
+            return true;
+        }
+
+        if(static_cast<size_t>(primitive.indices) >= model.accessors.size()) return false;
+        const GltfAccessor& indices = model.accessors[primitive.indices];
+        if(indices.data == nullptr || indices.component_count != 1) return false;
+
+        mesh.indices.resize(indices.count);
+        switch(indices.component_type)
+        {
+        case GltfComponentType::UNSIGNED_BYTE:
+        {
+            auto span = indices.span<uint8_t>();
+            for(size_t i = 0; i < span.size(); i++) mesh.indices[i] = span[i];
+            break;
+        }
+        case GltfComponentType::UNSIGNED_SHORT:
+        {
+            auto span = indices.span<uint16_t>();
+            for(size_t i = 0; i < span.size(); i++) mesh.indices[i] = span[i];
+            break;
+        }
+        case GltfComponentType::UNSIGNED_INT:
+        {
+            auto span = indices.span<uint32_t>();
+            if(span.contiguous())
+            {
+                std::memcpy(mesh.indices.data(), span.data(), span.size() * sizeof(uint32_t));
+            }
+            else
+            {
+                for(size_t i = 0; i < span.size(); i++) mesh.indices[i] = span[i];
+            }
+            break;
+        }
+        default:
+            return false;
+        }
+
+        for(uint32_t index : mesh.indices)
+        {
+            if(index >= mesh.vertices.size()) return false;
+        }
+        mesh.indices.resize(mesh.indices.size() - mesh.indices.size() % 3);
+        return true;
+    }
+} // namespace lux::engine::resource
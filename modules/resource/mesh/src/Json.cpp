@@ -0,0 +1,229 @@
+#include "Json.hpp"
+#include <lux-engine/platform/cxx/FastFloat.hpp>
+#include <cstring>
+
+namespace lux::engine::resource
+{
+    class JsonParser
+    {
+    public:
+        JsonParser(const char* begin, const char* end)
+            : _p(begin), _end(end){}
+
+        bool parseDocument(JsonValue& value)
+        {
+            if(!parseValue(value, 0)) return false;
+            skipWhitespace();
+            return _p == _end;
+        }
+
+    private:
+        // nesting guard against stack exhaustion on hostile input
+        static constexpr int kMaxDepth = 256;
+
+        void skipWhitespace()
+        {
+            while(_p < _end && (*_p == ' ' || *_p == '\t' || *_p == '\n' || *_p == '\r')) _p++;
+        }
+
+        bool consume(const char* literal)
+        {
+            const size_t length = std::strlen(literal);
+            if(static_cast<size_t>(_end - _p) < length || std::memcmp(_p, literal, length) != 0) return false;
+            _p += length;
+            return true;
+        }
+
+        static void appendUtf8(std::string& out, uint32_t code)
+        {
+            if(code < 0x80)
+            {
+                out += static_cast<char>(code);
+            }
+            else if(code < 0x800)
+            {
+                out += static_cast<char>(0xC0 | (code >> 6));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            }
+            else if(code < 0x10000)
+            {
+                out += static_cast<char>(0xE0 | (code >> 12));
+                out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            }
+            else
+            {
+                out += static_cast<char>(0xF0 | (code >> 18));
+                out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+                out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            }
+        }
+
+        bool parseHex4(uint32_t& code)
+        {
+            if(_end - _p < 4) return false;
+            code = 0;
+            for(int i = 0; i < 4; i++, _p++)
+            {
+                const char c = *_p;
+                code <<= 4;
+                if(c >= '0' && c <= '9')      code |= c - '0';
+                else if(c >= 'a' && c <= 'f') code |= c - 'a' + 10;
+                else if(c >= 'A' && c <= 'F') code |= c - 'A' + 10;
+                else return false;
+            }
+            return true;
+        }
+
+        bool parseString(std::string& out)
+        {
+            if(_p >= _end || *_p != '"') return false;
+            _p++;
+            while(_p < _end)
+            {
+                // copy runs without escapes in one go
+                const char* run = _p;
+                while(_p < _end && *_p != '"' && *_p != '\\') _p++;
+                out.append(run, _p);
+                if(_p >= _end) return false;
+                if(*_p++ == '"') return true;
+
+                if(_p >= _end) return false;
+                switch(*_p++)
+                {
+                case '"':  out += '"';  break;
+                case '\\': out += '\\'; break;
+                case '/':  out += '/';  break;
+                case 'b':  out += '\b'; break;
+                case 'f':  out += '\f'; break;
+                case 'n':  out += '\n'; break;
+                case 'r':  out += '\r'; break;
+                case 't':  out += '\t'; break;
+                case 'u':
+                {
+                    uint32_t code;
+                    if(!parseHex4(code)) return false;
+                    if(code >= 0xD800 && code < 0xDC00 && consume("\\u"))
+                    {
+                        uint32_t low;
+                        if(!parseHex4(low)) return false;
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendUtf8(out, code);
+                    break;
+                }
+                default:
+                    return false;
+                }
+            }
+            return false;
+        }
+
+        bool parseValue(JsonValue& value, int depth)
+        {
+            if(depth > kMaxDepth) return false;
+            skipWhitespace();
+            if(_p >= _end) return false;
+
+            switch(*_p)
+            {
+            case '{':
+            {
+                value._type = JsonValue::Type::OBJECT;
+                _p++;
+                skipWhitespace();
+                if(_p < _end && *_p == '}')
+                {
+                    _p++;
+                    return true;
+                }
+                while(true)
+                {
+                    skipWhitespace();
+                    value._keys.emplace_back();
+                    if(!parseString(value._keys.back())) return false;
+                    skipWhitespace();
+                    if(_p >= _end || *_p++ != ':') return false;
+                    value._values.emplace_back();
+                    if(!parseValue(value._values.back(), depth + 1)) return false;
+                    skipWhitespace();
+                    if(_p >= _end) return false;
+                    if(*_p == ',') { _p++; continue; }
+                    if(*_p == '}') { _p++; return true; }
+                    return false;
+                }
+            }
+            case '[':
+            {
+                value._type = JsonValue::Type::ARRAY;
+                _p++;
+                skipWhitespace();
+                if(_p < _end && *_p == ']')
+                {
+                    _p++;
+                    return true;
+                }
+                while(true)
+                {
+                    value._values.emplace_back();
+                    if(!parseValue(value._values.back(), depth + 1)) return false;
+                    skipWhitespace();
+                    if(_p >= _end) return false;
+                    if(*_p == ',') { _p++; continue; }
+                    if(*_p == ']') { _p++; return true; }
+                    return false;
+                }
+            }
+            case '"':
+                value._type = JsonValue::Type::STRING;
+                return parseString(value._string);
+            case 't':
+                value._type    = JsonValue::Type::BOOLEAN;
+                value._boolean = true;
+                return consume("true");
+            case 'f':
+                value._type    = JsonValue::Type::BOOLEAN;
+                value._boolean = false;
+                return consume("false");
+            case 'n':
+                value._type = JsonValue::Type::NUL;
+                return consume("null");
+            default:
+            {
+                const char* end = platform::parseDouble(_p, _end, value._number);
+                if(end == _p) return false;
+                value._type = JsonValue::Type::NUMBER;
+                _p = end;
+                return true;
+            }
+            }
+        }
+
+        const char* _p;
+        const char* _end;
+    };
+
+    const JsonValue& JsonValue::operator[](std::string_view key) const
+    {
+        static const JsonValue null_value;
+        for(size_t i = 0; i < _keys.size(); i++)
+        {
+            if(_keys[i] == key) return _values[i];
+        }
+        return null_value;
+    }
+
+    const JsonValue& JsonValue::operator[](size_t index) const
+    {
+        static const JsonValue null_value;
+        return _type == Type::ARRAY && index < _values.size() ? _values[index] : null_value;
+    }
+
+    bool JsonValue::parse(const char* begin, const char* end, JsonValue& value)
+    {
+        value = JsonValue{};
+        JsonParser parser(begin, end);
+        return parser.parseDocument(value);
+    }
+} // namespace lux::engine::resource
@@ -0,0 +1,60 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lux::engine::resource
+{
+    // minimal DOM for importer metadata (glTF), payloads never go through it
+    class JsonValue
+    {
+    public:
+        enum class Type
+        {
+            NUL,
+            BOOLEAN,
+            NUMBER,
+            STRING,
+            ARRAY,
+            OBJECT
+        };
+
+        Type type() const { return _type; }
+
+        bool isNull() const { return _type == Type::NUL; }
+
+        size_t size() const { return _values.size(); }
+
+        // missing keys and out of range indices yield a null value
+        const JsonValue& operator[](std::string_view key) const;
+
+        const JsonValue& operator[](size_t index) const;
+
+        const std::string& keyAt(size_t index) const { return _keys[index]; }
+
+        double asNumber(double fallback = 0.0) const { return _type == Type::NUMBER ? _number : fallback; }
+
+        // numbers outside the int64_t range and NaN yield the fallback, the cast would be undefined
+        int64_t asInt(int64_t fallback = 0) const
+        {
+            if(_type != Type::NUMBER || !(_number >= -0x1p63 && _number < 0x1p63)) return fallback;
+            return static_cast<int64_t>(_number);
+        }
+
+        bool asBool(bool fallback = false) const { return _type == Type::BOOLEAN ? _boolean : fallback; }
+
+        const std::string& asString() const { return _string; }
+
+        static bool parse(const char* begin, const char* end, JsonValue& value);
+
+    private:
+        friend class JsonParser;
+
+        Type                        _type{Type::NUL};
+        bool                        _boolean{false};
+        double                      _number{0.0};
+        std::string                 _string;
+        std::vector<std::string>    _keys;      // objects only, parallel to _values
+        std::vector<JsonValue>      _values;    // array elements or object members
+    };
+} // namespace lux::engine::resource
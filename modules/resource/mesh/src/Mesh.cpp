@@ -0,0 +1,39 @@
+#include "lux-engine/resource/mesh/Mesh.hpp"
+#include <cstring>
+#include <unordered_map>
+
+namespace lux::engine::resource
+{
+    namespace
+    {
+        struct PositionHash
+        {
+            size_t operator()(const Eigen::Vector3f& position) const noexcept
+            {
+                uint32_t bits[3];
+                std::memcpy(bits, position.data(), sizeof(bits));
+                return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+            }
+        };
+
+        struct PositionEqual
+        {
+            bool operator()(const Eigen::Vector3f& a, const Eigen::Vector3f& b) const noexcept
+            {
+                return std::memcmp(a.data(), b.data(), 3 * sizeof(float)) == 0;
+            }
+        };
+    }
+
+    std::vector<uint32_t> buildPositionRemap(const std::vector<MeshVertex>& vertices)
+    {
+        std::vector<uint32_t> remap(vertices.size());
+        std::unordered_map<Eigen::Vector3f, uint32_t, PositionHash, PositionEqual> table;
+        table.reserve(vertices.size());
+        for(uint32_t i = 0; i < vertices.size(); i++)
+        {
+            remap[i] = table.emplace(vertices[i].position, i).first->second;
+        }
+        return remap;
+    }
+} // namespace lux::engine::resource
@@ -0,0 +1,280 @@
+#include "lux-engine/resource/mesh/MeshBlob.hpp"
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+namespace lux::engine::resource
+{
+    namespace
+    {
+        inline uint64_t alignUp(uint64_t value)
+        {
+            return (value + kMeshBlobAlignment - 1) & ~(kMeshBlobAlignment - 1);
+        }
+
+        // section lies inside the file and is aligned for its element type
+        inline bool validSection(uint64_t offset, uint64_t count, uint64_t element_size, uint64_t file_size)
+        {
+            if(count == 0) return true;
+            if(offset % kMeshBlobAlignment != 0 || offset > file_size) return false;
+            return count <= (file_size - offset) / element_size;
+        }
+
+        template<class T>
+        const T* sectionPointer(const uint8_t* base, uint64_t offset, uint64_t count)
+        {
+            return count ? reinterpret_cast<const T*>(base + offset) : nullptr;
+        }
+
+        // [offset, offset + count) inside [0, total), in 64 bits so nothing wraps
+        inline bool validRange(uint64_t offset, uint64_t count, uint64_t total)
+        {
+            return offset <= total && count <= total - offset;
+        }
+
+        // the section contents of an entry whose sections are already known to be inside the file
+        bool validContents(const uint8_t* base, const MeshBlobEntry& entry)
+        {
+            const uint32_t* indices = sectionPointer<uint32_t>(base, entry.indices_offset, entry.index_count);
+            for(uint32_t i = 0; i < entry.index_count; i++)
+            {
+                if(indices[i] >= entry.vertex_count) return false;
+            }
+
+            const MeshLod* lods = sectionPointer<MeshLod>(base, entry.lods_offset, entry.lod_count);
+            for(uint32_t i = 0; i < entry.lod_count; i++)
+            {
+                if(!validRange(lods[i].index_offset, lods[i].index_count, entry.index_count)
+                    || !validRange(lods[i].meshlet_offset, lods[i].meshlet_count, entry.meshlet_count))
+                {
+                    return false;
+                }
+            }
+
+            const uint32_t* meshlet_vertices = sectionPointer<uint32_t>(base, entry.meshlet_vertices_offset, entry.meshlet_vertex_count);
+            for(uint32_t i = 0; i < entry.meshlet_vertex_count; i++)
+            {
+                if(meshlet_vertices[i] >= entry.vertex_count) return false;
+            }
+
+            const Meshlet* meshlets  = sectionPointer<Meshlet>(base, entry.meshlets_offset, entry.meshlet_count);
+            const uint8_t* triangles = sectionPointer<uint8_t>(base, entry.meshlet_triangles_offset, entry.meshlet_triangle_byte_count);
+            for(uint32_t i = 0; i < entry.meshlet_count; i++)
+            {
+                const Meshlet& meshlet = meshlets[i];
+                const uint64_t corner_count = uint64_t(meshlet.triangle_count) * 3;
+                if(!validRange(meshlet.vertex_offset, meshlet.vertex_count, entry.meshlet_vertex_count)
+                    || !validRange(meshlet.triangle_offset, corner_count, entry.meshlet_triangle_byte_count)
+                    || !validRange(meshlet.index_offset, corner_count, entry.index_count))
+                {
+                    return false;
+                }
+                // local indices address the meshlet's own vertex list
+                for(uint64_t c = 0; c < corner_count; c++)
+                {
+                    if(triangles[meshlet.triangle_offset + c] >= meshlet.vertex_count) return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    MeshBlob::MeshBlob(const std::string& path)
+    {
+        load(path);
+    }
+
+    bool MeshBlob::load(const std::string& path)
+    {
+        _header  = nullptr;
+        _entries = nullptr;
+        if(!_file.open(path)) return false;
+
+        const uint8_t* base = _file.data();
+        const uint64_t size = _file.size();
+        if(size < sizeof(MeshBlobHeader)) return false;
+
+        const MeshBlobHeader* header = reinterpret_cast<const MeshBlobHeader*>(base);
+        if(header->magic != kMeshBlobMagic || header->version != kMeshBlobVersion
+            || header->file_size != size
+            || header->vertex_size != sizeof(MeshVertex)
+            || header->lod_size != sizeof(MeshLod)
+            || header->meshlet_size != sizeof(Meshlet))
+        {
+            return false;
+        }
+        if(header->mesh_count > (size - sizeof(MeshBlobHeader)) / sizeof(MeshBlobEntry)) return false;
+
+        const MeshBlobEntry* entries = reinterpret_cast<const MeshBlobEntry*>(base + sizeof(MeshBlobHeader));
+        for(uint32_t i = 0; i < header->mesh_count; i++)
+        {
+            const MeshBlobEntry& entry = entries[i];
+            const bool valid =
+                validSection(entry.vertices_offset, entry.vertex_count, sizeof(MeshVertex), size)
+                && (!entry.has_tangents || validSection(entry.tangents_offset, entry.vertex_count, sizeof(Eigen::Vector4f), size))
+                && validSection(entry.indices_offset, entry.index_count, sizeof(uint32_t), size)
+                && validSection(entry.lods_offset, entry.lod_count, sizeof(MeshLod), size)
+                && validSection(entry.meshlets_offset, entry.meshlet_count, sizeof(Meshlet), size)
+                && validSection(entry.meshlet_vertices_offset, entry.meshlet_vertex_count, sizeof(uint32_t), size)
+                && validSection(entry.meshlet_triangles_offset, entry.meshlet_triangle_byte_count, 1, size)
+                && entry.name_offset <= size && entry.name_length <= size - entry.name_offset;
+            if(!valid || !validContents(base, entry)) return false;
+        }
+
+        _header  = header;
+        _entries = entries;
+        return true;
+    }
+
+    MeshView MeshBlob::mesh(size_t index) const
+    {
+        MeshView view;
+        if(!_header || index >= _header->mesh_count) return view;
+
+        const uint8_t*       base  = _file.data();
+        const MeshBlobEntry& entry = _entries[index];
+
+        view.name           = reinterpret_cast<const char*>(base + entry.name_offset);
+        view.name_length    = entry.name_length;
+        view.bounds         = Eigen::AlignedBox3f(
+            Eigen::Vector3f(entry.bounds_min[0], entry.bounds_min[1], entry.bounds_min[2]),
+            Eigen::Vector3f(entry.bounds_max[0], entry.bounds_max[1], entry.bounds_max[2])
+        );
+
+        view.vertices           = sectionPointer<MeshVertex>(base, entry.vertices_offset, entry.vertex_count);
+        view.tangents           = entry.has_tangents
+                                ? sectionPointer<Eigen::Vector4f>(base, entry.tangents_offset, entry.vertex_count)
+                                : nullptr;
+        view.indices            = sectionPointer<uint32_t>(base, entry.indices_offset, entry.index_count);
+        view.lods               = sectionPointer<MeshLod>(base, entry.lods_offset, entry.lod_count);
+        view.meshlets           = sectionPointer<Meshlet>(base, entry.meshlets_offset, entry.meshlet_count);
+        view.meshlet_vertices   = sectionPointer<uint32_t>(base, entry.meshlet_vertices_offset, entry.meshlet_vertex_count);
+        view.meshlet_triangles  = sectionPointer<uint8_t>(base, entry.meshlet_triangles_offset, entry.meshlet_triangle_byte_count);
+
+        view.vertex_count                = entry.vertex_count;
+        view.index_count                 = entry.index_count;
+        view.lod_count                   = entry.lod_count;
+        view.meshlet_count               = entry.meshlet_count;
+        view.meshlet_vertex_count        = entry.meshlet_vertex_count;
+        view.meshlet_triangle_byte_count = entry.meshlet_triangle_byte_count;
+        return view;
+    }
+
+    bool writeMeshBlob(const std::string& path, const std::vector<Mesh>& meshes, const std::vector<std::string>& names)
+    {
+        if(meshes.size() > std::numeric_limits<uint32_t>::max()) return false;
+
+        MeshBlobHeader header{};
+        header.magic        = kMeshBlobMagic;
+        header.version      = kMeshBlobVersion;
+        header.mesh_count   = static_cast<uint32_t>(meshes.size());
+        header.vertex_size  = sizeof(MeshVertex);
+        header.lod_size     = sizeof(MeshLod);
+        header.meshlet_size = sizeof(Meshlet);
+
+        // lay out every section first, then stream them in order
+        std::vector<MeshBlobEntry> entries(meshes.size());
+        uint64_t cursor = sizeof(MeshBlobHeader) + sizeof(MeshBlobEntry) * meshes.size();
+        auto place = [&cursor](uint64_t bytes)
+        {
+            cursor = alignUp(cursor);
+            const uint64_t offset = cursor;
+            cursor += bytes;
+            return offset;
+        };
+
+        for(size_t i = 0; i < meshes.size(); i++)
+        {
+            const Mesh&    mesh  = meshes[i];
+            MeshBlobEntry& entry = entries[i];
+            const std::string name = i < names.size() ? names[i] : std::string();
+
+            Eigen::AlignedBox3f bounds;
+            for(auto& vertex : mesh.vertices) bounds.extend(vertex.position);
+            if(mesh.vertices.empty()) bounds = Eigen::AlignedBox3f(Eigen::Vector3f::Zero(), Eigen::Vector3f::Zero());
+            for(int k = 0; k < 3; k++)
+            {
+                entry.bounds_min[k] = bounds.min()[k];
+                entry.bounds_max[k] = bounds.max()[k];
+            }
+
+            entry.vertex_count                = static_cast<uint32_t>(mesh.vertices.size());
+            entry.index_count                 = static_cast<uint32_t>(mesh.indices.size());
+            entry.lod_count                   = static_cast<uint32_t>(mesh.lods.size());
+            entry.meshlet_count               = static_cast<uint32_t>(mesh.meshlets.size());
+            entry.meshlet_vertex_count        = static_cast<uint32_t>(mesh.meshlet_vertices.size());
+            entry.meshlet_triangle_byte_count = static_cast<uint32_t>(mesh.meshlet_triangles.size());
+            entry.name_length                 = static_cast<uint32_t>(name.size());
+            entry.has_tangents                = mesh.tangents.size() == mesh.vertices.size() && !mesh.tangents.empty();
+
+            entry.vertices_offset          = place(mesh.vertices.size() * sizeof(MeshVertex));
+            entry.tangents_offset          = place(entry.has_tangents ? mesh.tangents.size() * sizeof(Eigen::Vector4f) : 0);
+            entry.indices_offset           = place(mesh.indices.size() * sizeof(uint32_t));
+            entry.lods_offset              = place(mesh.lods.size() * sizeof(MeshLod));
+            entry.meshlets_offset          = place(mesh.meshlets.size() * sizeof(Meshlet));
+            entry.meshlet_vertices_offset  = place(mesh.meshlet_vertices.size() * sizeof(uint32_t));
+            entry.meshlet_triangles_offset = place(mesh.meshlet_triangles.size());
+            entry.name_offset              = place(name.size());
+        }
+        header.file_size = cursor;
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if(!out) return false;
+
+        uint64_t written = 0;
+        auto write = [&](const void* data, uint64_t bytes)
+        {
+            out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+            written += bytes;
+        };
+        auto seek = [&](uint64_t offset)
+        {
+            static const char zeros[kMeshBlobAlignment]{};
+            write(zeros, offset - written);
+        };
+
+        write(&header, sizeof(header));
+        write(entries.data(), entries.size() * sizeof(MeshBlobEntry));
+        for(size_t i = 0; i < meshes.size(); i++)
+        {
+            const Mesh&          mesh  = meshes[i];
+            const MeshBlobEntry& entry = entries[i];
+
+            seek(entry.vertices_offset);
+            write(mesh.vertices.data(), mesh.vertices.size() * sizeof(MeshVertex));
+            seek(entry.tangents_offset);
+            if(entry.has_tangents) write(mesh.tangents.data(), mesh.tangents.size() * sizeof(Eigen::Vector4f));
+            seek(entry.indices_offset);
+            write(mesh.indices.data(), mesh.indices.size() * sizeof(uint32_t));
+            seek(entry.lods_offset);
+            write(mesh.lods.data(), mesh.lods.size() * sizeof(MeshLod));
+            seek(entry.meshlets_offset);
+            write(mesh.meshlets.data(), mesh.meshlets.size() * sizeof(Meshlet));
+            seek(entry.meshlet_vertices_offset);
+            write(mesh.meshlet_vertices.data(), mesh.meshlet_vertices.size() * sizeof(uint32_t));
+            seek(entry.meshlet_triangles_offset);
+            write(mesh.meshlet_triangles.data(), mesh.meshlet_triangles.size());
+            seek(entry.name_offset);
+            if(i < names.size()) write(names[i].data(), names[i].size());
+        }
+        return static_cast<bool>(out);
+    }
+
+    void copyMesh(const MeshView& view, Mesh& mesh)
+    {
+        mesh.vertices.assign(view.vertices, view.vertices + view.vertex_count);
+        if(view.tangents)
+        {
+            mesh.tangents.assign(view.tangents, view.tangents + view.vertex_count);
+        }
+        else
+        {
+            mesh.tangents.clear();
+        }
+        mesh.indices.assign(view.indices, view.indices + view.index_count);
+        mesh.lods.assign(view.lods, view.lods + view.lod_count);
+        mesh.meshlets.assign(view.meshlets, view.meshlets + view.meshlet_count);
+        mesh.meshlet_vertices.assign(view.meshlet_vertices, view.meshlet_vertices + view.meshlet_vertex_count);
+        mesh.meshlet_triangles.assign(view.meshlet_triangles, view.meshlet_triangles + view.meshlet_triangle_byte_count);
+    }
+} // namespace lux::engine::resource
@@ -0,0 +1,485 @@
+#include "lux-engine/resource/mesh/MeshSimplifier.hpp"
+#include <lux-engine/platform/cxx/Parallel.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace lux::engine::resource
+{
+    namespace
+    {
+        inline uint64_t edgeKey(uint32_t from, uint32_t to) noexcept
+        {
+            return (static_cast<uint64_t>(from) << 32) | to;
+        }
+
+        inline bool hasEdge(const std::vector<uint64_t>& sorted_edges, uint32_t from, uint32_t to)
+        {
+            return std::binary_search(sorted_edges.begin(), sorted_edges.end(), edgeKey(from, to));
+        }
+
+        struct Collapse
+        {
+            uint32_t from;
+            uint32_t to;
+            float    cost;
+        };
+
+        // border edges are weighted heavier than faces so silhouettes survive longer
+        constexpr double kBorderWeight    = 10.0;
+        // reject collapses rotating an adjacent triangle further than ~75 degrees
+        constexpr float  kFlipThreshold   = 0.25f;
+    }
+
+    MeshSimplifier::MeshSimplifier(const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices)
+        : _vertices(vertices)
+    {
+        buildWedges();
+        classifyVertices(indices);
+
+        Eigen::AlignedBox3f box;
+        for(auto& vertex : _vertices)
+        {
+            box.extend(vertex.position);
+        }
+        _extent = _vertices.empty() ? 1.0f : std::max(box.sizes().maxCoeff(), 1e-12f);
+    }
+
+    void MeshSimplifier::setAttributeWeight(float weight)
+    {
+        _attribute_weight = weight;
+    }
+
+    void MeshSimplifier::quadricAddPlane(Quadric& q, const Eigen::Vector3d& n, double d, double weight)
+    {
+        q.a00 += weight * n[0] * n[0];
+        q.a11 += weight * n[1] * n[1];
+        q.a22 += weight * n[2] * n[2];
+        q.a01 += weight * n[0] * n[1];
+        q.a02 += weight * n[0] * n[2];
+        q.a12 += weight * n[1] * n[2];
+        q.b0  += weight * n[0] * d;
+        q.b1  += weight * n[1] * d;
+        q.b2  += weight * n[2] * d;
+        q.c   += weight * d * d;
+        q.w   += weight;
+    }
+
+    void MeshSimplifier::quadricAdd(Quadric& q, const Quadric& r)
+    {
+        q.a00 += r.a00; q.a11 += r.a11; q.a22 += r.a22;
+        q.a01 += r.a01; q.a02 += r.a02; q.a12 += r.a12;
+        q.b0  += r.b0;  q.b1  += r.b1;  q.b2  += r.b2;
+        q.c   += r.c;   q.w   += r.w;
+    }
+
+    double MeshSimplifier::quadricError(const Quadric& q, const Eigen::Vector3f& p)
+    {
+        const double x = p[0], y = p[1], z = p[2];
+        const double rx = q.a00 * x + q.a01 * y + q.a02 * z + 2 * q.b0;
+        const double ry = q.a01 * x + q.a11 * y + q.a12 * z + 2 * q.b1;
+        const double rz = q.a02 * x + q.a12 * y + q.a22 * z + 2 * q.b2;
+        const double error = rx * x + ry * y + rz * z + q.c;
+        return q.w > 0 ? std::fabs(error) / q.w : 0.0;
+    }
+
+    void MeshSimplifier::buildWedges()
+    {
+        const size_t vertex_count = _vertices.size();
+        _remap = resource::buildPositionRemap(_vertices);
+        _wedge.resize(vertex_count);
+
+        for(uint32_t i = 0; i < vertex_count; i++)
+        {
+            _wedge[i] = i;
+        }
+
+        for(uint32_t i = 0; i < vertex_count; i++)
+        {
+            const uint32_t r = _remap[i];
+            if(r != i)
+            {
+                _wedge[i] = _wedge[r];
+                _wedge[r] = i;
+            }
+        }
+    }
+
+    void MeshSimplifier::classifyVertices(const std::vector<uint32_t>& indices)
+    {
+        std::vector<uint64_t> edges;
+        edges.reserve(indices.size());
+        for(size_t i = 0; i + 2 < indices.size(); i += 3)
+        {
+            for(int k = 0; k < 3; k++)
+            {
+                const uint32_t a = _remap[indices[i + k]];
+                const uint32_t b = _remap[indices[i + (k + 1) % 3]];
+                if(a != b) edges.push_back(edgeKey(a, b));
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+
+        std::vector<uint8_t> border(_vertices.size(), 0);
+        std::vector<uint8_t> complex(_vertices.size(), 0);
+        for(size_t i = 0; i < edges.size(); i++)
+        {
+            const uint32_t a = static_cast<uint32_t>(edges[i] >> 32);
+            const uint32_t b = static_cast<uint32_t>(edges[i]);
+            // the same directed edge twice means more than two faces meet there
+            if(i + 1 < edges.size() && edges[i + 1] == edges[i])
+            {
+                complex[a] = complex[b] = 1;
+            }
+            if(!hasEdge(edges, b, a))
+            {
+                border[a] = border[b] = 1;
+            }
+        }
+
+        _kind.resize(_vertices.size());
+        for(size_t i = 0; i < _vertices.size(); i++)
+        {
+            const uint32_t r = _remap[i];
+            const bool has_seam = _wedge[r] != r;
+            if(complex[r] || (has_seam && border[r]))
+                _kind[i] = VertexKind::LOCKED;
+            else if(has_seam)
+                _kind[i] = VertexKind::SEAM;
+            else if(border[r])
+                _kind[i] = VertexKind::BORDER;
+            else
+                _kind[i] = VertexKind::MANIFOLD;
+        }
+    }
+
+    void MeshSimplifier::buildQuadrics(const std::vector<uint32_t>& indices, std::vector<Quadric>& quadrics) const
+    {
+        quadrics.assign(_vertices.size(), Quadric{});
+
+        std::vector<uint64_t> edges;
+        edges.reserve(indices.size());
+        for(size_t i = 0; i + 2 < indices.size(); i += 3)
+        {
+            for(int k = 0; k < 3; k++)
+            {
+                edges.push_back(edgeKey(_remap[indices[i + k]], _remap[indices[i + (k + 1) % 3]]));
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+
+        for(size_t i = 0; i + 2 < indices.size(); i += 3)
+        {
+            const uint32_t r[3]{_remap[indices[i]], _remap[indices[i + 1]], _remap[indices[i + 2]]};
+            const Eigen::Vector3d p[3]{
+                _vertices[r[0]].position.cast<double>(),
+                _vertices[r[1]].position.cast<double>(),
+                _vertices[r[2]].position.cast<double>()
+            };
+
+            Eigen::Vector3d normal = (p[1] - p[0]).cross(p[2] - p[0]);
+            const double double_area = normal.norm();
+            if(double_area <= 0) continue;
+            normal /= double_area;
+
+            const double distance = -normal.dot(p[0]);
+            for(auto vertex : r)
+            {
+                quadricAddPlane(quadrics[vertex], normal, distance, double_area * 0.5);
+            }
+
+            // constrain open edges with a plane perpendicular to the face
+            for(int k = 0; k < 3; k++)
+            {
+                const uint32_t a = r[k], b = r[(k + 1) % 3];
+                if(a == b || hasEdge(edges, b, a)) continue;
+
+                const Eigen::Vector3d edge = p[(k + 1) % 3] - p[k];
+                const double length = edge.norm();
+                const Eigen::Vector3d edge_normal = normal.cross(edge).normalized();
+                const double edge_distance = -edge_normal.dot(p[k]);
+                quadricAddPlane(quadrics[a], edge_normal, edge_distance, length * length * kBorderWeight);
+                quadricAddPlane(quadrics[b], edge_normal, edge_distance, length * length * kBorderWeight);
+            }
+        }
+    }
+
+    float MeshSimplifier::attributeDistance(uint32_t from, uint32_t to) const
+    {
+        const MeshVertex& a = _vertices[from];
+        const MeshVertex& b = _vertices[to];
+        return (a.normal - b.normal).squaredNorm() + (a.uv - b.uv).squaredNorm();
+    }
+
+    float MeshSimplifier::simplify(
+        const std::vector<uint32_t>& indices, size_t target_index_count,
+        float target_error, std::vector<uint32_t>& result)
+    {
+        result = indices;
+        if(indices.size() <= target_index_count) return 0.0f;
+
+        const size_t vertex_count = _vertices.size();
+        std::vector<Quadric> quadrics;
+        buildQuadrics(indices, quadrics);
+
+        const double error_limit      = double(target_error) * target_error * _extent * _extent;
+        const double attribute_scale  = double(_attribute_weight) * _attribute_weight * _extent * _extent;
+        double       result_error     = 0.0;
+
+        std::vector<uint32_t>   adjacency_offsets(vertex_count + 1);
+        std::vector<uint32_t>   adjacency;
+        std::vector<uint64_t>   edges;
+        std::vector<Collapse>   collapses;
+        std::vector<uint32_t>   collapse_remap(vertex_count);
+        std::vector<uint8_t>    collapse_locked(vertex_count);
+
+        auto canCollapse = [&](uint32_t from, uint32_t to)
+        {
+            switch(_kind[from])
+            {
+            case VertexKind::MANIFOLD:
+                return true;
+            case VertexKind::BORDER:
+                return (_kind[to] == VertexKind::BORDER || _kind[to] == VertexKind::LOCKED)
+                    && (!hasEdge(edges, to, from) || !hasEdge(edges, from, to));
+            case VertexKind::SEAM:
+                return _kind[to] == VertexKind::SEAM || _kind[to] == VertexKind::LOCKED;
+            default:
+                return false;
+            }
+        };
+
+        auto collapseCost = [&](uint32_t from, uint32_t to)
+        {
+            Quadric q = quadrics[from];
+            quadricAdd(q, quadrics[to]);
+            double cost = quadricError(q, _vertices[to].position);
+
+            uint32_t w = from;
+            do
+            {
+                float closest = std::numeric_limits<float>::max();
+                uint32_t t = to;
+                do
+                {
+                    closest = std::min(closest, attributeDistance(w, t));
+                    t = _wedge[t];
+                } while(t != to);
+                cost += attribute_scale * closest;
+                w = _wedge[w];
+            } while(w != from);
+
+            return cost;
+        };
+
+        auto findPartner = [&](uint32_t wedge, uint32_t to)
+        {
+            for(uint32_t a = adjacency_offsets[wedge]; a < adjacency_offsets[wedge + 1]; a++)
+            {
+                const uint32_t* triangle = &result[adjacency[a] * 3];
+                for(int k = 0; k < 3; k++)
+                {
+                    if(_remap[triangle[k]] == to) return triangle[k];
+                }
+            }
+            return ~0u;
+        };
+
+        // true if moving `from` onto `to` turns any surviving triangle around `wedge` over
+        auto flips = [&](uint32_t wedge, uint32_t from, uint32_t to)
+        {
+            const Eigen::Vector3f& target = _vertices[to].position;
+            for(uint32_t a = adjacency_offsets[wedge]; a < adjacency_offsets[wedge + 1]; a++)
+            {
+                const uint32_t* triangle = &result[adjacency[a] * 3];
+                const uint32_t r[3]{_remap[triangle[0]], _remap[triangle[1]], _remap[triangle[2]]};
+                if(r[0] == to || r[1] == to || r[2] == to) continue;
+
+                const Eigen::Vector3f& p0 = _vertices[r[0]].position;
+                const Eigen::Vector3f& p1 = _vertices[r[1]].position;
+                const Eigen::Vector3f& p2 = _vertices[r[2]].position;
+                const Eigen::Vector3f& q0 = r[0] == from ? target : p0;
+                const Eigen::Vector3f& q1 = r[1] == from ? target : p1;
+                const Eigen::Vector3f& q2 = r[2] == from ? target : p2;
+                const Eigen::Vector3f before = (p1 - p0).cross(p2 - p0);
+                const Eigen::Vector3f after  = (q1 - q0).cross(q2 - q0);
+                if(before.dot(after) < kFlipThreshold * before.norm() * after.norm()) return true;
+            }
+            return false;
+        };
+
+        while(result.size() > target_index_count)
+        {
+            const size_t triangle_count = result.size() / 3;
+
+            // vertex -> triangle adjacency
+            std::fill(adjacency_offsets.begin(), adjacency_offsets.end(), 0);
+            for(auto index : result) adjacency_offsets[index + 1]++;
+            for(size_t i = 0; i < vertex_count; i++) adjacency_offsets[i + 1] += adjacency_offsets[i];
+            adjacency.resize(result.size());
+            {
+                std::vector<uint32_t> cursor(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+                for(size_t i = 0; i < result.size(); i++)
+                {
+                    adjacency[cursor[result[i]]++] = static_cast<uint32_t>(i / 3);
+                }
+            }
+
+            // directed position edges, also used to find open edges for border collapses
+            edges.clear();
+            for(size_t i = 0; i < result.size(); i += 3)
+            {
+                for(int k = 0; k < 3; k++)
+                {
+                    const uint32_t a = _remap[result[i + k]];
+                    const uint32_t b = _remap[result[i + (k + 1) % 3]];
+                    if(a != b) edges.push_back(edgeKey(a, b));
+                }
+            }
+            std::sort(edges.begin(), edges.end());
+            edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+            collapses.clear();
+            for(auto key : edges)
+            {
+                const uint32_t a = static_cast<uint32_t>(key >> 32);
+                const uint32_t b = static_cast<uint32_t>(key);
+                // visit every undirected edge once
+                if(a > b && hasEdge(edges, b, a)) continue;
+
+                const bool ab = canCollapse(a, b);
+                const bool ba = canCollapse(b, a);
+                if(!ab && !ba) continue;
+
+                const double cost_ab = ab ? collapseCost(a, b) : std::numeric_limits<double>::max();
+                const double cost_ba = ba ? collapseCost(b, a) : std::numeric_limits<double>::max();
+                if(cost_ab <= cost_ba)
+                    collapses.push_back({a, b, static_cast<float>(cost_ab)});
+                else
+                    collapses.push_back({b, a, static_cast<float>(cost_ba)});
+            }
+            std::sort(collapses.begin(), collapses.end(),
+                [](const Collapse& l, const Collapse& r){ return l.cost < r.cost; });
+
+            for(uint32_t i = 0; i < vertex_count; i++) collapse_remap[i] = i;
+            std::fill(collapse_locked.begin(), collapse_locked.end(), 0);
+
+            // each collapse removes about two triangles
+            const size_t target_triangles = target_index_count / 3;
+            const size_t collapse_goal    = std::max<size_t>((triangle_count - target_triangles) / 2, 1);
+            size_t       collapse_count   = 0;
+
+            for(auto& collapse : collapses)
+            {
+                if(collapse.cost > error_limit) break;
+                if(collapse_locked[collapse.from] || collapse_locked[collapse.to]) continue;
+
+                bool valid = true;
+                uint32_t w = collapse.from;
+                do
+                {
+                    // every wedge of `from` needs a wedge of `to` it shares an edge with
+                    const uint32_t partner = findPartner(w, collapse.to);
+                    if(partner == ~0u || flips(w, collapse.from, collapse.to))
+                    {
+                        valid = false;
+                    }
+                    collapse_remap[w] = partner;
+                    w = _wedge[w];
+                } while(w != collapse.from && valid);
+
+                if(!valid)
+                {
+                    w = collapse.from;
+                    do { collapse_remap[w] = w; w = _wedge[w]; } while(w != collapse.from);
+                    continue;
+                }
+
+                // lock the one-ring so flip checks in this pass stay exact
+                w = collapse.from;
+                do
+                {
+                    for(uint32_t a = adjacency_offsets[w]; a < adjacency_offsets[w + 1]; a++)
+                    {
+                        const uint32_t* triangle = &result[adjacency[a] * 3];
+                        for(int k = 0; k < 3; k++) collapse_locked[_remap[triangle[k]]] = 1;
+                    }
+                    w = _wedge[w];
+                } while(w != collapse.from);
+                collapse_locked[collapse.to] = 1;
+
+                quadricAdd(quadrics[collapse.to], quadrics[collapse.from]);
+                result_error = std::max(result_error, double(collapse.cost));
+
+                if(++collapse_count >= collapse_goal) break;
+            }
+
+            if(collapse_count == 0) break;
+
+            size_t write = 0;
+            for(size_t i = 0; i < result.size(); i += 3)
+            {
+                const uint32_t a = collapse_remap[result[i]];
+                const uint32_t b = collapse_remap[result[i + 1]];
+                const uint32_t c = collapse_remap[result[i + 2]];
+                const uint32_t ra = _remap[a], rb = _remap[b], rc = _remap[c];
+                if(ra == rb || rb == rc || rc == ra) continue;
+
+                result[write++] = a;
+                result[write++] = b;
+                result[write++] = c;
+            }
+            result.resize(write);
+        }
+
+        return static_cast<float>(std::sqrt(result_error) / _extent);
+    }
+
+    void generateLodChain(Mesh& mesh, const LodChainSettings& settings)
+    {
+        mesh.lods.clear();
+        if(mesh.indices.empty()) return;
+
+        mesh.lods.push_back({0, static_cast<uint32_t>(mesh.indices.size()), 0.0f, 0, 0});
+
+        MeshSimplifier simplifier(mesh.vertices, mesh.indices);
+        simplifier.setAttributeWeight(settings.attribute_weight);
+
+        std::vector<uint32_t> source(mesh.indices);
+        std::vector<uint32_t> simplified;
+        float error = 0.0f;
+
+        while(mesh.lods.size() < settings.max_lod_count && source.size() > settings.min_index_count)
+        {
+            const size_t target = static_cast<size_t>(source.size() / 3 * settings.reduction_ratio) * 3;
+            // errors of successive levels add up, each level is simplified from the previous one
+            const float level_error = simplifier.simplify(source, target, settings.max_error - error, simplified);
+
+            // stop once the error budget no longer buys a meaningful reduction
+            if(simplified.empty() || simplified.size() * 20 > source.size() * 19) break;
+
+            error += level_error;
+            mesh.lods.push_back({
+                static_cast<uint32_t>(mesh.indices.size()),
+                static_cast<uint32_t>(simplified.size()),
+                error,
+                0,
+                0
+            });
+            mesh.indices.insert(mesh.indices.end(), simplified.begin(), simplified.end());
+            source.swap(simplified);
+        }
+    }
+
+    void generateLodChains(std::vector<Mesh>& meshes, const LodChainSettings& settings)
+    {
+        platform::parallelFor(0, meshes.size(), 1,
+            [&meshes, &settings](size_t begin, size_t end)
+            {
+                for(size_t i = begin; i < end; i++)
+                {
+                    generateLodChain(meshes[i], settings);
+                }
+            }
+        );
+    }
+} // namespace lux::engine::resource
@@ -0,0 +1,292 @@
+#include "lux-engine/resource/mesh/MeshletBuilder.hpp"
+#include <lux-engine/platform/cxx/Parallel.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace lux::engine::resource
+{
+    namespace
+    {
+        // cones wider than this (dot below the threshold) can never be culled, don't bother
+        constexpr float kMinConeDot = 0.1f;
+
+        // value initialization leaves the Eigen members alone, spell them out
+        Meshlet emptyMeshlet()
+        {
+            Meshlet meshlet{};
+            meshlet.center    = Eigen::Vector3f::Zero();
+            meshlet.cone_apex = Eigen::Vector3f::Zero();
+            meshlet.cone_axis = Eigen::Vector3f::Zero();
+            return meshlet;
+        }
+
+        void computeBounds(const Mesh& mesh, Meshlet& meshlet)
+        {
+            const uint32_t* local_vertices = &mesh.meshlet_vertices[meshlet.vertex_offset];
+            auto position = [&](uint32_t local) -> const Eigen::Vector3f&
+            {
+                return mesh.vertices[local_vertices[local]].position;
+            };
+
+            // Ritter's bounding sphere
+            uint32_t a = 0, b = 0;
+            for(uint32_t i = 0; i < meshlet.vertex_count; i++)
+            {
+                if((position(i) - position(0)).squaredNorm() > (position(a) - position(0)).squaredNorm()) a = i;
+            }
+            for(uint32_t i = 0; i < meshlet.vertex_count; i++)
+            {
+                if((position(i) - position(a)).squaredNorm() > (position(b) - position(a)).squaredNorm()) b = i;
+            }
+            Eigen::Vector3f center = (position(a) + position(b)) * 0.5f;
+            float radius = (position(b) - position(a)).norm() * 0.5f;
+            for(uint32_t i = 0; i < meshlet.vertex_count; i++)
+            {
+                const float distance = (position(i) - center).norm();
+                if(distance > radius)
+                {
+                    const float grown = (radius + distance) * 0.5f;
+                    center += (position(i) - center) * ((grown - radius) / distance);
+                    radius = grown;
+                }
+            }
+            meshlet.center = center;
+            meshlet.radius = radius;
+
+            // normal cone
+            const uint8_t* triangles = &mesh.meshlet_triangles[meshlet.triangle_offset];
+            std::vector<Eigen::Vector3f> normals;
+            std::vector<uint32_t>        corners;
+            normals.reserve(meshlet.triangle_count);
+            corners.reserve(meshlet.triangle_count);
+
+            Eigen::Vector3f axis = Eigen::Vector3f::Zero();
+            for(uint32_t i = 0; i < meshlet.triangle_count; i++)
+            {
+                const Eigen::Vector3f& p0 = position(triangles[i * 3]);
+                const Eigen::Vector3f& p1 = position(triangles[i * 3 + 1]);
+                const Eigen::Vector3f& p2 = position(triangles[i * 3 + 2]);
+                Eigen::Vector3f normal = (p1 - p0).cross(p2 - p0);
+                const float length = normal.norm();
+                if(length <= 0) continue;
+
+                normals.push_back(normal / length);
+                corners.push_back(triangles[i * 3]);
+                axis += normals.back();
+            }
+
+            meshlet.cone_apex   = center;
+            meshlet.cone_axis   = Eigen::Vector3f::UnitZ();
+            meshlet.cone_cutoff = 1.0f;
+
+            const float axis_length = axis.norm();
+            if(axis_length <= 0) return;
+            axis /= axis_length;
+            meshlet.cone_axis = axis;
+
+            float min_dot = 1.0f;
+            for(auto& normal : normals) min_dot = std::min(min_dot, normal.dot(axis));
+            if(min_dot <= kMinConeDot) return;
+
+            // move the apex back along the axis until it lies behind every triangle plane
+            float max_t = 0.0f;
+            for(size_t i = 0; i < normals.size(); i++)
+            {
+                const float dc = (center - position(corners[i])).dot(normals[i]);
+                const float dn = axis.dot(normals[i]);
+                max_t = std::max(max_t, dc / dn);
+            }
+            meshlet.cone_apex   = center - axis * max_t;
+            meshlet.cone_cutoff = std::sqrt(1.0f - min_dot * min_dot);
+        }
+
+        void buildRange(Mesh& mesh, MeshLod& lod, const MeshletSettings& settings)
+        {
+            const size_t    vertex_count    = mesh.vertices.size();
+            const uint32_t  triangle_count  = lod.index_count / 3;
+            const uint32_t* indices         = &mesh.indices[lod.index_offset];
+            const size_t    max_vertices    = std::min<size_t>(settings.max_vertices, 256);
+            const size_t    max_triangles   = std::min<size_t>(settings.max_triangles, 512);
+
+            lod.meshlet_offset = static_cast<uint32_t>(mesh.meshlets.size());
+            lod.meshlet_count  = 0;
+            if(triangle_count == 0) return;
+
+            // vertex -> triangle adjacency
+            std::vector<uint32_t> adjacency_offsets(vertex_count + 1, 0);
+            std::vector<uint32_t> adjacency(triangle_count * 3);
+            for(uint32_t i = 0; i < triangle_count * 3; i++) adjacency_offsets[indices[i] + 1]++;
+            for(size_t i = 0; i < vertex_count; i++) adjacency_offsets[i + 1] += adjacency_offsets[i];
+            {
+                std::vector<uint32_t> cursor(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+                for(uint32_t i = 0; i < triangle_count * 3; i++) adjacency[cursor[indices[i]]++] = i / 3;
+            }
+
+            std::vector<Eigen::Vector3f> centroids(triangle_count);
+            std::vector<Eigen::Vector3f> normals(triangle_count);
+            for(uint32_t i = 0; i < triangle_count; i++)
+            {
+                const Eigen::Vector3f& p0 = mesh.vertices[indices[i * 3]].position;
+                const Eigen::Vector3f& p1 = mesh.vertices[indices[i * 3 + 1]].position;
+                const Eigen::Vector3f& p2 = mesh.vertices[indices[i * 3 + 2]].position;
+                centroids[i] = (p0 + p1 + p2) / 3.0f;
+                normals[i]   = (p1 - p0).cross(p2 - p0).normalized();
+            }
+
+            std::vector<uint8_t>  emitted(triangle_count, 0);
+            std::vector<uint32_t> candidate_stamp(triangle_count, ~0u);
+            std::vector<uint32_t> local(vertex_count, ~0u);
+            std::vector<uint32_t> candidates;
+            std::vector<uint32_t> reordered;
+            reordered.reserve(lod.index_count);
+
+            Meshlet current = emptyMeshlet();
+            Eigen::Vector3f centroid_sum = Eigen::Vector3f::Zero();
+            Eigen::Vector3f normal_sum   = Eigen::Vector3f::Zero();
+            uint32_t meshlet_id = 0;
+            uint32_t cursor     = 0;
+
+            auto beginMeshlet = [&]()
+            {
+                current = emptyMeshlet();
+                current.vertex_offset   = static_cast<uint32_t>(mesh.meshlet_vertices.size());
+                current.triangle_offset = static_cast<uint32_t>(mesh.meshlet_triangles.size());
+                current.index_offset    = static_cast<uint32_t>(lod.index_offset + reordered.size());
+                centroid_sum.setZero();
+                normal_sum.setZero();
+                candidates.clear();
+            };
+
+            auto finishMeshlet = [&]()
+            {
+                if(current.triangle_count == 0) return;
+                for(uint32_t i = 0; i < current.vertex_count; i++)
+                {
+                    local[mesh.meshlet_vertices[current.vertex_offset + i]] = ~0u;
+                }
+                computeBounds(mesh, current);
+                mesh.meshlets.push_back(current);
+                lod.meshlet_count++;
+                meshlet_id++;
+            };
+
+            auto newVertexCount = [&](uint32_t triangle)
+            {
+                uint32_t count = 0;
+                for(int k = 0; k < 3; k++) count += local[indices[triangle * 3 + k]] == ~0u;
+                return count;
+            };
+
+            auto pickCandidate = [&]()
+            {
+                uint32_t best        = ~0u;
+                uint32_t best_extra  = ~0u;
+                float    best_score  = std::numeric_limits<float>::max();
+                const Eigen::Vector3f center = centroid_sum / std::max<float>(float(current.triangle_count), 1.0f);
+                const Eigen::Vector3f axis   = normal_sum.normalized();
+
+                for(size_t i = 0; i < candidates.size();)
+                {
+                    const uint32_t triangle = candidates[i];
+                    if(emitted[triangle])
+                    {
+                        candidates[i] = candidates.back();
+                        candidates.pop_back();
+                        continue;
+                    }
+
+                    const uint32_t extra = newVertexCount(triangle);
+                    const float    score = (centroids[triangle] - center).squaredNorm()
+                                         * (1.0f + settings.cone_weight * (1.0f - normals[triangle].dot(axis)));
+                    if(extra < best_extra || (extra == best_extra && score < best_score))
+                    {
+                        best = triangle;
+                        best_extra = extra;
+                        best_score = score;
+                    }
+                    i++;
+                }
+                return best;
+            };
+
+            beginMeshlet();
+            while(true)
+            {
+                uint32_t triangle = pickCandidate();
+                if(triangle == ~0u)
+                {
+                    while(cursor < triangle_count && emitted[cursor]) cursor++;
+                    if(cursor == triangle_count) break;
+                    triangle = cursor;
+                }
+
+                if(current.vertex_count + newVertexCount(triangle) > max_vertices
+                    || current.triangle_count + 1 > max_triangles)
+                {
+                    finishMeshlet();
+                    beginMeshlet();
+                }
+
+                for(int k = 0; k < 3; k++)
+                {
+                    const uint32_t vertex = indices[triangle * 3 + k];
+                    if(local[vertex] == ~0u)
+                    {
+                        local[vertex] = current.vertex_count++;
+                        mesh.meshlet_vertices.push_back(vertex);
+                    }
+                    mesh.meshlet_triangles.push_back(static_cast<uint8_t>(local[vertex]));
+                    reordered.push_back(vertex);
+
+                    for(uint32_t a = adjacency_offsets[vertex]; a < adjacency_offsets[vertex + 1]; a++)
+                    {
+                        const uint32_t neighbor = adjacency[a];
+                        if(!emitted[neighbor] && candidate_stamp[neighbor] != meshlet_id)
+                        {
+                            candidate_stamp[neighbor] = meshlet_id;
+                            candidates.push_back(neighbor);
+                        }
+                    }
+                }
+                emitted[triangle] = 1;
+                current.triangle_count++;
+                centroid_sum += centroids[triangle];
+                if(normals[triangle].allFinite()) normal_sum += normals[triangle];
+            }
+            finishMeshlet();
+
+            std::copy(reordered.begin(), reordered.end(), mesh.indices.begin() + lod.index_offset);
+        }
+    }
+
+    void buildMeshlets(Mesh& mesh, const MeshletSettings& settings)
+    {
+        mesh.meshlets.clear();
+        mesh.meshlet_vertices.clear();
+        mesh.meshlet_triangles.clear();
+
+        if(mesh.lods.empty())
+        {
+            mesh.lods.push_back({0, static_cast<uint32_t>(mesh.indices.size()), 0.0f, 0, 0});
+        }
+
+        for(auto& lod : mesh.lods)
+        {
+            buildRange(mesh, lod, settings);
+        }
+    }
+
+    void buildMeshlets(std::vector<Mesh>& meshes, const MeshletSettings& settings)
+    {
+        platform::parallelFor(0, meshes.size(), 1,
+            [&meshes, &settings](size_t begin, size_t end)
+            {
+                for(size_t i = begin; i < end; i++)
+                {
+                    buildMeshlets(meshes[i], settings);
+                }
+            }
+        );
+    }
+} // namespace lux::engine::resource
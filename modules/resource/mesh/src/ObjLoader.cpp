@@ -0,0 +1,484 @@
+#include "lux-engine/resource/mesh/ObjLoader.hpp"
+#include <lux-engine/platform/cxx/FastFloat.hpp>
+#include <lux-engine/platform/cxx/MappedFile.hpp>
+#include <lux-engine/platform/cxx/Parallel.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+namespace lux::engine::resource
+{
+    namespace
+    {
+        // corner components are either absolute (top bit clear) or relative to the chunk
+        // (negative obj indices, top bit set, biased by kRelativeBias)
+        constexpr uint32_t kRelativeFlag    = 0x80000000u;
+        constexpr int64_t  kRelativeBias    = int64_t(1) << 30;
+        constexpr uint32_t kMissing         = 0xffffffffu;
+        // aim for chunks big enough to amortize thread start up
+        constexpr size_t   kMinChunkSize    = 1 << 20;
+
+        struct ObjBatch
+        {
+            size_t  first_triangle;
+            int32_t object;     // index into ObjChunk::names, -1 inherits the previous chunk's state
+            int32_t material;
+        };
+
+        struct ObjChunk
+        {
+            std::vector<float>          positions;
+            std::vector<float>          uvs;
+            std::vector<float>          normals;
+            std::vector<uint32_t>       corners;    // v, vt, vn per corner, 3 corners per triangle
+            std::vector<ObjBatch>       batches{ObjBatch{0, -1, -1}};
+            std::vector<std::string>    names;
+            std::vector<std::string>    libraries;
+        };
+
+        inline bool isBlank(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\r';
+        }
+
+        inline const char* skipBlank(const char* p, const char* end)
+        {
+            while(p < end && isBlank(*p)) p++;
+            return p;
+        }
+
+        inline std::string restOfLine(const char* p, const char* end)
+        {
+            p = skipBlank(p, end);
+            while(end > p && isBlank(end[-1])) end--;
+            return std::string(p, end);
+        }
+
+        inline bool startsWith(const char* p, const char* end, const char* keyword)
+        {
+            const size_t length = std::strlen(keyword);
+            return static_cast<size_t>(end - p) > length
+                && std::memcmp(p, keyword, length) == 0
+                && isBlank(p[length]);
+        }
+
+        // obj index -> encoded corner component, `count` is the number of elements parsed so far in this chunk
+        inline const char* parseIndex(const char* p, const char* end, size_t count, uint32_t& index)
+        {
+            bool negative = false;
+            if(p < end && *p == '-')
+            {
+                negative = true;
+                p++;
+            }
+            int64_t value = 0;
+            const char* digits = p;
+            for(; p < end && static_cast<unsigned char>(*p - '0') < 10; p++)
+            {
+                value = value * 10 + (*p - '0');
+            }
+            if(p == digits || value == 0)
+            {
+                index = kMissing;
+            }
+            else if(negative)
+            {
+                index = kRelativeFlag | static_cast<uint32_t>(int64_t(count) - value + kRelativeBias);
+            }
+            else
+            {
+                index = static_cast<uint32_t>(value - 1) & ~kRelativeFlag;
+            }
+            return p;
+        }
+
+        inline uint32_t resolveIndex(uint32_t index, size_t chunk_offset, size_t total)
+        {
+            if(index == kMissing) return kMissing;
+            int64_t resolved = index & kRelativeFlag
+                ? int64_t(chunk_offset) + int64_t(index & ~kRelativeFlag) - kRelativeBias
+                : int64_t(index);
+            return resolved >= 0 && resolved < int64_t(total) ? static_cast<uint32_t>(resolved) : kMissing;
+        }
+
+        void setState(ObjChunk& chunk, size_t triangle_count, int32_t object, int32_t material)
+        {
+            if(chunk.batches.back().first_triangle != triangle_count)
+            {
+                chunk.batches.push_back(chunk.batches.back());
+                chunk.batches.back().first_triangle = triangle_count;
+            }
+            if(object   != -2) chunk.batches.back().object   = object;
+            if(material != -2) chunk.batches.back().material = material;
+        }
+
+        void parseChunk(const char* begin, const char* end, ObjChunk& chunk)
+        {
+            std::vector<uint32_t> polygon;
+            const char* line = begin;
+            while(line < end)
+            {
+                const char* line_end = static_cast<const char*>(std::memchr(line, '\n', end - line));
+                if(line_end == nullptr) line_end = end;
+
+                const char* p = skipBlank(line, line_end);
+                if(p + 1 < line_end)
+                {
+                    if(p[0] == 'v' && isBlank(p[1]))
+                    {
+                        float xyz[3]{0, 0, 0};
+                        p += 2;
+                        for(auto& value : xyz) p = platform::parseFloat(skipBlank(p, line_end), line_end, value);
+                        chunk.positions.insert(chunk.positions.end(), xyz, xyz + 3);
+                    }
+                    else if(p[0] == 'v' && p[1] == 't')
+                    {
+                        float uv[2]{0, 0};
+                        p += 2;
+                        for(auto& value : uv) p = platform::parseFloat(skipBlank(p, line_end), line_end, value);
+                        chunk.uvs.insert(chunk.uvs.end(), uv, uv + 2);
+                    }
+                    else if(p[0] == 'v' && p[1] == 'n')
+                    {
+                        float xyz[3]{0, 0, 0};
+                        p += 2;
+                        for(auto& value : xyz) p = platform::parseFloat(skipBlank(p, line_end), line_end, value);
+                        chunk.normals.insert(chunk.normals.end(), xyz, xyz + 3);
+                    }
+                    else if(p[0] == 'f' && isBlank(p[1]))
+                    {
+                        polygon.clear();
+                        p = skipBlank(p + 2, line_end);
+                        while(p < line_end)
+                        {
+                            uint32_t corner[3]{kMissing, kMissing, kMissing};
+                            p = parseIndex(p, line_end, chunk.positions.size() / 3, corner[0]);
+                            if(p < line_end && *p == '/')
+                            {
+                                p++;
+                                if(p < line_end && *p != '/') p = parseIndex(p, line_end, chunk.uvs.size() / 2, corner[1]);
+                                if(p < line_end && *p == '/') p = parseIndex(p + 1, line_end, chunk.normals.size() / 3, corner[2]);
+                            }
+                            if(corner[0] == kMissing) break;
+                            polygon.insert(polygon.end(), corner, corner + 3);
+                            p = skipBlank(p, line_end);
+                        }
+
+                        // triangle fan
+                        const size_t corner_count = polygon.size() / 3;
+                        for(size_t i = 2; i < corner_count; i++)
+                        {
+                            chunk.corners.insert(chunk.corners.end(), &polygon[0], &polygon[3]);
+                            chunk.corners.insert(chunk.corners.end(), &polygon[(i - 1) * 3], &polygon[i * 3]);
+                            chunk.corners.insert(chunk.corners.end(), &polygon[i * 3], &polygon[(i + 1) * 3]);
+                        }
+                    }
+                    else if((p[0] == 'o' || p[0] == 'g') && isBlank(p[1]))
+                    {
+                        chunk.names.push_back(restOfLine(p + 2, line_end));
+                        setState(chunk, chunk.corners.size() / 9, static_cast<int32_t>(chunk.names.size() - 1), -2);
+                    }
+                    else if(startsWith(p, line_end, "usemtl"))
+                    {
+                        chunk.names.push_back(restOfLine(p + 6, line_end));
+                        setState(chunk, chunk.corners.size() / 9, -2, static_cast<int32_t>(chunk.names.size() - 1));
+                    }
+                    else if(startsWith(p, line_end, "mtllib"))
+                    {
+                        // a single line may list several libraries
+                        for(const char* name = skipBlank(p + 6, line_end); name < line_end; name = skipBlank(name, line_end))
+                        {
+                            const char* name_end = name;
+                            while(name_end < line_end && !isBlank(*name_end)) name_end++;
+                            chunk.libraries.emplace_back(name, name_end);
+                            name = name_end;
+                        }
+                    }
+                }
+                line = line_end + 1;
+            }
+        }
+
+        struct CornerKey
+        {
+            uint32_t v, vt, vn;
+        };
+
+        // open addressing (v, vt, vn) -> vertex table
+        class CornerTable
+        {
+        public:
+            explicit CornerTable(size_t count)
+            {
+                size_t capacity = 16;
+                while(capacity < count * 2) capacity <<= 1;
+                _mask = capacity - 1;
+                _keys.resize(capacity);
+                _values.assign(capacity, kMissing);
+            }
+
+            // returns the vertex for `key`, `inserted` is set when `next` was used
+            uint32_t findOrInsert(const CornerKey& key, uint32_t next, bool& inserted)
+            {
+                size_t slot = hash(key) & _mask;
+                while(_values[slot] != kMissing)
+                {
+                    const CornerKey& other = _keys[slot];
+                    if(other.v == key.v && other.vt == key.vt && other.vn == key.vn)
+                    {
+                        inserted = false;
+                        return _values[slot];
+                    }
+                    slot = (slot + 1) & _mask;
+                }
+                _keys[slot]   = key;
+                _values[slot] = next;
+                inserted = true;
+                return next;
+            }
+
+        private:
+            static size_t hash(const CornerKey& key)
+            {
+                uint64_t h = key.v * 0x9E3779B97F4A7C15ull;
+                h ^= (key.vt + 0x632BE59BD9B4E019ull) * 0xC2B2AE3D27D4EB4Full;
+                h ^= (key.vn + 0x8CB92BA72F3D8DD7ull) * 0x165667B19E3779F9ull;
+                return static_cast<size_t>(h ^ (h >> 29));
+            }
+
+            size_t                  _mask;
+            std::vector<CornerKey>  _keys;
+            std::vector<uint32_t>   _values;
+        };
+
+        struct MeshSegment
+        {
+            size_t chunk;
+            size_t first_triangle;
+            size_t end_triangle;
+        };
+
+        std::string directoryOf(const std::string& path)
+        {
+            const size_t slash = path.find_last_of("/\\");
+            return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+        }
+    }
+
+    bool loadMtl(const std::string& path, std::vector<ObjMaterial>& materials)
+    {
+        std::ifstream file(path);
+        if(!file.is_open()) return false;
+
+        const std::string directory = directoryOf(path);
+        ObjMaterial* current = nullptr;
+        std::string line;
+        while(std::getline(file, line))
+        {
+            const char* p   = skipBlank(line.data(), line.data() + line.size());
+            const char* end = line.data() + line.size();
+
+            auto readVector = [&](const char* from, Eigen::Vector3f& value)
+            {
+                for(int i = 0; i < 3; i++) from = platform::parseFloat(skipBlank(from, end), end, value[i]);
+            };
+            auto readFloat = [&](const char* from, float& value)
+            {
+                platform::parseFloat(skipBlank(from, end), end, value);
+            };
+            auto readMap = [&](const char* from, std::string& value)
+            {
+                // options such as -bm come first, the path is the last token
+                std::string rest = restOfLine(from, end);
+                const size_t space = rest.find_last_of(" \t");
+                value = directory + (space == std::string::npos ? rest : rest.substr(space + 1));
+            };
+
+            if(startsWith(p, end, "newmtl"))
+            {
+                materials.emplace_back();
+                current = &materials.back();
+                current->name = restOfLine(p + 6, end);
+            }
+            else if(current == nullptr)
+            {
+                continue;
+            }
+            else if(startsWith(p, end, "Ka"))       readVector(p + 2, current->ambient);
+            else if(startsWith(p, end, "Kd"))       readVector(p + 2, current->diffuse);
+            else if(startsWith(p, end, "Ks"))       readVector(p + 2, current->specular);
+            else if(startsWith(p, end, "Ns"))       readFloat(p + 2, current->shininess);
+            else if(startsWith(p, end, "d"))        readFloat(p + 1, current->opacity);
+            else if(startsWith(p, end, "Tr"))
+            {
+                readFloat(p + 2, current->opacity);
+                current->opacity = 1.0f - current->opacity;
+            }
+            else if(startsWith(p, end, "map_Kd"))   readMap(p + 6, current->diffuse_map);
+            else if(startsWith(p, end, "map_Ks"))   readMap(p + 6, current->specular_map);
+            else if(startsWith(p, end, "map_d"))    readMap(p + 5, current->alpha_map);
+            else if(startsWith(p, end, "map_Bump")) readMap(p + 8, current->normal_map);
+            else if(startsWith(p, end, "map_bump")) readMap(p + 8, current->normal_map);
+            else if(startsWith(p, end, "bump"))     readMap(p + 4, current->normal_map);
+            else if(startsWith(p, end, "norm"))     readMap(p + 4, current->normal_map);
+        }
+        return true;
+    }
+
+    bool loadObj(const std::string& path, ObjModel& model)
+    {
+        platform::MappedFile file(path);
+        if(!file.isEnable()) return false;
+
+        const char*  text = reinterpret_cast<const char*>(file.data());
+        const size_t size = file.size();
+
+        // split at line boundaries
+        const size_t chunk_count = std::max<size_t>(1, std::min(platform::hardwareThreadCount() * 4, size / kMinChunkSize));
+        std::vector<const char*> bounds(chunk_count + 1);
+        bounds[0] = text;
+        bounds[chunk_count] = text + size;
+        for(size_t i = 1; i < chunk_count; i++)
+        {
+            const char* guess = std::max(text + size / chunk_count * i, bounds[i - 1]);
+            const char* newline = static_cast<const char*>(std::memchr(guess, '\n', text + size - guess));
+            bounds[i] = newline ? newline + 1 : text + size;
+        }
+
+        std::vector<ObjChunk> chunks(chunk_count);
+        platform::parallelFor(0, chunk_count, 1,
+            [&](size_t begin, size_t end)
+            {
+                for(size_t i = begin; i < end; i++) parseChunk(bounds[i], bounds[i + 1], chunks[i]);
+            }
+        );
+
+        // global attribute arrays
+        std::vector<size_t> position_offsets(chunk_count + 1, 0), uv_offsets(chunk_count + 1, 0), normal_offsets(chunk_count + 1, 0);
+        for(size_t i = 0; i < chunk_count; i++)
+        {
+            position_offsets[i + 1] = position_offsets[i] + chunks[i].positions.size() / 3;
+            uv_offsets[i + 1]       = uv_offsets[i]       + chunks[i].uvs.size() / 2;
+            normal_offsets[i + 1]   = normal_offsets[i]   + chunks[i].normals.size() / 3;
+        }
+        std::vector<float> positions(position_offsets[chunk_count] * 3);
+        std::vector<float> uvs(uv_offsets[chunk_count] * 2);
+        std::vector<float> normals(normal_offsets[chunk_count] * 3);
+
+        platform::parallelFor(0, chunk_count, 1,
+            [&](size_t begin, size_t end)
+            {
+                for(size_t i = begin; i < end; i++)
+                {
+                    ObjChunk& chunk = chunks[i];
+                    std::copy(chunk.positions.begin(), chunk.positions.end(), positions.begin() + position_offsets[i] * 3);
+                    std::copy(chunk.uvs.begin(),       chunk.uvs.end(),       uvs.begin()       + uv_offsets[i] * 2);
+                    std::copy(chunk.normals.begin(),   chunk.normals.end(),   normals.begin()   + normal_offsets[i] * 3);
+                    std::vector<float>().swap(chunk.positions);
+                    std::vector<float>().swap(chunk.uvs);
+                    std::vector<float>().swap(chunk.normals);
+
+                    for(size_t c = 0; c < chunk.corners.size(); c += 3)
+                    {
+                        chunk.corners[c]     = resolveIndex(chunk.corners[c],     position_offsets[i], position_offsets[chunk_count]);
+                        chunk.corners[c + 1] = resolveIndex(chunk.corners[c + 1], uv_offsets[i],       uv_offsets[chunk_count]);
+                        chunk.corners[c + 2] = resolveIndex(chunk.corners[c + 2], normal_offsets[i],   normal_offsets[chunk_count]);
+                    }
+                }
+            }
+        );
+
+        // materials
+        model = ObjModel{};
+        const std::string directory = directoryOf(path);
+        for(auto& chunk : chunks)
+        {
+            for(auto& library : chunk.libraries) loadMtl(directory + library, model.materials);
+        }
+        std::unordered_map<std::string, int32_t> material_ids;
+        for(size_t i = 0; i < model.materials.size(); i++)
+        {
+            material_ids.emplace(model.materials[i].name, static_cast<int32_t>(i));
+        }
+
+        // (object, material) -> mesh, walking batches in file order to carry state across chunks
+        std::unordered_map<std::string, size_t> mesh_ids;
+        std::vector<std::vector<MeshSegment>>   segments;
+        std::string object_name   = "default";
+        std::string material_name;
+        for(size_t i = 0; i < chunk_count; i++)
+        {
+            const ObjChunk& chunk = chunks[i];
+            const size_t triangle_count = chunk.corners.size() / 9;
+            for(size_t b = 0; b < chunk.batches.size(); b++)
+            {
+                const ObjBatch& batch = chunk.batches[b];
+                if(batch.object   >= 0) object_name   = chunk.names[batch.object];
+                if(batch.material >= 0) material_name = chunk.names[batch.material];
+
+                const size_t end = b + 1 < chunk.batches.size() ? chunk.batches[b + 1].first_triangle : triangle_count;
+                if(end == batch.first_triangle) continue;
+
+                auto [it, inserted] = mesh_ids.emplace(object_name + '\n' + material_name, segments.size());
+                if(inserted)
+                {
+                    segments.emplace_back();
+                    model.mesh_names.push_back(object_name);
+                    auto material = material_ids.find(material_name);
+                    model.mesh_materials.push_back(material == material_ids.end() ? -1 : material->second);
+                }
+                segments[it->second].push_back({i, batch.first_triangle, end});
+            }
+        }
+
+        // merge corners into indexed vertices
+        model.meshes.resize(segments.size());
+        platform::parallelFor(0, segments.size(), 1,
+            [&](size_t begin, size_t end)
+            {
+                for(size_t m = begin; m < end; m++)
+                {
+                    size_t corner_count = 0;
+                    for(auto& segment : segments[m]) corner_count += (segment.end_triangle - segment.first_triangle) * 3;
+
+                    Mesh& mesh = model.meshes[m];
+                    mesh.indices.reserve(corner_count);
+                    CornerTable table(corner_count);
+
+                    for(auto& segment : segments[m])
+                    {
+                        const uint32_t* corners = chunks[segment.chunk].corners.data();
+                        for(size_t t = segment.first_triangle; t < segment.end_triangle; t++)
+                        {
+                            const uint32_t* triangle = corners + t * 9;
+                            if(triangle[0] == kMissing || triangle[3] == kMissing || triangle[6] == kMissing) continue;
+
+                            for(int k = 0; k < 3; k++)
+                            {
+                                const CornerKey key{triangle[k * 3], triangle[k * 3 + 1], triangle[k * 3 + 2]};
+                                bool inserted;
+                                const uint32_t vertex = table.findOrInsert(key, static_cast<uint32_t>(mesh.vertices.size()), inserted);
+                                if(inserted)
+                                {
+                                    MeshVertex value;
+                                    value.position = Eigen::Map<const Eigen::Vector3f>(&positions[size_t(key.v) * 3]);
+                                    value.normal   = key.vn == kMissing
+                                        ? Eigen::Vector3f::Zero()
+                                        : Eigen::Vector3f(Eigen::Map<const Eigen::Vector3f>(&normals[size_t(key.vn) * 3]));
+                                    value.uv       = key.vt == kMissing
+                                        ? Eigen::Vector2f::Zero()
+                                        : Eigen::Vector2f(Eigen::Map<const Eigen::Vector2f>(&uvs[size_t(key.vt) * 2]));
+                                    mesh.vertices.push_back(value);
+                                }
+                                mesh.indices.push_back(vertex);
+                            }
+                        }
+                    }
+                }
+            }
+        );
+
+        return true;
+    }
+} // namespace lux::engine::resource
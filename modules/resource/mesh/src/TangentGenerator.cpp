@@ -0,0 +1,300 @@
+#include "lux-engine/resource/mesh/TangentGenerator.hpp"
+#include <lux-engine/platform/cxx/Parallel.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace lux::engine::resource
+{
+    namespace
+    {
+        constexpr float kEpsilon = 1e-20f;
+
+        inline Eigen::Vector3f projectOnPlane(const Eigen::Vector3f& v, const Eigen::Vector3f& n)
+        {
+            const Eigen::Vector3f projected = v - n * n.dot(v);
+            const float length = projected.norm();
+            return length > 0 ? Eigen::Vector3f(projected / length) : Eigen::Vector3f::Zero();
+        }
+
+        // angle at `corner` between the edges to the other two triangle vertices, seen from plane `n`
+        inline float cornerAngle(
+            const Eigen::Vector3f& prev, const Eigen::Vector3f& corner, const Eigen::Vector3f& next,
+            const Eigen::Vector3f& n)
+        {
+            const Eigen::Vector3f v1 = projectOnPlane(prev - corner, n);
+            const Eigen::Vector3f v2 = projectOnPlane(next - corner, n);
+            return std::acos(std::clamp(v1.dot(v2), -1.0f, 1.0f));
+        }
+
+        // vertex -> corner adjacency so the gather pass can run per vertex without atomics
+        void buildCornerAdjacency(
+            const uint32_t* indices, size_t index_count, size_t vertex_count,
+            std::vector<uint32_t>& offsets, std::vector<uint32_t>& corners)
+        {
+            offsets.assign(vertex_count + 1, 0);
+            corners.resize(index_count);
+            for(size_t i = 0; i < index_count; i++) offsets[indices[i] + 1]++;
+            for(size_t i = 0; i < vertex_count; i++) offsets[i + 1] += offsets[i];
+
+            std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+            for(size_t i = 0; i < index_count; i++) corners[cursor[indices[i]]++] = static_cast<uint32_t>(i);
+        }
+
+        // `all` rebuilds every normal, otherwise only the zero length ones and authored hard edges stay intact
+        void rebuildNormals(Mesh& mesh, const uint32_t* indices, size_t index_count, size_t grain, bool all)
+        {
+            const size_t triangle_count = index_count / 3;
+            std::vector<Eigen::Vector3f> face_normals(triangle_count);
+
+            platform::parallelFor(0, triangle_count, grain,
+                [&](size_t begin, size_t end)
+                {
+                    for(size_t t = begin; t < end; t++)
+                    {
+                        const Eigen::Vector3f& p0 = mesh.vertices[indices[t * 3]].position;
+                        const Eigen::Vector3f& p1 = mesh.vertices[indices[t * 3 + 1]].position;
+                        const Eigen::Vector3f& p2 = mesh.vertices[indices[t * 3 + 2]].position;
+                        face_normals[t] = (p1 - p0).cross(p2 - p0).normalized();
+                    }
+                }
+            );
+
+            // smooth across vertices sharing a position, uv seams must not show up as creases
+            const std::vector<uint32_t> remap = buildPositionRemap(mesh.vertices);
+            std::vector<uint32_t> welded(index_count);
+            for(size_t i = 0; i < index_count; i++) welded[i] = remap[indices[i]];
+
+            std::vector<uint32_t> offsets, corners;
+            buildCornerAdjacency(welded.data(), index_count, mesh.vertices.size(), offsets, corners);
+
+            platform::parallelFor(0, mesh.vertices.size(), grain,
+                [&](size_t begin, size_t end)
+                {
+                    for(size_t v = begin; v < end; v++)
+                    {
+                        if(!all && mesh.vertices[v].normal.squaredNorm() >= kEpsilon) continue;
+                        const uint32_t r = remap[v];
+                        Eigen::Vector3f normal = Eigen::Vector3f::Zero();
+                        for(uint32_t c = offsets[r]; c < offsets[r + 1]; c++)
+                        {
+                            const uint32_t corner   = corners[c];
+                            const uint32_t triangle = corner / 3;
+                            const uint32_t k        = corner - triangle * 3;
+                            const Eigen::Vector3f& self = mesh.vertices[indices[corner]].position;
+                            const Eigen::Vector3f& prev = mesh.vertices[indices[triangle * 3 + (k + 2) % 3]].position;
+                            const Eigen::Vector3f& next = mesh.vertices[indices[triangle * 3 + (k + 1) % 3]].position;
+                            const Eigen::Vector3f e1 = (prev - self).normalized();
+                            const Eigen::Vector3f e2 = (next - self).normalized();
+                            // angle weighted
+                            normal += face_normals[triangle] * std::acos(std::clamp(e1.dot(e2), -1.0f, 1.0f));
+                        }
+                        const float length = normal.norm();
+                        mesh.vertices[v].normal = length > 0 ? Eigen::Vector3f(normal / length) : Eigen::Vector3f::UnitZ();
+                    }
+                }
+            );
+        }
+
+        struct CornerTangent
+        {
+            Eigen::Vector3f tangent;    // angle weighted, already projected on the vertex normal plane
+            bool            orient_preserving;
+        };
+    }
+
+    void generateTangents(Mesh& mesh, const TangentSettings& settings)
+    {
+        // lods share the vertices of level 0, only level 0 defines the tangent space
+        const size_t index_offset = mesh.lods.empty() ? 0 : mesh.lods[0].index_offset;
+        const size_t index_count  = mesh.lods.empty() ? mesh.indices.size() : mesh.lods[0].index_count;
+        const size_t grain        = std::max<size_t>(settings.triangles_per_task, 1);
+        uint32_t*    indices      = mesh.indices.data() + index_offset;
+
+        bool rebuild_normals = settings.recompute_normals;
+        for(size_t v = 0; v < mesh.vertices.size() && !rebuild_normals; v++)
+        {
+            rebuild_normals = mesh.vertices[v].normal.squaredNorm() < kEpsilon;
+        }
+        if(rebuild_normals)
+        {
+            rebuildNormals(mesh, indices, index_count, grain, settings.recompute_normals);
+        }
+
+        // per corner contribution, the triangle's uv aligned direction scaled by the corner angle
+        const size_t triangle_count = index_count / 3;
+        std::vector<CornerTangent> corner_tangents(index_count);
+        platform::parallelFor(0, triangle_count, grain,
+            [&](size_t begin, size_t end)
+            {
+                for(size_t t = begin; t < end; t++)
+                {
+                    const MeshVertex& v1 = mesh.vertices[indices[t * 3]];
+                    const MeshVertex& v2 = mesh.vertices[indices[t * 3 + 1]];
+                    const MeshVertex& v3 = mesh.vertices[indices[t * 3 + 2]];
+
+                    const float t21x = v2.uv.x() - v1.uv.x();
+                    const float t21y = v2.uv.y() - v1.uv.y();
+                    const float t31x = v3.uv.x() - v1.uv.x();
+                    const float t31y = v3.uv.y() - v1.uv.y();
+                    const Eigen::Vector3f d1 = v2.position - v1.position;
+                    const Eigen::Vector3f d2 = v3.position - v1.position;
+
+                    const float signed_area = t21x * t31y - t21y * t31x;
+                    const bool  orient_preserving = signed_area > 0;
+                    Eigen::Vector3f os = t31y * d1 - t21y * d2;
+                    const float os_length = os.norm();
+                    if(std::fabs(signed_area) > kEpsilon && os_length > kEpsilon)
+                    {
+                        os *= (orient_preserving ? 1.0f : -1.0f) / os_length;
+                    }
+                    else
+                    {
+                        os.setZero();
+                    }
+
+                    const MeshVertex* corner_vertices[3]{&v1, &v2, &v3};
+                    for(int k = 0; k < 3; k++)
+                    {
+                        const MeshVertex& corner = *corner_vertices[k];
+                        const MeshVertex& prev   = *corner_vertices[(k + 2) % 3];
+                        const MeshVertex& next   = *corner_vertices[(k + 1) % 3];
+                        const float angle = cornerAngle(prev.position, corner.position, next.position, corner.normal);
+                        corner_tangents[t * 3 + k] = {projectOnPlane(os, corner.normal) * angle, orient_preserving};
+                    }
+                }
+            }
+        );
+
+        std::vector<uint32_t> offsets, corners;
+        buildCornerAdjacency(indices, index_count, mesh.vertices.size(), offsets, corners);
+
+        const size_t original_vertex_count = mesh.vertices.size();
+        std::vector<Eigen::Vector4f> split_tangents(original_vertex_count, Eigen::Vector4f::Zero());
+        mesh.tangents.assign(original_vertex_count, Eigen::Vector4f(1, 0, 0, 1));
+
+        platform::parallelFor(0, original_vertex_count, grain,
+            [&](size_t begin, size_t end)
+            {
+                for(size_t v = begin; v < end; v++)
+                {
+                    Eigen::Vector3f sum[2]{Eigen::Vector3f::Zero(), Eigen::Vector3f::Zero()};
+                    uint32_t        count[2]{0, 0};
+                    for(uint32_t c = offsets[v]; c < offsets[v + 1]; c++)
+                    {
+                        const CornerTangent& corner = corner_tangents[corners[c]];
+                        // corners of uv degenerate triangles don't get a vote
+                        if(corner.tangent.isZero()) continue;
+                        sum[corner.orient_preserving] += corner.tangent;
+                        count[corner.orient_preserving]++;
+                    }
+
+                    const int dominant = count[1] >= count[0] ? 1 : 0;
+                    auto toTangent = [&](int orientation)
+                    {
+                        Eigen::Vector3f tangent = sum[orientation];
+                        const float length = tangent.norm();
+                        tangent = length > 0
+                            ? Eigen::Vector3f(tangent / length)
+                            : projectOnPlane(Eigen::Vector3f::UnitX(), mesh.vertices[v].normal);
+                        return Eigen::Vector4f(tangent.x(), tangent.y(), tangent.z(), orientation ? 1.0f : -1.0f);
+                    };
+
+                    mesh.tangents[v] = toTangent(dominant);
+                    if(count[1 - dominant] > 0)
+                    {
+                        split_tangents[v] = toTangent(1 - dominant);
+                    }
+                }
+            }
+        );
+
+        if(!settings.split_mirrored_vertices) return;
+
+        // give the minority orientation of mirrored vertices its own vertex
+        std::vector<uint32_t> split_of(original_vertex_count, UINT32_MAX);
+        for(size_t v = 0; v < original_vertex_count; v++)
+        {
+            if(split_tangents[v].w() == 0) continue;
+
+            const uint32_t split = static_cast<uint32_t>(mesh.vertices.size());
+            split_of[v] = split;
+            const MeshVertex vertex = mesh.vertices[v];
+            mesh.vertices.push_back(vertex);
+            mesh.tangents.push_back(split_tangents[v]);
+
+            const bool minority = split_tangents[v].w() > 0;
+            for(uint32_t c = offsets[v]; c < offsets[v + 1]; c++)
+            {
+                const CornerTangent& corner = corner_tangents[corners[c]];
+                if(!corner.tangent.isZero() && corner.orient_preserving == minority)
+                {
+                    indices[corners[c]] = split;
+                }
+            }
+        }
+
+        // coarser lods reuse the vertices, their corners follow the uv orientation of their own triangles
+        for(size_t lod = 1; lod < mesh.lods.size(); lod++)
+        {
+            uint32_t* lod_indices = mesh.indices.data() + mesh.lods[lod].index_offset;
+            for(size_t t = 0; t < mesh.lods[lod].index_count / 3; t++)
+            {
+                uint32_t* triangle = lod_indices + t * 3;
+                // already remapped when the lod shares its range with level 0
+                if(triangle[0] >= original_vertex_count || triangle[1] >= original_vertex_count || triangle[2] >= original_vertex_count)
+                {
+                    continue;
+                }
+                const Eigen::Vector2f& uv1 = mesh.vertices[triangle[0]].uv;
+                const Eigen::Vector2f  e1  = mesh.vertices[triangle[1]].uv - uv1;
+                const Eigen::Vector2f  e2  = mesh.vertices[triangle[2]].uv - uv1;
+                const float signed_area = e1.x() * e2.y() - e1.y() * e2.x();
+                if(std::fabs(signed_area) <= kEpsilon) continue;
+
+                for(int k = 0; k < 3; k++)
+                {
+                    const uint32_t v = triangle[k];
+                    if(split_of[v] != UINT32_MAX && (signed_area > 0) == (mesh.tangents[split_of[v]].w() > 0))
+                    {
+                        triangle[k] = split_of[v];
+                    }
+                }
+            }
+        }
+    }
+
+    uint32_t packSnorm10x3_2(const Eigen::Vector4f& value)
+    {
+        auto snorm = [](float x, float scale, uint32_t mask) -> uint32_t
+        {
+            const int32_t q = static_cast<int32_t>(std::lround(std::clamp(x, -1.0f, 1.0f) * scale));
+            return static_cast<uint32_t>(q) & mask;
+        };
+        return snorm(value.x(), 511.0f, 0x3ff)
+            | (snorm(value.y(), 511.0f, 0x3ff) << 10)
+            | (snorm(value.z(), 511.0f, 0x3ff) << 20)
+            | (snorm(value.w(), 1.0f, 0x3) << 30);
+    }
+
+    void packTangentFrames(const Mesh& mesh, std::vector<uint32_t>& packed_normals, std::vector<uint32_t>& packed_tangents)
+    {
+        const size_t vertex_count = mesh.vertices.size();
+        packed_normals.resize(vertex_count);
+        packed_tangents.resize(mesh.tangents.size() == vertex_count ? vertex_count : 0);
+
+        platform::parallelFor(0, vertex_count, 64 * 1024,
+            [&](size_t begin, size_t end)
+            {
+                for(size_t v = begin; v < end; v++)
+                {
+                    const Eigen::Vector3f& n = mesh.vertices[v].normal;
+                    packed_normals[v] = packSnorm10x3_2(Eigen::Vector4f(n.x(), n.y(), n.z(), 0.0f));
+                    if(!packed_tangents.empty())
+                    {
+                        packed_tangents[v] = packSnorm10x3_2(mesh.tangents[v]);
+                    }
+                }
+            }
+        );
+    }
+} // namespace lux::engine::resource
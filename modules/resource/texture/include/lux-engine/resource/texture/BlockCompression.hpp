@@ -0,0 +1,85 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <lux-engine/platform/cxx/visibility_control.h>
+
+namespace lux::engine::resource
+{
+    enum class BlockFormat : uint8_t
+    {
+        BC1,    // rgb + 1 bit alpha, 8 bytes per 4x4 block
+        BC3,    // rgba, bc1 color + bc4 alpha, 16 bytes
+        BC4,    // one channel (red), 8 bytes
+        BC5,    // two channels (red, green), e.g. normal maps, 16 bytes
+        BC7     // rgba, 16 bytes
+    };
+
+    enum class CompressionQuality : uint8_t
+    {
+        FAST,   // bounding box endpoints, meant for runtime conversion
+        NORMAL, // principal axis endpoints refined once
+        HIGH    // more refinement and, for bc7, more modes and partitions
+    };
+
+    struct BlockCompressionSettings
+    {
+        BlockFormat         format{BlockFormat::BC7};
+        CompressionQuality  quality{CompressionQuality::NORMAL};
+    };
+
+    constexpr size_t blockBytes(BlockFormat format)
+    {
+        return format == BlockFormat::BC1 || format == BlockFormat::BC4 ? 8 : 16;
+    }
+
+    constexpr size_t compressedSize(BlockFormat format, uint32_t width, uint32_t height)
+    {
+        return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * blockBytes(format);
+    }
+
+    /**
+     * @brief encode an 8 bit image into 4x4 blocks, rows of blocks are encoded in parallel.
+     *        partial blocks at the right and bottom edge repeat the last column / row.
+     *        missing channels read as gray (1 channel), red + green (2) and opaque alpha.
+     *        bc1 switches a block to its 3 color mode with a transparent index when a texel's
+     *        alpha is below 128
+     *
+     * @param pixels    tightly packed rows, `channels` bytes per texel
+     * @param blocks    resized to compressedSize(), block rows top to bottom
+     */
+    LUX_EXPORT bool compressImage(
+        const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels,
+        const BlockCompressionSettings& settings, std::vector<uint8_t>& blocks
+    );
+
+    /**
+     * @brief compressImage() backed by a directory of previously encoded results.
+     *        entries are keyed by a hash of the pixels, the size, the settings and the encoder version,
+     *        so a texture is only encoded again when it or the encoder changed.
+     *        safe to use from several threads, entries are written to a temporary file and renamed
+     */
+    class BlockCompressionCache
+    {
+    public:
+        LUX_EXPORT explicit BlockCompressionCache(std::string directory);
+
+        LUX_EXPORT bool compress(
+            const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels,
+            const BlockCompressionSettings& settings, std::vector<uint8_t>& blocks
+        );
+
+        const std::string& directory() const { return _directory; }
+
+        size_t hits() const { return _hits.load(std::memory_order_relaxed); }
+
+        size_t misses() const { return _misses.load(std::memory_order_relaxed); }
+
+    private:
+        std::string         _directory;
+        std::atomic<size_t> _hits{0};
+        std::atomic<size_t> _misses{0};
+    };
+} // namespace lux::engine::resource
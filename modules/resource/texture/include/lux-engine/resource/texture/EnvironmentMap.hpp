@@ -0,0 +1,70 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <lux-engine/platform/cxx/visibility_control.h>
+#include <lux-engine/platform/media_loaders/Image.hpp>
+
+namespace lux::engine::resource
+{
+    // one mip level of a cube map, linear rgb floats of the six faces one after another
+    struct CubemapLevel
+    {
+        uint32_t            size{0};
+        std::vector<float>  texels;
+
+        float* face(uint32_t index) { return texels.data() + size_t(index) * size * size * 3; }
+
+        const float* face(uint32_t index) const { return texels.data() + size_t(index) * size * size * 3; }
+    };
+
+    /**
+     * @brief faces in GL order (+x, -x, +y, -y, +z, -z) laid out like GL_TEXTURE_CUBE_MAP_POSITIVE_X + i expects
+     *        them, so a level uploads face by face without any reordering
+     */
+    struct Cubemap
+    {
+        std::vector<CubemapLevel> levels;
+
+        bool empty() const { return levels.empty(); }
+
+        uint32_t size() const { return levels.empty() ? 0 : levels[0].size; }
+    };
+
+    /**
+     * @brief resample an equirectangular (latitude / longitude) environment into a cube map with a single level.
+     *        rows must run top (+y) to bottom, i.e. the image loaded with flip_vertically = false.
+     *        8 bit images are taken as sRGB, 16 bit and float ones as linear
+     */
+    LUX_EXPORT Cubemap cubemapFromEquirect(platform::Image& image, uint32_t face_size);
+
+    // append 2x2 box filtered levels down to 1x1, the radiance chain the prefilter samples from
+    LUX_EXPORT void generateCubemapMips(Cubemap& cubemap);
+
+    struct SpecularPrefilterSettings
+    {
+        uint32_t face_size{256};
+        // 0 goes down to 8x8 faces
+        uint32_t level_count{0};
+        // GGX samples per texel, the source mip picked per sample keeps low counts free of fireflies
+        uint32_t sample_count{64};
+    };
+
+    // roughness a prefiltered level was convolved for, the shader picks lod = roughness * (level_count - 1)
+    inline float prefilterRoughness(uint32_t level, uint32_t level_count)
+    {
+        return level_count > 1 ? static_cast<float>(level) / static_cast<float>(level_count - 1) : 0.0f;
+    }
+
+    /**
+     * @brief GGX prefiltered radiance for the split sum approximation (n = v = r), one roughness per level.
+     *        importance sampled with a Hammersley set and filtered importance sampling, spread over every
+     *        hardware thread. `environment` gets its mip chain built on a copy when it only has one level
+     */
+    LUX_EXPORT Cubemap prefilterSpecular(const Cubemap& environment, const SpecularPrefilterSettings& settings = {});
+
+    /**
+     * @brief split sum environment BRDF: scale and bias of F0 in rg pairs, x is n.v and y the roughness,
+     *        both from 0 to 1 at texel centers. `size` * `size` * 2 floats
+     */
+    LUX_EXPORT std::vector<float> computeBrdfLut(uint32_t size = 128, uint32_t sample_count = 512);
+} // namespace lux::engine::resource
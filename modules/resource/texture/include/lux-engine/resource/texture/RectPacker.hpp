@@ -0,0 +1,67 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <lux-engine/platform/cxx/visibility_control.h>
+
+namespace lux::engine::resource
+{
+    struct PackedRect
+    {
+        uint32_t x{0};
+        uint32_t y{0};
+        uint32_t width{0};
+        uint32_t height{0};
+    };
+
+    enum class RectPackHeuristic
+    {
+        // keeps every maximal free rectangle and places by best short side fit. densest, inserts cost
+        // grows with the number of free rectangles
+        MAX_RECTS,
+        // bottom left placement against a skyline of the top edges, cheap and good for similar heights (glyphs)
+        SKYLINE
+    };
+
+    /**
+     * @brief online packing of rectangles into a fixed size bin, rectangles are never rotated
+     */
+    class RectPacker
+    {
+    public:
+        RectPacker() = default;
+
+        LUX_EXPORT RectPacker(uint32_t width, uint32_t height, RectPackHeuristic heuristic = RectPackHeuristic::MAX_RECTS);
+
+        // empty the bin, keeps the size and heuristic
+        LUX_EXPORT void reset();
+
+        // false when the rectangle doesn't fit anywhere
+        LUX_EXPORT bool insert(uint32_t width, uint32_t height, PackedRect& rect);
+
+        uint32_t width() const { return _width; }
+
+        uint32_t height() const { return _height; }
+
+        // used fraction of the bin area
+        float occupancy() const { return _width && _height ? float(_used_area) / (float(_width) * float(_height)) : 0.0f; }
+
+    private:
+        struct SkylineNode
+        {
+            uint32_t x;
+            uint32_t y;
+            uint32_t width;
+        };
+
+        bool insertMaxRects(uint32_t width, uint32_t height, PackedRect& rect);
+
+        bool insertSkyline(uint32_t width, uint32_t height, PackedRect& rect);
+
+        uint32_t                    _width{0};
+        uint32_t                    _height{0};
+        RectPackHeuristic           _heuristic{RectPackHeuristic::MAX_RECTS};
+        uint64_t                    _used_area{0};
+        std::vector<PackedRect>     _free;
+        std::vector<SkylineNode>    _skyline;
+    };
+} // namespace lux::engine::resource
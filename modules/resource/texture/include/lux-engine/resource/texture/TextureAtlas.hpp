@@ -0,0 +1,117 @@
+#pragma once
+#include "RectPacker.hpp"
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <lux-engine/platform/cxx/visibility_control.h>
+#include <lux-engine/platform/media_loaders/Image.hpp>
+
+namespace lux::engine::resource
+{
+    struct TextureAtlasSettings
+    {
+        uint32_t            page_size{2048};
+        uint32_t            max_pages{8};
+        RectPackHeuristic   heuristic{RectPackHeuristic::MAX_RECTS};
+        // mip levels (counting level 0) that stay free of bleeding between neighbours: regions start on a
+        // multiple of 2^(levels - 1) texels and are surrounded by gutters that wide, filled by repeating the
+        // edge texels, so every texel of those levels only averages texels of its own region
+        uint32_t            mip_levels{4};
+    };
+
+    // where one image ended up, the uv remap table is one of these per image
+    struct AtlasRegion
+    {
+        uint32_t    page{0};
+        uint32_t    x{0};               // texels of the image inside the page, gutters excluded
+        uint32_t    y{0};
+        uint32_t    width{0};
+        uint32_t    height{0};
+        float       uv_offset[2]{0.0f, 0.0f};
+        float       uv_scale[2]{1.0f, 1.0f};
+
+        // map a uv of the original image into the page
+        void remap(float u, float v, float& atlas_u, float& atlas_v) const
+        {
+            atlas_u = uv_offset[0] + u * uv_scale[0];
+            atlas_v = uv_offset[1] + v * uv_scale[1];
+        }
+    };
+
+    // rgba8 texels of one page, rows in the order the images were given (bottom first for flipped images)
+    struct AtlasPage
+    {
+        uint32_t                size{0};
+        std::vector<uint8_t>    pixels;
+        // texels written since the last clearDirty(), x0 >= x1 when clean
+        uint32_t                dirty_x0{0};
+        uint32_t                dirty_y0{0};
+        uint32_t                dirty_x1{0};
+        uint32_t                dirty_y1{0};
+
+        bool isDirty() const { return dirty_x0 < dirty_x1 && dirty_y0 < dirty_y1; }
+    };
+
+    struct AtlasImage
+    {
+        const uint8_t*  pixels{nullptr};
+        uint32_t        width{0};
+        uint32_t        height{0};
+        uint32_t        channels{4};    // 1 - 4, 2 is gray + alpha
+    };
+
+    /**
+     * @brief packs many small images into a few large rgba8 pages so they can share one texture binding.
+     *        images can be added one by one at runtime, every page keeps its own packer and a dirty
+     *        rectangle for partial uploads
+     */
+    class TextureAtlas
+    {
+    public:
+        static constexpr uint32_t kInvalidRegion = std::numeric_limits<uint32_t>::max();
+
+        LUX_EXPORT explicit TextureAtlas(const TextureAtlasSettings& settings = {});
+
+        // pack one image into the first page with room, opening a new page when needed.
+        // returns the region index or kInvalidRegion when the image is larger than a page or max_pages is reached
+        LUX_EXPORT uint32_t add(const AtlasImage& image);
+
+        // 8 bit images only, kInvalidRegion for UINT16 / FLOAT32 ones
+        LUX_EXPORT uint32_t add(platform::Image& image);
+
+        /**
+         * @brief pack a batch, largest side first, which packs much tighter than arrival order.
+         *        `regions[i]` belongs to `images[i]`, false when any image didn't fit
+         */
+        LUX_EXPORT bool addBatch(const std::vector<AtlasImage>& images, std::vector<uint32_t>& regions);
+
+        const AtlasRegion& region(uint32_t index) const { return _regions[index]; }
+
+        // the uv remap table, indexed by region
+        const std::vector<AtlasRegion>& regions() const { return _regions; }
+
+        size_t pageCount() const { return _pages.size(); }
+
+        const AtlasPage& page(size_t index) const { return _pages[index]; }
+
+        LUX_EXPORT void clearDirty(size_t page);
+
+        float occupancy(size_t page) const { return _packers[page].occupancy(); }
+
+        // gutter width and placement alignment in texels
+        uint32_t gutter() const { return _gutter; }
+
+        // levels that are safe to sample, coarser ones mix neighbouring regions
+        uint32_t mipLevels() const { return _mip_levels; }
+
+    private:
+        void blit(AtlasPage& page, const AtlasImage& image, uint32_t x, uint32_t y);
+
+        TextureAtlasSettings        _settings;
+        uint32_t                    _mip_levels{1};
+        uint32_t                    _gutter{1};
+        std::vector<AtlasPage>      _pages;
+        std::vector<RectPacker>     _packers;
+        std::vector<AtlasRegion>    _regions;
+    };
+} // namespace lux::engine::resource
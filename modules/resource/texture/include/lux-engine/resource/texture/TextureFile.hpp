@@ -0,0 +1,197 @@
+#pragma once
+#include "BlockCompression.hpp"
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <lux-engine/platform/cxx/MappedFile.hpp>
+#include <lux-engine/platform/cxx/visibility_control.h>
+
+namespace lux::engine::resource
+{
+    enum class TextureFormat : uint32_t
+    {
+        R8,
+        RG8,
+        RGB8,
+        RGBA8,
+        BC1,
+        BC3,
+        BC4,
+        BC5,
+        BC7
+    };
+
+    constexpr bool isBlockCompressed(TextureFormat format)
+    {
+        return format >= TextureFormat::BC1;
+    }
+
+    // only meaningful for block compressed formats
+    constexpr BlockFormat toBlockFormat(TextureFormat format)
+    {
+        return static_cast<BlockFormat>(static_cast<uint32_t>(format) - static_cast<uint32_t>(TextureFormat::BC1));
+    }
+
+    constexpr TextureFormat toTextureFormat(BlockFormat format)
+    {
+        return static_cast<TextureFormat>(static_cast<uint32_t>(format) + static_cast<uint32_t>(TextureFormat::BC1));
+    }
+
+    // one and two channel formats are data (masks, normals), GL has no sRGB variant of them
+    constexpr bool hasSrgbVariant(TextureFormat format)
+    {
+        return format != TextureFormat::R8 && format != TextureFormat::RG8
+            && format != TextureFormat::BC4 && format != TextureFormat::BC5;
+    }
+
+    // bytes per texel of the uncompressed formats
+    constexpr uint32_t textureFormatChannels(TextureFormat format)
+    {
+        return isBlockCompressed(format) ? 0 : static_cast<uint32_t>(format) + 1;
+    }
+
+    constexpr size_t textureLevelSize(TextureFormat format, uint32_t width, uint32_t height)
+    {
+        return isBlockCompressed(format)
+            ? compressedSize(toBlockFormat(format), width, height)
+            : static_cast<size_t>(width) * height * textureFormatChannels(format);
+    }
+
+    enum TextureFileFlags : uint32_t
+    {
+        TEXTURE_FILE_SRGB                   = 1u << 0,  // color channels are sRGB encoded
+        TEXTURE_FILE_NORMAL_MAP             = 1u << 1,
+        TEXTURE_FILE_PREMULTIPLIED_ALPHA    = 1u << 2
+    };
+
+    /**
+     * cooked texture file, little endian, every offset is from the start of the file:
+     *
+     *   TextureFileHeader
+     *   TextureLevelEntry[level_count]     level 0 is the full size
+     *   metadata: per entry uint32_t key length, uint32_t value length, key bytes, value bytes
+     *   level payloads, each aligned to kTextureFileAlignment, largest level last
+     *
+     * a level payload is exactly what glCompressedTexSubImage2D (or glTexSubImage2D with
+     * GL_UNPACK_ALIGNMENT 1) takes for that level, rows bottom to top as uploaded
+     */
+    constexpr uint32_t kTextureFileMagic     = 0x5854584C; // "LXTX"
+    constexpr uint32_t kTextureFileVersion   = 1;
+    constexpr uint64_t kTextureFileAlignment = 64;
+
+    struct TextureFileHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t format;            // TextureFormat
+        uint32_t flags;             // TextureFileFlags
+        uint32_t width;
+        uint32_t height;
+        uint32_t level_count;
+        uint32_t metadata_count;
+        uint64_t metadata_offset;
+        uint64_t metadata_size;
+        uint64_t file_size;
+    };
+
+    struct TextureLevelEntry
+    {
+        uint64_t offset;
+        uint64_t size;
+        uint32_t width;
+        uint32_t height;
+    };
+
+    // one level, the pointer goes straight into the mapped file
+    struct TextureLevelView
+    {
+        const uint8_t*  data{nullptr};
+        size_t          size{0};
+        uint32_t        width{0};
+        uint32_t        height{0};
+    };
+
+    /**
+     * @brief a memory mapped texture file. loading validates the header, the level table and the
+     *        metadata once, after that the levels are plain pointers into the mapping
+     */
+    class TextureFile
+    {
+    public:
+        TextureFile() = default;
+
+        LUX_EXPORT explicit TextureFile(const std::string& path);
+
+        LUX_EXPORT bool load(const std::string& path);
+
+        bool isEnable() const { return _header != nullptr; }
+
+        TextureFormat format() const { return static_cast<TextureFormat>(_header->format); }
+
+        uint32_t flags() const { return _header->flags; }
+
+        bool isSrgb() const { return (_header->flags & TEXTURE_FILE_SRGB) != 0; }
+
+        uint32_t width() const { return _header->width; }
+
+        uint32_t height() const { return _header->height; }
+
+        size_t levelCount() const { return _header ? _header->level_count : 0; }
+
+        LUX_EXPORT TextureLevelView level(size_t index) const;
+
+        size_t metadataCount() const { return _metadata.size(); }
+
+        const std::pair<std::string_view, std::string_view>& metadataAt(size_t index) const { return _metadata[index]; }
+
+        // empty when the key is missing
+        LUX_EXPORT std::string_view metadata(std::string_view key) const;
+
+        // bytes of every level together
+        LUX_EXPORT size_t payloadSize() const;
+
+    private:
+        platform::MappedFile        _file;
+        const TextureFileHeader*    _header{nullptr};
+        const TextureLevelEntry*    _levels{nullptr};
+        std::vector<std::pair<std::string_view, std::string_view>> _metadata;
+    };
+
+    // an editable texture, what writeTextureFile() stores
+    struct TextureData
+    {
+        TextureFormat                                       format{TextureFormat::RGBA8};
+        uint32_t                                            flags{0};
+        uint32_t                                            width{0};
+        uint32_t                                            height{0};
+        std::vector<std::vector<uint8_t>>                   levels;     // levels[i] is max(width >> i, 1) x max(height >> i, 1)
+        std::vector<std::pair<std::string, std::string>>    metadata;
+    };
+
+    LUX_EXPORT bool writeTextureFile(const std::string& path, const TextureData& texture);
+
+    struct TextureBuildSettings
+    {
+        TextureFormat           format{TextureFormat::BC7};
+        CompressionQuality      quality{CompressionQuality::NORMAL};
+        // sRGB color, filtered in linear space and flagged for an sRGB internal format.
+        // ignored for formats without an sRGB variant, see hasSrgbVariant()
+        bool                    srgb{true};
+        bool                    mips{true};
+        bool                    wrap{true};
+        float                   alpha_cutoff{0.0f};
+        uint32_t                flags{0};           // extra TextureFileFlags
+        // optional, reuses block compressed levels encoded before
+        BlockCompressionCache*  cache{nullptr};
+    };
+
+    /**
+     * @brief mip chain and encoding of an 8 bit image (1 - 4 channels) into `texture`.
+     *        uncompressed target formats drop or append channels (appended alpha is opaque)
+     */
+    LUX_EXPORT bool buildTexture(
+        const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels,
+        const TextureBuildSettings& settings, TextureData& texture
+    );
+} // namespace lux::engine::resource
@@ -0,0 +1,245 @@
+#pragma once
+#include "VirtualTextureFile.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <lux-engine/platform/cxx/IoQueue.hpp>
+#include <lux-engine/platform/cxx/visibility_control.h>
+
+namespace lux::engine::resource
+{
+    // one tile of the virtual mip chain, packed the way the feedback pass writes it: level 8 bits, y and x 12 bits
+    constexpr uint32_t packVirtualTile(uint32_t level, uint32_t x, uint32_t y)
+    {
+        return (level << 24) | ((y & 0xFFF) << 12) | (x & 0xFFF);
+    }
+
+    constexpr uint32_t virtualTileLevel(uint32_t tile) { return tile >> 24; }
+
+    constexpr uint32_t virtualTileX(uint32_t tile) { return tile & 0xFFF; }
+
+    constexpr uint32_t virtualTileY(uint32_t tile) { return (tile >> 12) & 0xFFF; }
+
+    // feedback texels that saw no virtual texture
+    constexpr uint32_t kNoVirtualTile = 0xFFFFFFFF;
+
+    /**
+     * @brief the cpu side of the indirection texture: one rgba8 texel per tile and level holding the physical
+     *        slot (r, g) and the level (b) of the finest resident tile covering it, a = 255 once anything is
+     *        mapped. uploaded as a mip mapped texture sampled with nearest filtering at the wanted level
+     */
+    class VirtualPageTable
+    {
+    public:
+        VirtualPageTable() = default;
+
+        LUX_EXPORT VirtualPageTable(uint32_t width, uint32_t height, uint32_t tile_size, uint32_t level_count);
+
+        uint32_t levelCount() const { return static_cast<uint32_t>(_entries.size()); }
+
+        uint32_t width(uint32_t level) const { return _sizes[level].first; }
+
+        uint32_t height(uint32_t level) const { return _sizes[level].second; }
+
+        // rgba8 texels of one level, width(level) * height(level)
+        const uint32_t* entries(uint32_t level) const { return _entries[level].data(); }
+
+        uint32_t entry(uint32_t level, uint32_t x, uint32_t y) const { return _entries[level][size_t(y) * width(level) + x]; }
+
+        // point (level, x, y) and every finer entry that fell back to a coarser tile at the physical slot
+        LUX_EXPORT void map(uint32_t level, uint32_t x, uint32_t y, uint32_t slot_x, uint32_t slot_y);
+
+        // the entries fall back to the closest resident ancestor
+        LUX_EXPORT void unmap(uint32_t level, uint32_t x, uint32_t y);
+
+        bool isMapped(uint32_t level, uint32_t x, uint32_t y) const { return _own[level][size_t(y) * width(level) + x] != 0; }
+
+        // changed entries of a level since clearDirty(), x0 >= x1 when clean
+        struct DirtyRect
+        {
+            uint32_t x0{0}, y0{0}, x1{0}, y1{0};
+        };
+
+        const DirtyRect& dirty(uint32_t level) const { return _dirty[level]; }
+
+        LUX_EXPORT void clearDirty();
+
+    private:
+        void refresh(uint32_t level, uint32_t x, uint32_t y);
+
+        std::vector<std::pair<uint32_t, uint32_t>>  _sizes;
+        std::vector<std::vector<uint32_t>>          _own;       // the tile's own mapping, 0 when not resident
+        std::vector<std::vector<uint32_t>>          _entries;   // own mapping or the inherited one
+        std::vector<DirtyRect>                      _dirty;
+    };
+
+    /**
+     * @brief fixed grid of physical tile slots with least recently used replacement.
+     *        slots touched in the current frame and pinned slots are never evicted
+     */
+    class VirtualTileCache
+    {
+    public:
+        static constexpr uint32_t kNoSlot = 0xFFFFFFFF;
+
+        VirtualTileCache() = default;
+
+        LUX_EXPORT VirtualTileCache(uint32_t slots_x, uint32_t slots_y);
+
+        uint32_t slotsX() const { return _slots_x; }
+
+        uint32_t slotsY() const { return _slots_y; }
+
+        size_t residentCount() const { return _lookup.size(); }
+
+        // slot of a resident tile or kNoSlot, does not count as a use
+        LUX_EXPORT uint32_t find(uint32_t tile) const;
+
+        // mark a resident tile as used this frame
+        LUX_EXPORT bool touch(uint32_t tile);
+
+        /**
+         * @brief take a slot for `tile`, a free one or the least recently used one.
+         *        `evicted` is the tile that lost its slot (kNoVirtualTile when the slot was free).
+         *        returns kNoSlot when every slot is pinned or in use this frame
+         */
+        LUX_EXPORT uint32_t allocate(uint32_t tile, uint32_t& evicted);
+
+        LUX_EXPORT void pin(uint32_t slot);
+
+        void beginFrame() { _frame++; }
+
+        uint64_t frame() const { return _frame; }
+
+    private:
+        struct Slot
+        {
+            uint32_t tile{kNoVirtualTile};
+            uint64_t last_used{0};
+            bool     pinned{false};
+            uint32_t previous{kNoSlot};
+            uint32_t next{kNoSlot};
+        };
+
+        void unlink(uint32_t slot);
+
+        void pushBack(uint32_t slot);
+
+        uint32_t                                _slots_x{0};
+        uint32_t                                _slots_y{0};
+        std::vector<Slot>                       _slots;
+        uint32_t                                _head{kNoSlot};     // least recently used
+        uint32_t                                _tail{kNoSlot};
+        std::unordered_map<uint32_t, uint32_t>  _lookup;
+        uint64_t                                _frame{1};
+    };
+
+    struct VirtualTextureSettings
+    {
+        // physical cache, the only memory that scales with the tile count: slots * tileBytes()
+        uint32_t    cache_slots_x{16};
+        uint32_t    cache_slots_y{16};
+        // tiles handed to the gpu per update, spreads uploads over frames
+        uint32_t    max_uploads_per_update{16};
+        // reads queued or running on the io threads, bounds the staging memory
+        uint32_t    max_requests_in_flight{32};
+        // nullptr reads on platform::IoQueue::global(), must outlive the texture
+        platform::IoQueue*  io_queue{nullptr};
+    };
+
+    // a tile ready to copy into the physical texture at slot (slot_x, slot_y) * tileStride()
+    struct VirtualTileUpload
+    {
+        uint32_t                tile{kNoVirtualTile};
+        uint32_t                slot_x{0};
+        uint32_t                slot_y{0};
+        std::vector<uint8_t>    data;       // tileBytes() in the file's format
+    };
+
+    /**
+     * @brief residency manager of one virtual texture, no gpu involved: feedback in, tile uploads and page
+     *        table changes out. tiles are read from the mapped file on the io threads, coarse levels first.
+     *        the coarsest level is loaded up front and pinned, so every lookup has a fallback
+     */
+    class VirtualTexture
+    {
+    public:
+        LUX_EXPORT VirtualTexture(const std::string& path, const VirtualTextureSettings& settings = {});
+
+        LUX_EXPORT ~VirtualTexture();
+
+        VirtualTexture(const VirtualTexture&) = delete;
+
+        VirtualTexture& operator=(const VirtualTexture&) = delete;
+
+        bool isEnable() const { return _file.isEnable() && _enabled; }
+
+        const VirtualTextureFile& file() const { return _file; }
+
+        const VirtualPageTable& pageTable() const { return _page_table; }
+
+        VirtualPageTable& pageTable() { return _page_table; }
+
+        const VirtualTileCache& cache() const { return _cache; }
+
+        // packed tiles from this frame's feedback buffer, kNoVirtualTile entries are skipped. may be called
+        // several times per frame (e.g. for several feedback buffers)
+        LUX_EXPORT void addFeedback(const uint32_t* tiles, size_t count);
+
+        /**
+         * @brief once per frame: request the tiles the feedback asked for, map finished reads into the cache
+         *        and append their uploads. the page table's dirty rects cover every remapped entry
+         */
+        LUX_EXPORT void update(std::vector<VirtualTileUpload>& uploads);
+
+        // reads queued or running
+        LUX_EXPORT size_t pendingCount() const;
+
+    private:
+        struct Request
+        {
+            uint32_t tile;
+            uint32_t priority;
+
+            bool operator<(const Request& other) const { return priority < other.priority; }
+        };
+
+        struct Completed
+        {
+            uint32_t                tile;
+            std::vector<uint8_t>    data;
+        };
+
+        void request(uint32_t tile, uint32_t coverage);
+
+        bool place(uint32_t tile, std::vector<uint8_t> data, std::vector<VirtualTileUpload>& uploads);
+
+        // an io task reads whichever tile is first in line when it starts
+        void readNext();
+
+        VirtualTextureFile                          _file;
+        VirtualTextureSettings                      _settings;
+        VirtualPageTable                            _page_table;
+        VirtualTileCache                            _cache;
+        bool                                        _enabled{false};
+
+        // feedback of the current frame: tile -> covered texels
+        std::unordered_map<uint32_t, uint32_t>      _feedback;
+        std::vector<VirtualTileUpload>              _initial_uploads;
+
+        platform::IoQueue*                          _io{nullptr};
+        platform::IoCounter                         _tasks;
+        mutable std::mutex                          _mutex;
+        std::priority_queue<Request>                _queue;
+        // io tasks submitted but not started, the queue is refilled every update and they are reused
+        size_t                                      _scheduled{0};
+        std::unordered_set<uint32_t>                _pending;   // queued or being read
+        std::vector<Completed>                      _completed;
+    };
+} // namespace lux::engine::resource
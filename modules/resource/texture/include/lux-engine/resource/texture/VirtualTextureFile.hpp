@@ -0,0 +1,124 @@
+#pragma once
+#include "TextureFile.hpp"
+#include <string>
+#include <vector>
+#include <lux-engine/platform/cxx/MappedFile.hpp>
+#include <lux-engine/platform/cxx/visibility_control.h>
+
+namespace lux::engine::resource
+{
+    /**
+     * tiled mip chain for virtual texturing, little endian:
+     *
+     *   VirtualTextureHeader
+     *   VirtualTileEntry[tile_count]       level 0 first, row by row within a level
+     *   tile payloads, each aligned to kTextureFileAlignment
+     *
+     * every tile stores tile_size + 2 * border texels per side: its own texels plus a border copied from the
+     * neighbouring tiles (clamped at the image edge), so bilinear and anisotropic filtering inside the
+     * physical cache never reads a foreign tile. levels stop once a level fits into a single tile
+     */
+    constexpr uint32_t kVirtualTextureMagic   = 0x5456584C; // "LXVT"
+    constexpr uint32_t kVirtualTextureVersion = 1;
+
+    struct VirtualTextureHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t format;            // TextureFormat
+        uint32_t flags;             // TextureFileFlags
+        uint32_t width;
+        uint32_t height;
+        uint32_t tile_size;
+        uint32_t border;
+        uint32_t level_count;
+        uint32_t tile_count;
+        uint64_t file_size;
+    };
+
+    struct VirtualTileEntry
+    {
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    // packVirtualTile() keeps 12 bits of x and y, level 0 may not have more tiles than this along either axis
+    constexpr uint32_t kMaxVirtualTilesPerAxis = 4096;
+
+    // tiles of one level along each axis
+    constexpr uint32_t virtualTileCount(uint32_t extent, uint32_t level, uint32_t tile_size)
+    {
+        const uint32_t level_extent = (extent >> level) > 0 ? (extent >> level) : 1;
+        return static_cast<uint32_t>((uint64_t(level_extent) + tile_size - 1) / tile_size);
+    }
+
+    /**
+     * @brief a memory mapped virtual texture file, validated once on load. tile() is safe to call from any
+     *        thread, the first touch of a tile is what actually reads it from disk
+     */
+    class VirtualTextureFile
+    {
+    public:
+        VirtualTextureFile() = default;
+
+        LUX_EXPORT explicit VirtualTextureFile(const std::string& path);
+
+        LUX_EXPORT bool load(const std::string& path);
+
+        bool isEnable() const { return _header != nullptr; }
+
+        TextureFormat format() const { return static_cast<TextureFormat>(_header->format); }
+
+        uint32_t flags() const { return _header->flags; }
+
+        uint32_t width() const { return _header->width; }
+
+        uint32_t height() const { return _header->height; }
+
+        uint32_t tileSize() const { return _header->tile_size; }
+
+        uint32_t border() const { return _header->border; }
+
+        // texels per side of a stored tile, border included
+        uint32_t tileStride() const { return _header->tile_size + 2 * _header->border; }
+
+        // bytes of every stored tile
+        size_t tileBytes() const { return textureLevelSize(format(), tileStride(), tileStride()); }
+
+        uint32_t levelCount() const { return _header ? _header->level_count : 0; }
+
+        uint32_t tilesX(uint32_t level) const { return virtualTileCount(_header->width, level, _header->tile_size); }
+
+        uint32_t tilesY(uint32_t level) const { return virtualTileCount(_header->height, level, _header->tile_size); }
+
+        // a view into the mapping, empty when out of range
+        LUX_EXPORT TextureLevelView tile(uint32_t level, uint32_t x, uint32_t y) const;
+
+    private:
+        platform::MappedFile            _file;
+        const VirtualTextureHeader*     _header{nullptr};
+        const VirtualTileEntry*         _tiles{nullptr};
+        std::vector<uint32_t>           _level_first_tile;
+    };
+
+    struct VirtualTextureBuildSettings
+    {
+        TextureFormat           format{TextureFormat::BC7};     // RGBA8 or a block compressed format
+        CompressionQuality      quality{CompressionQuality::NORMAL};
+        // ignored for formats without an sRGB variant, see hasSrgbVariant()
+        bool                    srgb{true};
+        // tile_size + 2 * border must be a multiple of 4 for block compressed formats
+        uint32_t                tile_size{128};
+        uint32_t                border{4};
+    };
+
+    /**
+     * @brief cut an 8 bit image (1 - 4 channels) and its mip chain into bordered tiles and write them
+     *        as a virtual texture file. offline tool path, the whole chain is kept in memory.
+     *        fails for images wider or taller than kMaxVirtualTilesPerAxis tiles
+     */
+    LUX_EXPORT bool buildVirtualTexture(
+        const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels,
+        const VirtualTextureBuildSettings& settings, const std::string& path
+    );
+} // namespace lux::engine::resource
@@ -0,0 +1,438 @@
+#include "BlockEncoders.hpp"
+#include <lux-engine/platform/cxx/Simd.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace lux::engine::resource
+{
+    namespace
+    {
+        inline int expand5(int value) { return (value << 3) | (value >> 2); }
+
+        inline int expand6(int value) { return (value << 2) | (value >> 4); }
+
+        inline uint16_t pack565(float r, float g, float b)
+        {
+            const int r5 = std::clamp(static_cast<int>(std::lround(r * 31.0f / 255.0f)), 0, 31);
+            const int g6 = std::clamp(static_cast<int>(std::lround(g * 63.0f / 255.0f)), 0, 63);
+            const int b5 = std::clamp(static_cast<int>(std::lround(b * 31.0f / 255.0f)), 0, 31);
+            return static_cast<uint16_t>((r5 << 11) | (g6 << 5) | b5);
+        }
+
+        inline void unpack565(uint16_t color, int* rgb)
+        {
+            rgb[0] = expand5((color >> 11) & 31);
+            rgb[1] = expand6((color >> 5) & 63);
+            rgb[2] = expand5(color & 31);
+        }
+
+        /**
+         * for every 8 bit value, the endpoint pair whose 2/3 : 1/3 interpolant reproduces it best.
+         * a single color block encoded through these tables is exact up to the interpolation
+         * error instead of the plain 565 rounding error
+         */
+        struct SingleColorTable
+        {
+            uint8_t endpoints[256][2];
+
+            SingleColorTable(int bits)
+            {
+                const int levels = 1 << bits;
+                for(int value = 0; value < 256; value++)
+                {
+                    int best_error = std::numeric_limits<int>::max();
+                    for(int a = 0; a < levels; a++)
+                    {
+                        for(int b = 0; b < levels; b++)
+                        {
+                            const int ea = bits == 5 ? expand5(a) : expand6(a);
+                            const int eb = bits == 5 ? expand5(b) : expand6(b);
+                            const int error = std::abs((2 * ea + eb) / 3 - value);
+                            if(error < best_error)
+                            {
+                                best_error = error;
+                                endpoints[value][0] = static_cast<uint8_t>(a);
+                                endpoints[value][1] = static_cast<uint8_t>(b);
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        struct Palette
+        {
+            int colors[4][3];
+        };
+
+        // 4 color mode for color0 > color1, 3 color mode (third color halfway, index 3 transparent) otherwise
+        Palette makePalette(uint16_t color0, uint16_t color1)
+        {
+            Palette palette;
+            unpack565(color0, palette.colors[0]);
+            unpack565(color1, palette.colors[1]);
+            for(int c = 0; c < 3; c++)
+            {
+                const int a = palette.colors[0][c], b = palette.colors[1][c];
+                if(color0 > color1)
+                {
+                    palette.colors[2][c] = (2 * a + b) / 3;
+                    palette.colors[3][c] = (a + 2 * b) / 3;
+                }
+                else
+                {
+                    palette.colors[2][c] = (a + b) / 2;
+                    palette.colors[3][c] = 0;
+                }
+            }
+            return palette;
+        }
+
+        /**
+         * @brief nearest of the first `entries` palette colors for every texel, rgb distance.
+         *        texels in `transparent` (bit mask) take index 3 and add no error
+         *
+         * @return summed squared error
+         */
+        uint32_t assignIndices(const uint8_t* rgba, const Palette& palette, int entries, uint32_t transparent,
+            uint8_t* indices)
+        {
+            uint32_t total = 0;
+#if defined(LUX_SIMD_SSE2)
+            const __m128i zero       = _mm_setzero_si128();
+            const __m128i alpha_mask = _mm_set1_epi32(0x00ffffff);
+            __m128i colors[4];
+            for(int k = 0; k < entries; k++)
+            {
+                const int* c = palette.colors[k];
+                colors[k] = _mm_setr_epi16(
+                    static_cast<short>(c[0]), static_cast<short>(c[1]), static_cast<short>(c[2]), 0,
+                    static_cast<short>(c[0]), static_cast<short>(c[1]), static_cast<short>(c[2]), 0);
+            }
+            for(int group = 0; group < 4; group++)
+            {
+                const __m128i texels = _mm_and_si128(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba + group * 16)), alpha_mask);
+                const __m128i low  = _mm_unpacklo_epi8(texels, zero);
+                const __m128i high = _mm_unpackhi_epi8(texels, zero);
+
+                __m128i best_error = _mm_set1_epi32(std::numeric_limits<int32_t>::max());
+                __m128i best_index = zero;
+                for(int k = 0; k < entries; k++)
+                {
+                    // squared distance of four texels: (r, g) and (b, 0) pair sums, then added up
+                    __m128i dl = _mm_sub_epi16(low, colors[k]);
+                    __m128i dh = _mm_sub_epi16(high, colors[k]);
+                    dl = _mm_madd_epi16(dl, dl);
+                    dh = _mm_madd_epi16(dh, dh);
+                    const __m128 fl = _mm_castsi128_ps(dl), fh = _mm_castsi128_ps(dh);
+                    const __m128i error = _mm_add_epi32(
+                        _mm_castps_si128(_mm_shuffle_ps(fl, fh, _MM_SHUFFLE(2, 0, 2, 0))),
+                        _mm_castps_si128(_mm_shuffle_ps(fl, fh, _MM_SHUFFLE(3, 1, 3, 1))));
+
+                    const __m128i better = _mm_cmplt_epi32(error, best_error);
+                    best_error = _mm_or_si128(_mm_and_si128(better, error), _mm_andnot_si128(better, best_error));
+                    best_index = _mm_or_si128(_mm_and_si128(better, _mm_set1_epi32(k)), _mm_andnot_si128(better, best_index));
+                }
+
+                int32_t errors[4], best[4];
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(errors), best_error);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(best), best_index);
+                for(int i = 0; i < 4; i++)
+                {
+                    const int texel = group * 4 + i;
+                    if(transparent >> texel & 1)
+                    {
+                        indices[texel] = 3;
+                        continue;
+                    }
+                    indices[texel] = static_cast<uint8_t>(best[i]);
+                    total += static_cast<uint32_t>(errors[i]);
+                }
+            }
+#else
+            for(int texel = 0; texel < 16; texel++)
+            {
+                if(transparent >> texel & 1)
+                {
+                    indices[texel] = 3;
+                    continue;
+                }
+                const uint8_t* color = rgba + texel * 4;
+                int best = 0, best_error = std::numeric_limits<int>::max();
+                for(int k = 0; k < entries; k++)
+                {
+                    int error = 0;
+                    for(int c = 0; c < 3; c++)
+                    {
+                        const int d = color[c] - palette.colors[k][c];
+                        error += d * d;
+                    }
+                    if(error < best_error)
+                    {
+                        best_error = error;
+                        best       = k;
+                    }
+                }
+                indices[texel] = static_cast<uint8_t>(best);
+                total += static_cast<uint32_t>(best_error);
+            }
+#endif
+            return total;
+        }
+
+        // per channel bounds of the texels not in `transparent`
+        void colorBounds(const uint8_t* rgba, uint32_t transparent, uint8_t* low, uint8_t* high)
+        {
+#if defined(LUX_SIMD_SSE2)
+            if(transparent == 0)
+            {
+                __m128i min = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba));
+                __m128i max = min;
+                for(int group = 1; group < 4; group++)
+                {
+                    const __m128i texels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba + group * 16));
+                    min = _mm_min_epu8(min, texels);
+                    max = _mm_max_epu8(max, texels);
+                }
+                // fold the four texels of each register
+                min = _mm_min_epu8(min, _mm_srli_si128(min, 8));
+                max = _mm_max_epu8(max, _mm_srli_si128(max, 8));
+                min = _mm_min_epu8(min, _mm_srli_si128(min, 4));
+                max = _mm_max_epu8(max, _mm_srli_si128(max, 4));
+                const uint32_t packed_min = static_cast<uint32_t>(_mm_cvtsi128_si32(min));
+                const uint32_t packed_max = static_cast<uint32_t>(_mm_cvtsi128_si32(max));
+                for(int c = 0; c < 3; c++)
+                {
+                    low[c]  = static_cast<uint8_t>(packed_min >> (c * 8));
+                    high[c] = static_cast<uint8_t>(packed_max >> (c * 8));
+                }
+                return;
+            }
+#endif
+            low[0] = low[1] = low[2] = 255;
+            high[0] = high[1] = high[2] = 0;
+            for(int texel = 0; texel < 16; texel++)
+            {
+                if(transparent >> texel & 1) continue;
+                for(int c = 0; c < 3; c++)
+                {
+                    low[c]  = std::min(low[c], rgba[texel * 4 + c]);
+                    high[c] = std::max(high[c], rgba[texel * 4 + c]);
+                }
+            }
+        }
+
+        struct Bc1Result
+        {
+            uint16_t color0{0};
+            uint16_t color1{0};
+            uint8_t  indices[16]{};
+            uint32_t error{std::numeric_limits<uint32_t>::max()};
+        };
+
+        // evaluate an endpoint pair in the requested mode, ordering the endpoints as the mode needs
+        void tryEndpoints(const uint8_t* rgba, uint32_t transparent, uint16_t a, uint16_t b, bool three_color,
+            Bc1Result& best)
+        {
+            Bc1Result candidate;
+            if(three_color)
+            {
+                candidate.color0 = std::min(a, b);
+                candidate.color1 = std::max(a, b);
+            }
+            else
+            {
+                candidate.color0 = std::max(a, b);
+                candidate.color1 = std::min(a, b);
+            }
+            const Palette palette = makePalette(candidate.color0, candidate.color1);
+            // equal endpoints decode in 3 color mode, entry 0 is the color either way
+            const int entries = three_color || candidate.color0 == candidate.color1 ? 3 : 4;
+            candidate.error = assignIndices(rgba, palette, entries, transparent, candidate.indices);
+            if(candidate.error < best.error) best = candidate;
+        }
+
+        // least squares endpoints for the current indices, weights are the share of color0
+        bool refineEndpoints(const uint8_t* rgba, uint32_t transparent, const Bc1Result& current, bool three_color,
+            uint16_t& a, uint16_t& b)
+        {
+            const bool  four_color = !three_color && current.color0 != current.color1;
+            const float weights4[4] = {1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+            const float weights3[3] = {1.0f, 0.0f, 0.5f};
+
+            float aa = 0, ab = 0, bb = 0, ax[3]{}, bx[3]{};
+            for(int texel = 0; texel < 16; texel++)
+            {
+                if(transparent >> texel & 1) continue;
+                const float s = four_color ? weights4[current.indices[texel]] : weights3[current.indices[texel]];
+                const float t = 1.0f - s;
+                aa += s * s;
+                ab += s * t;
+                bb += t * t;
+                for(int c = 0; c < 3; c++)
+                {
+                    ax[c] += s * rgba[texel * 4 + c];
+                    bx[c] += t * rgba[texel * 4 + c];
+                }
+            }
+            const float determinant = aa * bb - ab * ab;
+            if(std::abs(determinant) < 1e-6f) return false;
+
+            float e0[3], e1[3];
+            for(int c = 0; c < 3; c++)
+            {
+                e0[c] = (bb * ax[c] - ab * bx[c]) / determinant;
+                e1[c] = (aa * bx[c] - ab * ax[c]) / determinant;
+            }
+            a = pack565(e0[0], e0[1], e0[2]);
+            b = pack565(e1[0], e1[1], e1[2]);
+            return true;
+        }
+
+        // endpoints at the extremes of the texels projected on the principal axis
+        void principalEndpoints(const uint8_t* rgba, uint32_t transparent, uint16_t& a, uint16_t& b)
+        {
+            float mean[3]{};
+            int   count = 0;
+            for(int texel = 0; texel < 16; texel++)
+            {
+                if(transparent >> texel & 1) continue;
+                for(int c = 0; c < 3; c++) mean[c] += rgba[texel * 4 + c];
+                count++;
+            }
+            for(int c = 0; c < 3; c++) mean[c] /= static_cast<float>(count);
+
+            float covariance[6]{};
+            for(int texel = 0; texel < 16; texel++)
+            {
+                if(transparent >> texel & 1) continue;
+                const float r = rgba[texel * 4] - mean[0], g = rgba[texel * 4 + 1] - mean[1], bl = rgba[texel * 4 + 2] - mean[2];
+                covariance[0] += r * r;
+                covariance[1] += r * g;
+                covariance[2] += r * bl;
+                covariance[3] += g * g;
+                covariance[4] += g * bl;
+                covariance[5] += bl * bl;
+            }
+
+            uint8_t low[3], high[3];
+            colorBounds(rgba, transparent, low, high);
+            float axis[3] = {
+                static_cast<float>(high[0] - low[0]),
+                static_cast<float>(high[1] - low[1]),
+                static_cast<float>(high[2] - low[2])
+            };
+            for(int iteration = 0; iteration < 4; iteration++)
+            {
+                const float next[3] = {
+                    covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2],
+                    covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2],
+                    covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2]
+                };
+                const float length = std::max({std::abs(next[0]), std::abs(next[1]), std::abs(next[2])});
+                if(length < 1e-6f) break;
+                for(int c = 0; c < 3; c++) axis[c] = next[c] / length;
+            }
+
+            int   min_texel = -1, max_texel = -1;
+            float min_t = std::numeric_limits<float>::max(), max_t = -min_t;
+            for(int texel = 0; texel < 16; texel++)
+            {
+                if(transparent >> texel & 1) continue;
+                const float t = rgba[texel * 4] * axis[0] + rgba[texel * 4 + 1] * axis[1] + rgba[texel * 4 + 2] * axis[2];
+                if(t < min_t) { min_t = t; min_texel = texel; }
+                if(t > max_t) { max_t = t; max_texel = texel; }
+            }
+            const uint8_t* lo = rgba + min_texel * 4;
+            const uint8_t* hi = rgba + max_texel * 4;
+            a = pack565(hi[0], hi[1], hi[2]);
+            b = pack565(lo[0], lo[1], lo[2]);
+        }
+    }
+
+    void encodeBc1Block(const uint8_t* rgba, CompressionQuality quality, bool punch_through, uint8_t* out)
+    {
+        uint32_t transparent = 0;
+        if(punch_through)
+        {
+            for(int texel = 0; texel < 16; texel++)
+            {
+                if(rgba[texel * 4 + 3] < 128) transparent |= 1u << texel;
+            }
+        }
+
+        Bc1Result best;
+        if(transparent == 0xffff)
+        {
+            // 3 color mode, every index transparent
+            std::fill(best.indices, best.indices + 16, 3);
+        }
+        else
+        {
+            const bool three_color = transparent != 0;
+
+            uint8_t low[3], high[3];
+            colorBounds(rgba, transparent, low, high);
+            if(low[0] == high[0] && low[1] == high[1] && low[2] == high[2])
+            {
+                if(three_color)
+                {
+                    const uint16_t color = pack565(low[0], low[1], low[2]);
+                    tryEndpoints(rgba, transparent, color, color, true, best);
+                }
+                else
+                {
+                    // every texel on the 2/3 interpolant of a tuned pair
+                    static const SingleColorTable table5(5), table6(6);
+                    const uint16_t a = static_cast<uint16_t>(
+                        (table5.endpoints[low[0]][0] << 11) | (table6.endpoints[low[1]][0] << 5) | table5.endpoints[low[2]][0]);
+                    const uint16_t b = static_cast<uint16_t>(
+                        (table5.endpoints[low[0]][1] << 11) | (table6.endpoints[low[1]][1] << 5) | table5.endpoints[low[2]][1]);
+                    tryEndpoints(rgba, transparent, a, b, false, best);
+                    tryEndpoints(rgba, transparent, pack565(low[0], low[1], low[2]), pack565(low[0], low[1], low[2]), false, best);
+                }
+            }
+            else
+            {
+                // bounding box, inset by 1/16 of the range to pull the endpoints off the outliers
+                float inset_low[3], inset_high[3];
+                for(int c = 0; c < 3; c++)
+                {
+                    const float inset = (high[c] - low[c]) / 16.0f;
+                    inset_low[c]  = low[c] + inset;
+                    inset_high[c] = high[c] - inset;
+                }
+                tryEndpoints(rgba, transparent,
+                    pack565(inset_high[0], inset_high[1], inset_high[2]),
+                    pack565(inset_low[0], inset_low[1], inset_low[2]), three_color, best);
+
+                if(quality != CompressionQuality::FAST)
+                {
+                    uint16_t a, b;
+                    principalEndpoints(rgba, transparent, a, b);
+                    tryEndpoints(rgba, transparent, a, b, three_color, best);
+
+                    const int iterations = quality == CompressionQuality::HIGH ? 4 : 1;
+                    for(int iteration = 0; iteration < iterations && best.error > 0; iteration++)
+                    {
+                        const uint32_t previous = best.error;
+                        if(!refineEndpoints(rgba, transparent, best, three_color, a, b)) break;
+                        tryEndpoints(rgba, transparent, a, b, three_color, best);
+                        if(best.error >= previous) break;
+                    }
+                }
+            }
+        }
+
+        uint32_t bits = 0;
+        for(int texel = 0; texel < 16; texel++) bits |= static_cast<uint32_t>(best.indices[texel]) << (texel * 2);
+        out[0] = static_cast<uint8_t>(best.color0);
+        out[1] = static_cast<uint8_t>(best.color0 >> 8);
+        out[2] = static_cast<uint8_t>(best.color1);
+        out[3] = static_cast<uint8_t>(best.color1 >> 8);
+        for(int i = 0; i < 4; i++) out[4 + i] = static_cast<uint8_t>(bits >> (i * 8));
+    }
+} // namespace lux::engine::resource
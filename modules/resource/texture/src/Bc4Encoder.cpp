@@ -0,0 +1,156 @@
+#include "BlockEncoders.hpp"
+#include <lux-engine/platform/cxx/Simd.hpp>
+#include <algorithm>
+#include <limits>
+
+namespace lux::engine::resource
+{
+    namespace
+    {
+        /**
+         * e0 > e1: 8 entries, e0, e1 and six interpolants
+         * e0 <= e1: 6 entries, e0, e1, four interpolants, then 0 and 255
+         */
+        void makePalette(int e0, int e1, uint8_t* palette)
+        {
+            palette[0] = static_cast<uint8_t>(e0);
+            palette[1] = static_cast<uint8_t>(e1);
+            if(e0 > e1)
+            {
+                for(int i = 2; i < 8; i++) palette[i] = static_cast<uint8_t>(((8 - i) * e0 + (i - 1) * e1 + 3) / 7);
+            }
+            else
+            {
+                for(int i = 2; i < 6; i++) palette[i] = static_cast<uint8_t>(((6 - i) * e0 + (i - 1) * e1 + 2) / 5);
+                palette[6] = 0;
+                palette[7] = 255;
+            }
+        }
+
+        struct Bc4Result
+        {
+            uint8_t  e0{0};
+            uint8_t  e1{0};
+            uint8_t  indices[16]{};
+            uint32_t error{std::numeric_limits<uint32_t>::max()};
+        };
+
+        // nearest palette entry of each value, all 16 values at once
+        uint32_t assignIndices(const uint8_t* values, const uint8_t* palette, uint8_t* indices)
+        {
+#if defined(LUX_SIMD_SSE2)
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values));
+            __m128i best_distance = _mm_set1_epi8(static_cast<char>(0xff));
+            __m128i best_index    = _mm_setzero_si128();
+            for(int k = 0; k < 8; k++)
+            {
+                const __m128i entry    = _mm_set1_epi8(static_cast<char>(palette[k]));
+                const __m128i distance = _mm_or_si128(_mm_subs_epu8(v, entry), _mm_subs_epu8(entry, v));
+                // unsigned distance < best: min differs from best
+                const __m128i closer   = _mm_andnot_si128(
+                    _mm_cmpeq_epi8(_mm_min_epu8(distance, best_distance), best_distance),
+                    _mm_set1_epi8(static_cast<char>(0xff)));
+                best_distance = _mm_min_epu8(distance, best_distance);
+                best_index    = _mm_or_si128(_mm_and_si128(closer, _mm_set1_epi8(static_cast<char>(k))),
+                                             _mm_andnot_si128(closer, best_index));
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(indices), best_index);
+
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i low  = _mm_unpacklo_epi8(best_distance, zero);
+            const __m128i high = _mm_unpackhi_epi8(best_distance, zero);
+            __m128i sum = _mm_add_epi32(_mm_madd_epi16(low, low), _mm_madd_epi16(high, high));
+            sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 8));
+            sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 4));
+            return static_cast<uint32_t>(_mm_cvtsi128_si32(sum));
+#else
+            uint32_t total = 0;
+            for(int i = 0; i < 16; i++)
+            {
+                int best = 0, best_distance = 256;
+                for(int k = 0; k < 8; k++)
+                {
+                    const int distance = std::abs(values[i] - palette[k]);
+                    if(distance < best_distance)
+                    {
+                        best_distance = distance;
+                        best          = k;
+                    }
+                }
+                indices[i] = static_cast<uint8_t>(best);
+                total += static_cast<uint32_t>(best_distance * best_distance);
+            }
+            return total;
+#endif
+        }
+
+        void tryEndpoints(const uint8_t* values, int e0, int e1, Bc4Result& best)
+        {
+            Bc4Result candidate;
+            candidate.e0 = static_cast<uint8_t>(e0);
+            candidate.e1 = static_cast<uint8_t>(e1);
+            uint8_t palette[8];
+            makePalette(e0, e1, palette);
+            candidate.error = assignIndices(values, palette, candidate.indices);
+            if(candidate.error < best.error) best = candidate;
+        }
+    }
+
+    void encodeBc4Block(const uint8_t* values, size_t stride, CompressionQuality quality, uint8_t* out)
+    {
+        uint8_t block[16];
+        for(int i = 0; i < 16; i++) block[i] = values[i * stride];
+
+        int low = 255, high = 0;
+        // range without the values the 6 entry mode stores exactly
+        int inner_low = 255, inner_high = 0;
+        for(int i = 0; i < 16; i++)
+        {
+            low  = std::min<int>(low, block[i]);
+            high = std::max<int>(high, block[i]);
+            if(block[i] != 0 && block[i] != 255)
+            {
+                inner_low  = std::min<int>(inner_low, block[i]);
+                inner_high = std::max<int>(inner_high, block[i]);
+            }
+        }
+
+        Bc4Result best;
+        if(low == high)
+        {
+            tryEndpoints(block, high, low, best);
+        }
+        else
+        {
+            tryEndpoints(block, high, low, best);
+
+            if(quality != CompressionQuality::FAST)
+            {
+                if(inner_low <= inner_high && (low == 0 || high == 255))
+                {
+                    tryEndpoints(block, inner_low, inner_high, best);
+                }
+
+                // local search around the best pair, keeping its mode
+                const int radius = quality == CompressionQuality::HIGH ? 3 : 1;
+                const int e0 = best.e0, e1 = best.e1;
+                for(int d0 = -radius; d0 <= radius && best.error > 0; d0++)
+                {
+                    for(int d1 = -radius; d1 <= radius; d1++)
+                    {
+                        const int a = e0 + d0, b = e1 + d1;
+                        if(a < 0 || a > 255 || b < 0 || b > 255) continue;
+                        if((e0 > e1) != (a > b)) continue;
+                        tryEndpoints(block, a, b, best);
+                    }
+                }
+            }
+        }
+
+        out[0] = best.e0;
+        out[1] = best.e1;
+        uint64_t bits = 0;
+        for(int i = 0; i < 16; i++) bits |= static_cast<uint64_t>(best.indices[i]) << (i * 3);
+        for(int i = 0; i < 6; i++) out[2 + i] = static_cast<uint8_t>(bits >> (i * 8));
+    }
+} // namespace lux::engine::resource
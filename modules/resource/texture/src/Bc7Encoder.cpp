@@ -0,0 +1,716 @@
+#include "BlockEncoders.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace lux::engine::resource
+{
+    namespace
+    {
+        // two subset partitions, bit i is set when texel i belongs to subset 1
+        constexpr uint16_t kPartitions2[64] = {
+            0xcccc, 0x8888, 0xeeee, 0xecc8, 0xc880, 0xfeec, 0xfec8, 0xec80,
+            0xc800, 0xffec, 0xfe80, 0xe800, 0xffe8, 0xff00, 0xfff0, 0xf000,
+            0xf710, 0x008e, 0x7100, 0x08ce, 0x008c, 0x7310, 0x3100, 0x8cce,
+            0x088c, 0x3110, 0x6666, 0x366c, 0x17e8, 0x0ff0, 0x718e, 0x399c,
+            0xaaaa, 0xf0f0, 0x5a5a, 0x33cc, 0x3c3c, 0x55aa, 0x9696, 0xa55a,
+            0x73ce, 0x13c8, 0x324c, 0x3bdc, 0x6996, 0xc33c, 0x9966, 0x0660,
+            0x0272, 0x04e4, 0x4e40, 0x2720, 0xc936, 0x936c, 0x39c6, 0x639c,
+            0x9336, 0x9cc6, 0x817e, 0xe718, 0xccf0, 0x0fcc, 0x7744, 0xee22
+        };
+
+        // texel holding the anchor index of subset 1, subset 0 always anchors at texel 0
+        constexpr uint8_t kAnchors2[64] = {
+            15, 15, 15, 15, 15, 15, 15, 15,
+            15, 15, 15, 15, 15, 15, 15, 15,
+            15,  2,  8,  2,  2,  8,  8, 15,
+             2,  8,  2,  2,  8,  8,  2,  2,
+            15, 15,  6,  8,  2,  8, 15, 15,
+             2,  8,  2,  2,  2, 15, 15,  6,
+             6,  2,  6,  8, 15, 15,  2,  2,
+            15, 15, 15, 15, 15,  2,  2, 15
+        };
+
+        constexpr uint8_t kWeights2[4]  = {0, 21, 43, 64};
+        constexpr uint8_t kWeights3[8]  = {0, 9, 18, 27, 37, 46, 55, 64};
+        constexpr uint8_t kWeights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+        inline const uint8_t* weightTable(int index_bits)
+        {
+            return index_bits == 2 ? kWeights2 : index_bits == 3 ? kWeights3 : kWeights4;
+        }
+
+        enum class PBits
+        {
+            NONE,
+            SHARED,     // one p-bit per subset
+            UNIQUE      // one p-bit per endpoint
+        };
+
+        // how one set of endpoints is stored and interpolated
+        struct EndpointFormat
+        {
+            int     first_channel;
+            int     channel_count;
+            int     bits;           // stored bits per component, p-bit excluded
+            PBits   pbits;
+            int     index_bits;
+        };
+
+        using Texels = uint8_t[16][4];
+
+        struct Subset
+        {
+            uint8_t texels[16];
+            int     count{0};
+        };
+
+        struct SubsetFit
+        {
+            uint8_t  quantized[2][4]{};     // stored components
+            uint8_t  pbits[2]{};
+            int      decoded[2][4]{};       // 8 bit endpoints as the decoder sees them
+            uint8_t  indices[16]{};         // by texel
+            uint32_t error{std::numeric_limits<uint32_t>::max()};
+        };
+
+        inline int countTrailingZeros(uint32_t value)
+        {
+            int count = 0;
+            while(!(value & 1))
+            {
+                value >>= 1;
+                count++;
+            }
+            return count;
+        }
+
+        inline int expandComponent(int value, int bits)
+        {
+            return bits >= 8 ? value : (value << (8 - bits)) | (value >> (2 * bits - 8));
+        }
+
+        /**
+         * for every 8 bit target, the stored value whose expansion lands closest to it.
+         * one table per component width (5 to 8 bits) and p-bit (none, 0, 1)
+         */
+        struct QuantizeLookup
+        {
+            uint8_t stored[4][3][256];
+            uint8_t decoded[4][3][256];
+
+            QuantizeLookup()
+            {
+                for(int bits = 5; bits <= 8; bits++)
+                {
+                    for(int pbit_mode = 0; pbit_mode < 3; pbit_mode++)
+                    {
+                        const bool has_pbit = pbit_mode > 0;
+                        const int  total    = bits + (has_pbit ? 1 : 0);
+                        if(total > 8) continue;
+                        for(int target = 0; target < 256; target++)
+                        {
+                            int best_error = 256;
+                            for(int q = 0; q < (1 << bits); q++)
+                            {
+                                const int value = expandComponent(has_pbit ? (q << 1) | (pbit_mode - 1) : q, total);
+                                if(std::abs(value - target) < best_error)
+                                {
+                                    best_error = std::abs(value - target);
+                                    stored[bits - 5][pbit_mode][target]  = static_cast<uint8_t>(q);
+                                    decoded[bits - 5][pbit_mode][target] = static_cast<uint8_t>(value);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        // stored value whose expansion (with `pbit` appended) lands closest to `target`
+        inline int quantizeComponent(float target, int bits, bool has_pbit, int pbit, int& decoded)
+        {
+            static const QuantizeLookup lookup;
+            const int rounded   = static_cast<int>(std::clamp(target, 0.0f, 255.0f) + 0.5f);
+            const int pbit_mode = has_pbit ? pbit + 1 : 0;
+            decoded = lookup.decoded[bits - 5][pbit_mode][rounded];
+            return lookup.stored[bits - 5][pbit_mode][rounded];
+        }
+
+        // for a position t = 0..64 along the endpoint line, the index whose weight is nearest
+        struct WeightLookup
+        {
+            uint8_t nearest[3][65];
+
+            WeightLookup()
+            {
+                for(int bits = 2; bits <= 4; bits++)
+                {
+                    const uint8_t* weights = weightTable(bits);
+                    for(int t = 0; t <= 64; t++)
+                    {
+                        int best = 0;
+                        for(int k = 1; k < (1 << bits); k++)
+                        {
+                            if(std::abs(weights[k] - t) < std::abs(weights[best] - t)) best = k;
+                        }
+                        nearest[bits - 2][t] = static_cast<uint8_t>(best);
+                    }
+                }
+            }
+        };
+
+        /**
+         * @brief nearest palette entry per texel, returns the summed squared error.
+         *        the texel is projected on the endpoint line for a first guess, then the guess and
+         *        its neighbours are compared exactly (integer rounding of the palette can move the optimum)
+         */
+        uint32_t assignIndices(const Texels& block, const Subset& subset, const EndpointFormat& format,
+            const int (&endpoints)[2][4], uint8_t* indices)
+        {
+            static const WeightLookup lookup;
+            const uint8_t* weights = weightTable(format.index_bits);
+            const uint8_t* nearest = lookup.nearest[format.index_bits - 2];
+            const int      levels  = 1 << format.index_bits;
+            const int      first   = format.first_channel;
+            const int      last    = first + format.channel_count;
+
+            int palette[16][4];
+            int direction[4]{}, length = 0;
+            for(int c = first; c < last; c++)
+            {
+                for(int k = 0; k < levels; k++)
+                {
+                    palette[k][c] = ((64 - weights[k]) * endpoints[0][c] + weights[k] * endpoints[1][c] + 32) >> 6;
+                }
+                direction[c] = endpoints[1][c] - endpoints[0][c];
+                length += direction[c] * direction[c];
+            }
+            const float scale = length > 0 ? 64.0f / static_cast<float>(length) : 0.0f;
+
+            uint32_t total = 0;
+            for(int i = 0; i < subset.count; i++)
+            {
+                const uint8_t* texel = block[subset.texels[i]];
+                int dot = 0;
+                for(int c = first; c < last; c++) dot += (texel[c] - endpoints[0][c]) * direction[c];
+                const int guess = nearest[std::clamp(static_cast<int>(dot * scale + 0.5f), 0, 64)];
+
+                int best = guess, best_error = std::numeric_limits<int>::max();
+                for(int k = std::max(guess - 1, 0); k <= std::min(guess + 1, levels - 1); k++)
+                {
+                    int error = 0;
+                    for(int c = first; c < last; c++)
+                    {
+                        const int d = palette[k][c] - texel[c];
+                        error += d * d;
+                    }
+                    if(error < best_error)
+                    {
+                        best_error = error;
+                        best       = k;
+                    }
+                }
+                indices[subset.texels[i]] = static_cast<uint8_t>(best);
+                total += static_cast<uint32_t>(best_error);
+            }
+            return total;
+        }
+
+        struct FitEffort
+        {
+            int  refine_iterations;
+            bool all_pbits;         // evaluate every p-bit combination instead of the closest one
+        };
+
+        // quantize float endpoints under the allowed p-bit choices and keep the best result
+        void tryEndpoints(const Texels& block, const Subset& subset, const EndpointFormat& format,
+            const FitEffort& effort, const float (&endpoints)[2][4], SubsetFit& best)
+        {
+            const bool has_pbit = format.pbits != PBits::NONE;
+            const int  first    = format.first_channel;
+            const int  last     = first + format.channel_count;
+
+            auto quantize = [&](int combo, SubsetFit& candidate)
+            {
+                candidate.pbits[0] = static_cast<uint8_t>(combo & 1);
+                candidate.pbits[1] = static_cast<uint8_t>(format.pbits == PBits::UNIQUE ? combo >> 1 : combo & 1);
+                int error = 0;
+                for(int e = 0; e < 2; e++)
+                {
+                    for(int c = first; c < last; c++)
+                    {
+                        candidate.quantized[e][c] = static_cast<uint8_t>(quantizeComponent(
+                            endpoints[e][c], format.bits, has_pbit, candidate.pbits[e], candidate.decoded[e][c]));
+                        const float d = candidate.decoded[e][c] - endpoints[e][c];
+                        error += static_cast<int>(d * d);
+                    }
+                }
+                return error;
+            };
+
+            const int combos = format.pbits == PBits::UNIQUE ? 4 : format.pbits == PBits::SHARED ? 2 : 1;
+            if(effort.all_pbits || combos == 1)
+            {
+                for(int combo = 0; combo < combos; combo++)
+                {
+                    SubsetFit candidate;
+                    quantize(combo, candidate);
+                    candidate.error = assignIndices(block, subset, format, candidate.decoded, candidate.indices);
+                    if(candidate.error < best.error) best = candidate;
+                }
+                return;
+            }
+
+            // only the combination that moves the endpoints the least
+            SubsetFit candidate, closest;
+            int closest_error = std::numeric_limits<int>::max();
+            for(int combo = 0; combo < combos; combo++)
+            {
+                const int error = quantize(combo, candidate);
+                if(error < closest_error)
+                {
+                    closest_error = error;
+                    closest       = candidate;
+                }
+            }
+            closest.error = assignIndices(block, subset, format, closest.decoded, closest.indices);
+            if(closest.error < best.error) best = closest;
+        }
+
+        // principal axis endpoints, then least squares refinement against the chosen indices
+        void fitSubset(const Texels& block, const Subset& subset, const EndpointFormat& format,
+            const FitEffort& effort, SubsetFit& best)
+        {
+            const int first = format.first_channel;
+            const int last  = first + format.channel_count;
+
+            float mean[4]{}, low[4], high[4];
+            std::fill(low, low + 4, 255.0f);
+            std::fill(high, high + 4, 0.0f);
+            for(int i = 0; i < subset.count; i++)
+            {
+                const uint8_t* texel = block[subset.texels[i]];
+                for(int c = first; c < last; c++)
+                {
+                    mean[c] += texel[c];
+                    low[c]   = std::min<float>(low[c], texel[c]);
+                    high[c]  = std::max<float>(high[c], texel[c]);
+                }
+            }
+            for(int c = first; c < last; c++) mean[c] /= static_cast<float>(subset.count);
+
+            float covariance[4][4]{};
+            for(int i = 0; i < subset.count; i++)
+            {
+                const uint8_t* texel = block[subset.texels[i]];
+                for(int a = first; a < last; a++)
+                {
+                    for(int b = a; b < last; b++)
+                    {
+                        covariance[a][b] += (texel[a] - mean[a]) * (texel[b] - mean[b]);
+                    }
+                }
+            }
+            for(int a = first; a < last; a++)
+            {
+                for(int b = first; b < a; b++) covariance[a][b] = covariance[b][a];
+            }
+
+            // power iteration from the bounding box diagonal
+            float axis[4]{};
+            for(int c = first; c < last; c++) axis[c] = high[c] - low[c];
+            for(int iteration = 0; iteration < 6; iteration++)
+            {
+                float next[4]{}, length = 0;
+                for(int a = first; a < last; a++)
+                {
+                    for(int b = first; b < last; b++) next[a] += covariance[a][b] * axis[b];
+                    length = std::max(length, std::abs(next[a]));
+                }
+                if(length < 1e-6f) break;
+                for(int c = first; c < last; c++) axis[c] = next[c] / length;
+            }
+
+            float norm = 0;
+            for(int c = first; c < last; c++) norm += axis[c] * axis[c];
+
+            float endpoints[2][4]{};
+            if(norm < 1e-12f)
+            {
+                for(int c = first; c < last; c++) endpoints[0][c] = endpoints[1][c] = mean[c];
+            }
+            else
+            {
+                float t_min = std::numeric_limits<float>::max(), t_max = -t_min;
+                for(int i = 0; i < subset.count; i++)
+                {
+                    const uint8_t* texel = block[subset.texels[i]];
+                    float t = 0;
+                    for(int c = first; c < last; c++) t += (texel[c] - mean[c]) * axis[c];
+                    t_min = std::min(t_min, t);
+                    t_max = std::max(t_max, t);
+                }
+                for(int c = first; c < last; c++)
+                {
+                    endpoints[0][c] = mean[c] + axis[c] * t_min / norm;
+                    endpoints[1][c] = mean[c] + axis[c] * t_max / norm;
+                }
+            }
+            tryEndpoints(block, subset, format, effort, endpoints, best);
+
+            const uint8_t* weights = weightTable(format.index_bits);
+            for(int iteration = 0; iteration < effort.refine_iterations && best.error > 0; iteration++)
+            {
+                // minimize sum |(1 - t) e0 + t e1 - x|^2 over the endpoints for fixed t
+                float aa = 0, ab = 0, bb = 0, ax[4]{}, bx[4]{};
+                for(int i = 0; i < subset.count; i++)
+                {
+                    const uint8_t  texel_index = subset.texels[i];
+                    const uint8_t* texel = block[texel_index];
+                    const float    t = weights[best.indices[texel_index]] / 64.0f;
+                    const float    s = 1.0f - t;
+                    aa += s * s;
+                    ab += s * t;
+                    bb += t * t;
+                    for(int c = first; c < last; c++)
+                    {
+                        ax[c] += s * texel[c];
+                        bx[c] += t * texel[c];
+                    }
+                }
+                const float determinant = aa * bb - ab * ab;
+                if(std::abs(determinant) < 1e-6f) break;
+
+                float refined[2][4]{};
+                for(int c = first; c < last; c++)
+                {
+                    refined[0][c] = (bb * ax[c] - ab * bx[c]) / determinant;
+                    refined[1][c] = (aa * bx[c] - ab * ax[c]) / determinant;
+                }
+                const uint32_t previous = best.error;
+                tryEndpoints(block, subset, format, effort, refined, best);
+                if(best.error >= previous) break;
+            }
+        }
+
+        // the anchor texel stores its index without the top bit, which therefore has to be zero
+        void fixAnchor(const Subset& subset, const EndpointFormat& format, int anchor, SubsetFit& fit)
+        {
+            const int high_bit = 1 << (format.index_bits - 1);
+            if(fit.indices[anchor] < high_bit) return;
+
+            const int max_index = (1 << format.index_bits) - 1;
+            for(int c = 0; c < 4; c++)
+            {
+                std::swap(fit.quantized[0][c], fit.quantized[1][c]);
+                std::swap(fit.decoded[0][c], fit.decoded[1][c]);
+            }
+            std::swap(fit.pbits[0], fit.pbits[1]);
+            for(int i = 0; i < subset.count; i++)
+            {
+                const uint8_t texel = subset.texels[i];
+                fit.indices[texel] = static_cast<uint8_t>(max_index - fit.indices[texel]);
+            }
+        }
+
+        class BitWriter
+        {
+        public:
+            void write(uint32_t value, int bits)
+            {
+                for(int i = 0; i < bits; i++, _position++)
+                {
+                    _bytes[_position >> 3] |= static_cast<uint8_t>(((value >> i) & 1) << (_position & 7));
+                }
+            }
+
+            const uint8_t* bytes() const { return _bytes; }
+
+        private:
+            uint8_t _bytes[16]{};
+            int     _position{0};
+        };
+
+        struct EncodedBlock
+        {
+            uint8_t  bytes[16]{};
+            uint32_t error{std::numeric_limits<uint32_t>::max()};
+        };
+
+        inline void keepBetter(EncodedBlock& best, const BitWriter& writer, uint32_t error)
+        {
+            if(error >= best.error) return;
+            std::memcpy(best.bytes, writer.bytes(), 16);
+            best.error = error;
+        }
+
+        // modes 6 (one subset) and 1, 3, 7 (two subsets): color and alpha share one index set
+        void encodeJointMode(const Texels& block, int mode, int partition, const FitEffort& effort, EncodedBlock& best)
+        {
+            EndpointFormat format{};
+            switch(mode)
+            {
+                case 1: format = {0, 3, 6, PBits::SHARED, 3}; break;
+                case 3: format = {0, 3, 7, PBits::UNIQUE, 2}; break;
+                case 6: format = {0, 4, 7, PBits::UNIQUE, 4}; break;
+                case 7: format = {0, 4, 5, PBits::UNIQUE, 2}; break;
+                default: return;
+            }
+            const int subset_count = mode == 6 ? 1 : 2;
+
+            Subset subsets[2];
+            for(int texel = 0; texel < 16; texel++)
+            {
+                const int s = subset_count == 2 ? (kPartitions2[partition] >> texel) & 1 : 0;
+                subsets[s].texels[subsets[s].count++] = static_cast<uint8_t>(texel);
+            }
+
+            SubsetFit fits[2];
+            uint32_t  error = 0;
+            for(int s = 0; s < subset_count; s++)
+            {
+                fitSubset(block, subsets[s], format, effort, fits[s]);
+                fixAnchor(subsets[s], format, s == 0 ? 0 : kAnchors2[partition], fits[s]);
+                error += fits[s].error;
+                if(error >= best.error) return;
+            }
+
+            BitWriter writer;
+            writer.write(1u << mode, mode + 1);
+            if(subset_count == 2) writer.write(static_cast<uint32_t>(partition), 6);
+            for(int c = 0; c < format.channel_count; c++)
+            {
+                for(int s = 0; s < subset_count; s++)
+                {
+                    writer.write(fits[s].quantized[0][c], format.bits);
+                    writer.write(fits[s].quantized[1][c], format.bits);
+                }
+            }
+            for(int s = 0; s < subset_count; s++)
+            {
+                writer.write(fits[s].pbits[0], 1);
+                if(format.pbits == PBits::UNIQUE) writer.write(fits[s].pbits[1], 1);
+            }
+            const int anchor = subset_count == 2 ? kAnchors2[partition] : 0;
+            for(int texel = 0; texel < 16; texel++)
+            {
+                const int s    = subset_count == 2 ? (kPartitions2[partition] >> texel) & 1 : 0;
+                const int bits = texel == 0 || (subset_count == 2 && texel == anchor) ? format.index_bits - 1 : format.index_bits;
+                writer.write(fits[s].indices[texel], bits);
+            }
+            keepBetter(best, writer, error);
+        }
+
+        // modes 4 and 5: one subset, color and alpha with their own indices, one color channel
+        // optionally swapped with alpha (`rotation` 1..3 swaps red, green, blue)
+        void encodeSeparateAlphaMode(const Texels& source, int mode, int rotation, int index_selection,
+            const FitEffort& effort, EncodedBlock& best)
+        {
+            Texels block;
+            std::memcpy(block, source, sizeof(Texels));
+            if(rotation > 0)
+            {
+                for(auto& texel : block) std::swap(texel[rotation - 1], texel[3]);
+            }
+
+            EndpointFormat color_format{}, alpha_format{};
+            if(mode == 5)
+            {
+                color_format = {0, 3, 7, PBits::NONE, 2};
+                alpha_format = {3, 1, 8, PBits::NONE, 2};
+            }
+            else
+            {
+                color_format = {0, 3, 5, PBits::NONE, index_selection ? 3 : 2};
+                alpha_format = {3, 1, 6, PBits::NONE, index_selection ? 2 : 3};
+            }
+
+            Subset all;
+            for(int texel = 0; texel < 16; texel++) all.texels[all.count++] = static_cast<uint8_t>(texel);
+
+            SubsetFit color, alpha;
+            fitSubset(block, all, alpha_format, effort, alpha);
+            if(alpha.error >= best.error) return;
+            fitSubset(block, all, color_format, effort, color);
+            const uint32_t error = color.error + alpha.error;
+            if(error >= best.error) return;
+            fixAnchor(all, color_format, 0, color);
+            fixAnchor(all, alpha_format, 0, alpha);
+
+            BitWriter writer;
+            writer.write(1u << mode, mode + 1);
+            writer.write(static_cast<uint32_t>(rotation), 2);
+            if(mode == 4) writer.write(static_cast<uint32_t>(index_selection), 1);
+            for(int c = 0; c < 3; c++)
+            {
+                writer.write(color.quantized[0][c], color_format.bits);
+                writer.write(color.quantized[1][c], color_format.bits);
+            }
+            writer.write(alpha.quantized[0][3], alpha_format.bits);
+            writer.write(alpha.quantized[1][3], alpha_format.bits);
+
+            // the 2 bit index set is stored first
+            const SubsetFit&      narrow        = color_format.index_bits == 2 ? color : alpha;
+            const SubsetFit&      wide          = color_format.index_bits == 2 ? alpha : color;
+            const EndpointFormat& wide_format   = color_format.index_bits == 2 ? alpha_format : color_format;
+            for(int texel = 0; texel < 16; texel++)
+            {
+                writer.write(narrow.indices[texel], texel == 0 ? 1 : 2);
+            }
+            for(int texel = 0; texel < 16; texel++)
+            {
+                writer.write(wide.indices[texel], texel == 0 ? wide_format.index_bits - 1 : wide_format.index_bits);
+            }
+            keepBetter(best, writer, error);
+        }
+
+        // second moments of a texel set: count, sums and the upper triangle of the products
+        struct Moments
+        {
+            float count{0};
+            float sum[4]{};
+            float products[4][4]{};
+        };
+
+        // squared distance of the set from its best fitting line: trace of the covariance minus
+        // the largest eigenvalue, estimated by a few power iterations
+        float lineResidual(const Moments& moments, int channel_count)
+        {
+            if(moments.count < 1) return 0;
+            float covariance[4][4];
+            float trace = 0;
+            for(int a = 0; a < channel_count; a++)
+            {
+                for(int b = a; b < channel_count; b++)
+                {
+                    covariance[a][b] = covariance[b][a] = moments.products[a][b] - moments.sum[a] * moments.sum[b] / moments.count;
+                }
+                trace += covariance[a][a];
+            }
+
+            float axis[4] = {1, 1, 1, 1};
+            for(int iteration = 0; iteration < 3; iteration++)
+            {
+                float next[4]{}, length = 0;
+                for(int a = 0; a < channel_count; a++)
+                {
+                    for(int b = 0; b < channel_count; b++) next[a] += covariance[a][b] * axis[b];
+                    length = std::max(length, std::abs(next[a]));
+                }
+                if(length < 1e-6f) return trace;
+                for(int c = 0; c < channel_count; c++) axis[c] = next[c] / length;
+            }
+            float numerator = 0, denominator = 0;
+            for(int a = 0; a < channel_count; a++)
+            {
+                float row = 0;
+                for(int b = 0; b < channel_count; b++) row += covariance[a][b] * axis[b];
+                numerator   += axis[a] * row;
+                denominator += axis[a] * axis[a];
+            }
+            return std::max(trace - numerator / denominator, 0.0f);
+        }
+
+        // cheap ranking of the two subset partitions by how well each subset fits a line
+        void rankPartitions(const Texels& block, int channel_count, int* ranked, int count)
+        {
+            Moments total;
+            Moments texels[16];
+            for(int texel = 0; texel < 16; texel++)
+            {
+                Moments& moments = texels[texel];
+                moments.count = 1;
+                for(int a = 0; a < channel_count; a++)
+                {
+                    moments.sum[a] = block[texel][a];
+                    for(int b = a; b < channel_count; b++) moments.products[a][b] = static_cast<float>(block[texel][a] * block[texel][b]);
+                }
+                total.count += 1;
+                for(int a = 0; a < channel_count; a++)
+                {
+                    total.sum[a] += moments.sum[a];
+                    for(int b = a; b < channel_count; b++) total.products[a][b] += moments.products[a][b];
+                }
+            }
+
+            float estimates[64];
+            for(int partition = 0; partition < 64; partition++)
+            {
+                // subset 1 from its texels, subset 0 is the rest
+                Moments second;
+                for(uint32_t mask = kPartitions2[partition]; mask; mask &= mask - 1)
+                {
+                    const Moments& moments = texels[countTrailingZeros(mask)];
+                    second.count += 1;
+                    for(int a = 0; a < channel_count; a++)
+                    {
+                        second.sum[a] += moments.sum[a];
+                        for(int b = a; b < channel_count; b++) second.products[a][b] += moments.products[a][b];
+                    }
+                }
+                Moments first;
+                first.count = total.count - second.count;
+                for(int a = 0; a < channel_count; a++)
+                {
+                    first.sum[a] = total.sum[a] - second.sum[a];
+                    for(int b = a; b < channel_count; b++) first.products[a][b] = total.products[a][b] - second.products[a][b];
+                }
+                estimates[partition] = lineResidual(first, channel_count) + lineResidual(second, channel_count);
+            }
+
+            int order[64];
+            for(int i = 0; i < 64; i++) order[i] = i;
+            std::partial_sort(order, order + count, order + 64,
+                [&](int a, int b) { return estimates[a] < estimates[b]; });
+            std::copy(order, order + count, ranked);
+        }
+    }
+
+    void encodeBc7Block(const uint8_t* rgba, CompressionQuality quality, uint8_t* out)
+    {
+        Texels block;
+        std::memcpy(block, rgba, sizeof(Texels));
+
+        bool opaque = true;
+        for(auto& texel : block) opaque = opaque && texel[3] == 255;
+
+        const FitEffort effort{quality == CompressionQuality::HIGH ? 2 : 1, quality == CompressionQuality::HIGH};
+        const int       tried = quality == CompressionQuality::FAST ? 0 : quality == CompressionQuality::NORMAL ? 4 : 16;
+
+        EncodedBlock best;
+        encodeJointMode(block, 6, 0, effort, best);
+
+        if(tried > 0 && best.error > 0)
+        {
+            int partitions[64];
+            rankPartitions(block, opaque ? 3 : 4, partitions, tried);
+            for(int i = 0; i < tried && best.error > 0; i++)
+            {
+                if(opaque)
+                {
+                    encodeJointMode(block, 1, partitions[i], effort, best);
+                    encodeJointMode(block, 3, partitions[i], effort, best);
+                }
+                else
+                {
+                    encodeJointMode(block, 7, partitions[i], effort, best);
+                }
+            }
+
+            // separate alpha pays off for blocks whose alpha (or one color channel) doesn't follow the rest
+            const int rotations = quality == CompressionQuality::HIGH ? 4 : 1;
+            for(int rotation = 0; rotation < rotations && best.error > 0; rotation++)
+            {
+                encodeSeparateAlphaMode(block, 5, rotation, 0, effort, best);
+                if(quality == CompressionQuality::HIGH)
+                {
+                    encodeSeparateAlphaMode(block, 4, rotation, 0, effort, best);
+                    encodeSeparateAlphaMode(block, 4, rotation, 1, effort, best);
+                }
+            }
+        }
+        std::memcpy(out, best.bytes, 16);
+    }
+} // namespace lux::engine::resource
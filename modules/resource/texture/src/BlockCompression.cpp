@@ -0,0 +1,189 @@
+#include "lux-engine/resource/texture/BlockCompression.hpp"
+#include "BlockEncoders.hpp"
+#include <lux-engine/platform/cxx/Hash.hpp>
+#include <lux-engine/platform/cxx/MappedFile.hpp>
+#include <lux-engine/platform/cxx/Parallel.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+namespace lux::engine::resource
+{
+    namespace
+    {
+        // bump whenever an encoder changes its output, cached blocks of older versions are ignored
+        constexpr uint32_t kEncoderVersion = 1;
+        constexpr uint32_t kCacheMagic     = 0x4342584C; // "LXBC"
+
+        struct CacheHeader
+        {
+            uint32_t magic;
+            uint32_t encoder_version;
+            uint64_t key;
+            uint64_t size;
+        };
+
+        // 4x4 texels as rgba, clamped to the image at the right and bottom edge
+        void fetchBlock(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels,
+            uint32_t block_x, uint32_t block_y, uint8_t* rgba)
+        {
+            for(uint32_t y = 0; y < 4; y++)
+            {
+                const uint32_t source_y = std::min(block_y * 4 + y, height - 1);
+                const uint8_t* row = pixels + static_cast<size_t>(source_y) * width * channels;
+                for(uint32_t x = 0; x < 4; x++)
+                {
+                    const uint32_t source_x = std::min(block_x * 4 + x, width - 1);
+                    const uint8_t* texel = row + static_cast<size_t>(source_x) * channels;
+                    uint8_t* target = rgba + (y * 4 + x) * 4;
+                    switch(channels)
+                    {
+                        case 1:
+                            target[0] = target[1] = target[2] = texel[0];
+                            target[3] = 255;
+                            break;
+                        case 2:
+                            target[0] = texel[0];
+                            target[1] = texel[1];
+                            target[2] = 0;
+                            target[3] = 255;
+                            break;
+                        case 3:
+                            target[0] = texel[0];
+                            target[1] = texel[1];
+                            target[2] = texel[2];
+                            target[3] = 255;
+                            break;
+                        default:
+                            target[0] = texel[0];
+                            target[1] = texel[1];
+                            target[2] = texel[2];
+                            target[3] = texel[3];
+                            break;
+                    }
+                }
+            }
+        }
+
+        void encodeBlock(const uint8_t* rgba, const BlockCompressionSettings& settings, uint8_t* out)
+        {
+            switch(settings.format)
+            {
+                case BlockFormat::BC1:
+                    encodeBc1Block(rgba, settings.quality, true, out);
+                    break;
+                case BlockFormat::BC3:
+                    encodeBc4Block(rgba + 3, 4, settings.quality, out);
+                    encodeBc1Block(rgba, settings.quality, false, out + 8);
+                    break;
+                case BlockFormat::BC4:
+                    encodeBc4Block(rgba, 4, settings.quality, out);
+                    break;
+                case BlockFormat::BC5:
+                    encodeBc4Block(rgba, 4, settings.quality, out);
+                    encodeBc4Block(rgba + 1, 4, settings.quality, out + 8);
+                    break;
+                case BlockFormat::BC7:
+                    encodeBc7Block(rgba, settings.quality, out);
+                    break;
+            }
+        }
+
+        uint64_t cacheKey(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels,
+            const BlockCompressionSettings& settings)
+        {
+            uint64_t key = platform::hash64(pixels, static_cast<size_t>(width) * height * channels);
+            key = platform::hashCombine(key, (static_cast<uint64_t>(width) << 32) | height);
+            key = platform::hashCombine(key, (static_cast<uint64_t>(channels) << 16)
+                | (static_cast<uint64_t>(settings.format) << 8) | static_cast<uint64_t>(settings.quality));
+            return platform::hashCombine(key, kEncoderVersion);
+        }
+    }
+
+    bool compressImage(
+        const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels,
+        const BlockCompressionSettings& settings, std::vector<uint8_t>& blocks)
+    {
+        if(!pixels || width == 0 || height == 0 || channels == 0 || channels > 4) return false;
+
+        const uint32_t blocks_x = (width + 3) / 4;
+        const uint32_t blocks_y = (height + 3) / 4;
+        const size_t   block_size = blockBytes(settings.format);
+        blocks.resize(compressedSize(settings.format, width, height));
+
+        // bc7 costs orders of magnitude more per block, hand out smaller chunks of rows
+        const size_t grain = settings.format == BlockFormat::BC7 ? 1 : std::max<size_t>(1, 4096 / blocks_x);
+        platform::parallelFor(0, blocks_y, grain, [&](size_t row_begin, size_t row_end)
+        {
+            uint8_t rgba[64];
+            for(size_t block_y = row_begin; block_y < row_end; block_y++)
+            {
+                uint8_t* out = blocks.data() + block_y * blocks_x * block_size;
+                for(uint32_t block_x = 0; block_x < blocks_x; block_x++, out += block_size)
+                {
+                    fetchBlock(pixels, width, height, channels, block_x, static_cast<uint32_t>(block_y), rgba);
+                    encodeBlock(rgba, settings, out);
+                }
+            }
+        });
+        return true;
+    }
+
+    BlockCompressionCache::BlockCompressionCache(std::string directory)
+        : _directory(std::move(directory))
+    {
+        std::error_code error;
+        std::filesystem::create_directories(_directory, error);
+    }
+
+    bool BlockCompressionCache::compress(
+        const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels,
+        const BlockCompressionSettings& settings, std::vector<uint8_t>& blocks)
+    {
+        if(!pixels || width == 0 || height == 0 || channels == 0 || channels > 4) return false;
+
+        const uint64_t key  = cacheKey(pixels, width, height, channels, settings);
+        const uint64_t size = compressedSize(settings.format, width, height);
+
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.bc", static_cast<unsigned long long>(key));
+        const std::filesystem::path path = std::filesystem::path(_directory) / name;
+
+        platform::MappedFile file;
+        if(file.open(path.string()) && file.size() == sizeof(CacheHeader) + size)
+        {
+            const CacheHeader* header = reinterpret_cast<const CacheHeader*>(file.data());
+            if(header->magic == kCacheMagic && header->encoder_version == kEncoderVersion
+                && header->key == key && header->size == size)
+            {
+                blocks.assign(file.data() + sizeof(CacheHeader), file.data() + sizeof(CacheHeader) + size);
+                _hits.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        file.close();
+
+        _misses.fetch_add(1, std::memory_order_relaxed);
+        if(!compressImage(pixels, width, height, channels, settings, blocks)) return false;
+
+        // unique temporary name per thread, readers never see a partially written entry
+        std::filesystem::path temporary = path;
+        temporary += "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+        bool written = false;
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            const CacheHeader header{kCacheMagic, kEncoderVersion, key, size};
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(blocks.data()), static_cast<std::streamsize>(size));
+            written = static_cast<bool>(out);
+        }
+        std::error_code error;
+        if(written) std::filesystem::rename(temporary, path, error);
+        if(!written || error) std::filesystem::remove(temporary, error);
+        // a failed cache write still leaves a valid result
+        return true;
+    }
+} // namespace lux::engine::resource
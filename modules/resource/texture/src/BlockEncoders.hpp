@@ -0,0 +1,16 @@
+#pragma once
+#include "lux-engine/resource/texture/BlockCompression.hpp"
+
+namespace lux::engine::resource
+{
+    // single block encoders, `rgba` is 16 texels in row order, 4 bytes each
+
+    // 8 bytes. with `punch_through` texels with alpha < 128 use bc1's transparent index
+    void encodeBc1Block(const uint8_t* rgba, CompressionQuality quality, bool punch_through, uint8_t* out);
+
+    // 8 bytes, `values` is 16 texels of one channel taken every `stride` bytes
+    void encodeBc4Block(const uint8_t* values, size_t stride, CompressionQuality quality, uint8_t* out);
+
+    // 16 bytes
+    void encodeBc7Block(const uint8_t* rgba, CompressionQuality quality, uint8_t* out);
+} // namespace lux::engine::resource
@@ -0,0 +1,524 @@
+#include "lux-engine/resource/texture/EnvironmentMap.hpp"
+#include <lux-engine/platform/cxx/Parallel.hpp>
+#include <lux-engine/platform/cxx/Simd.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace lux::engine::resource
+{
+    namespace
+    {
+        constexpr float kPi = 3.14159265358979f;
+
+        // texel center of face `face` at (s, t) in [-1, 1] -> unit direction, the GL cube map convention
+        inline void faceDirection(uint32_t face, float s, float t, float direction[3])
+        {
+            float x, y, z;
+            switch(face)
+            {
+                case 0:  x =  1.0f; y = -t;    z = -s;    break;
+                case 1:  x = -1.0f; y = -t;    z =  s;    break;
+                case 2:  x =  s;    y =  1.0f; z =  t;    break;
+                case 3:  x =  s;    y = -1.0f; z = -t;    break;
+                case 4:  x =  s;    y = -t;    z =  1.0f; break;
+                default: x = -s;    y = -t;    z = -1.0f; break;
+            }
+            const float inverse = 1.0f / std::sqrt(x * x + y * y + z * z);
+            direction[0] = x * inverse;
+            direction[1] = y * inverse;
+            direction[2] = z * inverse;
+        }
+
+        // direction -> face and coordinates in [0, 1], the inverse of faceDirection()
+        inline uint32_t directionToFace(float x, float y, float z, float& s, float& t)
+        {
+            const float ax = std::fabs(x), ay = std::fabs(y), az = std::fabs(z);
+            uint32_t face;
+            float ma, sc, tc;
+            if(ax >= ay && ax >= az)
+            {
+                face = x < 0.0f ? 1 : 0;
+                ma = ax; sc = x < 0.0f ? z : -z; tc = -y;
+            }
+            else if(ay >= az)
+            {
+                face = y < 0.0f ? 3 : 2;
+                ma = ay; sc = x; tc = y < 0.0f ? -z : z;
+            }
+            else
+            {
+                face = z < 0.0f ? 5 : 4;
+                ma = az; sc = z < 0.0f ? -x : x; tc = -y;
+            }
+            const float inverse = 0.5f / ma;
+            s = sc * inverse + 0.5f;
+            t = tc * inverse + 0.5f;
+            return face;
+        }
+
+        // bilinear within the face, edges clamp
+        inline void accumulateBilinear(const CubemapLevel& level, uint32_t face, float s, float t, float weight, float sum[3])
+        {
+            const int   last = static_cast<int>(level.size) - 1;
+            const float fx   = std::clamp(s * level.size - 0.5f, 0.0f, static_cast<float>(last));
+            const float fy   = std::clamp(t * level.size - 0.5f, 0.0f, static_cast<float>(last));
+            const int   x0   = static_cast<int>(fx), y0 = static_cast<int>(fy);
+            const int   x1   = std::min(x0 + 1, last), y1 = std::min(y0 + 1, last);
+            const float wx   = fx - x0, wy = fy - y0;
+
+            const float* texels = level.face(face);
+            const float* a = texels + (size_t(y0) * level.size + x0) * 3;
+            const float* b = texels + (size_t(y0) * level.size + x1) * 3;
+            const float* c = texels + (size_t(y1) * level.size + x0) * 3;
+            const float* d = texels + (size_t(y1) * level.size + x1) * 3;
+            const float wa = (1.0f - wx) * (1.0f - wy) * weight, wb = wx * (1.0f - wy) * weight;
+            const float wc = (1.0f - wx) * wy * weight,          wd = wx * wy * weight;
+            for(int i = 0; i < 3; i++) sum[i] += a[i] * wa + b[i] * wb + c[i] * wc + d[i] * wd;
+        }
+
+        inline float radicalInverse(uint32_t bits)
+        {
+            bits = (bits << 16) | (bits >> 16);
+            bits = ((bits & 0x55555555u) << 1) | ((bits & 0xAAAAAAAAu) >> 1);
+            bits = ((bits & 0x33333333u) << 2) | ((bits & 0xCCCCCCCCu) >> 2);
+            bits = ((bits & 0x0F0F0F0Fu) << 4) | ((bits & 0xF0F0F0F0u) >> 4);
+            bits = ((bits & 0x00FF00FFu) << 8) | ((bits & 0xFF00FF00u) >> 8);
+            return static_cast<float>(bits) * 2.3283064365386963e-10f;
+        }
+
+        // GGX distributed half vector around +z for the Hammersley point (i / count, radicalInverse(i))
+        inline void sampleGgx(uint32_t i, uint32_t count, float alpha, float half[3])
+        {
+            const float phi       = 2.0f * kPi * (static_cast<float>(i) + 0.5f) / static_cast<float>(count);
+            const float xi        = radicalInverse(i);
+            const float cos_theta = std::sqrt((1.0f - xi) / (1.0f + (alpha * alpha - 1.0f) * xi));
+            const float sin_theta = std::sqrt(std::max(0.0f, 1.0f - cos_theta * cos_theta));
+            half[0] = sin_theta * std::cos(phi);
+            half[1] = sin_theta * std::sin(phi);
+            half[2] = cos_theta;
+        }
+
+        // light direction in the tangent frame of n = v, its weight and the source level it reads
+        struct PrefilterSample
+        {
+            float       x, y, z;
+            float       weight;
+            uint32_t    level;
+        };
+
+        std::vector<PrefilterSample> prefilterSamples(float roughness, uint32_t sample_count, uint32_t source_size, uint32_t source_levels)
+        {
+            const float alpha = std::max(roughness * roughness, 1e-4f);
+            const float alpha2 = alpha * alpha;
+            // solid angle of a level 0 source texel, on average over the sphere
+            const float texel_solid_angle = 4.0f * kPi / (6.0f * source_size * source_size);
+
+            std::vector<PrefilterSample> samples;
+            samples.reserve(sample_count);
+            float total = 0.0f;
+            for(uint32_t i = 0; i < sample_count; i++)
+            {
+                float h[3];
+                sampleGgx(i, sample_count, alpha, h);
+                // reflect v = n = +z around h
+                const PrefilterSample sample{2.0f * h[2] * h[0], 2.0f * h[2] * h[1], 2.0f * h[2] * h[2] - 1.0f, 0.0f, 0};
+                if(sample.z <= 0.0f) continue;
+
+                // with n = v the pdf of l is D(h) (n.h) / (4 v.h) = D(h) / 4
+                const float d = h[2] * h[2] * (alpha2 - 1.0f) + 1.0f;
+                const float pdf = alpha2 / (kPi * d * d) * 0.25f;
+                const float sample_solid_angle = 1.0f / (static_cast<float>(sample_count) * pdf + 1e-6f);
+                // filtered importance sampling: read the level whose texels cover the sample's solid angle
+                const float lod = std::clamp(0.5f * std::log2(sample_solid_angle / texel_solid_angle) + 1.0f,
+                    0.0f, static_cast<float>(source_levels - 1));
+
+                PrefilterSample& added = samples.emplace_back(sample);
+                added.weight = sample.z;
+                added.level  = static_cast<uint32_t>(lod + 0.5f);
+                total += sample.z;
+            }
+            for(auto& sample : samples) sample.weight /= total;
+            return samples;
+        }
+
+        inline void tangentFrame(const float n[3], float tangent[3], float bitangent[3])
+        {
+            // up = z unless n is close to it
+            float up[3] = {0.0f, 0.0f, 1.0f};
+            if(std::fabs(n[2]) > 0.999f) { up[0] = 1.0f; up[2] = 0.0f; }
+            tangent[0] = up[1] * n[2] - up[2] * n[1];
+            tangent[1] = up[2] * n[0] - up[0] * n[2];
+            tangent[2] = up[0] * n[1] - up[1] * n[0];
+            const float inverse = 1.0f / std::sqrt(tangent[0] * tangent[0] + tangent[1] * tangent[1] + tangent[2] * tangent[2]);
+            for(int i = 0; i < 3; i++) tangent[i] *= inverse;
+            bitangent[0] = n[1] * tangent[2] - n[2] * tangent[1];
+            bitangent[1] = n[2] * tangent[0] - n[0] * tangent[2];
+            bitangent[2] = n[0] * tangent[1] - n[1] * tangent[0];
+        }
+
+#if defined(LUX_SIMD_SSE2)
+        inline __m128 select(__m128 mask, __m128 a, __m128 b)
+        {
+            return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+        }
+
+        // directionToFace() for four directions at once
+        inline void directionToFace4(__m128 x, __m128 y, __m128 z, uint32_t face[4], float s[4], float t[4])
+        {
+            const __m128 sign = _mm_set1_ps(-0.0f);
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 one  = _mm_set1_ps(1.0f);
+            const __m128 half = _mm_set1_ps(0.5f);
+            const __m128 ax = _mm_andnot_ps(sign, x), ay = _mm_andnot_ps(sign, y), az = _mm_andnot_ps(sign, z);
+            const __m128 x_major = _mm_and_ps(_mm_cmpge_ps(ax, ay), _mm_cmpge_ps(ax, az));
+            const __m128 y_major = _mm_andnot_ps(x_major, _mm_cmpge_ps(ay, az));
+            const __m128 negative_x = _mm_cmplt_ps(x, zero);
+            const __m128 negative_y = _mm_cmplt_ps(y, zero);
+            const __m128 negative_z = _mm_cmplt_ps(z, zero);
+
+            const __m128 ma = select(x_major, ax, select(y_major, ay, az));
+            const __m128 sc = select(x_major, select(negative_x, z, _mm_xor_ps(z, sign)),
+                select(y_major, x, select(negative_z, _mm_xor_ps(x, sign), x)));
+            const __m128 tc = select(y_major, select(negative_y, _mm_xor_ps(z, sign), z), _mm_xor_ps(y, sign));
+            // +x 0, +y 2, +z 4, one more for the negative side
+            const __m128 base = select(x_major, zero, select(y_major, _mm_set1_ps(2.0f), _mm_set1_ps(4.0f)));
+            const __m128 negative = select(x_major, negative_x, select(y_major, negative_y, negative_z));
+            const __m128 index = _mm_add_ps(base, _mm_and_ps(negative, one));
+
+            const __m128 inverse = _mm_div_ps(half, ma);
+            _mm_storeu_ps(s, _mm_add_ps(_mm_mul_ps(sc, inverse), half));
+            _mm_storeu_ps(t, _mm_add_ps(_mm_mul_ps(tc, inverse), half));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(face), _mm_cvttps_epi32(index));
+        }
+#endif
+
+        // one row of one prefiltered face
+        void prefilterRow(const Cubemap& source, const std::vector<PrefilterSample>& samples,
+            uint32_t face, uint32_t row, uint32_t size, float* out)
+        {
+            const float t = 2.0f * (static_cast<float>(row) + 0.5f) / static_cast<float>(size) - 1.0f;
+            uint32_t x = 0;
+#if defined(LUX_SIMD_SSE2)
+            // four texels of the row share every sample, the lookup math runs on all of them at once
+            for(; x + 4 <= size; x += 4)
+            {
+                alignas(16) float nx[4], ny[4], nz[4], tx[4], ty[4], tz[4], bx[4], by[4], bz[4];
+                for(uint32_t lane = 0; lane < 4; lane++)
+                {
+                    float n[3], tangent[3], bitangent[3];
+                    faceDirection(face, 2.0f * (static_cast<float>(x + lane) + 0.5f) / static_cast<float>(size) - 1.0f, t, n);
+                    tangentFrame(n, tangent, bitangent);
+                    nx[lane] = n[0];       ny[lane] = n[1];       nz[lane] = n[2];
+                    tx[lane] = tangent[0]; ty[lane] = tangent[1]; tz[lane] = tangent[2];
+                    bx[lane] = bitangent[0]; by[lane] = bitangent[1]; bz[lane] = bitangent[2];
+                }
+                const __m128 vnx = _mm_load_ps(nx), vny = _mm_load_ps(ny), vnz = _mm_load_ps(nz);
+                const __m128 vtx = _mm_load_ps(tx), vty = _mm_load_ps(ty), vtz = _mm_load_ps(tz);
+                const __m128 vbx = _mm_load_ps(bx), vby = _mm_load_ps(by), vbz = _mm_load_ps(bz);
+
+                float sums[4][3]{};
+                alignas(16) uint32_t faces[4];
+                alignas(16) float s[4], u[4];
+                for(const PrefilterSample& sample : samples)
+                {
+                    const __m128 lx = _mm_set1_ps(sample.x), ly = _mm_set1_ps(sample.y), lz = _mm_set1_ps(sample.z);
+                    const __m128 dx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vtx, lx), _mm_mul_ps(vbx, ly)), _mm_mul_ps(vnx, lz));
+                    const __m128 dy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vty, lx), _mm_mul_ps(vby, ly)), _mm_mul_ps(vny, lz));
+                    const __m128 dz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vtz, lx), _mm_mul_ps(vbz, ly)), _mm_mul_ps(vnz, lz));
+                    directionToFace4(dx, dy, dz, faces, s, u);
+                    const CubemapLevel& level = source.levels[sample.level];
+                    for(uint32_t lane = 0; lane < 4; lane++)
+                    {
+                        accumulateBilinear(level, faces[lane], s[lane], u[lane], sample.weight, sums[lane]);
+                    }
+                }
+                for(uint32_t lane = 0; lane < 4; lane++)
+                {
+                    float* texel = out + (x + lane) * 3;
+                    texel[0] = sums[lane][0]; texel[1] = sums[lane][1]; texel[2] = sums[lane][2];
+                }
+            }
+#endif
+            for(; x < size; x++)
+            {
+                float n[3], tangent[3], bitangent[3];
+                faceDirection(face, 2.0f * (static_cast<float>(x) + 0.5f) / static_cast<float>(size) - 1.0f, t, n);
+                tangentFrame(n, tangent, bitangent);
+                float sum[3]{};
+                for(const PrefilterSample& sample : samples)
+                {
+                    const float dx = tangent[0] * sample.x + bitangent[0] * sample.y + n[0] * sample.z;
+                    const float dy = tangent[1] * sample.x + bitangent[1] * sample.y + n[1] * sample.z;
+                    const float dz = tangent[2] * sample.x + bitangent[2] * sample.y + n[2] * sample.z;
+                    float s, u;
+                    const uint32_t sample_face = directionToFace(dx, dy, dz, s, u);
+                    accumulateBilinear(source.levels[sample.level], sample_face, s, u, sample.weight, sum);
+                }
+                float* texel = out + x * 3;
+                texel[0] = sum[0]; texel[1] = sum[1]; texel[2] = sum[2];
+            }
+        }
+
+        // Schlick-Smith visibility with k = a / 2, the IBL remapping of the split sum
+        inline float geometrySmith(float n_dot_v, float n_dot_l, float k)
+        {
+            return n_dot_v / (n_dot_v * (1.0f - k) + k) * (n_dot_l / (n_dot_l * (1.0f - k) + k));
+        }
+    }
+
+    Cubemap cubemapFromEquirect(platform::Image& image, uint32_t face_size)
+    {
+        Cubemap cubemap;
+        if(!image.isEnable() || face_size == 0 || image.channel() < 1) return cubemap;
+
+        const uint32_t width    = static_cast<uint32_t>(image.width());
+        const uint32_t height   = static_cast<uint32_t>(image.height());
+        const uint32_t channels = static_cast<uint32_t>(image.channel());
+        const platform::PixelFormat format = image.format();
+        const void* data = image.data();
+
+        float srgb[256];
+        for(int i = 0; i < 256; i++)
+        {
+            const float c = static_cast<float>(i) / 255.0f;
+            srgb[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+        // gray and gray + alpha are replicated, alpha is dropped
+        auto fetch = [&](uint32_t x, uint32_t y, float rgb[3])
+        {
+            const size_t texel = (size_t(y) * width + x) * channels;
+            for(uint32_t c = 0; c < 3; c++)
+            {
+                const size_t index = texel + (channels >= 3 ? c : 0);
+                switch(format)
+                {
+                    case platform::PixelFormat::UINT8:   rgb[c] = srgb[static_cast<const uint8_t*>(data)[index]]; break;
+                    case platform::PixelFormat::UINT16:  rgb[c] = static_cast<const uint16_t*>(data)[index] / 65535.0f; break;
+                    case platform::PixelFormat::FLOAT32: rgb[c] = static_cast<const float*>(data)[index]; break;
+                }
+            }
+        };
+
+        CubemapLevel& level = cubemap.levels.emplace_back();
+        level.size = face_size;
+        level.texels.resize(size_t(face_size) * face_size * 18);
+        platform::parallelFor(0, size_t(6) * face_size, 16,
+            [&](size_t begin, size_t end)
+            {
+                for(size_t row = begin; row < end; row++)
+                {
+                    const uint32_t face = static_cast<uint32_t>(row / face_size);
+                    const uint32_t y    = static_cast<uint32_t>(row % face_size);
+                    float* out = level.face(face) + size_t(y) * face_size * 3;
+                    for(uint32_t x = 0; x < face_size; x++)
+                    {
+                        float d[3];
+                        faceDirection(face,
+                            2.0f * (static_cast<float>(x) + 0.5f) / static_cast<float>(face_size) - 1.0f,
+                            2.0f * (static_cast<float>(y) + 0.5f) / static_cast<float>(face_size) - 1.0f, d);
+                        // longitude around +y starting at -z, latitude from +y down
+                        const float u = std::atan2(d[0], -d[2]) / (2.0f * kPi) + 0.5f;
+                        const float v = std::acos(std::clamp(d[1], -1.0f, 1.0f)) / kPi;
+
+                        // bilinear, wrapping around in longitude
+                        const float fx = u * width - 0.5f;
+                        const float fy = std::clamp(v * height - 0.5f, 0.0f, static_cast<float>(height - 1));
+                        const int   x0 = static_cast<int>(std::floor(fx));
+                        const uint32_t y0 = static_cast<uint32_t>(fy), y1 = std::min(y0 + 1, height - 1);
+                        const float wx = fx - static_cast<float>(x0), wy = fy - static_cast<float>(y0);
+                        const uint32_t xa = static_cast<uint32_t>((x0 % static_cast<int>(width) + width) % width);
+                        const uint32_t xb = (xa + 1) % width;
+                        float a[3], b[3], c[3], e[3];
+                        fetch(xa, y0, a); fetch(xb, y0, b); fetch(xa, y1, c); fetch(xb, y1, e);
+                        for(int i = 0; i < 3; i++)
+                        {
+                            out[x * 3 + i] = (a[i] * (1.0f - wx) + b[i] * wx) * (1.0f - wy) + (c[i] * (1.0f - wx) + e[i] * wx) * wy;
+                        }
+                    }
+                }
+            }
+        );
+        return cubemap;
+    }
+
+    void generateCubemapMips(Cubemap& cubemap)
+    {
+        if(cubemap.empty()) return;
+        cubemap.levels.resize(1);
+        while(cubemap.levels.back().size > 1)
+        {
+            const uint32_t size = cubemap.levels.back().size;
+            CubemapLevel next;
+            next.size = std::max<uint32_t>(size / 2, 1);
+            next.texels.resize(size_t(next.size) * next.size * 18);
+            const CubemapLevel& previous = cubemap.levels.back();
+            platform::parallelFor(0, size_t(6) * next.size, std::max<size_t>(1, 8192 / next.size),
+                [&](size_t begin, size_t end)
+                {
+                    for(size_t row = begin; row < end; row++)
+                    {
+                        const uint32_t face = static_cast<uint32_t>(row / next.size);
+                        const uint32_t y    = static_cast<uint32_t>(row % next.size);
+                        const float* top    = previous.face(face) + size_t(std::min(y * 2, size - 1)) * size * 3;
+                        const float* bottom = previous.face(face) + size_t(std::min(y * 2 + 1, size - 1)) * size * 3;
+                        float* out = next.face(face) + size_t(y) * next.size * 3;
+                        for(uint32_t x = 0; x < next.size; x++)
+                        {
+                            const uint32_t x0 = std::min(x * 2, size - 1) * 3, x1 = std::min(x * 2 + 1, size - 1) * 3;
+                            for(int i = 0; i < 3; i++)
+                            {
+                                out[x * 3 + i] = (top[x0 + i] + top[x1 + i] + bottom[x0 + i] + bottom[x1 + i]) * 0.25f;
+                            }
+                        }
+                    }
+                }
+            );
+            cubemap.levels.push_back(std::move(next));
+        }
+    }
+
+    Cubemap prefilterSpecular(const Cubemap& environment, const SpecularPrefilterSettings& settings)
+    {
+        Cubemap result;
+        if(environment.empty() || settings.face_size == 0) return result;
+
+        Cubemap chain;
+        const Cubemap* source = &environment;
+        if(environment.levels.size() == 1 && environment.size() > 1)
+        {
+            chain.levels.push_back(environment.levels[0]);
+            generateCubemapMips(chain);
+            source = &chain;
+        }
+        const uint32_t source_size   = source->size();
+        const uint32_t source_levels = static_cast<uint32_t>(source->levels.size());
+
+        uint32_t level_count = settings.level_count;
+        if(level_count == 0)
+        {
+            for(uint32_t size = settings.face_size; size >= 8; size /= 2) level_count++;
+        }
+        level_count = std::max<uint32_t>(level_count, 1);
+
+        for(uint32_t index = 0; index < level_count; index++)
+        {
+            CubemapLevel& level = result.levels.emplace_back();
+            level.size = std::max<uint32_t>(settings.face_size >> index, 1);
+            level.texels.resize(size_t(level.size) * level.size * 18);
+
+            std::vector<PrefilterSample> samples;
+            const float roughness = prefilterRoughness(index, level_count);
+            if(index == 0)
+            {
+                // mirror reflection, the environment itself at the matching resolution
+                float lod = std::log2(static_cast<float>(source_size) / static_cast<float>(level.size));
+                lod = std::clamp(lod, 0.0f, static_cast<float>(source_levels - 1));
+                samples.push_back(PrefilterSample{0.0f, 0.0f, 1.0f, 1.0f, static_cast<uint32_t>(lod + 0.5f)});
+            }
+            else
+            {
+                samples = prefilterSamples(roughness, std::max<uint32_t>(settings.sample_count, 1), source_size, source_levels);
+            }
+
+            // rows of all six faces in one pool, small levels still keep every thread busy
+            const uint32_t size = level.size;
+            const size_t grain = std::max<size_t>(1, 16384 / (size_t(size) * samples.size()));
+            platform::parallelFor(0, size_t(6) * size, grain,
+                [&](size_t begin, size_t end)
+                {
+                    for(size_t row = begin; row < end; row++)
+                    {
+                        const uint32_t face = static_cast<uint32_t>(row / size);
+                        const uint32_t y    = static_cast<uint32_t>(row % size);
+                        prefilterRow(*source, samples, face, y, size, level.face(face) + size_t(y) * size * 3);
+                    }
+                }
+            );
+        }
+        return result;
+    }
+
+    std::vector<float> computeBrdfLut(uint32_t size, uint32_t sample_count)
+    {
+        std::vector<float> lut(size_t(size) * size * 2);
+        sample_count = std::max<uint32_t>(sample_count, 1);
+        platform::parallelFor(0, size, 4,
+            [&](size_t begin, size_t end)
+            {
+                std::vector<float> halves(size_t(sample_count) * 3);
+                for(size_t row = begin; row < end; row++)
+                {
+                    const float roughness = (static_cast<float>(row) + 0.5f) / static_cast<float>(size);
+                    const float alpha     = roughness * roughness;
+                    const float k         = alpha * 0.5f;
+                    // the half vectors only depend on the roughness, shared by the whole row
+                    for(uint32_t i = 0; i < sample_count; i++) sampleGgx(i, sample_count, alpha, halves.data() + i * 3);
+                    const float inverse_count = 1.0f / static_cast<float>(sample_count);
+
+                    float* out = lut.data() + row * size * 2;
+                    uint32_t x = 0;
+#if defined(LUX_SIMD_SSE2)
+                    const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f), two = _mm_set1_ps(2.0f);
+                    const __m128 vk = _mm_set1_ps(k), one_minus_k = _mm_set1_ps(1.0f - k);
+                    for(; x + 4 <= size; x += 4)
+                    {
+                        // v = (sqrt(1 - n.v^2), 0, n.v) for four n.v at once
+                        const __m128 n_dot_v = _mm_div_ps(
+                            _mm_add_ps(_mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f), _mm_set1_ps(static_cast<float>(x) + 0.5f)),
+                            _mm_set1_ps(static_cast<float>(size)));
+                        const __m128 vx = _mm_sqrt_ps(_mm_max_ps(zero, _mm_sub_ps(one, _mm_mul_ps(n_dot_v, n_dot_v))));
+                        const __m128 g_v = _mm_div_ps(n_dot_v, _mm_add_ps(_mm_mul_ps(n_dot_v, one_minus_k), vk));
+                        __m128 scale = zero, bias = zero;
+                        for(uint32_t i = 0; i < sample_count; i++)
+                        {
+                            const float* h = halves.data() + i * 3;
+                            const __m128 hx = _mm_set1_ps(h[0]), hz = _mm_set1_ps(h[2]);
+                            const __m128 v_dot_h = _mm_max_ps(zero, _mm_add_ps(_mm_mul_ps(vx, hx), _mm_mul_ps(n_dot_v, hz)));
+                            // l = 2 (v.h) h - v, only its z is needed
+                            const __m128 n_dot_l = _mm_sub_ps(_mm_mul_ps(_mm_mul_ps(two, v_dot_h), hz), n_dot_v);
+                            const __m128 valid = _mm_cmpgt_ps(n_dot_l, zero);
+                            const __m128 g_l = _mm_div_ps(n_dot_l, _mm_add_ps(_mm_mul_ps(n_dot_l, one_minus_k), vk));
+                            // G * v.h / (n.h * n.v), with the n.v of G_v cancelled
+                            const __m128 visibility = _mm_and_ps(valid,
+                                _mm_div_ps(_mm_mul_ps(_mm_div_ps(g_v, n_dot_v), _mm_mul_ps(g_l, v_dot_h)), hz));
+                            const __m128 c  = _mm_sub_ps(one, v_dot_h);
+                            const __m128 c2 = _mm_mul_ps(c, c);
+                            const __m128 fresnel = _mm_mul_ps(_mm_mul_ps(c2, c2), c);
+                            scale = _mm_add_ps(scale, _mm_mul_ps(_mm_sub_ps(one, fresnel), visibility));
+                            bias  = _mm_add_ps(bias, _mm_mul_ps(fresnel, visibility));
+                        }
+                        alignas(16) float scales[4], biases[4];
+                        _mm_store_ps(scales, _mm_mul_ps(scale, _mm_set1_ps(inverse_count)));
+                        _mm_store_ps(biases, _mm_mul_ps(bias, _mm_set1_ps(inverse_count)));
+                        for(uint32_t lane = 0; lane < 4; lane++)
+                        {
+                            out[(x + lane) * 2 + 0] = scales[lane];
+                            out[(x + lane) * 2 + 1] = biases[lane];
+                        }
+                    }
+#endif
+                    for(; x < size; x++)
+                    {
+                        const float n_dot_v = (static_cast<float>(x) + 0.5f) / static_cast<float>(size);
+                        const float vx = std::sqrt(std::max(0.0f, 1.0f - n_dot_v * n_dot_v));
+                        float scale = 0.0f, bias = 0.0f;
+                        for(uint32_t i = 0; i < sample_count; i++)
+                        {
+                            const float* h = halves.data() + i * 3;
+                            const float v_dot_h = std::max(0.0f, vx * h[0] + n_dot_v * h[2]);
+                            const float n_dot_l = 2.0f * v_dot_h * h[2] - n_dot_v;
+                            if(n_dot_l <= 0.0f) continue;
+                            const float visibility = geometrySmith(n_dot_v, n_dot_l, k) * v_dot_h / (h[2] * n_dot_v);
+                            const float fresnel = std::pow(1.0f - v_dot_h, 5.0f);
+                            scale += (1.0f - fresnel) * visibility;
+                            bias  += fresnel * visibility;
+                        }
+                        out[x * 2 + 0] = scale * inverse_count;
+                        out[x * 2 + 1] = bias * inverse_count;
+                    }
+                }
+            }
+        );
+        return lut;
+    }
+} // namespace lux::engine::resource
@@ -0,0 +1,167 @@
+#include "lux-engine/resource/texture/RectPacker.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace lux::engine::resource
+{
+    namespace
+    {
+        inline bool contains(const PackedRect& outer, const PackedRect& inner)
+        {
+            return inner.x >= outer.x && inner.y >= outer.y
+                && inner.x + inner.width <= outer.x + outer.width && inner.y + inner.height <= outer.y + outer.height;
+        }
+
+        inline bool overlaps(const PackedRect& a, const PackedRect& b)
+        {
+            return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+        }
+    }
+
+    RectPacker::RectPacker(uint32_t width, uint32_t height, RectPackHeuristic heuristic)
+        : _width(width), _height(height), _heuristic(heuristic)
+    {
+        reset();
+    }
+
+    void RectPacker::reset()
+    {
+        _used_area = 0;
+        _free.assign(1, PackedRect{0, 0, _width, _height});
+        _skyline.assign(1, SkylineNode{0, 0, _width});
+    }
+
+    bool RectPacker::insert(uint32_t width, uint32_t height, PackedRect& rect)
+    {
+        if(width == 0 || height == 0 || width > _width || height > _height) return false;
+        const bool placed = _heuristic == RectPackHeuristic::MAX_RECTS
+            ? insertMaxRects(width, height, rect)
+            : insertSkyline(width, height, rect);
+        if(placed) _used_area += uint64_t(width) * height;
+        return placed;
+    }
+
+    bool RectPacker::insertMaxRects(uint32_t width, uint32_t height, PackedRect& rect)
+    {
+        // best short side fit, ties broken by the long side
+        uint32_t best_short = std::numeric_limits<uint32_t>::max();
+        uint32_t best_long  = std::numeric_limits<uint32_t>::max();
+        size_t   best       = _free.size();
+        for(size_t i = 0; i < _free.size(); i++)
+        {
+            const PackedRect& free = _free[i];
+            if(free.width < width || free.height < height) continue;
+            const uint32_t leftover_x = free.width - width;
+            const uint32_t leftover_y = free.height - height;
+            const uint32_t short_side = std::min(leftover_x, leftover_y);
+            const uint32_t long_side  = std::max(leftover_x, leftover_y);
+            if(short_side < best_short || (short_side == best_short && long_side < best_long))
+            {
+                best_short = short_side;
+                best_long  = long_side;
+                best       = i;
+            }
+        }
+        if(best == _free.size()) return false;
+        rect = PackedRect{_free[best].x, _free[best].y, width, height};
+
+        // split every free rectangle the new one overlaps into the (up to 4) maximal pieces around it
+        std::vector<PackedRect> pieces;
+        for(size_t i = 0; i < _free.size();)
+        {
+            const PackedRect free = _free[i];
+            if(!overlaps(free, rect))
+            {
+                i++;
+                continue;
+            }
+            if(rect.x > free.x)                                 pieces.push_back({free.x, free.y, rect.x - free.x, free.height});
+            if(rect.x + rect.width < free.x + free.width)       pieces.push_back({rect.x + rect.width, free.y, free.x + free.width - rect.x - rect.width, free.height});
+            if(rect.y > free.y)                                 pieces.push_back({free.x, free.y, free.width, rect.y - free.y});
+            if(rect.y + rect.height < free.y + free.height)     pieces.push_back({free.x, rect.y + rect.height, free.width, free.y + free.height - rect.y - rect.height});
+            _free[i] = _free.back();
+            _free.pop_back();
+        }
+
+        // only the new pieces can be redundant: drop those inside another free rectangle, and older
+        // rectangles inside a new piece
+        for(size_t i = 0; i < pieces.size(); i++)
+        {
+            bool redundant = false;
+            for(size_t j = 0; j < pieces.size() && !redundant; j++)
+            {
+                if(i == j) continue;
+                // of two identical pieces keep the first
+                redundant = contains(pieces[j], pieces[i])
+                    && (!contains(pieces[i], pieces[j]) || j < i);
+            }
+            for(size_t j = 0; j < _free.size() && !redundant; j++) redundant = contains(_free[j], pieces[i]);
+            if(redundant) continue;
+            _free.erase(std::remove_if(_free.begin(), _free.end(),
+                [&](const PackedRect& free) { return contains(pieces[i], free); }), _free.end());
+            _free.push_back(pieces[i]);
+        }
+        return true;
+    }
+
+    bool RectPacker::insertSkyline(uint32_t width, uint32_t height, PackedRect& rect)
+    {
+        // bottom left: lowest top edge after placement, ties go to the narrower starting segment
+        uint32_t best_top   = std::numeric_limits<uint32_t>::max();
+        uint32_t best_width = std::numeric_limits<uint32_t>::max();
+        size_t   best       = _skyline.size();
+        uint32_t best_y     = 0;
+        for(size_t i = 0; i < _skyline.size(); i++)
+        {
+            const uint32_t x = _skyline[i].x;
+            if(x + width > _width) break;
+            uint32_t y = 0;
+            uint32_t covered = 0;
+            for(size_t j = i; covered < width; j++)
+            {
+                y        = std::max(y, _skyline[j].y);
+                covered += _skyline[j].width;
+            }
+            if(y + height > _height) continue;
+            if(y + height < best_top || (y + height == best_top && _skyline[i].width < best_width))
+            {
+                best_top   = y + height;
+                best_width = _skyline[i].width;
+                best       = i;
+                best_y     = y;
+            }
+        }
+        if(best == _skyline.size()) return false;
+        rect = PackedRect{_skyline[best].x, best_y, width, height};
+
+        // the new segment replaces everything it shadows, a partly covered segment is shortened
+        const SkylineNode node{rect.x, rect.y + height, width};
+        _skyline.insert(_skyline.begin() + best, node);
+        const uint32_t right = node.x + node.width;
+        for(size_t i = best + 1; i < _skyline.size();)
+        {
+            SkylineNode& next = _skyline[i];
+            if(next.x >= right) break;
+            const uint32_t next_right = next.x + next.width;
+            if(next_right <= right)
+            {
+                _skyline.erase(_skyline.begin() + i);
+                continue;
+            }
+            next.width = next_right - right;
+            next.x     = right;
+            break;
+        }
+        for(size_t i = 0; i + 1 < _skyline.size();)
+        {
+            if(_skyline[i].y == _skyline[i + 1].y)
+            {
+                _skyline[i].width += _skyline[i + 1].width;
+                _skyline.erase(_skyline.begin() + i + 1);
+                continue;
+            }
+            i++;
+        }
+        return true;
+    }
+} // namespace lux::engine::resource
@@ -0,0 +1,160 @@
+#include "lux-engine/resource/texture/TextureAtlas.hpp"
+#include <lux-engine/platform/media_loaders/ImageOps.hpp>
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace lux::engine::resource
+{
+    namespace
+    {
+        inline uint32_t alignUp(uint32_t value, uint32_t alignment)
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+    }
+
+    TextureAtlas::TextureAtlas(const TextureAtlasSettings& settings)
+        : _settings(settings)
+    {
+        _mip_levels = std::clamp<uint32_t>(_settings.mip_levels, 1, 16);
+        _gutter     = 1u << (_mip_levels - 1);
+        // a page must hold whole aligned cells, otherwise the last row/column would break the alignment
+        _settings.page_size = std::max(alignUp(_settings.page_size, _gutter), _gutter * 4);
+    }
+
+    uint32_t TextureAtlas::add(const AtlasImage& image)
+    {
+        if(!image.pixels || image.width == 0 || image.height == 0 || image.channels == 0 || image.channels > 4)
+        {
+            return kInvalidRegion;
+        }
+
+        // a gutter on both sides, rounded to the alignment so every placement stays aligned
+        const uint32_t cell_width  = alignUp(image.width + 2 * _gutter, _gutter);
+        const uint32_t cell_height = alignUp(image.height + 2 * _gutter, _gutter);
+        PackedRect cell;
+        size_t page = 0;
+        for(; page < _packers.size(); page++)
+        {
+            if(_packers[page].insert(cell_width, cell_height, cell)) break;
+        }
+        if(page == _packers.size())
+        {
+            if(_pages.size() >= _settings.max_pages) return kInvalidRegion;
+            RectPacker packer(_settings.page_size, _settings.page_size, _settings.heuristic);
+            if(!packer.insert(cell_width, cell_height, cell)) return kInvalidRegion;
+            AtlasPage new_page;
+            new_page.size = _settings.page_size;
+            new_page.pixels.assign(size_t(new_page.size) * new_page.size * 4, 0);
+            _pages.push_back(std::move(new_page));
+            _packers.push_back(std::move(packer));
+        }
+
+        AtlasPage& target = _pages[page];
+        blit(target, image, cell.x, cell.y);
+
+        AtlasRegion region;
+        region.page         = static_cast<uint32_t>(page);
+        region.x            = cell.x + _gutter;
+        region.y            = cell.y + _gutter;
+        region.width        = image.width;
+        region.height       = image.height;
+        region.uv_offset[0] = float(region.x) / float(target.size);
+        region.uv_offset[1] = float(region.y) / float(target.size);
+        region.uv_scale[0]  = float(region.width) / float(target.size);
+        region.uv_scale[1]  = float(region.height) / float(target.size);
+        _regions.push_back(region);
+        return static_cast<uint32_t>(_regions.size() - 1);
+    }
+
+    uint32_t TextureAtlas::add(platform::Image& image)
+    {
+        if(!image.isEnable() || image.format() != platform::PixelFormat::UINT8) return kInvalidRegion;
+        AtlasImage atlas_image;
+        atlas_image.pixels      = static_cast<const uint8_t*>(image.data());
+        atlas_image.width       = static_cast<uint32_t>(image.width());
+        atlas_image.height      = static_cast<uint32_t>(image.height());
+        atlas_image.channels    = static_cast<uint32_t>(image.channel());
+        return add(atlas_image);
+    }
+
+    bool TextureAtlas::addBatch(const std::vector<AtlasImage>& images, std::vector<uint32_t>& regions)
+    {
+        std::vector<size_t> order(images.size());
+        std::iota(order.begin(), order.end(), size_t(0));
+        std::stable_sort(order.begin(), order.end(),
+            [&](size_t a, size_t b)
+            {
+                const uint32_t side_a = std::max(images[a].width, images[a].height);
+                const uint32_t side_b = std::max(images[b].width, images[b].height);
+                if(side_a != side_b) return side_a > side_b;
+                return uint64_t(images[a].width) * images[a].height > uint64_t(images[b].width) * images[b].height;
+            }
+        );
+
+        bool all = true;
+        regions.assign(images.size(), kInvalidRegion);
+        for(size_t index : order)
+        {
+            regions[index] = add(images[index]);
+            all = all && regions[index] != kInvalidRegion;
+        }
+        return all;
+    }
+
+    void TextureAtlas::clearDirty(size_t page)
+    {
+        AtlasPage& target = _pages[page];
+        target.dirty_x0 = target.dirty_y0 = target.dirty_x1 = target.dirty_y1 = 0;
+    }
+
+    void TextureAtlas::blit(AtlasPage& page, const AtlasImage& image, uint32_t x, uint32_t y)
+    {
+        const size_t   page_row = size_t(page.size) * 4;
+        const uint32_t left     = x + _gutter;
+        const uint32_t bottom   = y + _gutter;
+
+        // the image itself, converted to rgba row by row
+        for(uint32_t row = 0; row < image.height; row++)
+        {
+            platform::convertChannels(image.pixels + size_t(row) * image.width * image.channels, image.channels,
+                &page.pixels[(bottom + row) * page_row + size_t(left) * 4], 4, image.width, true);
+        }
+
+        // gutters repeat the edge texels, the same as clamp to edge sampling would see
+        for(uint32_t row = 0; row < image.height; row++)
+        {
+            uint8_t* line = &page.pixels[(bottom + row) * page_row];
+            for(uint32_t i = 1; i <= _gutter; i++)
+            {
+                std::memcpy(line + size_t(left - i) * 4, line + size_t(left) * 4, 4);
+                std::memcpy(line + size_t(left + image.width - 1 + i) * 4, line + size_t(left + image.width - 1) * 4, 4);
+            }
+        }
+        const size_t span = size_t(image.width + 2 * _gutter) * 4;
+        for(uint32_t i = 1; i <= _gutter; i++)
+        {
+            std::memcpy(&page.pixels[(bottom - i) * page_row + size_t(x) * 4], &page.pixels[bottom * page_row + size_t(x) * 4], span);
+            const uint32_t top = bottom + image.height - 1;
+            std::memcpy(&page.pixels[(top + i) * page_row + size_t(x) * 4], &page.pixels[top * page_row + size_t(x) * 4], span);
+        }
+
+        const uint32_t x1 = x + image.width + 2 * _gutter;
+        const uint32_t y1 = y + image.height + 2 * _gutter;
+        if(page.isDirty())
+        {
+            page.dirty_x0 = std::min(page.dirty_x0, x);
+            page.dirty_y0 = std::min(page.dirty_y0, y);
+            page.dirty_x1 = std::max(page.dirty_x1, x1);
+            page.dirty_y1 = std::max(page.dirty_y1, y1);
+        }
+        else
+        {
+            page.dirty_x0 = x;
+            page.dirty_y0 = y;
+            page.dirty_x1 = x1;
+            page.dirty_y1 = y1;
+        }
+    }
+} // namespace lux::engine::resource
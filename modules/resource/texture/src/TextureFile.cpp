@@ -0,0 +1,247 @@
+#include "lux-engine/resource/texture/TextureFile.hpp"
+#include <lux-engine/platform/media_loaders/ImageOps.hpp>
+#include <lux-engine/platform/media_loaders/MipGenerator.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+namespace lux::engine::resource
+{
+    namespace
+    {
+        inline uint64_t alignUp(uint64_t value)
+        {
+            return (value + kTextureFileAlignment - 1) & ~(kTextureFileAlignment - 1);
+        }
+
+        inline uint32_t levelExtent(uint32_t extent, size_t level)
+        {
+            return std::max<uint32_t>(extent >> level, 1);
+        }
+
+        inline uint32_t fullLevelCount(uint32_t width, uint32_t height)
+        {
+            // extents come from untrusted headers, never shift by the full width of the type
+            uint32_t count = 1;
+            while(count < 32 && ((width >> count) > 0 || (height >> count) > 0)) count++;
+            return count;
+        }
+    }
+
+    TextureFile::TextureFile(const std::string& path)
+    {
+        load(path);
+    }
+
+    bool TextureFile::load(const std::string& path)
+    {
+        _header = nullptr;
+        _levels = nullptr;
+        _metadata.clear();
+        if(!_file.open(path)) return false;
+
+        const uint8_t* base = _file.data();
+        const uint64_t size = _file.size();
+        if(size < sizeof(TextureFileHeader)) return false;
+
+        const TextureFileHeader* header = reinterpret_cast<const TextureFileHeader*>(base);
+        if(header->magic != kTextureFileMagic || header->version != kTextureFileVersion
+            || header->file_size != size
+            || header->format > static_cast<uint32_t>(TextureFormat::BC7)
+            || header->width == 0 || header->height == 0
+            || header->level_count == 0 || header->level_count > fullLevelCount(header->width, header->height))
+        {
+            return false;
+        }
+        if(header->level_count > (size - sizeof(TextureFileHeader)) / sizeof(TextureLevelEntry)) return false;
+
+        const TextureFormat      format = static_cast<TextureFormat>(header->format);
+        const TextureLevelEntry* levels = reinterpret_cast<const TextureLevelEntry*>(base + sizeof(TextureFileHeader));
+        for(uint32_t i = 0; i < header->level_count; i++)
+        {
+            const TextureLevelEntry& level = levels[i];
+            const bool valid =
+                level.width == levelExtent(header->width, i) && level.height == levelExtent(header->height, i)
+                && level.size == textureLevelSize(format, level.width, level.height)
+                && level.offset % kTextureFileAlignment == 0
+                && level.offset <= size && level.size <= size - level.offset;
+            if(!valid) return false;
+        }
+
+        if(header->metadata_offset > size || header->metadata_size > size - header->metadata_offset) return false;
+        const uint8_t* cursor = base + header->metadata_offset;
+        const uint8_t* end    = cursor + header->metadata_size;
+        // every pair starts with two 32 bit lengths, more pairs than that can't fit and the reserve must not trust it
+        if(header->metadata_count > header->metadata_size / (2 * sizeof(uint32_t))) return false;
+        std::vector<std::pair<std::string_view, std::string_view>> metadata;
+        metadata.reserve(header->metadata_count);
+        for(uint32_t i = 0; i < header->metadata_count; i++)
+        {
+            uint32_t lengths[2];
+            if(static_cast<size_t>(end - cursor) < sizeof(lengths)) return false;
+            std::memcpy(lengths, cursor, sizeof(lengths));
+            cursor += sizeof(lengths);
+            if(static_cast<uint64_t>(lengths[0]) + lengths[1] > static_cast<size_t>(end - cursor)) return false;
+            const char* text = reinterpret_cast<const char*>(cursor);
+            metadata.emplace_back(std::string_view(text, lengths[0]), std::string_view(text + lengths[0], lengths[1]));
+            cursor += lengths[0] + lengths[1];
+        }
+
+        _header   = header;
+        _levels   = levels;
+        _metadata = std::move(metadata);
+        return true;
+    }
+
+    TextureLevelView TextureFile::level(size_t index) const
+    {
+        TextureLevelView view;
+        if(!_header || index >= _header->level_count) return view;
+        const TextureLevelEntry& level = _levels[index];
+        view.data   = _file.data() + level.offset;
+        view.size   = level.size;
+        view.width  = level.width;
+        view.height = level.height;
+        return view;
+    }
+
+    std::string_view TextureFile::metadata(std::string_view key) const
+    {
+        for(auto& [entry_key, value] : _metadata)
+        {
+            if(entry_key == key) return value;
+        }
+        return {};
+    }
+
+    size_t TextureFile::payloadSize() const
+    {
+        size_t total = 0;
+        for(size_t i = 0; i < levelCount(); i++) total += _levels[i].size;
+        return total;
+    }
+
+    bool writeTextureFile(const std::string& path, const TextureData& texture)
+    {
+        if(texture.width == 0 || texture.height == 0 || texture.levels.empty()
+            || texture.levels.size() > fullLevelCount(texture.width, texture.height)
+            || texture.metadata.size() > std::numeric_limits<uint32_t>::max())
+        {
+            return false;
+        }
+
+        TextureFileHeader header{};
+        header.magic            = kTextureFileMagic;
+        header.version          = kTextureFileVersion;
+        header.format           = static_cast<uint32_t>(texture.format);
+        header.flags            = texture.flags;
+        header.width            = texture.width;
+        header.height           = texture.height;
+        header.level_count      = static_cast<uint32_t>(texture.levels.size());
+        header.metadata_count   = static_cast<uint32_t>(texture.metadata.size());
+
+        std::vector<uint8_t> metadata;
+        for(auto& [key, value] : texture.metadata)
+        {
+            const uint32_t lengths[2] = {static_cast<uint32_t>(key.size()), static_cast<uint32_t>(value.size())};
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(lengths);
+            metadata.insert(metadata.end(), bytes, bytes + sizeof(lengths));
+            metadata.insert(metadata.end(), key.begin(), key.end());
+            metadata.insert(metadata.end(), value.begin(), value.end());
+        }
+        header.metadata_offset  = sizeof(TextureFileHeader) + sizeof(TextureLevelEntry) * texture.levels.size();
+        header.metadata_size    = metadata.size();
+
+        // smallest level first, a reader streaming the file front to back gets a usable texture early
+        std::vector<TextureLevelEntry> levels(texture.levels.size());
+        uint64_t cursor = header.metadata_offset + header.metadata_size;
+        for(size_t i = levels.size(); i-- > 0;)
+        {
+            TextureLevelEntry& level = levels[i];
+            level.width  = levelExtent(texture.width, i);
+            level.height = levelExtent(texture.height, i);
+            level.size   = textureLevelSize(texture.format, level.width, level.height);
+            if(texture.levels[i].size() != level.size) return false;
+            cursor       = alignUp(cursor);
+            level.offset = cursor;
+            cursor      += level.size;
+        }
+        header.file_size = cursor;
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if(!out) return false;
+
+        uint64_t written = 0;
+        auto write = [&](const void* data, uint64_t bytes)
+        {
+            out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+            written += bytes;
+        };
+        auto seek = [&](uint64_t offset)
+        {
+            static const char zeros[kTextureFileAlignment]{};
+            write(zeros, offset - written);
+        };
+
+        write(&header, sizeof(header));
+        write(levels.data(), levels.size() * sizeof(TextureLevelEntry));
+        write(metadata.data(), metadata.size());
+        for(size_t i = levels.size(); i-- > 0;)
+        {
+            seek(levels[i].offset);
+            write(texture.levels[i].data(), levels[i].size);
+        }
+        return static_cast<bool>(out);
+    }
+
+    bool buildTexture(
+        const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels,
+        const TextureBuildSettings& settings, TextureData& texture)
+    {
+        if(!pixels || width == 0 || height == 0 || channels == 0 || channels > 4) return false;
+
+        // averaging masks or normals as sRGB would skew them, and the GPU samples these formats as linear anyway
+        const bool srgb = settings.srgb && hasSrgbVariant(settings.format);
+
+        platform::MipSettings mip_settings;
+        mip_settings.srgb         = srgb;
+        mip_settings.wrap         = settings.wrap;
+        mip_settings.alpha_cutoff = settings.alpha_cutoff;
+        mip_settings.max_levels   = settings.mips ? 0 : 1;
+
+        platform::MipChain chain;
+        platform::generateMips(pixels, static_cast<int>(width), static_cast<int>(height), static_cast<int>(channels),
+            mip_settings, chain);
+        if(chain.levels.empty()) return false;
+
+        texture.format  = settings.format;
+        texture.flags   = settings.flags | (srgb ? static_cast<uint32_t>(TEXTURE_FILE_SRGB) : 0u);
+        texture.width   = width;
+        texture.height  = height;
+        texture.levels.assign(chain.levels.size(), {});
+
+        for(size_t i = 0; i < chain.levels.size(); i++)
+        {
+            const platform::MipLevel& level = chain.levels[i];
+            const uint32_t level_width  = static_cast<uint32_t>(level.width);
+            const uint32_t level_height = static_cast<uint32_t>(level.height);
+            if(isBlockCompressed(settings.format))
+            {
+                const BlockCompressionSettings block_settings{toBlockFormat(settings.format), settings.quality};
+                const bool encoded = settings.cache
+                    ? settings.cache->compress(level.pixels.data(), level_width, level_height, channels, block_settings, texture.levels[i])
+                    : compressImage(level.pixels.data(), level_width, level_height, channels, block_settings, texture.levels[i]);
+                if(!encoded) return false;
+            }
+            else
+            {
+                const size_t   texel_count = static_cast<size_t>(level_width) * level_height;
+                const uint32_t target      = textureFormatChannels(settings.format);
+                texture.levels[i].resize(texel_count * target);
+                platform::convertChannels(level.pixels.data(), channels, texture.levels[i].data(), target, texel_count);
+            }
+        }
+        return true;
+    }
+} // namespace lux::engine::resource
@@ -0,0 +1,316 @@
+#include "lux-engine/resource/texture/VirtualTexture.hpp"
+#include <algorithm>
+
+namespace lux::engine::resource
+{
+    namespace
+    {
+        inline uint32_t encodeEntry(uint32_t slot_x, uint32_t slot_y, uint32_t level)
+        {
+            return slot_x | (slot_y << 8) | (level << 16) | 0xFF000000u;
+        }
+    }
+
+    VirtualPageTable::VirtualPageTable(uint32_t width, uint32_t height, uint32_t tile_size, uint32_t level_count)
+    {
+        _sizes.resize(level_count);
+        _own.resize(level_count);
+        _entries.resize(level_count);
+        _dirty.resize(level_count);
+        for(uint32_t level = 0; level < level_count; level++)
+        {
+            _sizes[level] = {virtualTileCount(width, level, tile_size), virtualTileCount(height, level, tile_size)};
+            const size_t count = size_t(_sizes[level].first) * _sizes[level].second;
+            _own[level].assign(count, 0);
+            _entries[level].assign(count, 0);
+            // the first upload has to cover everything
+            _dirty[level] = DirtyRect{0, 0, _sizes[level].first, _sizes[level].second};
+        }
+    }
+
+    void VirtualPageTable::map(uint32_t level, uint32_t x, uint32_t y, uint32_t slot_x, uint32_t slot_y)
+    {
+        _own[level][size_t(y) * width(level) + x] = encodeEntry(slot_x, slot_y, level);
+        refresh(level, x, y);
+    }
+
+    void VirtualPageTable::unmap(uint32_t level, uint32_t x, uint32_t y)
+    {
+        _own[level][size_t(y) * width(level) + x] = 0;
+        refresh(level, x, y);
+    }
+
+    void VirtualPageTable::clearDirty()
+    {
+        for(auto& rect : _dirty) rect = DirtyRect{};
+    }
+
+    void VirtualPageTable::refresh(uint32_t level, uint32_t x, uint32_t y)
+    {
+        // walk the subtree below the changed tile, every entry takes its own mapping or its parent's
+        uint32_t x0 = x, y0 = y, x1 = x + 1, y1 = y + 1;
+        for(uint32_t l = level + 1; l-- > 0;)
+        {
+            const uint32_t w = width(l);
+            const uint32_t h = height(l);
+            if(l != level)
+            {
+                // the last child column/row of an odd sized level hangs off the last parent, see the clamp below
+                x1 = x1 == width(l + 1) ? w : std::min(x1 * 2, w);
+                y1 = y1 == height(l + 1) ? h : std::min(y1 * 2, h);
+                x0 = std::min(x0 * 2, w);
+                y0 = std::min(y0 * 2, h);
+            }
+            for(uint32_t cy = y0; cy < y1; cy++)
+            {
+                for(uint32_t cx = x0; cx < x1; cx++)
+                {
+                    const size_t index = size_t(cy) * w + cx;
+                    uint32_t entry = _own[l][index];
+                    if(entry == 0 && l + 1 < levelCount())
+                    {
+                        const uint32_t px = std::min(cx / 2, width(l + 1) - 1);
+                        const uint32_t py = std::min(cy / 2, height(l + 1) - 1);
+                        entry = _entries[l + 1][size_t(py) * width(l + 1) + px];
+                    }
+                    _entries[l][index] = entry;
+                }
+            }
+
+            DirtyRect& dirty = _dirty[l];
+            if(x0 >= x1 || y0 >= y1) continue;
+            if(dirty.x0 < dirty.x1 && dirty.y0 < dirty.y1)
+            {
+                dirty.x0 = std::min(dirty.x0, x0);
+                dirty.y0 = std::min(dirty.y0, y0);
+                dirty.x1 = std::max(dirty.x1, x1);
+                dirty.y1 = std::max(dirty.y1, y1);
+            }
+            else
+            {
+                dirty = DirtyRect{x0, y0, x1, y1};
+            }
+        }
+    }
+
+    VirtualTileCache::VirtualTileCache(uint32_t slots_x, uint32_t slots_y)
+        : _slots_x(slots_x), _slots_y(slots_y), _slots(size_t(slots_x) * slots_y)
+    {
+        for(uint32_t slot = 0; slot < _slots.size(); slot++) pushBack(slot);
+    }
+
+    uint32_t VirtualTileCache::find(uint32_t tile) const
+    {
+        const auto found = _lookup.find(tile);
+        return found == _lookup.end() ? kNoSlot : found->second;
+    }
+
+    bool VirtualTileCache::touch(uint32_t tile)
+    {
+        const uint32_t slot = find(tile);
+        if(slot == kNoSlot) return false;
+        _slots[slot].last_used = _frame;
+        if(!_slots[slot].pinned)
+        {
+            unlink(slot);
+            pushBack(slot);
+        }
+        return true;
+    }
+
+    uint32_t VirtualTileCache::allocate(uint32_t tile, uint32_t& evicted)
+    {
+        evicted = kNoVirtualTile;
+        // pinned slots are not in the list, the rest is ordered by last use so the head is the only candidate
+        const uint32_t slot = _head;
+        if(slot == kNoSlot || (_slots[slot].tile != kNoVirtualTile && _slots[slot].last_used == _frame)) return kNoSlot;
+
+        Slot& target = _slots[slot];
+        if(target.tile != kNoVirtualTile)
+        {
+            evicted = target.tile;
+            _lookup.erase(target.tile);
+        }
+        target.tile      = tile;
+        target.last_used = _frame;
+        _lookup[tile]    = slot;
+        unlink(slot);
+        pushBack(slot);
+        return slot;
+    }
+
+    void VirtualTileCache::pin(uint32_t slot)
+    {
+        if(_slots[slot].pinned) return;
+        _slots[slot].pinned = true;
+        unlink(slot);
+    }
+
+    void VirtualTileCache::unlink(uint32_t slot)
+    {
+        Slot& target = _slots[slot];
+        if(target.previous != kNoSlot) _slots[target.previous].next = target.next;
+        else                           _head = target.next;
+        if(target.next != kNoSlot)     _slots[target.next].previous = target.previous;
+        else                           _tail = target.previous;
+        target.previous = target.next = kNoSlot;
+    }
+
+    void VirtualTileCache::pushBack(uint32_t slot)
+    {
+        Slot& target = _slots[slot];
+        target.previous = _tail;
+        target.next     = kNoSlot;
+        if(_tail != kNoSlot) _slots[_tail].next = slot;
+        else                 _head = slot;
+        _tail = slot;
+    }
+
+    VirtualTexture::VirtualTexture(const std::string& path, const VirtualTextureSettings& settings)
+        : _file(path), _settings(settings), _io(settings.io_queue ? settings.io_queue : &platform::IoQueue::global())
+    {
+        // slots are addressed by 8 bit page table channels
+        _settings.cache_slots_x = std::clamp<uint32_t>(_settings.cache_slots_x, 1, 256);
+        _settings.cache_slots_y = std::clamp<uint32_t>(_settings.cache_slots_y, 1, 256);
+        if(!_file.isEnable()) return;
+
+        _page_table = VirtualPageTable(_file.width(), _file.height(), _file.tileSize(), _file.levelCount());
+        _cache      = VirtualTileCache(_settings.cache_slots_x, _settings.cache_slots_y);
+
+        // the coarsest level is a single tile, it stays resident as the fallback of every lookup
+        const uint32_t top  = packVirtualTile(_file.levelCount() - 1, 0, 0);
+        const TextureLevelView view = _file.tile(_file.levelCount() - 1, 0, 0);
+        if(!place(top, std::vector<uint8_t>(view.data, view.data + view.size), _initial_uploads)) return;
+        _cache.pin(_cache.find(top));
+        _enabled = true;
+    }
+
+    VirtualTexture::~VirtualTexture()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _queue = {};
+        }
+        // the tasks still scheduled find the queue empty and return
+        _tasks.wait();
+    }
+
+    void VirtualTexture::addFeedback(const uint32_t* tiles, size_t count)
+    {
+        if(!isEnable()) return;
+        for(size_t i = 0; i < count; i++)
+        {
+            const uint32_t tile  = tiles[i];
+            const uint32_t level = virtualTileLevel(tile);
+            if(tile == kNoVirtualTile || level >= _file.levelCount()
+                || virtualTileX(tile) >= _file.tilesX(level) || virtualTileY(tile) >= _file.tilesY(level))
+            {
+                continue;
+            }
+            _feedback[tile]++;
+        }
+    }
+
+    void VirtualTexture::update(std::vector<VirtualTileUpload>& uploads)
+    {
+        if(!isEnable()) return;
+        for(auto& upload : _initial_uploads) uploads.push_back(std::move(upload));
+        _initial_uploads.clear();
+        _cache.beginFrame();
+
+        // keep every wanted tile and its ancestors hot, gather the missing ones
+        std::vector<Request> wanted;
+        std::unordered_map<uint32_t, uint32_t> missing;
+        for(auto& [tile, coverage] : _feedback)
+        {
+            uint32_t level = virtualTileLevel(tile);
+            uint32_t x     = virtualTileX(tile);
+            uint32_t y     = virtualTileY(tile);
+            for(; level < _file.levelCount(); level++, x /= 2, y /= 2)
+            {
+                x = std::min(x, _file.tilesX(level) - 1);
+                y = std::min(y, _file.tilesY(level) - 1);
+                const uint32_t ancestor = packVirtualTile(level, x, y);
+                if(!_cache.touch(ancestor)) missing[ancestor] += coverage;
+            }
+        }
+        _feedback.clear();
+        for(auto& [tile, coverage] : missing)
+        {
+            // coarse tiles first, they unblock the most texels, then by screen coverage
+            wanted.push_back(Request{tile, (virtualTileLevel(tile) << 24) | std::min<uint32_t>(coverage, 0xFFFFFF)});
+        }
+        std::sort(wanted.begin(), wanted.end(), [](const Request& a, const Request& b) { return b < a; });
+
+        std::vector<Completed> completed;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            // requests nobody started are dropped, this frame's feedback decides again what is still needed
+            while(!_queue.empty())
+            {
+                _pending.erase(_queue.top().tile);
+                _queue.pop();
+            }
+            for(const Request& request : wanted)
+            {
+                if(_pending.size() >= _settings.max_requests_in_flight) break;
+                if(_pending.insert(request.tile).second) _queue.push(request);
+            }
+            for(; _scheduled < _queue.size(); _scheduled++) _io->submit([this]{ readNext(); }, &_tasks);
+
+            const size_t take = std::min<size_t>(_completed.size(), _settings.max_uploads_per_update);
+            completed.assign(std::make_move_iterator(_completed.begin()), std::make_move_iterator(_completed.begin() + take));
+            _completed.erase(_completed.begin(), _completed.begin() + take);
+            for(auto& tile : completed) _pending.erase(tile.tile);
+        }
+
+        for(auto& tile : completed) place(tile.tile, std::move(tile.data), uploads);
+    }
+
+    size_t VirtualTexture::pendingCount() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _pending.size();
+    }
+
+    bool VirtualTexture::place(uint32_t tile, std::vector<uint8_t> data, std::vector<VirtualTileUpload>& uploads)
+    {
+        if(data.empty() || _cache.find(tile) != VirtualTileCache::kNoSlot) return false;
+
+        uint32_t evicted;
+        const uint32_t slot = _cache.allocate(tile, evicted);
+        if(slot == VirtualTileCache::kNoSlot) return false;     // everything is in use this frame, asked again later
+        if(evicted != kNoVirtualTile)
+        {
+            _page_table.unmap(virtualTileLevel(evicted), virtualTileX(evicted), virtualTileY(evicted));
+        }
+
+        VirtualTileUpload upload;
+        upload.tile   = tile;
+        upload.slot_x = slot % _cache.slotsX();
+        upload.slot_y = slot / _cache.slotsX();
+        upload.data   = std::move(data);
+        _page_table.map(virtualTileLevel(tile), virtualTileX(tile), virtualTileY(tile), upload.slot_x, upload.slot_y);
+        uploads.push_back(std::move(upload));
+        return true;
+    }
+
+    void VirtualTexture::readNext()
+    {
+        uint32_t tile;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _scheduled--;
+            if(_queue.empty()) return;
+            tile = _queue.top().tile;
+            _queue.pop();
+        }
+
+        // the copy out of the mapping is where the tile is actually read from disk
+        const TextureLevelView view = _file.tile(virtualTileLevel(tile), virtualTileX(tile), virtualTileY(tile));
+        Completed result{tile, std::vector<uint8_t>(view.data, view.data + view.size)};
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _completed.push_back(std::move(result));
+    }
+} // namespace lux::engine::resource
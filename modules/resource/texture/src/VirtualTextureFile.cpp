@@ -0,0 +1,224 @@
+#include "lux-engine/resource/texture/VirtualTextureFile.hpp"
+#include <lux-engine/platform/media_loaders/ImageOps.hpp>
+#include <lux-engine/platform/media_loaders/MipGenerator.hpp>
+#include <algorithm>
+#include <fstream>
+
+namespace lux::engine::resource
+{
+    namespace
+    {
+        // bigger tiles than any GL texture can hold only come from a corrupt header
+        constexpr uint64_t kMaxVirtualTileStride = 16384;
+
+        inline uint64_t alignUp(uint64_t value)
+        {
+            return (value + kTextureFileAlignment - 1) & ~(kTextureFileAlignment - 1);
+        }
+
+        // levels down to the first one that fits into a single tile
+        uint32_t virtualLevelCount(uint32_t width, uint32_t height, uint32_t tile_size)
+        {
+            uint32_t levels = 1;
+            while(virtualTileCount(width, levels - 1, tile_size) > 1 || virtualTileCount(height, levels - 1, tile_size) > 1)
+            {
+                levels++;
+            }
+            return levels;
+        }
+
+        // the stride x stride texels of one tile, border included, clamped at the level edge
+        void extractTile(const platform::MipLevel& level, uint32_t channels, int origin_x, int origin_y, uint32_t stride,
+            std::vector<uint8_t>& tile)
+        {
+            tile.resize(size_t(stride) * stride * channels);
+            for(uint32_t y = 0; y < stride; y++)
+            {
+                const int source_y = std::clamp(origin_y + int(y), 0, level.height - 1);
+                const uint8_t* row = &level.pixels[size_t(source_y) * level.width * channels];
+                uint8_t* target = &tile[size_t(y) * stride * channels];
+                for(uint32_t x = 0; x < stride; x++)
+                {
+                    const int source_x = std::clamp(origin_x + int(x), 0, level.width - 1);
+                    std::copy_n(row + size_t(source_x) * channels, channels, target + size_t(x) * channels);
+                }
+            }
+        }
+    }
+
+    VirtualTextureFile::VirtualTextureFile(const std::string& path)
+    {
+        load(path);
+    }
+
+    bool VirtualTextureFile::load(const std::string& path)
+    {
+        _header = nullptr;
+        _tiles  = nullptr;
+        _level_first_tile.clear();
+        if(!_file.open(path)) return false;
+
+        const uint8_t* base = _file.data();
+        const uint64_t size = _file.size();
+        if(size < sizeof(VirtualTextureHeader)) return false;
+
+        const VirtualTextureHeader* header = reinterpret_cast<const VirtualTextureHeader*>(base);
+        if(header->magic != kVirtualTextureMagic || header->version != kVirtualTextureVersion
+            || header->file_size != size
+            || header->format > static_cast<uint32_t>(TextureFormat::BC7)
+            || header->width == 0 || header->height == 0 || header->tile_size == 0
+            || uint64_t(header->tile_size) + 2ull * header->border > kMaxVirtualTileStride
+            || virtualTileCount(header->width, 0, header->tile_size) > kMaxVirtualTilesPerAxis
+            || virtualTileCount(header->height, 0, header->tile_size) > kMaxVirtualTilesPerAxis
+            || header->level_count != virtualLevelCount(header->width, header->height, header->tile_size))
+        {
+            return false;
+        }
+
+        // summed wide, a crafted header must not wrap around to its own tile_count
+        std::vector<uint32_t> first_tile(header->level_count + 1, 0);
+        uint64_t total = 0;
+        for(uint32_t level = 0; level < header->level_count; level++)
+        {
+            total += uint64_t(virtualTileCount(header->width, level, header->tile_size)) * virtualTileCount(header->height, level, header->tile_size);
+            if(total > header->tile_count) return false;
+            first_tile[level + 1] = static_cast<uint32_t>(total);
+        }
+        if(header->tile_count != total
+            || header->tile_count > (size - sizeof(VirtualTextureHeader)) / sizeof(VirtualTileEntry))
+        {
+            return false;
+        }
+
+        const uint32_t stride     = header->tile_size + 2 * header->border;
+        const size_t   tile_bytes = textureLevelSize(static_cast<TextureFormat>(header->format), stride, stride);
+        const VirtualTileEntry* tiles = reinterpret_cast<const VirtualTileEntry*>(base + sizeof(VirtualTextureHeader));
+        for(uint32_t i = 0; i < header->tile_count; i++)
+        {
+            const VirtualTileEntry& tile = tiles[i];
+            if(tile.size != tile_bytes || tile.offset % kTextureFileAlignment != 0
+                || tile.offset > size || tile.size > size - tile.offset)
+            {
+                return false;
+            }
+        }
+
+        _header           = header;
+        _tiles            = tiles;
+        _level_first_tile = std::move(first_tile);
+        return true;
+    }
+
+    TextureLevelView VirtualTextureFile::tile(uint32_t level, uint32_t x, uint32_t y) const
+    {
+        TextureLevelView view;
+        if(!_header || level >= _header->level_count || x >= tilesX(level) || y >= tilesY(level)) return view;
+        const VirtualTileEntry& entry = _tiles[_level_first_tile[level] + y * tilesX(level) + x];
+        view.data   = _file.data() + entry.offset;
+        view.size   = entry.size;
+        view.width  = tileStride();
+        view.height = tileStride();
+        return view;
+    }
+
+    bool buildVirtualTexture(
+        const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels,
+        const VirtualTextureBuildSettings& settings, const std::string& path)
+    {
+        const uint32_t stride = settings.tile_size + 2 * settings.border;
+        const bool compressed = isBlockCompressed(settings.format);
+        if(!pixels || width == 0 || height == 0 || channels == 0 || channels > 4 || settings.tile_size == 0
+            || uint64_t(settings.tile_size) + 2ull * settings.border > kMaxVirtualTileStride
+            || virtualTileCount(width, 0, settings.tile_size) > kMaxVirtualTilesPerAxis
+            || virtualTileCount(height, 0, settings.tile_size) > kMaxVirtualTilesPerAxis
+            || (!compressed && settings.format != TextureFormat::RGBA8) || (compressed && stride % 4 != 0))
+        {
+            return false;
+        }
+        // BC4 / BC5 hold data, never filtered or flagged as sRGB
+        const bool srgb = settings.srgb && hasSrgbVariant(settings.format);
+
+        VirtualTextureHeader header{};
+        header.magic        = kVirtualTextureMagic;
+        header.version      = kVirtualTextureVersion;
+        header.format       = static_cast<uint32_t>(settings.format);
+        header.flags        = srgb ? static_cast<uint32_t>(TEXTURE_FILE_SRGB) : 0u;
+        header.width        = width;
+        header.height       = height;
+        header.tile_size    = settings.tile_size;
+        header.border       = settings.border;
+        header.level_count  = virtualLevelCount(width, height, settings.tile_size);
+
+        platform::MipSettings mip_settings;
+        mip_settings.srgb       = srgb;
+        mip_settings.wrap       = false;
+        mip_settings.max_levels = header.level_count;
+        platform::MipChain chain;
+        platform::generateMips(pixels, int(width), int(height), int(channels), mip_settings, chain);
+        if(chain.levels.size() != header.level_count) return false;
+
+        // every tile has the same size, so the whole table is known before anything is encoded
+        const size_t tile_bytes = textureLevelSize(settings.format, stride, stride);
+        std::vector<VirtualTileEntry> tiles;
+        for(uint32_t level = 0; level < header.level_count; level++)
+        {
+            const uint32_t count = virtualTileCount(width, level, settings.tile_size) * virtualTileCount(height, level, settings.tile_size);
+            tiles.resize(tiles.size() + count);
+        }
+        header.tile_count = static_cast<uint32_t>(tiles.size());
+        uint64_t cursor = alignUp(sizeof(VirtualTextureHeader) + sizeof(VirtualTileEntry) * tiles.size());
+        for(auto& tile : tiles)
+        {
+            tile.offset = cursor;
+            tile.size   = tile_bytes;
+            cursor      = alignUp(cursor + tile_bytes);
+        }
+        header.file_size = tiles.back().offset + tile_bytes;
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if(!out) return false;
+        uint64_t written = 0;
+        auto write = [&](const void* data, uint64_t bytes)
+        {
+            out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+            written += bytes;
+        };
+        auto seek = [&](uint64_t offset)
+        {
+            static const char zeros[kTextureFileAlignment]{};
+            write(zeros, offset - written);
+        };
+        write(&header, sizeof(header));
+        write(tiles.data(), tiles.size() * sizeof(VirtualTileEntry));
+
+        const BlockCompressionSettings block_settings{compressed ? toBlockFormat(settings.format) : BlockFormat::BC7, settings.quality};
+        std::vector<uint8_t> texels, payload;
+        size_t index = 0;
+        for(uint32_t level = 0; level < header.level_count; level++)
+        {
+            const uint32_t tiles_x = virtualTileCount(width, level, settings.tile_size);
+            const uint32_t tiles_y = virtualTileCount(height, level, settings.tile_size);
+            for(uint32_t y = 0; y < tiles_y; y++)
+            {
+                for(uint32_t x = 0; x < tiles_x; x++, index++)
+                {
+                    const int origin_x = int(x * settings.tile_size) - int(settings.border);
+                    const int origin_y = int(y * settings.tile_size) - int(settings.border);
+                    extractTile(chain.levels[level], channels, origin_x, origin_y, stride, texels);
+                    if(compressed)
+                    {
+                        if(!compressImage(texels.data(), stride, stride, channels, block_settings, payload)) return false;
+                    }
+                    else
+                    {
+                        payload.resize(size_t(stride) * stride * 4);
+                        platform::convertChannels(texels.data(), channels, payload.data(), 4, size_t(stride) * stride, true);
+                    }
+                    seek(tiles[index].offset);
+                    write(payload.data(), payload.size());
+                }
+            }
+        }
+        return static_cast<bool>(out);
+    }
+} // namespace lux::engine::resource
@@ -0,0 +1,146 @@
+// offline conversion of imported meshes (.obj, .gltf, .glb) into the engine mesh blob:
+// tangents, lod chain and meshlets are generated once here instead of on every startup
+#include <lux-engine/resource/mesh/GltfLoader.hpp>
+#include <lux-engine/resource/mesh/MeshBlob.hpp>
+#include <lux-engine/resource/mesh/MeshSimplifier.hpp>
+#include <lux-engine/resource/mesh/MeshletBuilder.hpp>
+#include <lux-engine/resource/mesh/ObjLoader.hpp>
+#include <lux-engine/resource/mesh/TangentGenerator.hpp>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+using namespace lux::engine::resource;
+
+namespace
+{
+    void printUsage()
+    {
+        std::cout << "usage: lux_engine_mesh_cooker <input.obj|.gltf|.glb> <output> [options]\n"
+                  << "  --no-tangents     skip tangent generation\n"
+                  << "  --no-lod          keep only the full detail level\n"
+                  << "  --no-meshlets     skip meshlet generation\n"
+                  << "  --lod-count <n>   maximum number of lods (default 8)\n";
+    }
+
+    // whole positive decimal number, false on anything else
+    bool parseCount(const char* text, size_t& value)
+    {
+        char* end = nullptr;
+        const unsigned long long parsed = std::strtoull(text, &end, 10);
+        if(end == text || *end != '\0' || text[0] == '-' || parsed == 0) return false;
+        value = static_cast<size_t>(parsed);
+        return true;
+    }
+
+    bool importMeshes(const std::string& path, std::vector<Mesh>& meshes, std::vector<std::string>& names)
+    {
+        std::string extension = std::filesystem::path(path).extension().string();
+        for(auto& c : extension) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+
+        if(extension == ".obj")
+        {
+            ObjModel model;
+            if(!loadObj(path, model)) return false;
+            meshes = std::move(model.meshes);
+            names  = std::move(model.mesh_names);
+            return true;
+        }
+
+        if(extension == ".gltf" || extension == ".glb")
+        {
+            GltfModel model(path);
+            if(!model.isEnable()) return false;
+            for(auto& gltf_mesh : model.meshes)
+            {
+                for(size_t p = 0; p < gltf_mesh.primitives.size(); p++)
+                {
+                    Mesh mesh;
+                    if(!convertGltfPrimitive(model, gltf_mesh.primitives[p], mesh))
+                    {
+                        std::cerr << "skipping primitive " << p << " of mesh '" << gltf_mesh.name << "'\n";
+                        continue;
+                    }
+                    meshes.push_back(std::move(mesh));
+                    names.push_back(gltf_mesh.primitives.size() > 1
+                        ? gltf_mesh.name + "." + std::to_string(p)
+                        : gltf_mesh.name);
+                }
+            }
+            return true;
+        }
+
+        std::cerr << "unsupported input format '" << extension << "'\n";
+        return false;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if(argc < 3)
+    {
+        printUsage();
+        return 1;
+    }
+
+    const std::string input  = argv[1];
+    const std::string output = argv[2];
+    bool tangents = true, lods = true, meshlets = true;
+    LodChainSettings lod_settings;
+    for(int i = 3; i < argc; i++)
+    {
+        const std::string option = argv[i];
+        if(option == "--no-tangents")     tangents = false;
+        else if(option == "--no-lod")     lods     = false;
+        else if(option == "--no-meshlets") meshlets = false;
+        else if(option == "--lod-count" && i + 1 < argc && parseCount(argv[i + 1], lod_settings.max_lod_count)) i++;
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+    if(!lods) lod_settings.max_lod_count = 1;
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<Mesh>        meshes;
+    std::vector<std::string> names;
+    if(!importMeshes(input, meshes, names))
+    {
+        std::cerr << "failed to import '" << input << "'\n";
+        return 1;
+    }
+
+    // tangents first, mirrored vertex splitting rewrites the index buffer the lods are built from
+    if(tangents)
+    {
+        for(auto& mesh : meshes) generateTangents(mesh);
+    }
+    generateLodChains(meshes, lod_settings);
+    if(meshlets)
+    {
+        buildMeshlets(meshes);
+    }
+
+    if(!writeMeshBlob(output, meshes, names))
+    {
+        std::cerr << "failed to write '" << output << "'\n";
+        return 1;
+    }
+
+    size_t vertex_count = 0, index_count = 0, meshlet_count = 0;
+    for(auto& mesh : meshes)
+    {
+        vertex_count  += mesh.vertices.size();
+        index_count   += mesh.indices.size();
+        meshlet_count += mesh.meshlets.size();
+    }
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "cooked " << meshes.size() << " meshes, " << vertex_count << " vertices, "
+              << index_count << " indices (all lods), " << meshlet_count << " meshlets in "
+              << elapsed << " ms\n";
+    return 0;
+}
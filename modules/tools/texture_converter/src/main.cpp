@@ -0,0 +1,192 @@
+// offline conversion of png/jpg/... images into the engine texture file:
+// decoding, mip generation and block compression happen once here instead of on every startup
+#include <lux-engine/platform/media_loaders/Image.hpp>
+#include <lux-engine/platform/media_loaders/ImageResize.hpp>
+#include <lux-engine/resource/texture/TextureFile.hpp>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace lux::engine;
+using namespace lux::engine::resource;
+
+namespace
+{
+    void printUsage()
+    {
+        std::cout << "usage: lux_engine_texture_converter <input image> <output> [options]\n"
+                  << "  --format <f>          bc1|bc3|bc4|bc5|bc7|r8|rg8|rgb8|rgba8 (default bc7)\n"
+                  << "  --quality <q>         fast|normal|high (default normal)\n"
+                  << "  --linear              data texture (normals, masks), no sRGB. implied by r8, rg8, bc4 and bc5\n"
+                  << "  --normal-map          linear, flagged as normal map\n"
+                  << "  --premultiplied       flag the alpha as premultiplied\n"
+                  << "  --no-mips             store the full size level only\n"
+                  << "  --clamp               filter mips without wrapping around the edges\n"
+                  << "  --alpha-cutoff <a>    keep alpha test coverage of every mip at cutoff a (0-1)\n"
+                  << "  --no-flip             keep the image rows top to bottom\n"
+                  << "  --max-size <n>        downscale (lanczos) so neither side exceeds n texels\n"
+                  << "  --cache <dir>         reuse block compressed levels from a cache directory\n"
+                  << "  --meta <key>=<value>  store a metadata entry, repeatable\n";
+    }
+
+    bool parseFormat(const std::string& name, TextureFormat& format)
+    {
+        const std::pair<const char*, TextureFormat> formats[] = {
+            {"bc1", TextureFormat::BC1}, {"bc3", TextureFormat::BC3}, {"bc4", TextureFormat::BC4},
+            {"bc5", TextureFormat::BC5}, {"bc7", TextureFormat::BC7}, {"r8", TextureFormat::R8},
+            {"rg8", TextureFormat::RG8}, {"rgb8", TextureFormat::RGB8}, {"rgba8", TextureFormat::RGBA8}
+        };
+        for(auto& [key, value] : formats)
+        {
+            if(name == key)
+            {
+                format = value;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool parseFloat(const char* text, float& value)
+    {
+        char* end = nullptr;
+        const float parsed = std::strtof(text, &end);
+        if(end == text || *end != '\0') return false;
+        value = parsed;
+        return true;
+    }
+
+    bool parseInt(const char* text, int& value)
+    {
+        char* end = nullptr;
+        const long parsed = std::strtol(text, &end, 10);
+        if(end == text || *end != '\0' || parsed < INT_MIN || parsed > INT_MAX) return false;
+        value = static_cast<int>(parsed);
+        return true;
+    }
+
+    bool parseQuality(const std::string& name, CompressionQuality& quality)
+    {
+        if(name == "fast")        quality = CompressionQuality::FAST;
+        else if(name == "normal") quality = CompressionQuality::NORMAL;
+        else if(name == "high")   quality = CompressionQuality::HIGH;
+        else return false;
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if(argc < 3)
+    {
+        printUsage();
+        return 1;
+    }
+
+    const std::string input  = argv[1];
+    const std::string output = argv[2];
+    TextureBuildSettings settings;
+    std::vector<std::pair<std::string, std::string>> metadata;
+    std::string cache_directory;
+    bool flip = true;
+    int max_size = 0;
+    for(int i = 3; i < argc; i++)
+    {
+        const std::string option = argv[i];
+        const bool has_value = i + 1 < argc;
+        if(option == "--format" && has_value && parseFormat(argv[i + 1], settings.format))          i++;
+        else if(option == "--quality" && has_value && parseQuality(argv[i + 1], settings.quality))  i++;
+        else if(option == "--linear")           settings.srgb = false;
+        else if(option == "--normal-map")
+        {
+            settings.srgb   = false;
+            settings.flags |= TEXTURE_FILE_NORMAL_MAP;
+        }
+        else if(option == "--premultiplied")    settings.flags |= TEXTURE_FILE_PREMULTIPLIED_ALPHA;
+        else if(option == "--no-mips")          settings.mips = false;
+        else if(option == "--clamp")            settings.wrap = false;
+        else if(option == "--no-flip")          flip = false;
+        else if(option == "--alpha-cutoff" && has_value && parseFloat(argv[i + 1], settings.alpha_cutoff)) i++;
+        else if(option == "--cache" && has_value)        cache_directory = argv[++i];
+        else if(option == "--max-size" && has_value && parseInt(argv[i + 1], max_size)) i++;
+        else if(option == "--meta" && has_value && std::string(argv[i + 1]).find('=') != std::string::npos)
+        {
+            const std::string entry = argv[++i];
+            const size_t split = entry.find('=');
+            metadata.emplace_back(entry.substr(0, split), entry.substr(split + 1));
+        }
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    // one and two channel formats are always linear, downscaling has to agree with the mips
+    if(!hasSrgbVariant(settings.format)) settings.srgb = false;
+
+    const auto start = std::chrono::steady_clock::now();
+    // bottom row first, like every texture the playground uploads
+    platform::Image image(input, flip);
+    if(!image.isEnable())
+    {
+        std::cerr << "failed to decode '" << input << "'\n";
+        return 1;
+    }
+
+    std::unique_ptr<BlockCompressionCache> cache;
+    if(!cache_directory.empty())
+    {
+        cache = std::make_unique<BlockCompressionCache>(cache_directory);
+        settings.cache = cache.get();
+    }
+
+    const uint8_t* pixels = static_cast<const uint8_t*>(image.data());
+    int width  = image.width();
+    int height = image.height();
+    std::vector<uint8_t> resized;
+    if(max_size > 0 && (width > max_size || height > max_size))
+    {
+        int fitted_width, fitted_height;
+        platform::fitExtent(width, height, max_size, max_size, fitted_width, fitted_height);
+        platform::ResizeSettings resize_settings;
+        resize_settings.srgb = settings.srgb;
+        resize_settings.wrap = settings.wrap;
+        if(!platform::resizeImage(pixels, width, height, image.channel(), fitted_width, fitted_height, resize_settings, resized))
+        {
+            std::cerr << "failed to resize '" << input << "' to " << fitted_width << "x" << fitted_height << "\n";
+            return 1;
+        }
+        pixels = resized.data();
+        width  = fitted_width;
+        height = fitted_height;
+    }
+
+    TextureData texture;
+    if(!buildTexture(pixels, static_cast<uint32_t>(width), static_cast<uint32_t>(height),
+        static_cast<uint32_t>(image.channel()), settings, texture))
+    {
+        std::cerr << "failed to convert '" << input << "'\n";
+        return 1;
+    }
+    texture.metadata = std::move(metadata);
+    texture.metadata.emplace_back("source", input);
+
+    if(!writeTextureFile(output, texture))
+    {
+        std::cerr << "failed to write '" << output << "'\n";
+        return 1;
+    }
+
+    size_t payload = 0;
+    for(auto& level : texture.levels) payload += level.size();
+    const size_t uncompressed = static_cast<size_t>(width) * height * 4;
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "converted " << width << "x" << height << ", " << texture.levels.size() << " levels, "
+              << payload << " bytes (" << static_cast<double>(uncompressed) / static_cast<double>(payload)
+              << "x smaller than the rgba8 level 0) in " << elapsed << " ms\n";
+    return 0;
+}
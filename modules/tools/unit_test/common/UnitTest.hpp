@@ -0,0 +1,29 @@
+#pragma once
+#include <cstdio>
+
+// minimal checks for the unit test executables: a failed check is printed and main() returns non zero
+namespace lux::engine::unit_test
+{
+    inline int& failureCount()
+    {
+        static int count = 0;
+        return count;
+    }
+
+    // the exit code of a test executable
+    inline int result()
+    {
+        if(failureCount() > 0) std::fprintf(stderr, "%d check(s) failed\n", failureCount());
+        return failureCount() == 0 ? 0 : 1;
+    }
+} // namespace lux::engine::unit_test
+
+#define LUX_CHECK(expression)                                                                   \
+    do                                                                                          \
+    {                                                                                           \
+        if(!(expression))                                                                       \
+        {                                                                                       \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #expression); \
+            lux::engine::unit_test::failureCount()++;                                           \
+        }                                                                                       \
+    } while(false)
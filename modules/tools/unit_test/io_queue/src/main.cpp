@@ -0,0 +1,90 @@
+// io queue: counters, submission order, tasks submitting tasks and the drain on shutdown
+#include <lux-engine/platform/cxx/IoQueue.hpp>
+#include <UnitTest.hpp>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+using namespace lux::engine::platform;
+
+namespace
+{
+    void testCounter(IoQueue& queue)
+    {
+        std::atomic<int> count{0};
+        IoCounter counter;
+        for(int i = 0; i < 1000; i++) queue.submit([&]{ count++; }, &counter);
+        counter.wait();
+        LUX_CHECK(count.load() == 1000);
+        LUX_CHECK(counter.pending() == 0);
+
+        // a counter nobody submitted to doesn't block
+        IoCounter idle;
+        idle.wait();
+    }
+
+    // with a single worker the tasks run one after another in submission order
+    void testOrder()
+    {
+        IoQueue queue(1);
+        LUX_CHECK(queue.workerCount() == 1);
+        std::mutex mutex;
+        std::vector<int> order;
+        IoCounter counter;
+        for(int i = 0; i < 64; i++)
+        {
+            queue.submit([&, i]
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                order.push_back(i);
+            }, &counter);
+        }
+        counter.wait();
+        bool ordered = order.size() == 64;
+        for(size_t i = 0; ordered && i < order.size(); i++) ordered = order[i] == static_cast<int>(i);
+        LUX_CHECK(ordered);
+    }
+
+    // the way the loaders use it: one task per request, a task may queue follow up work on the same counter
+    void testNested(IoQueue& queue)
+    {
+        std::atomic<int> count{0};
+        IoCounter counter;
+        for(int i = 0; i < 16; i++)
+        {
+            queue.submit([&]
+            {
+                count++;
+                queue.submit([&]{ count++; }, &counter);
+            }, &counter);
+        }
+        counter.wait();
+        LUX_CHECK(count.load() == 32);
+    }
+
+    // whatever is queued still runs when the queue goes away
+    void testDestructorDrain()
+    {
+        std::atomic<int> count{0};
+        {
+            IoQueue queue(2);
+            for(int i = 0; i < 200; i++) queue.submit([&]{ count++; });
+        }
+        LUX_CHECK(count.load() == 200);
+    }
+}
+
+int main()
+{
+    IoQueue queue(3);
+    LUX_CHECK(queue.workerCount() == 3);
+    testCounter(queue);
+    testNested(queue);
+    testOrder();
+    testDestructorDrain();
+
+    const size_t global = IoQueue::global().workerCount();
+    LUX_CHECK(global >= 2 && global <= 4);
+
+    return lux::engine::unit_test::result();
+}
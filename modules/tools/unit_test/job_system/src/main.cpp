@@ -0,0 +1,199 @@
+// job system: work stealing deque, counters, dependent jobs, nested waits and shutdown
+#include <lux-engine/platform/cxx/JobSystem.hpp>
+#include <lux-engine/platform/cxx/Parallel.hpp>
+#include <UnitTest.hpp>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace lux::engine::platform;
+
+namespace
+{
+    // the owner pushes and pops at the bottom while thieves take from the top, every item must come out exactly once
+    void testDequeExactlyOnce()
+    {
+        constexpr size_t kItemCount  = 100000;
+        constexpr size_t kThiefCount = 3;
+        std::vector<size_t>             items(kItemCount);
+        std::vector<std::atomic<int>>   taken(kItemCount);
+        for(size_t i = 0; i < kItemCount; i++) items[i] = i;
+
+        // small on purpose, the ring grows while thieves are reading it
+        WorkStealingDeque<size_t> deque(4);
+        std::atomic<bool> owner_done{false};
+        std::vector<std::thread> thieves;
+        for(size_t t = 0; t < kThiefCount; t++)
+        {
+            thieves.emplace_back([&]
+            {
+                while(!owner_done.load() || !deque.empty())
+                {
+                    if(size_t* item = deque.steal()) taken[*item]++;
+                }
+            });
+        }
+        for(size_t i = 0; i < kItemCount; i++)
+        {
+            deque.push(&items[i]);
+            // keep the bottom busy too, pops race the thieves for the last item
+            if(i % 3 == 0)
+            {
+                if(size_t* item = deque.pop()) taken[*item]++;
+            }
+        }
+        while(size_t* item = deque.pop()) taken[*item]++;
+        owner_done = true;
+        for(auto& thief : thieves) thief.join();
+
+        size_t wrong = 0;
+        for(auto& count : taken) wrong += count.load() != 1;
+        LUX_CHECK(wrong == 0);
+        LUX_CHECK(deque.empty());
+    }
+
+    void testCounters(JobSystem& jobs)
+    {
+        JobCounter counter;
+        std::atomic<int> count{0};
+        for(int i = 0; i < 10000; i++) jobs.schedule([&]{ count++; }, &counter);
+        jobs.wait(counter);
+        LUX_CHECK(counter.done());
+        LUX_CHECK(count.load() == 10000);
+
+        // counters on the stack, released and reused quickly
+        bool all_done = true;
+        for(int round = 0; round < 1000; round++)
+        {
+            JobCounter local;
+            std::atomic<int> local_count{0};
+            for(int i = 0; i < 4; i++) jobs.schedule([&]{ local_count++; }, &local);
+            jobs.wait(local);
+            all_done = all_done && local_count.load() == 4;
+        }
+        LUX_CHECK(all_done);
+    }
+
+    void testScheduleAfter(JobSystem& jobs)
+    {
+        std::mutex          mutex;
+        std::vector<int>    order;
+        auto record = [&](int value)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(value);
+        };
+
+        // a chain a -> b -> c, registered while a is still running
+        JobCounter a, b, c;
+        jobs.schedule([&]{ std::this_thread::sleep_for(std::chrono::milliseconds(10)); record(1); }, &a);
+        jobs.scheduleAfter(a, [&]{ record(2); }, &b);
+        jobs.scheduleAfter(b, [&]{ record(3); }, &c);
+        jobs.wait(c);
+        LUX_CHECK(order == std::vector<int>({1, 2, 3}));
+
+        // a dependency that is already done runs the job right away
+        JobCounter d;
+        jobs.scheduleAfter(a, [&]{ record(4); }, &d);
+        jobs.wait(d);
+        LUX_CHECK(order.size() == 4 && order.back() == 4);
+
+        // fan in: the dependent waits for every job of the counter
+        JobCounter many, after;
+        std::atomic<int> finished{0};
+        int seen = -1;
+        for(int i = 0; i < 64; i++) jobs.schedule([&]{ std::this_thread::yield(); finished++; }, &many);
+        jobs.scheduleAfter(many, [&]{ seen = finished.load(); }, &after);
+        jobs.wait(after);
+        LUX_CHECK(seen == 64);
+    }
+
+    void testNestedWaits(JobSystem& jobs)
+    {
+        // jobs waiting on jobs they scheduled, the waits must run other work instead of blocking the workers
+        JobCounter outer;
+        std::atomic<int> leaves{0};
+        for(int i = 0; i < 32; i++)
+        {
+            jobs.schedule([&]
+            {
+                JobCounter inner;
+                for(int j = 0; j < 32; j++) jobs.schedule([&]{ leaves++; }, &inner);
+                jobs.wait(inner);
+            }, &outer);
+        }
+        jobs.wait(outer);
+        LUX_CHECK(leaves.load() == 32 * 32);
+    }
+
+    void testNestedParallelFor()
+    {
+        // parallelFor runs on the global system, from jobs of that same system and nested in itself
+        JobSystem& jobs = JobSystem::global();
+        constexpr size_t kCount = 1000;
+        std::vector<std::atomic<int>> visits(kCount);
+        JobCounter counter;
+        for(size_t part = 0; part < 4; part++)
+        {
+            jobs.schedule([&, part]
+            {
+                const size_t begin = part * kCount / 4, end = (part + 1) * kCount / 4;
+                parallelFor(begin, end, 25, [&](size_t chunk_begin, size_t chunk_end)
+                {
+                    parallelFor(chunk_begin, chunk_end, 4, [&](size_t inner_begin, size_t inner_end)
+                    {
+                        for(size_t i = inner_begin; i < inner_end; i++) visits[i]++;
+                    });
+                });
+            }, &counter);
+        }
+        jobs.wait(counter);
+
+        size_t wrong = 0;
+        for(auto& count : visits) wrong += count.load() != 1;
+        LUX_CHECK(wrong == 0);
+    }
+
+    void testDestructorDrain()
+    {
+        // jobs without a counter, dependents and jobs scheduled by jobs all run before the destructor returns
+        std::atomic<int> count{0};
+        JobCounter gate;
+        {
+            JobSystem jobs(2);
+            jobs.schedule([&]{ std::this_thread::sleep_for(std::chrono::milliseconds(10)); count++; }, &gate);
+            for(int i = 0; i < 16; i++) jobs.scheduleAfter(gate, [&]{ count++; });
+            for(int i = 0; i < 100; i++)
+            {
+                jobs.schedule([&]
+                {
+                    count++;
+                    jobs.schedule([&]{ count++; });
+                });
+            }
+        }
+        LUX_CHECK(count.load() == 1 + 16 + 200);
+        LUX_CHECK(gate.done());
+    }
+}
+
+int main()
+{
+    testDequeExactlyOnce();
+
+    // a single worker leaves most of the work to the waiting thread, three make them steal from each other
+    for(size_t worker_count : {size_t(1), size_t(3)})
+    {
+        JobSystem jobs(worker_count);
+        LUX_CHECK(jobs.workerCount() == worker_count);
+        testCounters(jobs);
+        testScheduleAfter(jobs);
+        testNestedWaits(jobs);
+    }
+    testNestedParallelFor();
+    testDestructorDrain();
+
+    return lux::engine::unit_test::result();
+}
@@ -0,0 +1,132 @@
+// task graph: dependencies from read / write sets, execution order, thread affinity and the critical path
+#include <lux-engine/platform/cxx/TaskGraph.hpp>
+#include <UnitTest.hpp>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace lux::engine::platform;
+
+namespace
+{
+    using Indices = std::vector<size_t>;
+
+    // begin / end ticks of every system in the last frame, to check the order they ran in
+    struct Trace
+    {
+        explicit Trace(size_t count) : begin(count), end(count), thread(count) {}
+
+        TaskGraph::System record(size_t index, uint32_t sleep_ms = 0)
+        {
+            return [this, index, sleep_ms]
+            {
+                begin[index]  = tick++;
+                thread[index] = std::this_thread::get_id();
+                if(sleep_ms) std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms));
+                end[index] = tick++;
+            };
+        }
+
+        std::atomic<uint32_t>           tick{0};
+        std::vector<uint32_t>           begin;
+        std::vector<uint32_t>           end;
+        std::vector<std::thread::id>    thread;
+    };
+
+    void testDependencies()
+    {
+        constexpr size_t kCount = 10;
+        Trace trace(kCount);
+        TaskGraph graph;
+        const auto calling = SystemAffinity::CALLING_THREAD;
+        graph.addSystem("input",   {},                     {"input"},   trace.record(0), calling);
+        graph.addSystem("camera",  {"input"},              {"camera"},  trace.record(1));
+        graph.addSystem("anim",    {},                     {"poses"},   trace.record(2));
+        graph.addSystem("models",  {"poses"},              {"models"},  trace.record(3));
+        graph.addSystem("culling", {"camera", "models"},   {"visible"}, trace.record(4));
+        graph.addSystem("ui",      {"camera"},             {},          trace.record(5), calling);
+        graph.addSystem("edit",    {},                     {"camera"},  trace.record(6));
+        graph.addSystem("draw",    {"visible", "camera"},  {"gl"},      trace.record(7), calling);
+        graph.addSystem("post",    {"gl"},                 {"gl"},      trace.record(8), calling);
+        graph.addSystem("present", {"gl", "gl"},           {},          trace.record(9), calling);
+        LUX_CHECK(graph.systemCount() == kCount);
+        LUX_CHECK(graph.systemName(4) == "culling");
+
+        LUX_CHECK(graph.dependencies(0).empty());
+        LUX_CHECK(graph.dependencies(1) == Indices({0}));               // read after write
+        LUX_CHECK(graph.dependencies(2).empty());
+        LUX_CHECK(graph.dependencies(3) == Indices({2}));
+        LUX_CHECK(graph.dependencies(4) == Indices({1, 3}));
+        LUX_CHECK(graph.dependencies(5) == Indices({1}));
+        LUX_CHECK(graph.dependencies(6) == Indices({1, 4, 5}));         // write after write and after both readers
+        LUX_CHECK(graph.dependencies(7) == Indices({4, 6}));            // the camera edit, not the first camera
+        LUX_CHECK(graph.dependencies(8) == Indices({7}));               // read and write counts as a write
+        LUX_CHECK(graph.dependencies(9) == Indices({8}));
+
+        // a single worker, the calling thread has to pick up part of the work too
+        const std::thread::id caller = std::this_thread::get_id();
+        for(size_t worker_count : {size_t(1), size_t(3)})
+        {
+            JobSystem jobs(worker_count);
+            for(int frame = 0; frame < 50; frame++)
+            {
+                trace.tick = 0;
+                graph.run(jobs);
+
+                bool ordered = true, on_caller = true;
+                for(size_t i = 0; i < kCount; i++)
+                {
+                    for(size_t dependency : graph.dependencies(i)) ordered = ordered && trace.end[dependency] < trace.begin[i];
+                }
+                for(size_t i : {0, 5, 7, 8, 9}) on_caller = on_caller && trace.thread[i] == caller;
+                LUX_CHECK(ordered);
+                LUX_CHECK(on_caller);
+                LUX_CHECK(trace.tick.load() == 2 * kCount);
+            }
+        }
+    }
+
+    void testCriticalPath()
+    {
+        // a 20 + 20 ms chain next to a 5 ms system and a 1 ms one hanging off the chain's start
+        constexpr size_t kCount = 4;
+        Trace trace(kCount);
+        TaskGraph graph;
+        graph.addSystem("load",     {},         {"a"}, trace.record(0, 20));
+        graph.addSystem("short",    {},         {"b"}, trace.record(1, 5));
+        graph.addSystem("process",  {"a"},      {"c"}, trace.record(2, 20));
+        graph.addSystem("peek",     {"a"},      {},    trace.record(3, 1));
+
+        JobSystem jobs(2);
+        graph.run(jobs);
+        const TaskGraphFrame& frame = graph.lastFrame();
+        LUX_CHECK(frame.durations.size() == kCount && frame.start_times.size() == kCount);
+        LUX_CHECK(frame.critical_path == Indices({0, 2}));
+        LUX_CHECK(frame.durations[0] >= 20.0 && frame.durations[2] >= 20.0);
+        LUX_CHECK(std::abs(frame.critical_time - (frame.durations[0] + frame.durations[2])) < 1e-9);
+
+        double serial = 0;
+        for(double duration : frame.durations) serial += duration;
+        LUX_CHECK(std::abs(frame.serial_time - serial) < 1e-9);
+        LUX_CHECK(frame.critical_time <= frame.serial_time);
+        LUX_CHECK(frame.wall_time >= frame.critical_time);
+        // process starts once load is done
+        LUX_CHECK(frame.start_times[2] >= frame.start_times[0] + frame.durations[0]);
+        LUX_CHECK(graph.describeCriticalPath().find("load") != std::string::npos);
+    }
+}
+
+int main()
+{
+    testDependencies();
+    testCriticalPath();
+
+    // an empty graph returns right away
+    TaskGraph empty;
+    empty.run();
+    LUX_CHECK(empty.lastFrame().critical_path.empty());
+
+    return lux::engine::unit_test::result();
+}
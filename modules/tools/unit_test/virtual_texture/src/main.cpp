@@ -0,0 +1,223 @@
+// cpu residency of virtual textures: page table fallback, tile cache replacement and request throttling
+#include <lux-engine/resource/texture/VirtualTexture.hpp>
+#include <UnitTest.hpp>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+
+using namespace lux::engine::resource;
+
+namespace
+{
+    uint32_t entryLevel(uint32_t entry) { return (entry >> 16) & 0xFF; }
+
+    uint32_t entrySlotX(uint32_t entry) { return entry & 0xFF; }
+
+    uint32_t entrySlotY(uint32_t entry) { return (entry >> 8) & 0xFF; }
+
+    // every entry is its own mapping or, when not resident, the entry of its (clamped) parent
+    bool fallbackConsistent(const VirtualPageTable& table)
+    {
+        for(uint32_t level = 0; level < table.levelCount(); level++)
+        {
+            for(uint32_t y = 0; y < table.height(level); y++)
+            {
+                for(uint32_t x = 0; x < table.width(level); x++)
+                {
+                    const uint32_t entry = table.entry(level, x, y);
+                    if(table.isMapped(level, x, y))
+                    {
+                        if(entryLevel(entry) != level) return false;
+                        continue;
+                    }
+                    const uint32_t expected = level + 1 < table.levelCount()
+                        ? table.entry(level + 1, std::min(x / 2, table.width(level + 1) - 1), std::min(y / 2, table.height(level + 1) - 1))
+                        : 0;
+                    if(entry != expected) return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    void testPageTableFallback()
+    {
+        // 1300 x 700 in 128 texel tiles: 11x6, 6x3, 3x2, 2x1, 1x1, the last column / row of most levels has a single child
+        VirtualPageTable table(1300, 700, 128, 5);
+        LUX_CHECK(table.levelCount() == 5);
+        LUX_CHECK(table.width(0) == 11 && table.height(0) == 6);
+        LUX_CHECK(table.width(1) == 6 && table.height(1) == 3);
+        LUX_CHECK(table.width(3) == 2 && table.height(3) == 1);
+
+        table.map(4, 0, 0, 1, 2);
+        LUX_CHECK(fallbackConsistent(table));
+        LUX_CHECK(entryLevel(table.entry(0, 10, 5)) == 4);
+        LUX_CHECK(entrySlotX(table.entry(0, 10, 5)) == 1 && entrySlotY(table.entry(0, 10, 5)) == 2);
+
+        // last column and row of level 1, level 0 column 10 and rows 4 - 5 hang off it
+        table.clearDirty();
+        table.map(1, 5, 2, 3, 4);
+        LUX_CHECK(fallbackConsistent(table));
+        LUX_CHECK(entryLevel(table.entry(0, 10, 5)) == 1);
+        LUX_CHECK(entryLevel(table.entry(0, 10, 4)) == 1);
+        LUX_CHECK(entryLevel(table.entry(0, 9, 5)) == 4);
+        LUX_CHECK(table.dirty(0).x0 == 10 && table.dirty(0).x1 == 11 && table.dirty(0).y0 == 4 && table.dirty(0).y1 == 6);
+        LUX_CHECK(table.dirty(2).x0 >= table.dirty(2).x1);
+
+        // level 2 row 1 is the clamped parent of level 1 row 2
+        table.map(2, 2, 1, 5, 6);
+        table.map(3, 1, 0, 7, 8);
+        LUX_CHECK(fallbackConsistent(table));
+        LUX_CHECK(entryLevel(table.entry(1, 4, 2)) == 2);
+        LUX_CHECK(entryLevel(table.entry(1, 5, 2)) == 1);
+        LUX_CHECK(entryLevel(table.entry(0, 8, 5)) == 2);
+
+        table.unmap(1, 5, 2);
+        LUX_CHECK(fallbackConsistent(table));
+        LUX_CHECK(entryLevel(table.entry(0, 10, 5)) == 2);
+        LUX_CHECK(entrySlotX(table.entry(0, 10, 5)) == 5 && entrySlotY(table.entry(0, 10, 5)) == 6);
+
+        table.unmap(2, 2, 1);
+        LUX_CHECK(fallbackConsistent(table));
+        LUX_CHECK(entryLevel(table.entry(0, 10, 5)) == 3);
+
+        table.unmap(3, 1, 0);
+        table.unmap(4, 0, 0);
+        LUX_CHECK(fallbackConsistent(table));
+        LUX_CHECK(table.entry(0, 10, 5) == 0);
+    }
+
+    void testCacheReplacement()
+    {
+        const uint32_t a = packVirtualTile(0, 0, 0), b = packVirtualTile(0, 1, 0), c = packVirtualTile(0, 2, 0);
+        const uint32_t d = packVirtualTile(0, 3, 0), e = packVirtualTile(0, 4, 0);
+        VirtualTileCache cache(2, 1);
+        uint32_t evicted;
+
+        LUX_CHECK(cache.allocate(a, evicted) != VirtualTileCache::kNoSlot && evicted == kNoVirtualTile);
+        LUX_CHECK(cache.allocate(b, evicted) != VirtualTileCache::kNoSlot && evicted == kNoVirtualTile);
+        // both slots were filled this frame, nothing may go
+        LUX_CHECK(cache.allocate(c, evicted) == VirtualTileCache::kNoSlot);
+        LUX_CHECK(cache.find(a) != VirtualTileCache::kNoSlot && cache.find(b) != VirtualTileCache::kNoSlot);
+
+        // a is used again, b is the least recently used one
+        cache.beginFrame();
+        LUX_CHECK(cache.touch(a));
+        const uint32_t slot_b = cache.find(b);
+        LUX_CHECK(cache.allocate(c, evicted) == slot_b && evicted == b);
+        LUX_CHECK(cache.find(b) == VirtualTileCache::kNoSlot);
+        // a was touched and c placed this frame
+        LUX_CHECK(cache.allocate(d, evicted) == VirtualTileCache::kNoSlot);
+        LUX_CHECK(!cache.touch(b));
+
+        // a pinned slot survives any number of frames without a touch
+        cache.pin(cache.find(a));
+        for(uint32_t frame = 0; frame < 4; frame++)
+        {
+            cache.beginFrame();
+            LUX_CHECK(cache.allocate(frame % 2 ? d : e, evicted) != VirtualTileCache::kNoSlot);
+            LUX_CHECK(evicted != a);
+            LUX_CHECK(cache.find(a) != VirtualTileCache::kNoSlot);
+        }
+        cache.beginFrame();
+        // the only unpinned slot was just used, the pinned one is never a candidate
+        uint32_t last = cache.find(d) != VirtualTileCache::kNoSlot ? d : e;
+        LUX_CHECK(cache.touch(last));
+        LUX_CHECK(cache.allocate(b, evicted) == VirtualTileCache::kNoSlot);
+        LUX_CHECK(cache.residentCount() == 2);
+    }
+
+    void testResidency(const std::string& path)
+    {
+        // odd extents, 10 x 6 tiles on level 0
+        const uint32_t width = 300, height = 170;
+        std::vector<uint8_t> pixels(size_t(width) * height * 4);
+        for(size_t i = 0; i < pixels.size(); i++) pixels[i] = static_cast<uint8_t>(i * 7);
+        VirtualTextureBuildSettings build;
+        build.format    = TextureFormat::RGBA8;
+        build.tile_size = 32;
+        build.border    = 2;
+        LUX_CHECK(buildVirtualTexture(pixels.data(), width, height, 4, build, path));
+
+        // more tiles along an axis than packVirtualTile() can address
+        VirtualTextureBuildSettings narrow = build;
+        narrow.tile_size = 1;
+        narrow.border    = 0;
+        std::vector<uint8_t> row(size_t(kMaxVirtualTilesPerAxis + 1) * 4);
+        LUX_CHECK(!buildVirtualTexture(row.data(), kMaxVirtualTilesPerAxis + 1, 1, 4, narrow, path + ".wide"));
+
+        // a queue of its own, the test doesn't depend on how many threads the global one has
+        lux::engine::platform::IoQueue io(2);
+        VirtualTextureSettings settings;
+        settings.cache_slots_x          = 3;
+        settings.cache_slots_y          = 2;
+        settings.max_uploads_per_update = 2;
+        settings.max_requests_in_flight = 3;
+        settings.io_queue               = &io;
+        VirtualTexture texture(path, settings);
+        LUX_CHECK(texture.isEnable());
+        if(!texture.isEnable()) return;
+
+        const VirtualTextureFile& file = texture.file();
+        const uint32_t top_level = file.levelCount() - 1;
+        const uint32_t top       = packVirtualTile(top_level, 0, 0);
+
+        // the coarsest tile comes with the first update and backs every entry
+        std::vector<VirtualTileUpload> uploads;
+        texture.update(uploads);
+        LUX_CHECK(uploads.size() == 1 && uploads[0].tile == top);
+        LUX_CHECK(uploads[0].data.size() == file.tileBytes());
+        LUX_CHECK(entryLevel(texture.pageTable().entry(0, file.tilesX(0) - 1, file.tilesY(0) - 1)) == top_level);
+        LUX_CHECK(fallbackConsistent(texture.pageTable()));
+
+        // ask for every level 0 tile at once, far more than the cache holds
+        std::vector<uint32_t> feedback;
+        for(uint32_t y = 0; y < file.tilesY(0); y++)
+        {
+            for(uint32_t x = 0; x < file.tilesX(0); x++) feedback.push_back(packVirtualTile(0, x, y));
+        }
+        size_t max_pending = 0;
+        for(uint32_t frame = 0; frame < 200; frame++)
+        {
+            uploads.clear();
+            texture.addFeedback(feedback.data(), feedback.size());
+            texture.update(uploads);
+            max_pending = std::max(max_pending, texture.pendingCount());
+            LUX_CHECK(uploads.size() <= settings.max_uploads_per_update);
+            LUX_CHECK(texture.cache().residentCount() <= size_t(settings.cache_slots_x) * settings.cache_slots_y);
+            LUX_CHECK(texture.cache().find(top) != VirtualTileCache::kNoSlot);
+            LUX_CHECK(fallbackConsistent(texture.pageTable()));
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        LUX_CHECK(max_pending > 0 && max_pending <= settings.max_requests_in_flight);
+
+        // a single wanted tile ends up resident with its ancestors once the demand drops
+        const uint32_t x = file.tilesX(0) - 1, y = file.tilesY(0) - 1;
+        const uint32_t wanted = packVirtualTile(0, x, y);
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while(!texture.pageTable().isMapped(0, x, y) && std::chrono::steady_clock::now() < deadline)
+        {
+            uploads.clear();
+            texture.addFeedback(&wanted, 1);
+            texture.update(uploads);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        LUX_CHECK(texture.pageTable().isMapped(0, x, y));
+        LUX_CHECK(texture.cache().find(top) != VirtualTileCache::kNoSlot);
+        LUX_CHECK(fallbackConsistent(texture.pageTable()));
+    }
+}
+
+int main()
+{
+    testPageTableFallback();
+    testCacheReplacement();
+
+    const std::string path = (std::filesystem::temp_directory_path() / "lux_virtual_texture_test.lxvt").string();
+    testResidency(path);
+    std::error_code error;
+    std::filesystem::remove(path, error);
+
+    return lux::engine::unit_test::result();
+}
@@ -10,6 +10,7 @@
 
 #include <graphic_api_wrapper/opengl3/VertexBufferObject.hpp>
 #include <graphic_api_wrapper/opengl3/ShaderProgram.hpp>
+#include <graphic_api_wrapper/opengl3/TextureUpload.hpp>
 
 #include "CubeVertex.hpp"
 
@@ -115,7 +116,10 @@ static int __main(int argc, char* argv[])
         std::cout << "Failed to load texture" << std::endl;
         return -1;
     }
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, image.width(), image.height(), 0, GL_RGBA, GL_UNSIGNED_BYTE, image.data());
+    function::ImageUploadSettings upload_settings;
+    upload_settings.srgb    = false;    // the shaders write the stored values, no sRGB framebuffer
+    upload_settings.mipmaps = false;
+    function::uploadImage(image, upload_settings);
     glActiveTexture(GL_TEXTURE0);
 
     GLuint vbo;
@@ -6,6 +6,7 @@
 #include <lux-engine/platform/media_loaders/Image.hpp>
 #include <graphic_api_wrapper/opengl3/VertexBufferObject.hpp>
 #include <graphic_api_wrapper/opengl3/ShaderProgram.hpp>
+#include <graphic_api_wrapper/opengl3/TextureUpload.hpp>
 
 static const char* predifined_vertex_shader =
 R"(
@@ -111,9 +112,9 @@ static int __main(int argc, char* argv[])
         std::cout << "Failed to load texture" << std::endl;
         return -1;
     }
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, image.width(), image.height(), 0, GL_RGBA, GL_UNSIGNED_BYTE, image.data());
-    
-    glGenerateMipmap(GL_TEXTURE_2D);
+    function::ImageUploadSettings upload_settings;
+    upload_settings.srgb    = false;    // the shaders write the stored values, no sRGB framebuffer
+    function::uploadImage(image, upload_settings);
     glActiveTexture(GL_TEXTURE0);
 
     GLuint vbo;
@@ -0,0 +1,323 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <lux-engine/platform/media_loaders/Image.hpp>
+#include <lux-engine/platform/media_loaders/ImageWriter.hpp>
+#include <lux-engine/platform/window/LuxWindow.hpp>
+#include <lux-engine/core/math/EigenTools.hpp>
+#include <lux-engine/resource/texture/EnvironmentMap.hpp>
+#include <render_helper/CameraHelper.hpp>
+
+#include <graphic_api_wrapper/opengl3/VertexBufferObject.hpp>
+#include <graphic_api_wrapper/opengl3/ShaderProgram.hpp>
+#include <graphic_api_wrapper/opengl3/IblUpload.hpp>
+#include <graphic_api_wrapper/opengl3/FramebufferReadback.hpp>
+
+#include "CubeVertex.hpp"
+
+static const char* predifined_vertex_shader =
+R"(
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+out     vec3 Normal;
+out     vec3 FragPos;
+
+void main()
+{
+    gl_Position = projection * view * model * vec4(aPos, 1.0f);
+    FragPos = vec3(model * vec4(aPos, 1.0f));
+    Normal = aNormal;
+}
+)";
+
+static const char* predefined_fragment_shader_head =
+R"(
+#version 330 core
+)";
+
+static const char* predefined_fragment_shader_body =
+R"(
+out vec4 color;
+
+in vec3 Normal;
+in vec3 FragPos;
+
+uniform vec3  viewPos;
+uniform vec3  f0;
+uniform float roughness;
+
+void main()
+{
+    vec3    norm        = normalize(Normal);
+    vec3    viewDir     = normalize(viewPos - FragPos);
+    // a bare metal, all of its light is the reflected environment
+    vec3    radiance    = ibl_specular(norm, viewDir, roughness, f0);
+
+    // linear radiance, no sRGB framebuffer
+    color = vec4(pow(radiance, vec3(1.0 / 2.2)), 1.0);
+}
+)";
+
+static const char* predefined_light_fragment_shader =
+R"(
+#version 330 core
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = vec4(1.0);
+}
+)";
+
+static int global_width  = 1920;
+static int global_height = 1080;
+
+static void glad_init()
+{
+    gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
+    int nrAttributes;
+    glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &nrAttributes);
+    std::cout << "Maximum nr of vertex attributes supported: " << nrAttributes << std::endl;
+}
+
+static int __main(int argc, char* argv[])
+{
+    using namespace lux::engine;
+    platform::LuxWindow window(global_width, global_height, "ibl");
+    glad_init();
+
+    function::ShaderProgram cube_program;
+    function::ShaderProgram light_program;
+
+    {
+        std::string info;
+        function::GlShader* shaders[2];
+        function::GlVertexShader   vertex_shader(&predifined_vertex_shader);
+        function::GlFragmentShader fragment_shader(
+            std::string(predefined_fragment_shader_head) + function::kSpecularIblGlsl + predefined_fragment_shader_body
+        );
+        shaders[0] = &vertex_shader;
+        shaders[1] = &fragment_shader;
+        for(auto shader : shaders)
+        {
+            bool is_success = shader->compile(info);
+            if(!is_success) {
+                std::string error_msg;
+                shader->getCompileMessage(error_msg);
+                std::cerr << "compile failed!" << std::endl;
+                std::cerr << error_msg << std::endl;
+                return -1;
+            };
+            cube_program.attachShader(*shader);
+        }
+        cube_program.link(info);
+    }
+
+    {
+        std::string info;
+        function::GlShader* shaders[2];
+        function::GlVertexShader   vertex_shader(&predifined_vertex_shader);
+        function::GlFragmentShader fragment_shader(&predefined_light_fragment_shader);
+        shaders[0] = &vertex_shader;
+        shaders[1] = &fragment_shader;
+        for(auto shader : shaders)
+        {
+            bool is_success = shader->compile(info);
+            if(!is_success) {
+                std::string error_msg;
+                shader->getCompileMessage(error_msg);
+                std::cerr << "compile failed!" << std::endl;
+                std::cerr << error_msg << std::endl;
+                return -1;
+            };
+            light_program.attachShader(*shader);
+        }
+        light_program.link(info);
+    }
+
+    // environment, an 8 bit equirect taken as sRGB. rows must run top to bottom, so no flip
+    platform::Image equirect("D:/Code/lux-game/playground/render/opengl3/texture/miku.png", false);
+    if(!equirect.isEnable())
+    {
+        std::cout << "Failed to load environment" << std::endl;
+        return -1;
+    }
+    resource::Cubemap environment = resource::cubemapFromEquirect(equirect, 512);
+    resource::generateCubemapMips(environment);
+    resource::Cubemap prefiltered = resource::prefilterSpecular(environment);
+    const uint32_t    brdf_lut_size = 128;
+    std::vector<float> brdf_lut     = resource::computeBrdfLut(brdf_lut_size);
+
+    GLuint ibl_textures[2];
+    glGenTextures(2, ibl_textures);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, ibl_textures[0]);
+    if(!function::uploadCubemap(prefiltered))
+    {
+        std::cout << "Failed to upload environment" << std::endl;
+        return -1;
+    }
+    glBindTexture(GL_TEXTURE_2D, ibl_textures[1]);
+    function::uploadBrdfLut(brdf_lut, brdf_lut_size);
+    glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+
+    GLuint vbo;
+    // vbo set
+    glGenBuffers(1, &vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(cube_vertex_normal), cube_vertex_normal, GL_STATIC_DRAW);
+
+    GLuint cube_vao;
+    glGenVertexArrays(1, &cube_vao);
+    glBindVertexArray(cube_vao);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Eigen::Vector6f), nullptr);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Eigen::Vector6f), (GLvoid*)(3 * sizeof(GLfloat)));
+    glEnableVertexAttribArray(1);
+    glBindVertexArray(0);
+
+    // light vao
+    GLuint light_vao;
+    glGenVertexArrays(1, &light_vao);
+    glBindVertexArray(light_vao);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Eigen::Vector6f), (void*)0);
+    glEnableVertexAttribArray(0);
+    glBindVertexArray(0);
+
+    glEnable(GL_DEPTH_TEST);
+
+    auto light_position = std::array<float, 3>{120.0f, 100.0f, 200.0f};
+    cube_program.use();
+
+    auto location_view_position = cube_program.uniformFindLocationUnsafe("viewPos");
+    auto location_roughness     = cube_program.uniformFindLocationUnsafe("roughness");
+
+    // gold
+    cube_program.uniformSetVector(cube_program.uniformFindLocationUnsafe("f0"), std::array{1.0f, 0.71f, 0.29f});
+    cube_program.uniformSetVector<int>(cube_program.uniformFindLocationUnsafe("ibl_prefiltered"), 0);
+    cube_program.uniformSetVector<int>(cube_program.uniformFindLocationUnsafe("ibl_brdf_lut"),    1);
+    cube_program.uniformSetVector(cube_program.uniformFindLocationUnsafe("ibl_level_count"),
+        static_cast<float>(prefiltered.levels.size()));
+
+    GLint cube_mvp_location[3]{
+        cube_program.uniformFindLocationUnsafe("model"),
+        cube_program.uniformFindLocationUnsafe("view"),
+        cube_program.uniformFindLocationUnsafe("projection")
+    };
+
+    light_program.use();
+    GLint light_mvp_location[3]{
+        light_program.uniformFindLocationUnsafe("model"),
+        light_program.uniformFindLocationUnsafe("view"),
+        light_program.uniformFindLocationUnsafe("projection")
+    };
+
+    // F12 saves the frame: the pixels come back a frame or two later, the png is written on the io threads
+    function::GlReadbackRing            readback;
+    platform::ImageWriter               screenshot_writer;
+    std::vector<function::ReadbackFrame> screenshots;
+    uint64_t                            screenshot_count = 0;
+    bool                                screenshot_key_down = false;
+
+    auto write_screenshots = [&]()
+    {
+        for(auto& frame : screenshots)
+        {
+            platform::ImageWriteRequest request;
+            request.path            = "ibl_screenshot_" + std::to_string(frame.user_data) + ".png";
+            request.pixels          = std::move(frame.pixels);
+            request.width           = frame.width;
+            request.height          = frame.height;
+            request.flip_vertically = true;
+            std::cout << "screenshot: " << request.path << std::endl;
+            screenshot_writer.submit(std::move(request));
+        }
+        screenshots.clear();
+    };
+
+    float deltaTime = 0.0f; // delta time
+    float lastFrame = 0.0f; // last frame time
+
+    function::UserControlCamera camera(window);
+
+    window.enableVsync(true);
+    glfwSetInputMode((GLFWwindow*)window.lowLayerPointer(), GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+
+    // cube position
+    Eigen::Affine3f cube_mode  = core::createTransform(Eigen::Vector3f{0,0,0}, {0,0,0});
+    // light position
+    Eigen::Affine3f light_mode = core::createTransform(Eigen::Vector3f{0,0,0}, light_position);
+
+    while(!window.shouldClose())
+    {
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+
+        float currentFrame = platform::LuxWindow::timeAfterFirstInitialization();
+        deltaTime = currentFrame - lastFrame;
+        lastFrame = currentFrame;
+
+        camera.setCameraSpeed(200.0f * deltaTime);
+        camera.updateViewInLoop();
+
+        Eigen::Matrix4f projection_transform =
+            core::perspectiveMatrix(camera.fov() * EIGEN_PI / 180, global_width / (float)global_height, 0.1f, 50000.0f);
+
+        cube_program.use();
+        cube_program.uniformSetMatrix(cube_mvp_location[0], false, cube_mode);
+        cube_program.uniformSetMatrix(cube_mvp_location[1], false, camera.viewMatrix());
+        cube_program.uniformSetMatrix(cube_mvp_location[2], false, projection_transform);
+
+        // sweep through every prefiltered level
+        cube_program.uniformSetVector(location_roughness,       0.5f + 0.5f * (float)sin(currentFrame * 0.5f));
+        cube_program.uniformSetVector(location_view_position,   camera.cameraPosition());
+
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_CUBE_MAP, ibl_textures[0]);
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, ibl_textures[1]);
+
+        glBindVertexArray(cube_vao);
+        glDrawArrays(GL_TRIANGLES, 0, 36);
+
+        light_program.use();
+        light_program.uniformSetMatrix(light_mvp_location[0], false, light_mode);
+        light_program.uniformSetMatrix(light_mvp_location[1], false, camera.viewMatrix());
+        light_program.uniformSetMatrix(light_mvp_location[2], false, projection_transform);
+        glBindVertexArray(light_vao);
+        glDrawArrays(GL_TRIANGLES, 0, 36);
+
+        // once per press, not once per frame the key is held
+        bool key_down = window.queryKey(platform::KeyEnum::KEY_F12) == platform::KeyState::PRESS;
+        if(key_down && !screenshot_key_down)
+        {
+            GLint viewport[4];
+            glGetIntegerv(GL_VIEWPORT, viewport);
+            readback.capture(viewport[0], viewport[1], viewport[2], viewport[3], screenshot_count++);
+        }
+        screenshot_key_down = key_down;
+        readback.collect(screenshots);
+        write_screenshots();
+
+        window.swapBuffer();
+        platform::LuxWindow::pollEvents();
+    }
+
+    // captures still in flight, the writer finishes the files before it goes away
+    readback.collect(screenshots, true);
+    write_screenshots();
+    screenshot_writer.waitIdle();
+
+    return 0;
+}
+
+#include <lux-engine/platform/cxx/SubProgram.hpp>
+RegistFunctionSubProgram(__main, "ibl")
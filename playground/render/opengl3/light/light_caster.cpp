@@ -2,14 +2,18 @@
 #include <GLFW/glfw3.h>
 #include <iostream>
 #include <functional>
+#include <iterator>
 
 #include <lux-engine/platform/media_loaders/Image.hpp>
 #include <lux-engine/platform/window/LuxWindow.hpp>
+#include <lux-engine/platform/cxx/TaskGraph.hpp>
 #include <lux-engine/core/math/EigenTools.hpp>
 #include <render_helper/CameraHelper.hpp>
 
 #include <graphic_api_wrapper/opengl3/VertexBufferObject.hpp>
 #include <graphic_api_wrapper/opengl3/ShaderProgram.hpp>
+#include <graphic_api_wrapper/opengl3/TextureUpload.hpp>
+#include <graphic_api_wrapper/opengl3/VertexLayout.hpp>
 
 #include <imgui.h>
 #include "imgui_impl_glfw.h"
@@ -93,25 +97,17 @@ static int __main(int argc, char* argv[])
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
     glBufferData(GL_ARRAY_BUFFER, sizeof(cube_vertex_normal_texture), cube_vertex_normal_texture, GL_STATIC_DRAW);
 
-    GLuint cube_vao;
-    glGenVertexArrays(1, &cube_vao);
-    glBindVertexArray(cube_vao);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Eigen::Vector8f), nullptr);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Eigen::Vector8f), (GLvoid*)(3 * sizeof(GLfloat)));
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Eigen::Vector8f), (GLvoid*)(6 * sizeof(GLfloat)));
-    glEnableVertexAttribArray(2);
-    glBindVertexArray(0);
-
-    // light vao
-    // glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    GLuint light_vao;
-    glGenVertexArrays(1, &light_vao);
-    glBindVertexArray(light_vao);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Eigen::Vector8f), (void*)0);
-    glEnableVertexAttribArray(0);
-    glBindVertexArray(0);
+    // interleaved position / normal / uv, the light cube only reads positions
+    using CubeLayout = function::VertexLayout<Eigen::Vector8f,
+        function::VertexAttribute<0, Eigen::Vector3f, 0>,
+        function::VertexAttribute<1, Eigen::Vector3f, 3 * sizeof(GLfloat)>,
+        function::VertexAttribute<2, Eigen::Vector2f, 6 * sizeof(GLfloat)>
+    >;
+    using LightLayout = function::VertexLayout<Eigen::Vector8f,
+        function::VertexAttribute<0, Eigen::Vector3f, 0>
+    >;
+    function::VertexArrayCache vertex_arrays;
+
     glEnable(GL_DEPTH_TEST);
 
     // textures
@@ -134,8 +130,9 @@ static int __main(int argc, char* argv[])
             std::cout << "Failed to load texture" << std::endl;
             return -1;
         }
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, image.width(), image.height(), 0, GL_RGBA, GL_UNSIGNED_BYTE, image.data());
-        glGenerateMipmap(GL_TEXTURE_2D);
+        function::ImageUploadSettings upload_settings;
+        upload_settings.srgb    = false;    // the shaders write the stored values, no sRGB framebuffer
+        function::uploadImage(image, upload_settings);
     }
 
     // light and cube attribute
@@ -205,34 +202,45 @@ static int __main(int argc, char* argv[])
     ImGui_ImplOpenGL3_Init("#version 130");
     
     float camera_speed = 200.0f;
-    while(!window.shouldClose())
-    {
-        platform::LuxWindow::pollEvents();
-        // Start the Dear ImGui frame
-        ImGui_ImplOpenGL3_NewFrame();
-        ImGui_ImplGlfw_NewFrame();
-        ImGui::NewFrame();
 
-        float currentFrame = platform::LuxWindow::timeAfterFirstInitialization();
-        deltaTime = currentFrame - lastFrame;
-        lastFrame = currentFrame;
+    // per frame stages with the state they share, the graph works out which ones may overlap
+    Eigen::Matrix4f projection_transform;
+    Eigen::Matrix4f view_transform;
+    Eigen::Affine3f cube_models[std::size(cubePositions)];
+    std::string     frame_report;
 
+    platform::TaskGraph frame_graph;
+    frame_graph.addSystem("ui", {"frame_report"}, {"cube_positions", "camera_speed", "imgui"}, [&]
+    {
+        ImGui::Begin("parameter panel!");
+        ImGui::SliderFloat("camera speed", &camera_speed, 0.0f, 2000.0f);
+        for(int count = 0; count < 10; count ++)
         {
-            ImGui::Begin("parameter panel!");
-            ImGui::SliderFloat("camera speed", &camera_speed, 0.0f, 2000.0f);
-            for(int count = 0; count < 10; count ++)
-            {
-                ImGui::SliderFloat3(std::to_string(count).c_str(), (float*)&cubePositions[count], -1000, 1000, "%.3f", 0);
-            }
-            ImGui::End();
+            ImGui::SliderFloat3(std::to_string(count).c_str(), (float*)&cubePositions[count], -1000, 1000, "%.3f", 0);
         }
-
+        ImGui::TextUnformatted(frame_report.c_str());
+        ImGui::End();
+    }, platform::SystemAffinity::CALLING_THREAD);
+    frame_graph.addSystem("camera", {"camera_speed"}, {"camera"}, [&]
+    {
         camera.setCameraSpeed(camera_speed * deltaTime);
         camera.updateViewInLoop();
-
-        Eigen::Matrix4f projection_transform = 
+        view_transform = camera.viewMatrix();
+    }, platform::SystemAffinity::CALLING_THREAD);
+    frame_graph.addSystem("projection", {"camera"}, {"projection"}, [&]
+    {
+        projection_transform = 
             core::perspectiveMatrix(camera.fov() * EIGEN_PI / 180, global_width / (float)global_height, 0.1f, 50000.0f);
-
+    });
+    frame_graph.addSystem("cube models", {"cube_positions"}, {"cube_models"}, [&]
+    {
+        for(size_t count = 0; count < std::size(cubePositions); count ++)
+        {
+            cube_models[count] = core::createTransform(Eigen::Vector3f{0,0,0}, cubePositions[count]);
+        }
+    });
+    frame_graph.addSystem("draw cubes", {"camera", "projection", "cube_models"}, {"gl"}, [&]
+    {
         cube_program.use();
     
         glActiveTexture(GL_TEXTURE0);
@@ -240,32 +248,50 @@ static int __main(int argc, char* argv[])
         glActiveTexture(GL_TEXTURE1);
         glBindTexture(GL_TEXTURE_2D, textures[1]);
 
-        cube_program.uniformSetMatrix(cube_mvp_location[1], false, camera.viewMatrix());
+        cube_program.uniformSetMatrix(cube_mvp_location[1], false, view_transform);
         cube_program.uniformSetMatrix(cube_mvp_location[2], false, projection_transform);
         cube_program.uniformSetVector(location_view_position,   camera.cameraPosition());
         
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
 
-        for(auto& cube_position : cubePositions)
+        for(auto& cube_model : cube_models)
         {
-            // cube position
-            auto cube_model  = core::createTransform(Eigen::Vector3f{0,0,0}, cube_position);
             cube_program.uniformSetMatrix(cube_mvp_location[0], false, cube_model);
-            glBindVertexArray(cube_vao);
+            vertex_arrays.bind<CubeLayout>(vbo);
             glDrawArrays(GL_TRIANGLES, 0, 36);
         }
-
+    }, platform::SystemAffinity::CALLING_THREAD);
+    frame_graph.addSystem("draw light", {"camera", "projection"}, {"gl"}, [&]
+    {
         light_program.use();
         light_program.uniformSetMatrix(light_mvp_location[0], false, light_model);
-        light_program.uniformSetMatrix(light_mvp_location[1], false, camera.viewMatrix());
+        light_program.uniformSetMatrix(light_mvp_location[1], false, view_transform);
         light_program.uniformSetMatrix(light_mvp_location[2], false, projection_transform);
 
-        ImGui::Render();
-
-        glBindVertexArray(light_vao);
+        vertex_arrays.bind<LightLayout>(vbo);
         glDrawArrays(GL_TRIANGLES, 0, 36);
+    }, platform::SystemAffinity::CALLING_THREAD);
+    frame_graph.addSystem("draw ui", {"imgui"}, {"gl"}, [&]
+    {
+        ImGui::Render();
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    }, platform::SystemAffinity::CALLING_THREAD);
+
+    while(!window.shouldClose())
+    {
+        platform::LuxWindow::pollEvents();
+        // Start the Dear ImGui frame
+        ImGui_ImplOpenGL3_NewFrame();
+        ImGui_ImplGlfw_NewFrame();
+        ImGui::NewFrame();
+
+        float currentFrame = platform::LuxWindow::timeAfterFirstInitialization();
+        deltaTime = currentFrame - lastFrame;
+        lastFrame = currentFrame;
+
+        frame_graph.run();
+        frame_report = frame_graph.describeCriticalPath();
 
         window.swapBuffer();
     }
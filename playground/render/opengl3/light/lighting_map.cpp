@@ -4,12 +4,15 @@
 #include <functional>
 
 #include <lux-engine/platform/media_loaders/Image.hpp>
+#include <lux-engine/platform/media_loaders/ImageLoader.hpp>
 #include <lux-engine/platform/window/LuxWindow.hpp>
 #include <lux-engine/core/math/EigenTools.hpp>
 #include <render_helper/CameraHelper.hpp>
 
 #include <graphic_api_wrapper/opengl3/VertexBufferObject.hpp>
 #include <graphic_api_wrapper/opengl3/ShaderProgram.hpp>
+#include <graphic_api_wrapper/opengl3/TextureUpload.hpp>
+#include <graphic_api_wrapper/opengl3/VertexLayout.hpp>
 
 #include "CubeVertex.hpp"
 
@@ -167,25 +170,17 @@ static int __main(int argc, char* argv[])
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
     glBufferData(GL_ARRAY_BUFFER, sizeof(cube_vertex_normal_texture), cube_vertex_normal_texture, GL_STATIC_DRAW);
 
-    GLuint cube_vao;
-    glGenVertexArrays(1, &cube_vao);
-    glBindVertexArray(cube_vao);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Eigen::Vector8f), nullptr);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Eigen::Vector8f), (GLvoid*)(3 * sizeof(GLfloat)));
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Eigen::Vector8f), (GLvoid*)(6 * sizeof(GLfloat)));
-    glEnableVertexAttribArray(2);
-    glBindVertexArray(0);
-
-    // light vao
-    // glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    GLuint light_vao;
-    glGenVertexArrays(1, &light_vao);
-    glBindVertexArray(light_vao);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Eigen::Vector8f), (void*)0);
-    glEnableVertexAttribArray(0);
-    glBindVertexArray(0);
+    // interleaved position / normal / uv, the light cube only reads positions
+    using CubeLayout = function::VertexLayout<Eigen::Vector8f,
+        function::VertexAttribute<0, Eigen::Vector3f, 0>,
+        function::VertexAttribute<1, Eigen::Vector3f, 3 * sizeof(GLfloat)>,
+        function::VertexAttribute<2, Eigen::Vector2f, 6 * sizeof(GLfloat)>
+    >;
+    using LightLayout = function::VertexLayout<Eigen::Vector8f,
+        function::VertexAttribute<0, Eigen::Vector3f, 0>
+    >;
+    function::VertexArrayCache vertex_arrays;
+
     glEnable(GL_DEPTH_TEST);
 
     // textures
@@ -194,6 +189,9 @@ static int __main(int argc, char* argv[])
         "D:/Code/lux-game/playground/render/opengl3/texture/container2.png",
         "D:/Code/lux-game/playground/render/opengl3/texture/container2_specular.png"
     };
+    // decode both textures in parallel, uploads stay on this thread
+    platform::ImageLoader image_loader;
+    auto images = image_loader.loadBatch({{paths[0]}, {paths[1]}});
     for(uint8_t count = 0; count < 2 ; count ++)
     {
         glGenTextures(1, &textures[count]);
@@ -202,14 +200,16 @@ static int __main(int argc, char* argv[])
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T,       GL_REPEAT);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,   GL_LINEAR_MIPMAP_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER,   GL_NEAREST_MIPMAP_NEAREST);
-        lux::engine::platform::Image image(paths[count]);
-        if(!image.isEnable())
+        images[count].wait();
+        if(images[count].status() != platform::ImageLoadStatus::READY)
         {
             std::cout << "Failed to load texture" << std::endl;
             return -1;
         }
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, image.width(), image.height(), 0, GL_RGBA, GL_UNSIGNED_BYTE, image.data());
-        glGenerateMipmap(GL_TEXTURE_2D);
+        auto& image = images[count].image();
+        function::ImageUploadSettings upload_settings;
+        upload_settings.srgb    = false;    // the shaders write the stored values, no sRGB framebuffer
+        function::uploadImage(image, upload_settings);
     }
 
     // light and cube attribute
@@ -288,14 +288,14 @@ static int __main(int argc, char* argv[])
         glActiveTexture(GL_TEXTURE1);
         glBindTexture(GL_TEXTURE_2D, textures[1]);
 
-        glBindVertexArray(cube_vao);
+        vertex_arrays.bind<CubeLayout>(vbo);
         glDrawArrays(GL_TRIANGLES, 0, 36);
 
         light_program.use();
         light_program.uniformSetMatrix(light_mvp_location[0], false, light_model);
         light_program.uniformSetMatrix(light_mvp_location[1], false, camera.viewMatrix());
         light_program.uniformSetMatrix(light_mvp_location[2], false, projection_transform);
-        glBindVertexArray(light_vao);
+        vertex_arrays.bind<LightLayout>(vbo);
         glDrawArrays(GL_TRIANGLES, 0, 36);
 
         window.swapBuffer();